@@ -0,0 +1,116 @@
+// Copyright (c) 2026.The Cloth contributors.
+//
+// CompilerThroughput.cs is part of the Cloth Compiler Benchmarks.
+//
+// Use, modification, and distribution of this file are governed by the
+// license terms provided with the Cloth Compiler source distribution.
+
+using Compiler;
+using Compiler.CIR;
+using Compiler.CIR.Passes;
+using Compiler.Configs;
+using Compiler.Configs.Profiles;
+using Compiler.LLVM;
+using Compiler.Semantics;
+using FrontEnd.File;
+using FrontEnd.Lexer;
+using FrontEnd.Parser;
+using FrontEnd.Parser.AST;
+
+namespace Benchmarks;
+
+/// <summary>
+/// The statistics of one phase over a shape's measured runs. Times are per run, in milliseconds;
+/// <see cref="AllocatedBytes"/> is the median bytes the phase allocated per run and <see cref="Gen0Collections"/>
+/// the total gen-0 collections it triggered across all runs.
+/// </summary>
+public sealed record PhaseStats(string Phase, double MeanMs, double StdDevMs, double MedianMs, double MinMs, long AllocatedBytes, int Gen0Collections, int Gen2Collections);
+
+/// <summary>
+/// One benchmarked project size: its shape, how much source it generated, how many functions it lowered
+/// to, and every phase's statistics in pipeline order.
+/// </summary>
+public sealed record ShapeResult(ProjectShape Shape, int Files, int Tokens, int Functions, List<PhaseStats> Phases);
+
+// Runs the compiler's in-memory pipeline over a generated project, phase by phase, the way
+// `Compiler.Compile` does — but without the cache, dependencies or the backend, and with the
+// sources already read, so the numbers are the compiler's own. Modeled on BenchmarkDotNet: a
+// few discarded warmup runs for the JIT and tiered compilation, then measured runs reported
+// as mean / standard deviation / median / min and allocated bytes.
+public sealed class CompilerThroughput(int warmup, int iterations) {
+	// Every phase this harness reports, in pipeline order. `parse` includes lexing, since the
+	// parser pulls tokens lazily; `lex` alone is the difference.
+	public static readonly string[] PhaseOrder = [
+		"lex", "parse", "symbols", "symbols.names", "symbols.members", "symbols.vtables", "symbols.prototype-slots", "symbols.effects",
+		"analyze", "lower", "passes", "emit"
+	];
+
+	public ShapeResult Run(string projectRoot, ProjectShape shape) {
+		var paths = SyntheticProject.Write(projectRoot, shape);
+		var sources = paths.Select(p => (Path: p, Content: File.ReadAllText(p))).ToList();
+		var config = ConfigReader.Read(Path.Combine(projectRoot, "build.toml"));
+		var sourceRoot = Path.Combine(projectRoot, config.Build.Source);
+		var tokens = sources.Sum(s => Lex(s.Path, s.Content).Count);
+
+		for (var i = 0; i < warmup; i++) RunOnce(sources, config, projectRoot, sourceRoot);
+
+		var runs = new List<IReadOnlyList<PhaseTiming>>();
+		var functions = 0;
+		for (var i = 0; i < iterations; i++) {
+			// Start each run from an empty gen 0 so one run's garbage isn't collected on the next one's clock.
+			GC.Collect();
+			GC.WaitForPendingFinalizers();
+			var (timings, lowered) = RunOnce(sources, config, projectRoot, sourceRoot);
+			runs.Add(timings);
+			functions = lowered;
+		}
+
+		var phases = PhaseOrder.Select(phase => Summarize(phase, runs.Select(r => r.First(t => t.Phase == phase)).ToList())).ToList();
+		return new ShapeResult(shape, sources.Count, tokens, functions, phases);
+	}
+
+	// One full pass over the pipeline. Every phase gets fresh inputs from the phase before it,
+	// as in a real build, since the registry and analyzer are filled in as they run. Returns the
+	// timings and the optimized module's function count.
+	private static (IReadOnlyList<PhaseTiming> Timings, int Functions) RunOnce(List<(string Path, string Content)> sources, ClothConfig config, string projectRoot, string sourceRoot) {
+		var phases = new PhaseRecorder(config.Project.Name);
+		var profile = ProfileSettings.For(BuildProfile.Release);
+
+		// Serial, unlike `Compiler.ParseUnits`: per-file cost is what scales with the project,
+		// and a parallel loop would mostly measure the machine's core count.
+		phases.Measure("lex", () => {
+			foreach (var (path, content) in sources) Lex(path, content);
+		});
+		var units = phases.Measure("parse", () => sources.Select(s => (Unit: Parse(s.Path, s.Content), FilePath: s.Path)).ToList());
+		var symbols = phases.Measure("symbols", () => SymbolRegistry.Build(units, phases: phases));
+
+		var analyzer = new SemanticAnalyzer(units, sourceRoot, symbols, null, config.Build.AllowLeaks);
+		phases.Measure("analyze", () => analyzer.Analyze(requireMain: config.Build.OutputType == OutputType.Executable));
+
+		var lowered = phases.Measure("lower", () => new CirGenerator(symbols).Generate(units, analyzer.InferredVarTypes));
+		var module = phases.Measure("passes", () => CirPassManager.Default().Run(lowered, new CirPassContext(profile, config.Build.OutputType)));
+
+		// The emitter streams text as it goes, so writing to a null sink times the lowering
+		// to IR without the disk.
+		phases.Measure("emit", () => new LlvmEmitter(module, config, projectRoot).Emit(TextWriter.Null));
+		return (phases.Timings, module.Functions.Count);
+	}
+
+	private static ClothFile SourceFile(string path, string content) => new(path, Path.GetFileNameWithoutExtension(path), content, true);
+
+	private static List<FrontEnd.Token.Token> Lex(string path, string content) => new Lexer(SourceFile(path, content)).LexAll();
+
+	private static CompilationUnit Parse(string path, string content) => new Parser(new Lexer(SourceFile(path, content))).Parse();
+
+	private static PhaseStats Summarize(string phase, List<PhaseTiming> timings) {
+		var ms = timings.Select(t => t.ElapsedMs).Order().ToList();
+		var mean = ms.Average();
+		var stdDev = ms.Count > 1 ? Math.Sqrt(ms.Sum(x => (x - mean) * (x - mean)) / (ms.Count - 1)) : 0;
+		var allocated = timings.Select(t => t.AllocatedBytes).Order().ToList();
+		return new PhaseStats(phase, mean, stdDev, Median(ms), ms[0], allocated[allocated.Count / 2],
+			timings.Sum(t => t.Gen0Collections), timings.Sum(t => t.Gen2Collections));
+	}
+
+	private static double Median(List<double> sorted) =>
+		sorted.Count % 2 == 1 ? sorted[sorted.Count / 2] : (sorted[sorted.Count / 2 - 1] + sorted[sorted.Count / 2]) / 2;
+}
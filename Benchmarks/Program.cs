@@ -0,0 +1,92 @@
+// Copyright (c) 2026.The Cloth contributors.
+//
+// Program.cs is part of the Cloth Compiler Benchmarks.
+//
+// Use, modification, and distribution of this file are governed by the
+// license terms provided with the Cloth Compiler source distribution.
+
+using Benchmarks;
+using FrontEnd.Utilities;
+
+// Compiler-throughput benchmarks: generates synthetic projects of growing size and times each
+// compiler phase on them, then checks that emission stays linear up to a project of
+// `--emission-functions` functions, exiting with 1 when it doesn't.
+//
+//   dotnet run -c Release --project Benchmarks -- [options]
+//
+//   --modules=4,8,16,32          module counts to sweep (the other dimensions stay fixed)
+//   --classes=8                  classes per module
+//   --interfaces=2               interfaces per module
+//   --overloads=4                `mix` overloads per class (1-8)
+//   --depth=4                    inheritance chain depth
+//   --iterations=10              measured runs per size
+//   --warmup=3                   discarded runs per size
+//   --emission-functions=50000   functions in the emission check's large project (a quarter in
+//                                the small one), 0 to skip it
+//   --out=<dir>                  generate into <dir> and keep the last size (default: a temporary directory)
+//   --json                       also print the results as JSON
+
+var options = args.Where(a => a.StartsWith("--")).Select(a => a[2..].Split('=', 2)).ToDictionary(kv => kv[0], kv => kv.Length > 1 ? kv[1] : "");
+
+int Option(string name, int fallback, int min = 1) {
+	if (!options.TryGetValue(name, out var text)) return fallback;
+	if (int.TryParse(text, out var value) && value >= min) return value;
+	Console.Error.WriteLine($"Error: --{name} expects an integer of at least {min}, got '{text}'");
+	Environment.Exit(1);
+	return 0;
+}
+
+List<int> moduleCounts = [4, 8, 16, 32];
+if (options.TryGetValue("modules", out var list)) {
+	moduleCounts = list.Split(',').Select(m => int.TryParse(m, out var count) && count > 0 ? count : 0).ToList();
+	if (moduleCounts.Contains(0)) {
+		Console.Error.WriteLine($"Error: --modules expects a comma-separated list of positive integers, got '{list}'");
+		Environment.Exit(1);
+	}
+}
+
+var shapes = moduleCounts.Select(m => new ProjectShape(m, Option("classes", 8), Option("interfaces", 2), Option("overloads", 4), Option("depth", 4))).ToList();
+var keep = options.TryGetValue("out", out var outDir);
+var root = keep ? Path.GetFullPath(outDir!) : Path.Combine(Path.GetTempPath(), $"cloth-bench-{Environment.ProcessId}");
+
+// The emission check's projects are wide modules of full-overload classes (more than 32
+// classes would name a field `f32`). The passes drop functions nothing reaches, so one- and
+// two-module probes measure what a module lowers to before the sizes are picked.
+var emissionFunctions = Option("emission-functions", 50000, min: 0);
+var emissionShape = new ProjectShape(1, 32, 2, SyntheticProject.MaxOverloads, 4);
+
+var harness = new CompilerThroughput(Option("warmup", 3, min: 0), Option("iterations", 10));
+var results = new List<ShapeResult>();
+var emissionLinear = true;
+try {
+	foreach (var shape in shapes) {
+		var result = harness.Run(root, shape);
+		results.Add(result);
+		Report.Print(result);
+	}
+
+	if (emissionFunctions > 0) {
+		// Both sizes run the whole pipeline, so they take fewer samples than the sweep.
+		var emissionHarness = new CompilerThroughput(1, 3);
+		var probe = new CompilerThroughput(0, 1);
+		var oneModule = probe.Run(root, emissionShape).Functions;
+		var perModule = Math.Max(1, probe.Run(root, emissionShape with { Modules = 2 }).Functions - oneModule);
+		var emissionModules = 1 + Math.Max(0, emissionFunctions - oneModule + perModule - 1) / perModule;
+		var small = emissionHarness.Run(root, emissionShape with { Modules = Math.Max(1, emissionModules / 4) });
+		Report.Print(small);
+		var large = emissionHarness.Run(root, emissionShape with { Modules = emissionModules });
+		Report.Print(large);
+		emissionLinear = Report.PrintEmissionCheck(small, large);
+	}
+}
+catch (ArgumentException e) {
+	Console.Error.WriteLine($"Error: {e.Message}");
+	Environment.Exit(1);
+}
+finally {
+	if (!keep && Directory.Exists(root)) Directory.Delete(root, recursive: true);
+}
+
+Report.PrintScaling(results);
+if (options.ContainsKey("json")) Console.WriteLine(new JsonDump<List<ShapeResult>>(results).ToJson());
+if (!emissionLinear) Environment.Exit(1);
@@ -0,0 +1,89 @@
+// Copyright (c) 2026.The Cloth contributors.
+//
+// Report.cs is part of the Cloth Compiler Benchmarks.
+//
+// Use, modification, and distribution of this file are governed by the
+// license terms provided with the Cloth Compiler source distribution.
+
+namespace Benchmarks;
+
+public static class Report {
+	// A phase whose time grows faster than tokens^SuperlinearExponent between two sizes is
+	// flagged; the slack absorbs noise and the log factor of sorted or hashed lookups.
+	private const double SuperlinearExponent = 1.25;
+
+	// The emission check's limit. What it guards against, a scan of the module's functions per
+	// call site, shows as an exponent near 2; at 50k functions cache and GC effects alone take
+	// a linear phase past `SuperlinearExponent`.
+	private const double EmissionExponent = 1.5;
+
+	public static void Print(ShapeResult result) {
+		Console.WriteLine($"{result.Shape}: {result.Files} files, {result.Tokens} tokens, {result.Functions} functions");
+		Console.WriteLine($"  {"phase",-26} {"mean",10} {"stddev",10} {"median",10} {"min",10} {"allocated",12} {"gen0",6} {"gen2",6}");
+		foreach (var p in result.Phases) {
+			// Sub-phases are indented under the phase that contains them.
+			var name = p.Phase.Contains('.') ? "  " + p.Phase : p.Phase;
+			Console.WriteLine($"  {name,-26} {Ms(p.MeanMs),10} {Ms(p.StdDevMs),10} {Ms(p.MedianMs),10} {Ms(p.MinMs),10} {Bytes(p.AllocatedBytes),12} {p.Gen0Collections,6} {p.Gen2Collections,6}");
+		}
+
+		Console.WriteLine();
+	}
+
+	// How each phase's median time grows with the token count between consecutive sizes:
+	// the exponent k in time ~ tokens^k, so 1 is linear and 2 quadratic.
+	public static void PrintScaling(List<ShapeResult> results) {
+		if (results.Count < 2) return;
+
+		Console.WriteLine("Scaling exponent (median time vs. tokens):");
+		Console.Write($"  {"phase",-26}");
+		for (var i = 1; i < results.Count; i++)
+			Console.Write($" {$"{results[i - 1].Shape.Modules}->{results[i].Shape.Modules}m",10}");
+		Console.WriteLine();
+
+		var flagged = new List<string>();
+		foreach (var phase in CompilerThroughput.PhaseOrder) {
+			Console.Write($"  {phase,-26}");
+			for (var i = 1; i < results.Count; i++) {
+				var before = results[i - 1];
+				var after = results[i];
+				var t0 = before.Phases.First(p => p.Phase == phase).MedianMs;
+				var t1 = after.Phases.First(p => p.Phase == phase).MedianMs;
+				if (t0 <= 0 || t1 <= 0 || after.Tokens == before.Tokens) {
+					Console.Write($" {"-",10}");
+					continue;
+				}
+
+				var exponent = Math.Log(t1 / t0) / Math.Log((double)after.Tokens / before.Tokens);
+				if (exponent > SuperlinearExponent && !flagged.Contains(phase)) flagged.Add(phase);
+				Console.Write($" {exponent,10:F2}");
+			}
+
+			Console.WriteLine();
+		}
+
+		if (flagged.Count > 0)
+			Console.WriteLine($"Superlinear (exponent > {SuperlinearExponent}): {string.Join(", ", flagged)}");
+	}
+
+	// The emission regression check: how `emit`'s median time grows with the function count
+	// from `small` to `large`. False when it grows faster than functions^EmissionExponent.
+	public static bool PrintEmissionCheck(ShapeResult small, ShapeResult large) {
+		var t0 = small.Phases.First(p => p.Phase == "emit").MedianMs;
+		var t1 = large.Phases.First(p => p.Phase == "emit").MedianMs;
+		var exponent = t0 > 0 && t1 > 0 && large.Functions > small.Functions
+			? Math.Log(t1 / t0) / Math.Log((double)large.Functions / small.Functions)
+			: 0;
+		var linear = exponent <= EmissionExponent;
+		Console.WriteLine($"Emission: {small.Functions} -> {large.Functions} functions, {Ms(t0)} -> {Ms(t1)}, exponent {exponent:F2} ({(linear ? "ok" : $"superlinear, over {EmissionExponent}")})");
+		return linear;
+	}
+
+	private static string Ms(double ms) => $"{ms:F3} ms";
+
+	private static string Bytes(long bytes) => bytes switch {
+		>= 1 << 30 => $"{bytes / (double)(1 << 30):F2} GB",
+		>= 1 << 20 => $"{bytes / (double)(1 << 20):F2} MB",
+		>= 1 << 10 => $"{bytes / (double)(1 << 10):F2} KB",
+		_ => $"{bytes} B"
+	};
+}
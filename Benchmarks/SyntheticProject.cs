@@ -0,0 +1,236 @@
+// Copyright (c) 2026.The Cloth contributors.
+//
+// SyntheticProject.cs is part of the Cloth Compiler Benchmarks.
+//
+// Use, modification, and distribution of this file are governed by the
+// license terms provided with the Cloth Compiler source distribution.
+
+using System.Text;
+
+namespace Benchmarks;
+
+/// <summary>
+/// The shape of a generated project: <see cref="Modules"/> modules, each with <see cref="Interfaces"/>
+/// interfaces (one with a default method) and a prototype base class extended by <see cref="Classes"/>
+/// classes. The classes form inheritance chains <see cref="Depth"/> deep, every one declares
+/// <see cref="Overloads"/> overloads of <c>mix</c>, and each module's first class calls into the
+/// previous module, so imports and cross-module resolution grow with the module count.
+/// </summary>
+public sealed record ProjectShape(int Modules, int Classes, int Interfaces, int Overloads, int Depth) {
+	public override string ToString() => $"{Modules}m x {Classes}c, {Interfaces}i, {Overloads}o, depth {Depth}";
+}
+
+// Writes a valid, leak-free executable project of a given `ProjectShape`, built from the
+// constructs Tests/My-Project exercises: interfaces with default methods, prototype classes
+// and prototype methods, inheritance chains, overloads, field initializers, loops,
+// `new`/`delete`, interface-typed locals and cross-module imports. It uses no standard
+// library, so it compiles on its own.
+public static class SyntheticProject {
+	// Parameter lists of the `mix` overloads. Every variant returns i64.
+	private static readonly string[][] OverloadParams = [
+		["i32"],
+		["i64"],
+		["i32", "i32"],
+		["i64", "i64"],
+		["i32", "i64"],
+		["i32", "i32", "i32"],
+		["i64", "i32", "i32"],
+		["i64", "i64", "i64"]
+	];
+
+	public static int MaxOverloads => OverloadParams.Length;
+
+	/// <summary>
+	/// Generates the project under <paramref name="root"/>: a <c>build.toml</c> and <c>src/gen/...</c>.
+	/// An existing <c>src</c> directory is replaced.
+	/// </summary>
+	/// <returns>The source file paths, sorted as the compiler collects them.</returns>
+	public static List<string> Write(string root, ProjectShape shape) {
+		if (shape.Modules < 1 || shape.Classes < 1 || shape.Interfaces < 1 || shape.Depth < 1 || shape.Overloads is < 1 || shape.Overloads > MaxOverloads)
+			throw new ArgumentException($"invalid project shape: {shape} (overloads must be 1-{MaxOverloads}, everything else at least 1)");
+
+		var sourceRoot = Path.Combine(root, "src");
+		if (Directory.Exists(sourceRoot)) Directory.Delete(sourceRoot, recursive: true);
+		Directory.CreateDirectory(root);
+		File.WriteAllText(Path.Combine(root, "build.toml"), "[project]\nname = \"Synthetic\"\nversion = \"0.0.1\"\n\n[build]\ntarget = \"x86_64\"\noutputType = 0\nsource = \"src\"\n");
+
+		var files = new List<string>();
+		void Emit(string module, string name, string text) {
+			var dir = Path.Combine(sourceRoot, Path.Combine(module.Split('.')));
+			Directory.CreateDirectory(dir);
+			var path = Path.Combine(dir, name + ".co");
+			File.WriteAllText(path, text);
+			files.Add(path);
+		}
+
+		for (var m = 0; m < shape.Modules; m++) {
+			var module = ModuleName(m);
+			for (var i = 0; i < shape.Interfaces; i++)
+				Emit(module, InterfaceName(m, i), Interface(module, i));
+			Emit(module, BaseName(m), Base(module, m));
+			for (var c = 0; c < shape.Classes; c++)
+				Emit(module, ClassName(m, c), Class(module, m, c, shape));
+		}
+
+		Emit("gen", "Main", MainClass(shape));
+		files.Sort(StringComparer.Ordinal);
+		return files;
+	}
+
+	private static string ModuleName(int m) => $"gen.m{m}";
+
+	private static string InterfaceName(int m, int i) => $"M{m}Iface{i}";
+
+	private static string BaseName(int m) => $"M{m}Base";
+
+	private static string ClassName(int m, int c) => $"M{m}Node{c}";
+
+	// A chain starts every `Depth` classes, extending the module's base and implementing one
+	// of its interfaces; the rest extend the class before them and inherit its interface.
+	private static bool StartsChain(int c, ProjectShape shape) => c % shape.Depth == 0;
+
+	private static int ChainInterface(int c, ProjectShape shape) => c / shape.Depth % shape.Interfaces;
+
+	private static string Interface(string module, int i) => $$"""
+		module {{module}};
+
+		public interface {
+		    public func area(i32 scale): i32;
+		    public func label(): string;
+		    public func weight(): i32 {
+		        return {{i + 1}};
+		    }
+		}
+
+		""";
+
+	private static string Base(string module, int m) => $$"""
+		module {{module}};
+
+		public prototype class () {
+
+		    public i32 seed = {{m % 7 + 1}};
+
+		    public {{BaseName(m)}} {
+		    }
+
+		    public ~{{BaseName(m)}} {
+		    }
+
+		    public prototype func kind(): i32;
+
+		}
+
+		""";
+
+	private static string Class(string module, int m, int c, ProjectShape shape) {
+		var sb = new StringBuilder();
+		sb.Append($"module {module};\n\n");
+		if (c == 0 && m > 0) sb.Append($"import {ModuleName(m - 1)}.{ClassName(m - 1, 0)};\n\n");
+
+		var parent = StartsChain(c, shape) ? BaseName(m) : ClassName(m, c - 1);
+		var implements = StartsChain(c, shape) ? $" -> {InterfaceName(m, ChainInterface(c, shape))}" : "";
+		var name = ClassName(m, c);
+		sb.Append($$"""
+			public class () : {{parent}}{{implements}} {
+
+			    public i32 f{{c}} = {{c % 5 + 1}};
+
+			    public {{name}} {
+			    }
+
+			    public ~{{name}} {
+			    }
+
+			    public func kind(): i32 {
+			        return {{c}};
+			    }
+
+			    public func area(i32 scale): i32 {
+			        i32 total = 0;
+			        for (i32 i = 0; i < scale; i++) {
+			            if (i % 2 == 0) {
+			                total = total + this.kind() * i;
+			            } else {
+			                total = total - this.f{{c}};
+			            }
+			        }
+			        return total;
+			    }
+
+			    public func label(): string {
+			        return "m{{m}}n{{c}}";
+			    }
+
+			""");
+
+		for (var o = 0; o < shape.Overloads; o++) {
+			var ps = OverloadParams[o];
+			var names = ps.Select((_, k) => ((char)('a' + k)).ToString()).ToList();
+			sb.Append($"\n    public func mix({string.Join(", ", ps.Zip(names, (t, n) => $"{t} {n}"))}): i64 {{\n");
+			sb.Append("        i64 r = 0;\n");
+			foreach (var n in names)
+				sb.Append($"        r = r + {n};\n");
+			sb.Append($"        while (r > {100 + o}) {{\n            r = r - {c + o + 1};\n        }}\n");
+			sb.Append("        return r;\n    }\n");
+		}
+
+		if (c == 0 && m > 0) {
+			sb.Append($$"""
+
+				    public func link(): i32 {
+				        let other = new {{ClassName(m - 1, 0)}}();
+				        i32 r = other.kind() + other.area(2);
+				        delete other;
+				        return r;
+				    }
+
+				""");
+		}
+
+		sb.Append("\n}\n");
+		return sb.ToString();
+	}
+
+	// Constructs the first and last class of the first chain in every module, calls them both
+	// directly (overload resolution) and through the chain's interface (vtable dispatch,
+	// inherited by the deeper class), then deletes them.
+	private static string MainClass(ProjectShape shape) {
+		var sb = new StringBuilder();
+		sb.Append("module gen;\n\n");
+		var deep = Math.Min(shape.Depth, shape.Classes) - 1;
+		for (var m = 0; m < shape.Modules; m++) {
+			sb.Append($"import {ModuleName(m)}.{ClassName(m, 0)};\n");
+			if (deep > 0) sb.Append($"import {ModuleName(m)}.{ClassName(m, deep)};\n");
+			sb.Append($"import {ModuleName(m)}.{InterfaceName(m, 0)};\n");
+		}
+
+		sb.Append("\npublic class (string[] args) {\n\n    public Main {\n        i64 sum = 0;\n");
+		for (var m = 0; m < shape.Modules; m++) {
+			var args = string.Join(", ", OverloadParams[shape.Overloads - 1].Select((_, k) => (k + 1).ToString()));
+			sb.Append($$"""
+
+				        let first{{m}} = new {{ClassName(m, 0)}}();
+				        {{InterfaceName(m, 0)}} s{{m}} = first{{m}};
+				        sum = sum + s{{m}}.area(4) + s{{m}}.weight();
+				        sum = sum + first{{m}}.mix({{args}});
+
+				""");
+			if (m > 0) sb.Append($"        sum = sum + first{m}.link();\n");
+			if (deep > 0) {
+				sb.Append($$"""
+					        let deep{{m}} = new {{ClassName(m, deep)}}();
+					        {{InterfaceName(m, 0)}} d{{m}} = deep{{m}};
+					        sum = sum + d{{m}}.area(3);
+					        delete deep{{m}};
+
+					""");
+			}
+
+			sb.Append($"        delete first{m};\n");
+		}
+
+		sb.Append("    }\n\n}\n");
+		return sb.ToString();
+	}
+}
@@ -4,7 +4,8 @@ open System
 
 // This is the artifacts left by LLVM and the Cloth compiler.
 // Since there is no point in keeping them, we can delete them.
-// Only the executable stays.
+// Only the executable stays. Subdirectories are left alone, so the PGO profiles in
+// build/pgo/ outlive the run that recorded them.
 let CLEANUP_EXTENSIONS: string[] = [| "o"; "ll" |]
 
 // Deletes all files with the given extensions in the given directory.
@@ -7,6 +7,8 @@ open Commands.Executor.Lexer
 open Commands.Executor.Help
 open Commands.Executor.Parser
 open Commands.Executor.Run
+open Commands.Executor.Bench
+open Commands.Executor.Serve
 open Commands.Executor.NewProject
 
 let dispatch (args: string[]) =
@@ -30,6 +32,14 @@ let dispatch (args: string[]) =
             else
                 runRun (args[1], args)
 
+        | "bench" ->
+            if args.Length < 2 then
+                Failure "Expected project directory. Example: cloth bench ./my-project"
+            else
+                runBench (args[1], args)
+
+        | "serve" -> runServe args
+
         | "test" -> Success "Test Called"
 
         | "lexer" ->
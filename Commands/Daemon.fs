@@ -0,0 +1,146 @@
+module Commands.Daemon
+
+open System
+open System.IO
+open System.Net.Sockets
+open System.Text
+open System.Text.Json
+open Commands.DispatchResult
+
+// `cloth serve` listens on a Unix domain socket (supported on Windows 10 and later too) and
+// runs each build it is handed in its own warm process. The protocol is one JSON request
+// line from the client, then JSON frame lines back: the build's stdout and stderr as it
+// writes them, and a final frame with its outcome.
+
+[<CLIMutable>]
+type DaemonRequest =
+    { Command: string
+      Path: string
+      Flags: string[]
+      StdlibPath: string
+      Version: string }
+
+// `Kind` is "out" or "err" for output, or the outcome: "success" / "failure" with a
+// message, "abort" with the exit code of a fatal diagnostic, or "stale" when the daemon
+// runs a different compiler binary than the client.
+[<CLIMutable>]
+type DaemonFrame =
+    { Kind: string
+      Text: string
+      Code: int }
+
+let socketPath () =
+    IO.Path.Combine(Environment.GetFolderPath(Environment.SpecialFolder.UserProfile), ".cloth", "daemon.sock")
+
+// Identifies the compiler binary, like the build cache's fingerprint: a daemon started before
+// the compiler was rebuilt must not serve the new client.
+let compilerVersion () =
+    let assembly = typeof<Compiler.Compiler>.Assembly
+    $"{assembly.GetName().Version}+{assembly.ManifestModule.ModuleVersionId}"
+
+let writeFrame (writer: TextWriter, frame: DaemonFrame) =
+    writer.WriteLine(JsonSerializer.Serialize(frame))
+    writer.Flush()
+
+let readRequest (reader: TextReader) =
+    match reader.ReadLine() with
+    | null -> None
+    | line -> Some(JsonSerializer.Deserialize<DaemonRequest>(line))
+
+// Forwards everything written to it as frames of `kind`, a line at a time, so a build's
+// output reaches the client while the build is still running.
+type FrameWriter(writer: TextWriter, kind: string) =
+    inherit TextWriter()
+    let buffer = StringBuilder()
+
+    override _.Encoding = Encoding.UTF8
+
+    override this.Write(c: char) =
+        buffer.Append(c) |> ignore
+
+        if c = '\n' then
+            this.Flush()
+
+    override _.Flush() =
+        if buffer.Length > 0 then
+            writeFrame (writer, { Kind = kind; Text = buffer.ToString(); Code = 0 })
+            buffer.Clear() |> ignore
+
+let private connect () =
+    let socket = new Socket(AddressFamily.Unix, SocketType.Stream, ProtocolType.Unspecified)
+
+    try
+        socket.Connect(UnixDomainSocketEndPoint(socketPath ()))
+        Some socket
+    with :? SocketException ->
+        socket.Dispose()
+        None
+
+let isRunning () =
+    File.Exists(socketPath ())
+    && (match connect () with
+        | Some socket ->
+            socket.Dispose()
+            true
+        | None -> false)
+
+// Sends `request` to the daemon and relays its frames until the outcome. None when no daemon
+// is listening (or it runs another compiler), so the caller builds in-process instead. A
+// fatal diagnostic ends this process with the daemon-side exit code, as a local build would.
+let private send (request: DaemonRequest) : DispatchResult option =
+    if not (File.Exists(socketPath ())) then
+        None
+    else
+        match connect () with
+        | None -> None
+        | Some socket ->
+            use socket = socket
+            use stream = new NetworkStream(socket)
+            use reader = new StreamReader(stream, UTF8Encoding(false))
+            use writer = new StreamWriter(stream, UTF8Encoding(false))
+            writer.WriteLine(JsonSerializer.Serialize(request))
+            writer.Flush()
+
+            let rec relay () =
+                match reader.ReadLine() with
+                | null -> Some(Failure "the build daemon closed the connection")
+                | line ->
+                    let frame = JsonSerializer.Deserialize<DaemonFrame>(line)
+
+                    match frame.Kind with
+                    | "out" ->
+                        Console.Out.Write(frame.Text)
+                        relay ()
+                    | "err" ->
+                        Console.Error.Write(frame.Text)
+                        relay ()
+                    | "success" -> Some(Success frame.Text)
+                    | "failure" -> Some(Failure frame.Text)
+                    | "abort" -> exit frame.Code
+                    | _ ->
+                        eprintfn "note: the build daemon runs a different compiler; building in-process (restart it with cloth serve)"
+                        None
+
+            relay ()
+
+// Hands `cloth build <path> <flags>` to a running daemon; see `send`.
+let tryBuild (path: string, flags: string[]) =
+    send
+        { Command = "build"
+          Path = IO.Path.GetFullPath(path)
+          Flags = flags
+          StdlibPath = Environment.GetEnvironmentVariable("CLOTH_STDLIB_PATH")
+          Version = compilerVersion () }
+
+// Asks a running daemon to exit once the build it is serving, if any, finishes.
+let stop () =
+    match
+        send
+            { Command = "stop"
+              Path = ""
+              Flags = [||]
+              StdlibPath = null
+              Version = compilerVersion () }
+    with
+    | Some result -> result
+    | None -> Failure $"no build daemon is listening on '{socketPath ()}'"
@@ -0,0 +1,229 @@
+module Commands.Executor.Bench
+
+open System
+open System.Diagnostics
+open System.Text.Json
+open Commands.Cleanup
+open Commands.DispatchResult
+open Commands.Flags
+open Compiler.Configs
+open Compiler.Configs.Profiles
+open FrontEnd.Utilities
+
+let clean (dir: string) = cleanup (dir, CLEANUP_EXTENSIONS)
+
+// Discarded runs before the measured ones, so caches and branch predictors have settled.
+let WARMUP_SAMPLES = 3
+let DEFAULT_SAMPLES = 30
+// Each sample calls the benchmark this long, give or take, so the clock's resolution and
+// the per-sample overhead stay negligible.
+let TARGET_SAMPLE_NS = 10_000_000L
+let MAX_ITERATIONS = 1L <<< 40
+let DEFAULT_THRESHOLD_PERCENT = 5.0
+
+// Per-call nanoseconds of one benchmark, over its measured samples.
+type BenchResult =
+    { Name: string
+      Iterations: int64
+      Samples: int
+      MedianNs: float
+      P99Ns: float
+      MadNs: float }
+
+type BenchReport =
+    { Project: string
+      Benchmarks: BenchResult[] }
+
+// The value of `--<name>=<value>` among `flags`.
+let private flagValue (flags: string[], name: string) =
+    let prefix = $"--{name}="
+
+    flags
+    |> Array.tryFind (fun flag -> flag.StartsWith(prefix))
+    |> Option.map (fun flag -> flag.Substring(prefix.Length))
+
+// Runs the bench binary and returns its stdout lines; a non-zero exit is an error.
+let private runDriver (exePath: string, args: string list) : Result<string[], string> =
+    let psi = ProcessStartInfo(exePath)
+    psi.WorkingDirectory <- IO.Path.GetDirectoryName(exePath)
+    psi.UseShellExecute <- false
+    psi.RedirectStandardOutput <- true
+
+    for arg in args do
+        psi.ArgumentList.Add(arg)
+
+    use proc = Process.Start(psi)
+    let output = proc.StandardOutput.ReadToEnd()
+    proc.WaitForExit()
+
+    if proc.ExitCode <> 0 then
+        Error $"benchmark driver exited with code {proc.ExitCode}"
+    else
+        Ok(output.Split('\n', StringSplitOptions.RemoveEmptyEntries ||| StringSplitOptions.TrimEntries))
+
+// Nanoseconds of each of `samples` runs of `iterations` calls to benchmark `index`.
+let private runSamples (exePath: string, index: int, iterations: int64, samples: int) =
+    runDriver (exePath, [ string index; string iterations; string samples ])
+    |> Result.map (Array.map int64)
+
+// Grows the iteration count until one sample takes about TARGET_SAMPLE_NS, jumping straight
+// to the count the last probe's rate predicts (at most 100× per probe).
+let rec private calibrate (exePath: string, index: int, iterations: int64) =
+    match runSamples (exePath, index, iterations, 1) with
+    | Error message -> Error message
+    | Ok times when times[0] >= TARGET_SAMPLE_NS || iterations >= MAX_ITERATIONS -> Ok iterations
+    | Ok times ->
+        let scale =
+            if times[0] <= 0L then
+                100.0
+            else
+                Math.Clamp(float TARGET_SAMPLE_NS / float times[0] * 1.1, 2.0, 100.0)
+
+        calibrate (exePath, index, min MAX_ITERATIONS (int64 (ceil (float iterations * scale))))
+
+let private median (sorted: float[]) =
+    let n = sorted.Length
+
+    if n % 2 = 1 then
+        sorted[n / 2]
+    else
+        (sorted[n / 2 - 1] + sorted[n / 2]) / 2.0
+
+// Nearest-rank percentile of an ascending array.
+let private percentile (sorted: float[], p: float) =
+    sorted[Math.Clamp(int (ceil (p * float sorted.Length)) - 1, 0, sorted.Length - 1)]
+
+let private summarize (name: string, iterations: int64, sampleNs: int64[]) =
+    let perCall = sampleNs |> Array.map (fun ns -> float ns / float iterations) |> Array.sort
+    let mid = median perCall
+    let deviations = perCall |> Array.map (fun x -> abs (x - mid)) |> Array.sort
+
+    { Name = name
+      Iterations = iterations
+      Samples = perCall.Length
+      MedianNs = mid
+      P99Ns = percentile (perCall, 0.99)
+      MadNs = median deviations }
+
+let private formatNs (ns: float) =
+    if ns >= 1e9 then $"%.3f{ns / 1e9} s"
+    elif ns >= 1e6 then $"%.3f{ns / 1e6} ms"
+    elif ns >= 1e3 then $"%.3f{ns / 1e3} us"
+    else $"%.3f{ns} ns"
+
+// Median and MAD of each benchmark in a saved report, by name.
+let private readBaseline (path: string) : Map<string, float * float> =
+    use doc = JsonDocument.Parse(IO.File.ReadAllText(path))
+
+    doc.RootElement.GetProperty("Benchmarks").EnumerateArray()
+    |> Seq.map (fun b ->
+        b.GetProperty("Name").GetString(), (b.GetProperty("MedianNs").GetDouble(), b.GetProperty("MadNs").GetDouble()))
+    |> Map.ofSeq
+
+// A benchmark regressed when its median moved up by more than `threshold` percent and by more
+// than three MADs of noise, so a jittery benchmark doesn't fail on a lucky baseline.
+let private regressed (result: BenchResult, baseMedian: float, baseMad: float, threshold: float) =
+    result.MedianNs > baseMedian * (1.0 + threshold / 100.0)
+    && result.MedianNs - baseMedian > 3.0 * max result.MadNs baseMad
+
+let runBench (path: string, args: string[]) =
+    let tomlPath = IO.Path.Combine(path, "build.toml")
+
+    if not (IO.File.Exists(tomlPath)) then
+        Failure $"build.toml not found in '{path}'"
+    else
+        let flags = getRelevantFlags (args, "bench")
+        let baselinePath = flagValue (flags, "baseline") |> Option.defaultValue (IO.Path.Combine(path, "bench-baseline.json"))
+        let filter = flagValue (flags, "filter")
+        let samples = flagValue (flags, "samples") |> Option.map Int32.TryParse
+        let threshold = flagValue (flags, "threshold") |> Option.map Double.TryParse
+
+        match samples, threshold with
+        | Some(false, _), _ -> Failure "--samples expects a positive integer"
+        | Some(true, n), _ when n < 1 -> Failure "--samples expects a positive integer"
+        | _, Some(false, _) -> Failure "--threshold expects a percentage"
+        | _ ->
+            let samples = samples |> Option.map snd |> Option.defaultValue DEFAULT_SAMPLES
+            let threshold = threshold |> Option.map snd |> Option.defaultValue DEFAULT_THRESHOLD_PERCENT
+
+            // One release build serves every benchmark; the driver picks one per run.
+            let compiler = Compiler.Compiler(path, ProfileSettings.For(BuildProfile.Release), Bench = true)
+            compiler.Compile() |> ignore
+
+            let config = ConfigReader.Read(tomlPath)
+            let buildDir = IO.Path.Combine(path, "build")
+            clean buildDir
+
+            let exeName =
+                config.Project.Name + "-bench" + (if OperatingSystem.IsWindows() then ".exe" else "")
+
+            let exePath = IO.Path.Combine(buildDir, exeName)
+
+            if not (IO.File.Exists(exePath)) then
+                Failure $"expected benchmark binary '{exePath}' was not produced by build"
+            else
+                match runDriver (exePath, []) with
+                | Error message -> Failure message
+                | Ok names ->
+                    let selected =
+                        names
+                        |> Array.indexed
+                        |> Array.filter (fun (_, name) -> filter |> Option.forall name.Contains)
+
+                    if selected.Length = 0 then
+                        Failure $"no @Bench methods to run in '{path}'"
+                    else
+                        let results =
+                            selected
+                            |> Array.map (fun (index, name) ->
+                                calibrate (exePath, index, 1L)
+                                |> Result.bind (fun iterations ->
+                                    runSamples (exePath, index, iterations, WARMUP_SAMPLES + samples)
+                                    |> Result.map (fun times -> summarize (name, iterations, Array.skip WARMUP_SAMPLES times))))
+
+                        match results |> Array.tryPick (function Error message -> Some message | Ok _ -> None) with
+                        | Some message -> Failure message
+                        | None ->
+                            let results = results |> Array.choose (function Ok r -> Some r | Error _ -> None)
+                            let report = { Project = config.Project.Name; Benchmarks = results }
+
+                            let baseline =
+                                if IO.File.Exists(baselinePath) then Some(readBaseline baselinePath) else None
+
+                            printfn "%-40s %12s %14s %14s %14s  %s" "benchmark" "iterations" "median" "p99" "MAD" "vs baseline"
+
+                            let mutable regressions = []
+
+                            for r in results do
+                                let comparison =
+                                    match baseline |> Option.bind (Map.tryFind r.Name) with
+                                    | None -> "-"
+                                    | Some(baseMedian, baseMad) ->
+                                        let change = (r.MedianNs / baseMedian - 1.0) * 100.0
+
+                                        if regressed (r, baseMedian, baseMad, threshold) then
+                                            regressions <- r.Name :: regressions
+                                            $"%+.1f{change}%% REGRESSED"
+                                        else
+                                            $"%+.1f{change}%%"
+
+                                printfn
+                                    "%-40s %12d %14s %14s %14s  %s"
+                                    r.Name
+                                    r.Iterations
+                                    (formatNs r.MedianNs)
+                                    (formatNs r.P99Ns)
+                                    (formatNs r.MadNs)
+                                    comparison
+
+                            if flags |> Array.contains "--json" then
+                                printfn $"{JsonDump(report).ToJson()}"
+
+                            if flags |> Array.contains "--save" then
+                                IO.File.WriteAllText(baselinePath, JsonDump(report).ToJson())
+                                printfn $"Baseline saved to {baselinePath}"
+
+                            if regressions.IsEmpty then
+                                Success ""
+                            else
+                                Failure $"{regressions.Length} benchmark(s) regressed more than {threshold}%% against '{baselinePath}'"
@@ -1,26 +1,136 @@
 module Commands.Executor.Build
 
 open System
+open System.Diagnostics
+open System.Threading
 open Commands.DispatchResult
 open Commands.Flags
 open Commands.Cleanup
+open Compiler.Cache
+open FrontEnd.Error
+open FrontEnd.Utilities
 
 let clean (dir: string) = cleanup (dir, CLEANUP_EXTENSIONS)
 
-let runBuild (path: string, args: string[]) =
+// After a change, `--watch` waits until the tree has been quiet this long, so an editor's
+// write-rename-delete burst on save triggers one rebuild.
+let WATCH_DEBOUNCE_MS = 100
+
+// One build of the project at `path`. `units` carries parsed units and their analysis over
+// from earlier builds in this process (`--watch`, `cloth serve`); null for a one-shot build.
+let buildProject (path: string, relevantFlags: string[], units: UnitCache) =
     let tomlPath = IO.Path.Combine(path, "build.toml")
 
     if not (IO.File.Exists(tomlPath)) then
         clean (path + "/build")
         Failure $"build.toml not found in '{path}'"
     else
-        let compiler = Compiler.Compiler(path)
-        let cirModule = compiler.Compile()
-        let relevantFlags = getRelevantFlags (args, "build")
+        let dump = relevantFlags |> Array.contains "--dump"
+        let timePasses = relevantFlags |> Array.contains "--time-passes"
 
-        if relevantFlags |> Array.contains "--dump" then
-            printfn $"{Compiler.CIR.CirPrinter.Print(cirModule)}"
+        match getPgoMode relevantFlags, getTimePhases relevantFlags with
+        | Error message, _
+        | _, Error message -> Failure message
+        | Ok pgo, Ok timePhases ->
+            // --dump needs the lowered module, so it bypasses the incremental IR cache.
+            let compiler = Compiler.Compiler(path, Incremental = not dump, Pgo = pgo, Units = units)
+            let cirModule = compiler.Compile()
 
-        clean (path + "/build")
+            if dump then
+                printfn $"{Compiler.CIR.CirPrinter.Print(cirModule)}"
+
+            if timePasses then
+                for timing in compiler.PassTimings do
+                    printfn "%-20s %10.3f ms" timing.Pass timing.Elapsed.TotalMilliseconds
+
+            match timePhases with
+            | Some "json" -> printfn $"{JsonDump(compiler.PhaseTimings).ToJson()}"
+            | Some _ ->
+                printfn "%-20s %-24s %12s %14s %5s %5s %5s" "project" "phase" "wall" "allocated" "gen0" "gen1" "gen2"
+
+                for timing in compiler.PhaseTimings do
+                    printfn
+                        "%-20s %-24s %9.3f ms %11.1f MB %5d %5d %5d"
+                        timing.Project
+                        timing.Phase
+                        timing.ElapsedMs
+                        (float timing.AllocatedBytes / 1048576.0)
+                        timing.Gen0Collections
+                        timing.Gen1Collections
+                        timing.Gen2Collections
+            | None -> ()
+
+            clean (path + "/build")
+
+            Success "Build completed."
+
+// `buildProject` in a host that outlives the build, with `FatalErrors.Throw` set: a fatal
+// diagnostic has already been printed, so it ends only this build, as Error with its exit code.
+let buildAbortable (path: string, relevantFlags: string[], units: UnitCache) =
+    try
+        let result = buildProject (path, relevantFlags, units)
+        units.Prune(path)
+        Ok result
+    with e ->
+        match FatalErrors.AbortOf e with
+        | null -> reraise ()
+        | aborted -> Error aborted.ExitCode
+
+// Rebuilds whenever a source file or the build.toml changes, until interrupted. Parsed units
+// stay in memory between builds, so an edit re-parses just the edited files, and re-analyzes
+// just those too unless it changed a declaration.
+let private watch (path: string, relevantFlags: string[]) =
+    FatalErrors.Throw <- true
+    let units = UnitCache()
+    let buildDir = IO.Path.GetFullPath(IO.Path.Combine(path, "build"))
+
+    let rebuild () =
+        let stopwatch = Stopwatch.StartNew()
+
+        match buildAbortable (path, relevantFlags, units) with
+        | Ok(Success message) when not (String.IsNullOrWhiteSpace(message)) -> printfn $"{message}"
+        | Ok(Failure error) -> eprintfn $"Error {error}"
+        | _ -> ()
+
+        printfn $"[watch] built in {stopwatch.ElapsedMilliseconds} ms ({units.TakeReparsedCount()} file(s) parsed, {units.Analyses.TakeReanalyzedCount()} analyzed); waiting for changes"
 
-        Success "Build completed."
+    rebuild ()
+
+    use changed = new AutoResetEvent(false)
+    use watcher = new IO.FileSystemWatcher(IO.Path.GetFullPath(path))
+    watcher.IncludeSubdirectories <- true
+
+    let onChange (e: IO.FileSystemEventArgs) =
+        let relevant =
+            e.FullPath.EndsWith(".co") || IO.Path.GetFileName(e.FullPath) = "build.toml"
+
+        if relevant && not (e.FullPath.StartsWith(buildDir)) then
+            changed.Set() |> ignore
+
+    watcher.Changed.Add onChange
+    watcher.Created.Add onChange
+    watcher.Deleted.Add onChange
+    watcher.Renamed.Add onChange
+    watcher.EnableRaisingEvents <- true
+
+    while true do
+        changed.WaitOne() |> ignore
+
+        while changed.WaitOne(WATCH_DEBOUNCE_MS) do
+            ()
+
+        rebuild ()
+
+    Success ""
+
+let runBuild (path: string, args: string[]) =
+    let relevantFlags = getRelevantFlags (args, "build")
+
+    if relevantFlags |> Array.contains "--watch" then
+        watch (path, relevantFlags)
+    elif relevantFlags |> Array.contains "--no-daemon" then
+        buildProject (path, relevantFlags, null)
+    else
+        match Commands.Daemon.tryBuild (path, relevantFlags) with
+        | Some result -> result
+        | None -> buildProject (path, relevantFlags, null)
@@ -21,6 +21,8 @@ let runHelp () : DispatchResult =
     eprintfn "  check <flags> <file>            Run semantic/type checks"
     eprintfn "  run <flags> <build_file>        Compile and execute"
     eprintfn "  build <flags> <build_file>      Compile to output artifact"
+    eprintfn "  bench <flags> <build_file>      Build the @Bench methods at release and time them"
+    eprintfn "  serve [--stop]                  Run (or stop) a build daemon that build and run hand their work to"
     eprintfn "  doc <flags> <build_file>        Generate documentation"
     eprintfn ""
 
@@ -32,13 +34,27 @@ let runHelp () : DispatchResult =
     eprintfn "  -Werror                         Treat warnings as errors"
     eprintfn "  -I <dir>                        Add import/include directory"
     eprintfn "  -color <mode>                   Diagnostic color: always|auto|never"
+    eprintfn "  --pgo=instrument|use            Build (or run) with profiling counters, or optimize with their counts"
+    eprintfn "  --watch                         Rebuild on every source change, keeping parsed and analyzed files in memory"
+    eprintfn "  --no-daemon                     Build in this process even when cloth serve is running"
+    eprintfn ""
+
+    eprintfn "Bench:"
+    eprintfn "  --samples=<n>                   Measured samples per benchmark (default 30, after 3 warmups)"
+    eprintfn "  --filter=<text>                 Only run benchmarks whose name contains <text>"
+    eprintfn "  --baseline=<file>               Baseline to compare against (default bench-baseline.json)"
+    eprintfn "  --threshold=<percent>           Median slowdown that counts as a regression (default 5)"
+    eprintfn "  --save                          Write the results as the new baseline"
+    eprintfn "  --json                          Also print the results as JSON"
     eprintfn ""
 
     eprintfn "Debug:"
     eprintfn "  --dump-tokens <flags>           Dump lexer tokens"
     eprintfn "  --dump-ast <flags>              Print parsed AST"
-    eprintfn "  --dump-ir <flags>               Print lowered IR"
+    eprintfn "  --dump-ir <flags>               Print lowered IR, with each class's field offsets, size and padding"
     eprintfn "  --dump-symbols <flags>          Print symbol table/resolution data"
+    eprintfn "  --time-passes                   Print the time each CIR optimization pass took"
+    eprintfn "  --time-phases[=table|json]      Print each build phase's wall time, allocations and GC counts"
     eprintfn ""
 
     eprintfn "Examples:"
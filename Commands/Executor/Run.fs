@@ -4,49 +4,77 @@ open System
 open System.Diagnostics
 open Commands.Cleanup
 open Commands.DispatchResult
+open Commands.Flags
 open Compiler.Configs
+open Compiler.Pgo
 
 let clean (dir: string) = cleanup (dir, CLEANUP_EXTENSIONS)
 
-let runRun (path: string, _args: string[]) =
+let runRun (path: string, args: string[]) =
     let tomlPath = IO.Path.Combine(path, "build.toml")
 
     if not (IO.File.Exists(tomlPath)) then
         Failure $"build.toml not found in '{path}'"
     else
-        let compiler = Compiler.Compiler(path)
-        compiler.Compile() |> ignore
+        let flags = getRelevantFlags (args, "run")
 
-        let config = ConfigReader.Read(tomlPath)
+        match getPgoMode flags with
+        | Error message -> Failure message
+        | Ok pgo ->
+            // A running `cloth serve` does the compile; the program itself always runs here,
+            // attached to this console.
+            let daemonBuild =
+                if flags |> Array.contains "--no-daemon" then
+                    None
+                else
+                    Commands.Daemon.tryBuild (path, flags |> Array.filter (fun flag -> flag.StartsWith("--pgo=")))
 
-        if config.Build.OutputType <> OutputType.Executable then
-            Failure $"cannot run a project with output='{ClothConfig.OutputTypeToString config.Build.OutputType}' (only 'executable' is runnable)"
-        else
-            let buildDir = IO.Path.Combine(path, "build")
+            let built =
+                match daemonBuild with
+                | Some(Failure message) -> Error message
+                | Some(Success _) -> Ok()
+                | None ->
+                    let compiler = Compiler.Compiler(path, Pgo = pgo)
+                    compiler.Compile() |> ignore
+                    Ok()
 
-            let exeName =
-                if OperatingSystem.IsWindows() then
-                    config.Project.Name + ".exe"
-                else
-                    config.Project.Name
-
-            let exePath = IO.Path.Combine(buildDir, exeName)
-
-            if not (IO.File.Exists(exePath)) then
-                clean buildDir
-                Failure $"expected binary '{exePath}' was not produced by build"
-            else
-                let psi = ProcessStartInfo()
-                psi.FileName <- exePath
-                psi.WorkingDirectory <- buildDir
-                psi.UseShellExecute <- false
-                psi.CreateNoWindow <- false
-
-                use proc = Process.Start(psi)
-                proc.WaitForExit()
-                clean buildDir
-
-                if proc.ExitCode = 0 then
-                    Success ""
+            let config = ConfigReader.Read(tomlPath)
+
+            match built with
+            | Error message -> Failure message
+            | Ok() when config.Build.OutputType <> OutputType.Executable ->
+                Failure $"cannot run a project with output='{ClothConfig.OutputTypeToString config.Build.OutputType}' (only 'executable' is runnable)"
+            | Ok() ->
+                let buildDir = IO.Path.Combine(path, "build")
+
+                let exeName =
+                    if OperatingSystem.IsWindows() then
+                        config.Project.Name + ".exe"
+                    else
+                        config.Project.Name
+
+                let exePath = IO.Path.Combine(buildDir, exeName)
+
+                if not (IO.File.Exists(exePath)) then
+                    clean buildDir
+                    Failure $"expected binary '{exePath}' was not produced by build"
                 else
-                    Failure $"program exited with code {proc.ExitCode}"
+                    let psi = ProcessStartInfo()
+                    psi.FileName <- exePath
+                    psi.WorkingDirectory <- buildDir
+                    psi.UseShellExecute <- false
+                    psi.CreateNoWindow <- false
+
+                    // The profiles live in build/pgo/, out of reach of the cleanup below, so an
+                    // instrumented run's counts survive until a --pgo=use build merges them.
+                    if pgo = PgoMode.Instrument then
+                        psi.Environment["LLVM_PROFILE_FILE"] <- PgoProfile.RawProfilePattern(path, config.Project.Name)
+
+                    use proc = Process.Start(psi)
+                    proc.WaitForExit()
+                    clean buildDir
+
+                    if proc.ExitCode = 0 then
+                        Success ""
+                    else
+                        Failure $"program exited with code {proc.ExitCode}"
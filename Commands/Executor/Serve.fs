@@ -0,0 +1,105 @@
+module Commands.Executor.Serve
+
+open System
+open System.IO
+open System.Net.Sockets
+open System.Text
+open Commands.Daemon
+open Commands.DispatchResult
+open Commands.Executor.Build
+open Commands.Flags
+open Compiler.Cache
+open FrontEnd.Error
+
+// Runs one build request with the console redirected to the client. Builds run one at a time,
+// since the console and CLOTH_STDLIB_PATH are process-wide.
+let private serveBuild (writer: TextWriter, request: DaemonRequest, units: UnitCache) =
+    let out = Console.Out
+    let err = Console.Error
+    use clientOut = new FrameWriter(writer, "out")
+    use clientErr = new FrameWriter(writer, "err")
+    Console.SetOut(clientOut)
+    Console.SetError(clientErr)
+    Environment.SetEnvironmentVariable("CLOTH_STDLIB_PATH", request.StdlibPath)
+
+    let outcome =
+        try
+            try
+                buildAbortable (request.Path, request.Flags, units)
+            with e ->
+                Ok(Failure $"internal compiler error: {e}")
+        finally
+            Console.Out.Flush()
+            Console.Error.Flush()
+            Console.SetOut(out)
+            Console.SetError(err)
+
+    match outcome with
+    | Ok(Success message) -> { Kind = "success"; Text = message; Code = 0 }
+    | Ok(Failure message) -> { Kind = "failure"; Text = message; Code = 1 }
+    | Error code -> { Kind = "abort"; Text = ""; Code = code }
+
+// Answers one connection; returns false once asked to stop.
+let private serveClient (client: Socket, units: UnitCache) =
+    use stream = new NetworkStream(client)
+    use reader = new StreamReader(stream, UTF8Encoding(false))
+    use writer = new StreamWriter(stream, UTF8Encoding(false))
+
+    match readRequest reader with
+    | None -> true
+    | Some request when request.Command = "stop" ->
+        writeFrame (writer, { Kind = "success"; Text = "Build daemon stopped."; Code = 0 })
+        false
+    | Some request when request.Version <> compilerVersion () ->
+        writeFrame (writer, { Kind = "stale"; Text = ""; Code = 0 })
+        true
+    | Some request ->
+        let started = DateTime.Now
+        let frame = serveBuild (writer, request, units)
+        writeFrame (writer, frame)
+        let elapsed = (DateTime.Now - started).TotalMilliseconds
+        let time = started.ToString("HH:mm:ss")
+        printfn $"[serve] {time} {request.Path}: {frame.Kind} in %.0f{elapsed} ms ({units.TakeReparsedCount()} file(s) parsed, {units.Analyses.TakeReanalyzedCount()} analyzed)"
+
+        true
+
+// `cloth serve`: keeps one compiler process, with every project's parsed and analyzed units,
+// warm for the `cloth build` / `cloth run` invocations that find it listening. `--stop` ends it.
+let runServe (args: string[]) =
+    let flags = getRelevantFlags (args, "serve")
+
+    if flags |> Array.contains "--stop" then
+        stop ()
+    elif isRunning () then
+        Failure $"a build daemon is already listening on '{socketPath ()}'"
+    else
+        let path = socketPath ()
+        Directory.CreateDirectory(Path.GetDirectoryName(path)) |> ignore
+
+        // Left behind by a daemon that didn't shut down cleanly; nothing is listening on it.
+        if File.Exists(path) then
+            File.Delete(path)
+
+        FatalErrors.Throw <- true
+        let units = UnitCache()
+        use listener = new Socket(AddressFamily.Unix, SocketType.Stream, ProtocolType.Unspecified)
+        listener.Bind(UnixDomainSocketEndPoint(path))
+        listener.Listen(16)
+        printfn $"Serving builds on {path} (stop with: cloth serve --stop)"
+
+        try
+            let mutable serving = true
+
+            while serving do
+                use client = listener.Accept()
+
+                serving <-
+                    try
+                        serveClient (client, units)
+                    with :? IOException ->
+                        // The client went away; keep serving the others.
+                        true
+        finally
+            File.Delete(path)
+
+        Success ""
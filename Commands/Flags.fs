@@ -1,8 +1,10 @@
 ﻿module Commands.Flags
 
+open System
+
 let FLAG_DELIMITER = "--"
 
-let MAIN_COMMANDS = set [ "lexer"; "run"; "build"; "parse" ]
+let MAIN_COMMANDS = set [ "lexer"; "run"; "build"; "bench"; "serve"; "parse" ]
 
 let getRelevantFlags (args: string[], command: string) : string[] =
     let commandIndex = args |> Array.tryFindIndex (fun arg -> arg = command)
@@ -14,3 +16,24 @@ let getRelevantFlags (args: string[], command: string) : string[] =
         |> Array.skip (index + 1)
         |> Array.takeWhile (fun arg -> not (MAIN_COMMANDS.Contains arg))
         |> Array.filter (fun arg -> arg.StartsWith(FLAG_DELIMITER))
+
+// The `--pgo=<mode>` flag among `flags`, PgoMode.None when absent.
+let getPgoMode (flags: string[]) : Result<Compiler.Configs.PgoMode, string> =
+    match flags |> Array.tryFind (fun flag -> flag.StartsWith("--pgo=")) with
+    | None -> Ok Compiler.Configs.PgoMode.None
+    | Some flag ->
+        try
+            Ok(Compiler.Configs.ClothConfig.StringToPgoMode(flag.Substring("--pgo=".Length)))
+        with :? ArgumentException as e ->
+            Error e.Message
+
+// The report format `--time-phases[=table|json]` asks for among `flags`, None when absent.
+let getTimePhases (flags: string[]) : Result<string option, string> =
+    match flags |> Array.tryFind (fun flag -> flag = "--time-phases" || flag.StartsWith("--time-phases=")) with
+    | None -> Ok None
+    | Some "--time-phases"
+    | Some "--time-phases=table" -> Ok(Some "table")
+    | Some "--time-phases=json" -> Ok(Some "json")
+    | Some flag ->
+        let format = flag.Substring("--time-phases=".Length)
+        Error $"Invalid --time-phases format: {format} (expected 'table' or 'json')"
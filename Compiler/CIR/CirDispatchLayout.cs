@@ -0,0 +1,104 @@
+// Copyright (c) 2026.The Cloth contributors.
+//
+// CirDispatchLayout.cs is part of the Cloth Compiler.
+//
+// Use, modification, and distribution of this file are governed by the
+// license terms provided with the Cloth Compiler source distribution.
+
+namespace Compiler.CIR;
+
+// Compact placement of the module's dispatch slots in the emitted vtable rows. CIR numbers
+// every interface and prototype method with its own global slot (`CirVtable.Slots`,
+// `VirtualCall.SlotId`), so a row indexed by slot would span every such method in the
+// program and be mostly null. Instead, slots are colored: two slots share a row position
+// unless some class fills both. A virtual call only reaches classes that fill its slot, so
+// whatever an unrelated class stores at the shared position is never loaded through it.
+//
+// Positions must agree across the link. A library's rows and call sites are compiled
+// before anyone extends its classes or implements its interfaces, so it cannot share a
+// position between two of its slots that some dependent class might fill together: each
+// `Exported` slot gets its own position, by slot-key order, and the library publishes them
+// in its metadata. An executable keeps every position a dependency published
+// (`PinnedPosition`), ranks a source-fed dependency's slots above all of those, and colors
+// just its own slots around both. Coloring is greedy, most-filled slot first (ties by slot
+// key, not by the module-local slot ID), each taking the lowest position none of its filling
+// classes has used yet.
+//
+// Libraries are built without seeing one another, so two of them can publish the same
+// position; that only matters to a class filling a slot of each, and `Publisher` lets the
+// conflict name both libraries.
+public sealed class CirDispatchLayout {
+	private readonly int[] _positions;
+
+	public CirDispatchLayout(IReadOnlyList<CirVtable> vtables, IReadOnlyList<CirDispatchSlot> slots) {
+		var slotCount = vtables.Count > 0 ? vtables[0].Slots.Count : slots.Count;
+		var holders = new List<int>[slotCount];
+		for (var slot = 0; slot < slotCount; slot++) holders[slot] = new List<int>();
+		for (var v = 0; v < vtables.Count; v++)
+			for (var slot = 0; slot < slotCount && slot < vtables[v].Slots.Count; slot++)
+				if (vtables[v].Slots[slot] != null) holders[slot].Add(v);
+
+		string KeyOf(int slot) => slot < slots.Count ? slots[slot].Key : "";
+		CirDispatchSlot? SlotOf(int slot) => slot < slots.Count ? slots[slot] : null;
+		string PublishedBy(int slot) => SlotOf(slot)?.Publisher is { } library ? $" (published by '{library}')" : "";
+
+		// Position → the slot holding it, per vtable.
+		var taken = vtables.Select(_ => new Dictionary<int, int>()).ToList();
+		_positions = new int[slotCount];
+		void Place(int slot, int position) {
+			foreach (var v in holders[slot])
+				if (!taken[v].TryAdd(position, slot))
+					CirError.DispatchSlotConflict.WithMessage($"class '{vtables[v].ClassFqn}' fills both '{KeyOf(taken[v][position])}'{PublishedBy(taken[v][position])} and '{KeyOf(slot)}'{PublishedBy(slot)}, which are both placed at vtable position {position}").Render();
+			_positions[slot] = position;
+			RowSize = Math.Max(RowSize, holders[slot].Count > 0 ? position + 1 : 0);
+		}
+
+		var byKey = Enumerable.Range(0, slotCount).OrderBy(KeyOf, StringComparer.Ordinal).ToList();
+		foreach (var slot in byKey)
+			if (SlotOf(slot)?.PinnedPosition is { } pinned)
+				Place(slot, pinned);
+
+		// Above every pinned position, so no pinned slot's filling class can collide with it.
+		var rank = byKey.Select(s => SlotOf(s)?.PinnedPosition + 1 ?? 0).DefaultIfEmpty(0).Max();
+		foreach (var slot in byKey)
+			if (SlotOf(slot) is { PinnedPosition: null, Exported: true })
+				Place(slot, rank++);
+
+		foreach (var slot in byKey.Where(s => SlotOf(s) is not ({ PinnedPosition: not null } or { Exported: true })).OrderByDescending(s => holders[s].Count)) {
+			var position = 0;
+			while (holders[slot].Any(v => taken[v].ContainsKey(position))) position++;
+			Place(slot, position);
+		}
+
+		SlotCount = slotCount;
+		TableCount = vtables.Count;
+	}
+
+	// Positions per row — the `N` of every defined vtable's `[N x ptr]` methods array.
+	public int RowSize { get; private set; }
+
+	// Global slots the rows stand in for, i.e. the row size without compaction.
+	public int SlotCount { get; }
+
+	public int TableCount { get; }
+
+	// Row position of global slot `slot`. Slots no class fills all map to position 0, unless
+	// exported or pinned.
+	public int PositionOf(int slot) => _positions[slot];
+
+	// `vtable`'s methods row: each filled slot's function at its position, null elsewhere.
+	public string?[] Row(CirVtable vtable) {
+		var row = new string?[RowSize];
+		for (var slot = 0; slot < vtable.Slots.Count && slot < _positions.Length; slot++)
+			if (vtable.Slots[slot] is { } fn) row[_positions[slot]] = fn;
+		return row;
+	}
+}
+
+// Placement input for global slot `i` of a module (`CirModule.DispatchSlots[i]`). `Key` is
+// the registry's slot key, the same in every project that sees the method. `PinnedPosition`
+// is the row position published by the dependency that declares the method, when one was
+// loaded, and `Publisher` names that dependency; `Exported` marks a slot that must not share
+// its position with any other — every slot of a library build, and a dependency's slot when
+// only its sources were parsed.
+public sealed record CirDispatchSlot(string Key, int? PinnedPosition, bool Exported, string? Publisher = null);
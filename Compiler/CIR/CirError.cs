@@ -5,6 +5,8 @@
 // Use, modification, and distribution of this file are governed by the
 // license terms provided with the Cloth Compiler source distribution.
 
+using FrontEnd.Error;
+
 namespace Compiler.CIR;
 
 public class CirError : Exception {
@@ -32,6 +34,8 @@ public class CirError : Exception {
 
 	public static readonly CirError MissingConstructorBody = new("C005", "constructor has no body — prototype constructors are not allowed", true);
 
+	public static readonly CirError DispatchSlotConflict = new("C006", "two dependency methods share a vtable position in one class", true);
+
 	public CirError WithMessage(string message) => new(_code, _label, _willExit, message, _file);
 	public CirError WithFile(string file) => new(_code, _label, _willExit, _message, file);
 
@@ -43,7 +47,7 @@ public class CirError : Exception {
 		if (_message != null)
 			Console.Error.WriteLine($"  = note: {_message}");
 		if (_willExit)
-			Environment.Exit(1);
+			FatalErrors.Exit(1);
 		return this;
 	}
 }
\ No newline at end of file
@@ -63,15 +63,19 @@ public abstract record CirExpr {
 	// nested array. `ElementType` is the LEAF element type; `Sizes` lists outer-to-inner
 	// dimensions. The LLVM emitter unrolls the multi-level case as nested calloc + loop
 	// fills (one allocation per level of nesting). Every level zero-initializes.
-	public sealed record NewArray(CirType ElementType, List<CirExpr> Sizes) : CirExpr;
+	// `Inline` (set by `InlineArrays`) sizes the buffer for class elements stored by value.
+	public sealed record NewArray(CirType ElementType, List<CirExpr> Sizes, bool Inline = false) : CirExpr;
 
 	// `arr[lo..hi]` — sub-slice. Produces a fresh slice value whose data pointer is
 	// `target.data + lo * sizeof(T)` and whose length is `hi - lo`. The new slice
 	// borrows from the same backing buffer; callers must ensure the parent outlives
 	// the sub-slice. `ElementType` is needed so the LLVM emitter knows the GEP stride.
-	public sealed record Subslice(CirExpr Target, CirExpr Lo, CirExpr Hi, CirType ElementType) : CirExpr;
+	// `Checked` is false inside an `@Unchecked` function, where the range test is skipped.
+	public sealed record Subslice(CirExpr Target, CirExpr Lo, CirExpr Hi, CirType ElementType, bool Checked = true) : CirExpr;
 
-	public sealed record Index(CirExpr Target, CirExpr Idx) : CirExpr;
+	// `arr[i]`. `Checked` is false when the access needs no `0 <= i < length` test: inside
+	// an `@Unchecked` function, or where `BoundsCheckElimination` proved the index in range.
+	public sealed record Index(CirExpr Target, CirExpr Idx, bool Checked = true) : CirExpr;
 
 	// Direct call to a mangled global function name
 	public sealed record Call(string MangledName, List<CirExpr> Args) : CirExpr;
@@ -96,8 +100,11 @@ public abstract record CirExpr {
 	// here — they're already the receiver value verbatim.
 	public sealed record Downcast(CirExpr Receiver, string TargetClassFqn, bool IsSafe) : CirExpr;
 
-	// Heap allocation: pairs type layout with the constructor to call
-	public sealed record Alloc(CirType Type, string CtorMangledName, List<CirExpr> Args) : CirExpr;
+	// Heap allocation: pairs type layout with the constructor to call. `InRegion` places the
+	// object in the enclosing `@Region` function's arena instead of the general heap; the
+	// arena destroys and releases it when the function returns. `OnStack` (set by
+	// `StackPromotion`) places it in the allocating function's frame.
+	public sealed record Alloc(CirType Type, string CtorMangledName, List<CirExpr> Args, bool InRegion = false, bool OnStack = false) : CirExpr;
 
 	public sealed record Cast(CirExpr Value, CirType TargetType, bool IsSafe) : CirExpr;
 
@@ -8,10 +8,15 @@
 namespace Compiler.CIR;
 
 // A single function in the CIR module.
-// All instance methods carry 'this' as the first explicit parameter.
-public sealed record CirFunction(string MangledName, CirFunctionKind Kind, List<CirParam> Parameters, CirType ReturnType, List<CirStmt> Body, bool IsExtern, bool IsStatic);
+// All instance methods carry 'this' as the first explicit parameter. `HasRegion` marks an
+// `@Region` body: the function owns an arena for its `InRegion` allocations, released on
+// every return. `IsBench` marks a `@Bench` static method, which a `cloth bench` build's
+// driver calls, passing `BenchInput` as its one argument when it has one.
+public sealed record CirFunction(string MangledName, CirFunctionKind Kind, List<CirParam> Parameters, CirType ReturnType, List<CirStmt> Body, bool IsExtern, bool IsStatic, bool HasRegion = false, bool IsBench = false, long? BenchInput = null);
 
-public sealed record CirParam(CirType Type, string Name);
+// `Transfer` marks a `Type!` parameter: the caller hands over its only reference, which the
+// LLVM emitter turns into `noalias`.
+public sealed record CirParam(CirType Type, string Name, bool Transfer = false);
 
 public enum CirFunctionKind {
 	Constructor,
@@ -5,6 +5,7 @@
 // Use, modification, and distribution of this file are governed by the
 // license terms provided with the Cloth Compiler source distribution.
 
+using Compiler.Configs;
 using Compiler.Semantics;
 using FrontEnd.Parser.AST;
 using FrontEnd.Parser.AST.Declarations;
@@ -43,12 +44,25 @@ public sealed class CirGenerator {
 	// the declared return type (e.g. `return small_i8;` in an i32 function).
 	private string _currentReturnType = "";
 
+	// True while lowering the body of an `@Unchecked` function: its index and sub-slice
+	// expressions skip the runtime range test. Reset by `BeginFunctionScope`.
+	private bool _uncheckedBody;
+
+	// True while lowering the body of an `@Region` function: `new` initializers of its local
+	// declarations allocate in the function's arena. Reset by `BeginFunctionScope`.
+	private bool _regionBody;
+
 	// Inferred types for VarDeclStmts whose source has no explicit annotation.
 	// Populated by SemanticAnalyzer; consulted in LowerVarDecl.
 	private Dictionary<TokenSpan, TypeExpression> _inferredVarTypes = new();
 
-	public CirGenerator(SymbolRegistry symbols) {
+	// A library's vtable rows are compiled before its dependents exist, so each of its
+	// dispatch slots gets a position of its own (see `CirDispatchLayout`).
+	private readonly OutputType _outputType;
+
+	public CirGenerator(SymbolRegistry symbols, OutputType outputType = OutputType.Executable) {
 		_symbols = symbols;
+		_outputType = outputType;
 		// Emit IsExtern stubs for cross-project methods so the LLVM emitter has full signatures
 		// for `declare` lines. Skip @Extern-annotated methods (libc bindings — handled separately
 		// by the LLVM emitter's variadic-collision logic).
@@ -89,7 +103,17 @@ public sealed class CirGenerator {
 			}
 		}
 
-		return new CirModule(_types, _functions, vtables, _staticFields, _symbols.InterfaceCount, _symbols.InterfaceIds);
+		// One placement entry per global slot, in slot-ID order.
+		var dispatchSlots = new CirDispatchSlot[_symbols.VtableSize];
+		foreach (var (key, slot) in _symbols.InterfaceMethodSlots) {
+			var isExtern = _symbols.ExternSlotKeys.Contains(key);
+			int? pinned = null;
+			string? publisher = null;
+			if (isExtern && _symbols.PublishedSlotPositions.TryGetValue(key, out var published)) (pinned, publisher) = published;
+			dispatchSlots[slot] = new CirDispatchSlot(key, pinned, Exported: isExtern || _outputType == OutputType.Library, publisher);
+		}
+
+		return new CirModule(_types, _functions, vtables, _staticFields, _symbols.InterfaceCount, _symbols.InterfaceIds, dispatchSlots.ToList());
 	}
 
 	// Walk every cross-project overload registered as `IsCrossProject` and produce a body-less
@@ -186,7 +210,7 @@ public sealed class CirGenerator {
 	// CirExpr.VirtualCall.
 	private CirFunction LowerInterfaceDefaultImpl(MethodDeclaration decl, string ifaceFqn) {
 		var thisParam = new CirParam(new CirType.Ptr(new CirType.Named(ifaceFqn)), "this");
-		var explicitParams = decl.Parameters.Select(p => new CirParam(LowerType(p.Type), p.Name));
+		var explicitParams = decl.Parameters.Select(LowerParam);
 		var allParams = new List<CirParam> { thisParam };
 		allParams.AddRange(explicitParams);
 
@@ -195,7 +219,9 @@ public sealed class CirGenerator {
 
 		BeginFunctionScope(decl.Parameters);
 		_currentReturnType = ResolveReturnTypeCanonical(decl.ReturnType);
-		return new CirFunction(mangledName, CirFunctionKind.Method, allParams, LowerType(decl.ReturnType), LowerBlock(decl.Body!.Value), IsExtern: false, IsStatic: false);
+		_uncheckedBody = HasUncheckedAnnotation(decl.Annotations);
+		_regionBody = HasRegionAnnotation(decl.Annotations);
+		return new CirFunction(mangledName, CirFunctionKind.Method, allParams, LowerType(decl.ReturnType), LowerBlock(decl.Body!.Value), IsExtern: false, IsStatic: false, HasRegion: _regionBody);
 	}
 
 	private CirTypeDecl LowerClassDeclaration(ClassDeclaration decl, string moduleFqn, string filePath) {
@@ -241,7 +267,7 @@ public sealed class CirGenerator {
 					{
 						var fieldType = LowerType(f.Declaration.TypeExpression);
 						var fieldCanon = CanonicalizeTypeExpr(f.Declaration.TypeExpression);
-						var loweredInit = f.Declaration.Initializer == null ? null : WidenIfNeeded(LowerExpr(f.Declaration.Initializer), f.Declaration.Initializer, fieldCanon, fieldType);
+						var loweredInit = f.Declaration.Initializer == null ? null : LowerStaticInitializer(f.Declaration.TypeExpression, f.Declaration.Initializer, fieldCanon, fieldType);
 						_staticFields.Add(new CirStaticField(typeFqn, f.Declaration.Name, fieldType, loweredInit, IsConst: f.Declaration.IsConst, IsExtern: false));
 						break;
 					}
@@ -252,7 +278,7 @@ public sealed class CirGenerator {
 					{
 						var constType = LowerType(c.Declaration.Type);
 						var constCanon = CanonicalizeTypeExpr(c.Declaration.Type);
-						var loweredInit = c.Declaration.Value == null ? null : WidenIfNeeded(LowerExpr(c.Declaration.Value), c.Declaration.Value, constCanon, constType);
+						var loweredInit = c.Declaration.Value == null ? null : LowerStaticInitializer(c.Declaration.Type, c.Declaration.Value, constCanon, constType);
 						_staticFields.Add(new CirStaticField(typeFqn, c.Declaration.Name, constType, loweredInit, IsConst: true, IsExtern: false));
 						break;
 					}
@@ -289,7 +315,8 @@ public sealed class CirGenerator {
 		// parser-level simple name (`Truck`). Downstream layers (LLVM struct flattening,
 		// vtable chain walks) need the canonical FQN.
 		var resolvedParentFqn = _symbols.ClassVtables.TryGetValue(typeFqn, out var resolvedLayout) ? resolvedLayout.ParentClassFqn : decl.Extends;
-		return new CirTypeDecl.Class(typeFqn, resolvedParentFqn, decl.IsList, fields, decl.Modifiers.Contains(ClassModifiers.Prototype), decl.Modifiers.Contains(ClassModifiers.Const));
+		var isCompact = decl.Annotations.Any(a => a.Name == SemanticAnalyzer.CompactAnnotationName);
+		return new CirTypeDecl.Class(typeFqn, resolvedParentFqn, decl.IsList, fields, decl.Modifiers.Contains(ClassModifiers.Prototype), decl.Modifiers.Contains(ClassModifiers.Const), isCompact);
 	}
 
 	private CirTypeDecl LowerStructDeclaration(StructDeclaration decl, string moduleFqn, string filePath) {
@@ -433,8 +460,8 @@ public sealed class CirGenerator {
 
 	private CirFunction LowerConstructor(ConstructorDeclaration decl, string typeFqn, List<Parameter> primaryParams, string className, List<(string Name, Expression Init, CirType FieldType, string FieldCanon)> fieldInitializers) {
 		var thisParam = new CirParam(new CirType.Ptr(new CirType.Named(typeFqn)), "this");
-		var primaryCirParams = primaryParams.Select(p => new CirParam(LowerType(p.Type), p.Name));
-		var explicitParams = decl.Parameters.Select(p => new CirParam(LowerType(p.Type), p.Name));
+		var primaryCirParams = primaryParams.Select(LowerParam);
+		var explicitParams = decl.Parameters.Select(LowerParam);
 
 		var allParams = new List<CirParam> { thisParam };
 
@@ -496,7 +523,14 @@ public sealed class CirGenerator {
 			return (CirStmt) new CirStmt.Assign(new CirExpr.FieldAccess(new CirExpr.ThisPtr(), fi.Name), CirAssignOp.Assign, loweredInit);
 		}).ToList();
 
+		// `@Unchecked` and `@Region` cover the constructor's own body, not the class's field
+		// initializers.
+		_uncheckedBody = HasUncheckedAnnotation(decl.Annotations);
+		_regionBody = HasRegionAnnotation(decl.Annotations);
 		var body = primaryPrologue.Concat(fieldPrologue).Concat(LowerBlock(decl.Body)).ToList();
+		var hasRegion = _regionBody;
+		_uncheckedBody = false;
+		_regionBody = false;
 
 		var combinedParamTypes = new List<string>();
 		// Inner-class capture: the mangled symbol must include the synthetic outer slot
@@ -504,7 +538,7 @@ public sealed class CirGenerator {
 		// the same prefix) lines up.
 		if (isInner) combinedParamTypes.Add(classInfo!.OuterClassFqn);
 		combinedParamTypes.AddRange(primaryParams.Concat(decl.Parameters).Select(p => TypeInference.CanonicalizeTypeExpression(p.Type, ResolveClassOrInterfaceFqn)));
-		return new CirFunction(MangleCtor(typeFqn, className, combinedParamTypes), CirFunctionKind.Constructor, allParams, new CirType.Void(), body, IsExtern: false, IsStatic: false);
+		return new CirFunction(MangleCtor(typeFqn, className, combinedParamTypes), CirFunctionKind.Constructor, allParams, new CirType.Void(), body, IsExtern: false, IsStatic: false, HasRegion: hasRegion);
 	}
 
 	private CirFunction LowerDestructor(DestructorDeclaration decl, string typeFqn, string className, List<CirField> fields) {
@@ -582,14 +616,18 @@ public sealed class CirGenerator {
 		var parameters = new List<CirParam>();
 		if (!isStatic)
 			parameters.Add(new CirParam(new CirType.Ptr(new CirType.Named(typeFqn)), "this"));
-		parameters.AddRange(decl.Parameters.Select(p => new CirParam(LowerType(p.Type), p.Name)));
+		parameters.AddRange(decl.Parameters.Select(LowerParam));
 
 		var paramTypes = decl.Parameters.Select(p => TypeInference.CanonicalizeTypeExpression(p.Type, ResolveClassOrInterfaceFqn)).ToList();
 		var mangledName = externSymbol ?? MangleMethod(typeFqn, decl.Name, paramTypes);
 
 		BeginFunctionScope(decl.Parameters);
 		_currentReturnType = ResolveReturnTypeCanonical(decl.ReturnType);
-		return new CirFunction(mangledName, isStatic ? CirFunctionKind.StaticMethod : CirFunctionKind.Method, parameters, LowerType(decl.ReturnType), isExtern ? [] : LowerBlock(decl.Body!.Value), isExtern, isStatic);
+		_uncheckedBody = HasUncheckedAnnotation(decl.Annotations);
+		_regionBody = HasRegionAnnotation(decl.Annotations);
+		var bench = decl.Annotations.FirstOrDefault(a => a.Name == SemanticAnalyzer.BenchAnnotationName);
+		long? benchInput = bench.Name != null && SemanticAnalyzer.BenchInput(bench) is { } text && TypeInference.TryParseSignedInt(text, out var input) ? input : null;
+		return new CirFunction(mangledName, isStatic ? CirFunctionKind.StaticMethod : CirFunctionKind.Method, parameters, LowerType(decl.ReturnType), isExtern ? [] : LowerBlock(decl.Body!.Value), isExtern, isStatic, HasRegion: _regionBody, IsBench: bench.Name != null, BenchInput: benchInput);
 	}
 
 	private CirFunction LowerFragment(FragmentDeclaration decl, string typeFqn) {
@@ -597,13 +635,15 @@ public sealed class CirGenerator {
 		var parameters = new List<CirParam> {
 			new CirParam(new CirType.Ptr(new CirType.Named(typeFqn)), "this")
 		};
-		parameters.AddRange(decl.Parameters.Select(p => new CirParam(LowerType(p.Type), p.Name)));
+		parameters.AddRange(decl.Parameters.Select(LowerParam));
 
 		var paramTypes = decl.Parameters.Select(p => TypeInference.CanonicalizeTypeExpression(p.Type, ResolveClassOrInterfaceFqn)).ToList();
 
 		BeginFunctionScope(decl.Parameters);
 		_currentReturnType = ResolveReturnTypeCanonical(decl.ReturnType);
-		return new CirFunction(MangleMethod(typeFqn, decl.Name, paramTypes), CirFunctionKind.Fragment, parameters, LowerType(decl.ReturnType), isExtern ? [] : LowerBlock(decl.Body!.Value), isExtern, IsStatic: false);
+		_uncheckedBody = HasUncheckedAnnotation(decl.Annotations);
+		_regionBody = HasRegionAnnotation(decl.Annotations);
+		return new CirFunction(MangleMethod(typeFqn, decl.Name, paramTypes), CirFunctionKind.Fragment, parameters, LowerType(decl.ReturnType), isExtern ? [] : LowerBlock(decl.Body!.Value), isExtern, IsStatic: false, HasRegion: _regionBody);
 	}
 
 	private string ResolveReturnTypeCanonical(TypeExpression type) => type.Base switch {
@@ -639,7 +679,7 @@ public sealed class CirGenerator {
 	private CirExpr? TryEmitVirtualPrototypeCall(string receiverClass, string methodName, List<Expression> rawArgs, CirExpr target, List<CirExpr> args) {
 		var cursor = receiverClass;
 		while (!string.IsNullOrEmpty(cursor)) {
-			if (_symbols.Overloads.TryGetValue($"{cursor}.{methodName}", out var overloads)) {
+			if (_symbols.DeclaredOverloads(cursor, methodName) is { } overloads) {
 				var proto = overloads.FirstOrDefault(o => o.IsPrototype && o.ParamTypes.Count == rawArgs.Count);
 				if (proto != null) {
 					var slotKey = SymbolRegistry.SlotKey(cursor, methodName, proto.ParamTypes);
@@ -658,8 +698,12 @@ public sealed class CirGenerator {
 	// Map a canonical type string to the matching CirType variant. "void" gets the dedicated
 	// CirType.Void; everything else (primitives, class FQNs, interface FQNs) goes through
 	// CirType.Named where the LLVM emitter handles the actual type lowering.
+	// An array canonical (`i64[]`, `i64[][]`) maps to a CirType.Array, so a slice-typed value
+	// reached by name (a static table) is loaded as `{ ptr, i64 }` like a declared local.
 	private static CirType CanonicalToCirType(string canonical) =>
-		canonical == "void" ? new CirType.Void() : new CirType.Named(canonical);
+		canonical == "void" ? new CirType.Void()
+		: canonical.EndsWith("[]") ? new CirType.Array(CanonicalToCirType(canonical[..^2]))
+		: new CirType.Named(canonical);
 
 	// Lower an array literal `[a, b, c]` to a CIR ArrayLit carrying the element type and
 	// the lowered element expressions. The element type comes from the typer's inference
@@ -686,6 +730,13 @@ public sealed class CirGenerator {
 		return lowered;
 	}
 
+	// A static or `const` field's initializer, lowered against the declared type. An array
+	// literal takes the declared element type, as a local's does in `LowerVarDecl`.
+	private CirExpr LowerStaticInitializer(TypeExpression type, Expression init, string canon, CirType cirType) =>
+		type.Base is BaseType.Array arrayType && init is Expression.ArrayLit lit
+			? LowerArrayLitWithDeclaredElementType(lit, arrayType.ElementType)
+			: WidenIfNeeded(LowerExpr(init), init, canon, cirType);
+
 	private CirExpr LowerArrayLit(Expression.ArrayLit lit) {
 		var elementCanon = lit.Elements.Select(e => _typer.InferType(e)).FirstOrDefault(t => !string.IsNullOrEmpty(t));
 		var elementType = elementCanon != null ? CanonicalToCirType(elementCanon) : new CirType.Any();
@@ -738,12 +789,17 @@ public sealed class CirGenerator {
 
 	// `for (T name in iterable) { body }`. Register the loop binding in the typer scope
 	// before lowering the body so identifier references inside the loop body resolve.
+	// A parallel body runs on worker threads, away from the function's `@Region` arena, so
+	// its `new`s are ordinary owned allocations.
 	private CirStmt LowerForInStmt(ForInStmt s) {
 		var iterable = LowerExpr(s.Iterable);
 		var elementType = LowerType(s.Type);
 		_typer.DeclareLocal(s.Name, CanonicalizeTypeExpr(s.Type));
+		var regionBody = _regionBody;
+		_regionBody &= !s.Parallel;
 		var body = LowerBlock(s.Body);
-		return new CirStmt.ForIn(elementType, s.Name, iterable, body);
+		_regionBody = regionBody;
+		return new CirStmt.ForIn(elementType, s.Name, iterable, body, s.Parallel);
 	}
 
 	// `new T[a]` / `new T[a][b]` / … → CirExpr.NewArray carrying the leaf element type
@@ -761,9 +817,9 @@ public sealed class CirGenerator {
 			// `[]` to get the canonical element form.
 			var targetTy = _typer.InferType(ix.Target);
 			var elementCanon = targetTy != null && targetTy.EndsWith("[]") ? targetTy[..^2] : "any";
-			return new CirExpr.Subslice(LowerExpr(ix.Target), LowerExpr(r.Start), LowerExpr(r.End), CanonicalToCirType(elementCanon));
+			return new CirExpr.Subslice(LowerExpr(ix.Target), LowerExpr(r.Start), LowerExpr(r.End), CanonicalToCirType(elementCanon), Checked: !_uncheckedBody);
 		}
-		return new CirExpr.Index(LowerExpr(ix.Target), LowerExpr(ix.IndexExpr));
+		return new CirExpr.Index(LowerExpr(ix.Target), LowerExpr(ix.IndexExpr), Checked: !_uncheckedBody);
 	}
 
 	// `arr::LENGTH` on an array-typed expression lowers to a slice-length extract. Any
@@ -895,12 +951,20 @@ public sealed class CirGenerator {
 	// Class-typed parameters land in the typer with their FQN.
 	private void BeginFunctionScope(IEnumerable<Parameter> parameters) {
 		_typer = new ExpressionTyper(_symbols, _importMap, _currentTypeFqn, _currentModuleFqn);
+		_uncheckedBody = false;
+		_regionBody = false;
 		foreach (var p in parameters) {
-			if (p.Type.Base is BaseType.Named)
+			if (p.Type.Base is BaseType.Named or BaseType.Array)
 				_typer.DeclareLocal(p.Name, CanonicalizeTypeExpr(p.Type));
 		}
 	}
 
+	private static bool HasUncheckedAnnotation(List<TraitAnnotation> annotations) =>
+		annotations.Any(a => a.Name == SemanticAnalyzer.UncheckedAnnotationName);
+
+	private static bool HasRegionAnnotation(List<TraitAnnotation> annotations) =>
+		annotations.Any(a => a.Name == SemanticAnalyzer.RegionAnnotationName);
+
 	private static string? TryGetExternSymbol(List<TraitAnnotation> annotations) {
 		foreach (var a in annotations) {
 			if (a.Name != "Extern") continue;
@@ -946,6 +1010,7 @@ public sealed class CirGenerator {
 		Stmt.Delete { Expression: var e } => LowerDeleteStmt(e),
 		Stmt.BlockStmt { Block: var b } => new CirStmt.Block(LowerBlock(b)),
 		Stmt.Discard { Expression: var e } => new CirStmt.Discard(LowerExpr(e)),
+		Stmt.Join { Tasks: var tasks } => new CirStmt.Join(tasks.Select(LowerExpr).ToList()),
 		Stmt.SuperCall { Arguments: var args } => new CirStmt.Expr(new CirExpr.Call("__super__", args.Select(LowerExpr).ToList())),
 		Stmt.ThisCall { Arguments: var args } => new CirStmt.Expr(new CirExpr.Call("__this__", args.Select(LowerExpr).ToList())),
 		Stmt.TupleDestructure { Declaration: var d } => new CirStmt.TupleDecl(d.Bindings.Select(b => (LowerType(b.Type), b.Name)).ToList(), LowerExpr(d.Init)),
@@ -1073,6 +1138,11 @@ public sealed class CirGenerator {
 			init = WidenIfNeeded(init, d.Init, canonicalName, new CirType.Named(canonicalName));
 		}
 
+		// In an `@Region` body a local initialized straight from `new` is owned by the arena;
+		// the analyzer has checked it never leaves the function (`CheckRegionEscape`).
+		if (_regionBody && d.Init is Expression.New && init is CirExpr.Alloc alloc)
+			init = alloc with { InRegion = true };
+
 		return new CirStmt.LocalDecl(type, d.Name, init, IsMutable: true);
 	}
 
@@ -1541,6 +1611,9 @@ public sealed class CirGenerator {
 	// Type lowering
 	// -------------------------------------------------------------------------
 
+	private CirParam LowerParam(Parameter p) =>
+		new(LowerType(p.Type), p.Name, p.Type.Ownership == OwnershipModifier.Transfer);
+
 	private CirType LowerType(TypeExpression type) {
 		var cirType = LowerBaseType(type.Base);
 		return type.Nullable ? new CirType.Nullable(cirType) : cirType;
@@ -0,0 +1,678 @@
+// Copyright (c) 2026.The Cloth contributors.
+//
+// CirInterpreter.cs is part of the Cloth Compiler.
+//
+// Use, modification, and distribution of this file are governed by the
+// license terms provided with the Cloth Compiler source distribution.
+
+using System.Globalization;
+using Compiler.CIR.Passes;
+using Compiler.Semantics;
+
+namespace Compiler.CIR;
+
+// Evaluates static and `const` field initializers, and enum case arguments, at compile
+// time, so the LLVM emitter can write their values as constant globals instead of code.
+//
+// An initializer may use literals, strings, arrays (`[...]`, `new T[n]`, indexing, slicing,
+// `::LENGTH`), enum cases and their fields and getters, other static fields of this module
+// (evaluated on demand, in any order), and calls to this module's static methods, which run
+// statement by statement over their own locals. Anything that would touch run-time state —
+// objects, instance fields, external or virtual calls, writes to a static, `delete`,
+// `throw` — makes it not constant, as does anything the emitted code would trap or leave
+// undefined on (an index out of bounds, division by zero, an oversized shift). Each
+// initializer gets a budget of `MaxSteps` evaluated nodes, `MaxCells` array elements and
+// `MaxDepth` nested calls.
+//
+// Values are computed exactly as the emitted code would compute them: an operation runs at
+// the LLVM type the emitter gives it (the wider operand's; a bare literal takes its smallest
+// signed fit), integers wrap at that width, division, shifts and comparisons are signed,
+// and casts extend, truncate and convert like the emitter's.
+public sealed class CirInterpreter(CirModule module) {
+	public const long MaxSteps = 10_000_000;
+	public const long MaxCells = 1 << 20;
+	public const int MaxDepth = 200;
+
+	private readonly Dictionary<string, CirValue> _statics = new();
+	private readonly HashSet<string> _evaluating = new();
+	private long _steps;
+	private long _cells;
+	private int _depth;
+	private int _owner;
+	private int _evaluations;
+
+	// The value `sf` holds once initialized, or false with the reason it isn't constant.
+	public bool TryEvaluateStatic(CirStaticField sf, out CirValue value, out string reason) =>
+		Try(() => StaticValue(sf.ClassFqn, sf.Name), out value, out reason);
+
+	// The value of `expr` stored into a `type` slot, or false with the reason it isn't constant.
+	public bool TryEvaluate(CirExpr expr, CirType type, out CirValue value, out string reason) =>
+		Try(() => Evaluate(expr, type), out value, out reason);
+
+	private static bool Try(Func<CirValue> evaluate, out CirValue value, out string reason) {
+		try {
+			value = evaluate();
+			reason = "";
+			return true;
+		}
+		catch (NotConstant e) {
+			value = new CirValue.Null();
+			reason = e.Message;
+			return false;
+		}
+	}
+
+	private sealed class NotConstant(string reason) : Exception(reason);
+
+	private static NotConstant Fail(string reason) => new(reason);
+
+	// One initializer, with a fresh budget. Nested initializers (a static read by another)
+	// get their own, but share the call depth.
+	private CirValue Evaluate(CirExpr expr, CirType type) {
+		var (steps, cells, owner) = (_steps, _cells, _owner);
+		_steps = 0;
+		_cells = 0;
+		_owner = ++_evaluations;
+		try {
+			return Store(Eval(expr, new Frame()), type);
+		}
+		finally {
+			(_steps, _cells, _owner) = (steps, cells, owner);
+		}
+	}
+
+	private CirValue StaticValue(string classFqn, string name) {
+		var key = CirModule.StaticFieldKey(classFqn, name);
+		if (_statics.TryGetValue(key, out var value)) return value;
+		if (!module.StaticFieldsByName.TryGetValue(key, out var sf)) throw Fail($"'{key}' is not a static field");
+		if (sf.IsExtern) throw Fail($"'{key}' is defined in another project");
+		if (!_evaluating.Add(key)) throw Fail($"'{key}' depends on its own value");
+		try {
+			value = sf.Initializer == null ? Zero(sf.Type) : Evaluate(sf.Initializer, sf.Type);
+		}
+		finally {
+			_evaluating.Remove(key);
+		}
+
+		_statics[key] = value;
+		return value;
+	}
+
+	// A call's locals, by name: the emitter gives each function one flat set of them too.
+	private sealed class Frame {
+		public readonly Dictionary<string, CirValue> Values = new();
+		public readonly Dictionary<string, CirType> Types = new();
+		public CirValue? Result;
+	}
+
+	private enum Flow {
+		Next,
+		Break,
+		Continue,
+		Return
+	}
+
+	private void Step() {
+		if (++_steps > MaxSteps) throw Fail($"takes more than {MaxSteps} steps");
+	}
+
+	// -------------------------------------------------------------------------
+	// Statements
+	// -------------------------------------------------------------------------
+
+	private Flow ExecBlock(List<CirStmt> block, Frame frame) {
+		foreach (var stmt in block) {
+			var flow = Exec(stmt, frame);
+			if (flow != Flow.Next) return flow;
+		}
+
+		return Flow.Next;
+	}
+
+	private Flow Exec(CirStmt stmt, Frame frame) {
+		Step();
+		switch (stmt) {
+			case CirStmt.LocalDecl ld:
+				if (ld.Type is { } declared) frame.Types[ld.Name] = declared;
+				else frame.Types.Remove(ld.Name);
+				frame.Values[ld.Name] = ld.Init != null ? Store(Eval(ld.Init, frame), ld.Type)
+					: ld.Type != null ? Zero(ld.Type)
+					: throw Fail($"local '{ld.Name}' has neither a type nor a value");
+				return Flow.Next;
+			case CirStmt.Assign a:
+				ExecAssign(a, frame);
+				return Flow.Next;
+			case CirStmt.Expr { Expression: var e }:
+				Eval(e, frame);
+				return Flow.Next;
+			case CirStmt.Discard { Expression: var e }:
+				Eval(e, frame);
+				return Flow.Next;
+			case CirStmt.Return r:
+				frame.Result = r.Value == null ? null : Eval(r.Value, frame);
+				return Flow.Return;
+			case CirStmt.If s:
+				if (Truth(Eval(s.Condition, frame))) return ExecBlock(s.Then, frame);
+				foreach (var (cond, body) in s.ElseIfs)
+					if (Truth(Eval(cond, frame))) return ExecBlock(body, frame);
+				return s.Else != null ? ExecBlock(s.Else, frame) : Flow.Next;
+			case CirStmt.While w:
+				while (Truth(Eval(w.Condition, frame))) {
+					var flow = ExecBlock(w.Body, frame);
+					if (flow == Flow.Break) break;
+					if (flow == Flow.Return) return flow;
+				}
+
+				return Flow.Next;
+			case CirStmt.DoWhile dw:
+				do {
+					var flow = ExecBlock(dw.Body, frame);
+					if (flow == Flow.Break) break;
+					if (flow == Flow.Return) return flow;
+				} while (Truth(Eval(dw.Condition, frame)));
+
+				return Flow.Next;
+			case CirStmt.For f:
+				Exec(f.Init, frame);
+				while (Truth(Eval(f.Condition, frame))) {
+					var flow = ExecBlock(f.Body, frame);
+					if (flow == Flow.Break) break;
+					if (flow == Flow.Return) return flow;
+					Eval(f.Iterator, frame);
+				}
+
+				return Flow.Next;
+			case CirStmt.ForIn fi: {
+				// The slice is evaluated once; each element is read as its iteration starts.
+				var slice = AsSlice(Eval(fi.Iterable, frame));
+				frame.Types[fi.ElementName] = fi.ElementType;
+				for (var i = 0; i < slice.Length; i++) {
+					frame.Values[fi.ElementName] = Store(slice.Array.Items[slice.Offset + i], fi.ElementType);
+					var flow = ExecBlock(fi.Body, frame);
+					if (flow == Flow.Break) break;
+					if (flow == Flow.Return) return flow;
+				}
+
+				return Flow.Next;
+			}
+			case CirStmt.Switch sw: {
+				// Break-by-default per case, as emitted; `break` leaves the switch, `continue`
+				// the loop around it.
+				var subject = Eval(sw.Subject, frame);
+				var arm = sw.Cases.FirstOrDefault(c => c.Pattern != null && Matches(subject, Eval(c.Pattern, frame))) ?? sw.Cases.FirstOrDefault(c => c.Pattern == null);
+				if (arm == null) return Flow.Next;
+				var flow = ExecBlock(arm.Body, frame);
+				return flow == Flow.Break ? Flow.Next : flow;
+			}
+			case CirStmt.Break:
+				return Flow.Break;
+			case CirStmt.Continue:
+				return Flow.Continue;
+			case CirStmt.Block b:
+				return ExecBlock(b.Body, frame);
+			case CirStmt.Throw:
+				throw Fail("throws");
+			case CirStmt.Delete:
+				throw Fail("deletes a value");
+			case CirStmt.Join:
+				throw Fail("runs code in parallel");
+			default:
+				throw Fail($"uses a {stmt.GetType().Name} statement");
+		}
+	}
+
+	private void ExecAssign(CirStmt.Assign a, Frame frame) {
+		switch (a.Target) {
+			case CirExpr.Local l: {
+				var value = Eval(a.Value, frame);
+				if (a.Op != CirAssignOp.Assign) value = Arithmetic(AssignToBinOp(a.Op), Read(l.Name, frame), value);
+				frame.Values[l.Name] = Store(value, frame.Types.GetValueOrDefault(l.Name));
+				break;
+			}
+			case CirExpr.Index ix: {
+				var (array, at) = Element(ix, frame);
+				var value = Eval(a.Value, frame);
+				if (a.Op != CirAssignOp.Assign) value = Arithmetic(AssignToBinOp(a.Op), array.Items[at], value);
+				Write(array, at, value);
+				break;
+			}
+			case CirExpr.StaticFieldRef sr:
+				throw Fail($"assigns static field '{CirModule.StaticFieldKey(sr.ClassFqn, sr.Name)}'");
+			default:
+				throw Fail("assigns a field");
+		}
+	}
+
+	private static CirBinOp AssignToBinOp(CirAssignOp op) => op switch {
+		CirAssignOp.AddAssign => CirBinOp.Add,
+		CirAssignOp.SubAssign => CirBinOp.Sub,
+		CirAssignOp.MulAssign => CirBinOp.Mul,
+		CirAssignOp.DivAssign => CirBinOp.Div,
+		CirAssignOp.RemAssign => CirBinOp.Rem,
+		CirAssignOp.AndAssign => CirBinOp.BitAnd,
+		CirAssignOp.OrAssign => CirBinOp.BitOr,
+		CirAssignOp.PowAssign => CirBinOp.Pow,
+		_ => CirBinOp.Add
+	};
+
+	// -------------------------------------------------------------------------
+	// Expressions
+	// -------------------------------------------------------------------------
+
+	private CirValue Eval(CirExpr expr, Frame frame) {
+		Step();
+		switch (expr) {
+			case CirExpr.IntLit i: {
+				if (!long.TryParse(i.Value, NumberStyles.AllowLeadingSign, CultureInfo.InvariantCulture, out var value))
+					throw Fail($"uses the integer literal '{i.Value}'");
+				return new CirValue.Int(value, IntegerTypes.Bits(TypeInference.SmallestSignedFit(i.Value)));
+			}
+			case CirExpr.FloatLit f:
+				return double.TryParse(f.Value, NumberStyles.Float, CultureInfo.InvariantCulture, out var fv) ? new CirValue.Float(fv, false) : throw Fail($"uses the float literal '{f.Value}'");
+			case CirExpr.BoolLit b:
+				return new CirValue.Bool(b.Value);
+			case CirExpr.CharLit c:
+				return new CirValue.Int(IntegerTypes.Wrap(c.Value, 8), 8);
+			case CirExpr.StrLit s:
+				return new CirValue.Str(s.Value);
+			case CirExpr.NullLit:
+				return new CirValue.Null();
+			case CirExpr.Local l:
+				return Read(l.Name, frame);
+			case CirExpr.ThisPtr:
+				return Read("this", frame);
+			case CirExpr.StaticFieldRef sr:
+				return StaticValue(sr.ClassFqn, sr.Name);
+			case CirExpr.EnumCaseRef ec:
+				return new CirValue.EnumCase(ec.EnumFqn, ec.CaseName);
+			case CirExpr.FieldAccess fa:
+				return Eval(fa.Target, frame) is CirValue.EnumCase ec2 ? EnumField(ec2, fa.FieldName) : throw Fail($"reads field '{fa.FieldName}' of an object");
+			case CirExpr.Binary b:
+				return b.Op == CirBinOp.In ? throw Fail("uses 'in'") : Arithmetic(b.Op, Eval(b.Left, frame), Eval(b.Right, frame));
+			case CirExpr.Unary u:
+				return EvalUnary(u, frame);
+			case CirExpr.Cast c:
+				return EvalCast(c, frame);
+			case CirExpr.Ternary t:
+				return Truth(Eval(t.Condition, frame)) ? Eval(t.Then, frame) : Eval(t.Else, frame);
+			case CirExpr.NullCoalesce nc: {
+				var left = Eval(nc.Left, frame);
+				return left is CirValue.Null ? Eval(nc.Right, frame) : left;
+			}
+			case CirExpr.ArrayLit al:
+				return NewSlice(al.ElementType, al.Elements.Select(e => Store(Eval(e, frame), al.ElementType)).ToList());
+			case CirExpr.NewArray na:
+				if (na.Inline) throw Fail("allocates an array of objects");
+				return NewArray(na.ElementType, na.Sizes.Select(s => AsInt(Eval(s, frame))).ToList(), 0);
+			case CirExpr.ArrayLength len:
+				return new CirValue.Int(AsSlice(Eval(len.Target, frame)).Length, 64);
+			case CirExpr.Index ix: {
+				var (array, at) = Element(ix, frame);
+				return array.Items[at];
+			}
+			case CirExpr.Subslice ss: {
+				var slice = AsSlice(Eval(ss.Target, frame));
+				var lo = AsInt(Eval(ss.Lo, frame));
+				var hi = AsInt(Eval(ss.Hi, frame));
+				if (lo < 0 || lo > hi || hi > slice.Length) throw Fail($"slices [{lo}..{hi}] out of an array of length {slice.Length}");
+				return new CirValue.Slice(slice.Array, slice.Offset + (int)lo, (int)(hi - lo));
+			}
+			case CirExpr.Call call:
+				return EvalCall(call, frame);
+			case CirExpr.Alloc:
+				throw Fail("creates an object");
+			case CirExpr.VirtualCall or CirExpr.IndirectCall:
+				throw Fail("makes a virtual or indirect call");
+			default:
+				throw Fail($"uses a {expr.GetType().Name} expression");
+		}
+	}
+
+	private CirValue Read(string name, Frame frame) =>
+		frame.Values.TryGetValue(name, out var value) ? value : throw Fail($"reads '{name}' before it has a value");
+
+	private CirValue EvalCall(CirExpr.Call call, Frame frame) {
+		var fn = module.FindFunction(call.MangledName);
+		if (fn == null || fn.IsExtern) throw Fail($"calls '{call.MangledName}', which isn't defined in this project");
+		if (fn.Kind is not (CirFunctionKind.Method or CirFunctionKind.StaticMethod) || fn.Parameters.Count != call.Args.Count)
+			throw Fail($"calls '{call.MangledName}', which has no body to evaluate");
+		if (_depth >= MaxDepth) throw Fail($"nests calls more than {MaxDepth} deep");
+
+		var callee = new Frame();
+		for (var i = 0; i < fn.Parameters.Count; i++) {
+			var p = fn.Parameters[i];
+			callee.Types[p.Name] = p.Type;
+			callee.Values[p.Name] = Store(Eval(call.Args[i], frame), p.Type);
+		}
+
+		_depth++;
+		try {
+			ExecBlock(fn.Body, callee);
+		}
+		finally {
+			_depth--;
+		}
+
+		if (fn.ReturnType is CirType.Void) return new CirValue.Null();
+		return callee.Result is { } result ? Store(result, fn.ReturnType) : throw Fail($"'{call.MangledName}' ends without returning a value");
+	}
+
+	// A field of an enum case's singleton: the built-in ordinal and name, or a constructor
+	// argument, itself evaluated like an initializer.
+	private CirValue EnumField(CirValue.EnumCase ec, string field) {
+		if (!module.EnumsByFqn.TryGetValue(ec.EnumFqn, out var e) || e.Cases.FirstOrDefault(c => c.Name == ec.CaseName) is not { } ecase)
+			throw Fail($"reads an unknown enum case '{ec.EnumFqn}.{ec.CaseName}'");
+		if (field == CirGenerator.EnumOrdinalField) return new CirValue.Int(ecase.Ordinal, 32);
+		if (field == CirGenerator.EnumNameField) return new CirValue.Str(ecase.Name);
+
+		var index = e.Parameters.FindIndex(p => p.Name == field);
+		if (index < 0 || index >= ecase.ConstructorArgs.Count) throw Fail($"reads an unknown field '{field}' of '{ec.EnumFqn}'");
+		var key = $"{ec.EnumFqn}.{ec.CaseName}.{field}";
+		if (!_evaluating.Add(key)) throw Fail($"'{key}' depends on its own value");
+		try {
+			return Evaluate(ecase.ConstructorArgs[index], e.Parameters[index].Type);
+		}
+		finally {
+			_evaluating.Remove(key);
+		}
+	}
+
+	private CirValue EvalUnary(CirExpr.Unary u, Frame frame) {
+		if (u.Op is CirUnOp.PreInc or CirUnOp.PreDec or CirUnOp.PostInc or CirUnOp.PostDec) {
+			var old = Eval(u.Operand, frame);
+			if (old is not CirValue.Int i) throw Fail("increments a non-integer");
+			var updated = new CirValue.Int(IntegerTypes.Wrap(u.Op is CirUnOp.PreInc or CirUnOp.PostInc ? unchecked(i.Value + 1) : unchecked(i.Value - 1), i.Bits), i.Bits);
+			switch (u.Operand) {
+				case CirExpr.Local l:
+					frame.Values[l.Name] = updated;
+					break;
+				case CirExpr.Index ix: {
+					var (array, at) = Element(ix, frame);
+					Write(array, at, updated);
+					break;
+				}
+				default:
+					throw Fail("increments a field");
+			}
+
+			return u.Op is CirUnOp.PostInc or CirUnOp.PostDec ? old : updated;
+		}
+
+		var operand = Eval(u.Operand, frame);
+		return (u.Op, operand) switch {
+			(CirUnOp.Neg, CirValue.Int i) => new CirValue.Int(IntegerTypes.Wrap(unchecked(-i.Value), i.Bits), i.Bits),
+			(CirUnOp.Neg, CirValue.Float f) => new CirValue.Float(-f.Value, f.Single),
+			(CirUnOp.Not, CirValue.Bool b) => new CirValue.Bool(!b.Value),
+			(CirUnOp.BitNot, CirValue.Int i) => new CirValue.Int(~i.Value, i.Bits),
+			(CirUnOp.BitNot, CirValue.Bool b) => new CirValue.Bool(!b.Value),
+			_ => throw Fail($"applies {u.Op} to a {TypeOf(operand)}")
+		};
+	}
+
+	// `EmitCast`: a literal cast to an integer type is that literal; otherwise integers
+	// truncate or extend (by the target's signedness), floats widen or narrow, and integers
+	// and floats convert into each other.
+	private CirValue EvalCast(CirExpr.Cast c, Frame frame) {
+		var target = LoweredType(c.TargetType);
+		var bits = IntBits(target);
+		if (bits > 0) {
+			switch (c.Value) {
+				case CirExpr.IntLit or CirExpr.CharLit:
+					return new CirValue.Int(IntegerTypes.Wrap(AsInt(Eval(c.Value, frame)), bits), bits);
+				case CirExpr.BoolLit b:
+					return new CirValue.Int(b.Value ? 1 : 0, bits);
+			}
+		}
+
+		var value = Eval(c.Value, frame);
+		var source = TypeOf(value);
+		if (source == target) return value;
+		var from = source == "i1" ? 1 : IntBits(source);
+		if (bits > 0 && from > 0) {
+			var raw = value is CirValue.Bool b ? (b.Value ? -1L : 0L) : ((CirValue.Int)value).Value;
+			if (from < bits && !IsSignedName(c.TargetType)) raw &= from == 64 ? -1L : (1L << from) - 1;
+			return new CirValue.Int(IntegerTypes.Wrap(raw, bits), bits);
+		}
+
+		return target is "float" or "double" || (bits > 0 && value is CirValue.Float) ? Convert(value, target) : throw Fail($"casts a {source} to {target}");
+	}
+
+	private static bool IsSignedName(CirType type) => type is CirType.Named { FullyQualifiedName: var name } && IntegerTypes.IsSigned(name);
+
+	// A binary operation at the wider operand's type, each operand converted to it first.
+	private CirValue Arithmetic(CirBinOp op, CirValue left, CirValue right) {
+		if (op == CirBinOp.Pow) {
+			if (left is CirValue.Int or CirValue.Bool && right is CirValue.Int or CirValue.Bool)
+				return new CirValue.Int(PowInt(AsInt(Convert(left, "i64")), AsInt(Convert(right, "i64"))), 64);
+			return new CirValue.Float(Math.Pow(AsDouble(Convert(left, "double")), AsDouble(Convert(right, "double"))), false);
+		}
+
+		var leftTy = TypeOf(left);
+		var rightTy = TypeOf(right);
+		var opTy = leftTy == rightTy ? leftTy : Width(leftTy) >= Width(rightTy) ? leftTy : rightTy;
+
+		if (opTy is "ptr" or "{ ptr, i64 }") {
+			if (op is not (CirBinOp.Eq or CirBinOp.NotEq)) throw Fail($"applies {op} to a {opTy}");
+			if (left is CirValue.Str && right is CirValue.Str) throw Fail("compares strings by address");
+			if (left is CirValue.Slice || right is CirValue.Slice) throw Fail("compares arrays");
+			return new CirValue.Bool(left.Equals(right) == (op == CirBinOp.Eq));
+		}
+
+		var l = Convert(left, opTy);
+		var r = Convert(right, opTy);
+		if (opTy is "float" or "double") {
+			var (x, y) = (AsDouble(l), AsDouble(r));
+			double? result = op switch {
+				CirBinOp.Add => x + y,
+				CirBinOp.Sub => x - y,
+				CirBinOp.Mul => x * y,
+				CirBinOp.Div => x / y,
+				CirBinOp.Rem => x % y,
+				_ => null
+			};
+			if (result is { } v) return new CirValue.Float(opTy == "float" ? (float)v : v, opTy == "float");
+
+			// Ordered comparisons: false whenever either side is NaN.
+			return op switch {
+				CirBinOp.Eq => new CirValue.Bool(x == y),
+				CirBinOp.NotEq => new CirValue.Bool(x < y || x > y),
+				CirBinOp.Lt => new CirValue.Bool(x < y),
+				CirBinOp.LtEq => new CirValue.Bool(x <= y),
+				CirBinOp.Gt => new CirValue.Bool(x > y),
+				CirBinOp.GtEq => new CirValue.Bool(x >= y),
+				_ => throw Fail($"applies {op} to a {opTy}")
+			};
+		}
+
+		var bits = opTy == "i1" ? 1 : IntBits(opTy);
+		var (a, b) = (Signed(l), Signed(r));
+		switch (op) {
+			case CirBinOp.Eq: return new CirValue.Bool(a == b);
+			case CirBinOp.NotEq: return new CirValue.Bool(a != b);
+			case CirBinOp.Lt: return new CirValue.Bool(a < b);
+			case CirBinOp.LtEq: return new CirValue.Bool(a <= b);
+			case CirBinOp.Gt: return new CirValue.Bool(a > b);
+			case CirBinOp.GtEq: return new CirValue.Bool(a >= b);
+		}
+
+		var min = bits >= 64 ? long.MinValue : -(1L << (bits - 1));
+		if (op is CirBinOp.Div or CirBinOp.Rem && (b == 0 || (a == min && b == -1))) throw Fail(b == 0 ? "divides by zero" : "overflows a division");
+		if (op is CirBinOp.Shl or CirBinOp.Shr && (b < 0 || b >= bits)) throw Fail($"shifts a {opTy} by {b}");
+		long value = op switch {
+			CirBinOp.Add => unchecked(a + b),
+			CirBinOp.Sub => unchecked(a - b),
+			CirBinOp.Mul => unchecked(a * b),
+			CirBinOp.Div => a / b,
+			CirBinOp.Rem => a % b,
+			CirBinOp.BitAnd or CirBinOp.And => a & b,
+			CirBinOp.BitOr or CirBinOp.Or => a | b,
+			CirBinOp.Shl => a << (int)b,
+			CirBinOp.Shr => a >> (int)b,
+			_ => throw Fail($"applies {op} to a {opTy}")
+		};
+		return bits == 1 ? new CirValue.Bool((value & 1) != 0) : new CirValue.Int(IntegerTypes.Wrap(value, bits), bits);
+	}
+
+	// `@cloth_pow_i64`: squaring, wrapping at 64 bits; 1 for a non-positive exponent.
+	private static long PowInt(long b, long e) {
+		var r = 1L;
+		for (; e > 0; e >>= 1) {
+			if ((e & 1) != 0) r = unchecked(r * b);
+			b = unchecked(b * b);
+		}
+
+		return r;
+	}
+
+	private static bool Matches(CirValue subject, CirValue pattern) => (subject, pattern) switch {
+		(CirValue.Str s, CirValue.Str p) => s.Value == p.Value,
+		(CirValue.Int or CirValue.Bool, CirValue.Int or CirValue.Bool) => Signed(subject) == Signed(pattern),
+		(CirValue.Float s, CirValue.Float p) => s.Value == p.Value,
+		_ => subject.Equals(pattern)
+	};
+
+	// -------------------------------------------------------------------------
+	// Arrays
+	// -------------------------------------------------------------------------
+
+	private (CirArray Array, int At) Element(CirExpr.Index ix, Frame frame) {
+		var slice = AsSlice(Eval(ix.Target, frame));
+		var i = AsInt(Eval(ix.Idx, frame));
+		if (i < 0 || i >= slice.Length) throw Fail($"indexes [{i}] out of an array of length {slice.Length}");
+		return (slice.Array, slice.Offset + (int)i);
+	}
+
+	private void Write(CirArray array, int at, CirValue value) {
+		if (array.Owner != _owner) throw Fail("writes to an array another initializer created");
+		array.Items[at] = Store(value, array.ElementType);
+	}
+
+	private void Allocate(long count) {
+		if (count < 0) throw Fail($"allocates an array of length {count}");
+		_cells += count;
+		if (_cells > MaxCells) throw Fail($"allocates more than {MaxCells} array elements");
+	}
+
+	private CirValue.Slice NewSlice(CirType elementType, List<CirValue> items) {
+		Allocate(items.Count);
+		return new CirValue.Slice(new CirArray(elementType, items.ToArray(), _owner), 0, items.Count);
+	}
+
+	// `new T[a][b]...`: dimension `level` on, every leaf zeroed.
+	private CirValue.Slice NewArray(CirType leaf, List<long> sizes, int level) {
+		var count = sizes[level];
+		Allocate(count);
+		var elementType = leaf;
+		for (var i = sizes.Count - 1; i > level; i--) elementType = new CirType.Array(elementType);
+		var items = new CirValue[count];
+		for (var i = 0; i < count; i++) items[i] = level + 1 < sizes.Count ? NewArray(leaf, sizes, level + 1) : Zero(leaf);
+		return new CirValue.Slice(new CirArray(elementType, items, _owner), 0, (int)count);
+	}
+
+	// -------------------------------------------------------------------------
+	// Types and conversions
+	// -------------------------------------------------------------------------
+
+	// The value an uninitialized slot of `type` holds: zero, false, null or an empty slice.
+	private CirValue Zero(CirType type) {
+		var lowered = LoweredType(type);
+		return lowered switch {
+			"i1" => new CirValue.Bool(false),
+			"float" or "double" => new CirValue.Float(0, lowered == "float"),
+			"{ ptr, i64 }" => new CirValue.Slice(new CirArray(((CirType.Array)Unwrap(type)).Element, [], _owner), 0, 0),
+			_ => IntBits(lowered) is var bits and > 0 ? new CirValue.Int(0, bits) : new CirValue.Null()
+		};
+	}
+
+	private static CirType Unwrap(CirType type) => type is CirType.Nullable n ? Unwrap(n.Inner) : type;
+
+	// `value` stored into a slot of `type`. Stores are already typed by the lowering
+	// (widenings are explicit casts), so this only settles literal widths and the
+	// conversions the emitter's coercions make.
+	private CirValue Store(CirValue value, CirType? type) {
+		if (type == null) return value;
+		var lowered = LoweredType(type);
+		if (lowered == TypeOf(value) || lowered == "void") return value;
+		if (lowered is "ptr" or "{ ptr, i64 }") throw Fail($"stores a {TypeOf(value)} into a {lowered}");
+		if (lowered == "i1") return value is CirValue.Int i ? new CirValue.Bool((i.Value & 1) != 0) : throw Fail($"stores a {TypeOf(value)} into a bool");
+		return Convert(value, lowered);
+	}
+
+	// `CoerceTo`: integers sign-extend or truncate, integers and floats convert into each
+	// other, floats widen or round.
+	private static CirValue Convert(CirValue value, string type) {
+		if (TypeOf(value) == type) return value;
+		if (IntBits(type) is var bits and > 0) {
+			if (value is CirValue.Float f) {
+				var truncated = Math.Truncate(f.Value);
+				var limit = Math.Pow(2, bits - 1);
+				if (double.IsNaN(truncated) || truncated < -limit || truncated >= limit) throw Fail($"converts {f.Value} to an i{bits}");
+				return new CirValue.Int((long)truncated, bits);
+			}
+
+			return new CirValue.Int(IntegerTypes.Wrap(Signed(value), bits), bits);
+		}
+
+		var x = value is CirValue.Float fl ? fl.Value : Signed(value);
+		return type switch {
+			"double" => new CirValue.Float(x, false),
+			"float" => new CirValue.Float((float)x, true),
+			_ => throw Fail($"converts a {TypeOf(value)} to {type}")
+		};
+	}
+
+	// Integer (or boolean, as an `i1`) value, sign-extended.
+	private static long Signed(CirValue value) => value switch {
+		CirValue.Int i => i.Value,
+		CirValue.Bool b => b.Value ? -1 : 0,
+		_ => throw Fail($"uses a {TypeOf(value)} as an integer")
+	};
+
+	private static long AsInt(CirValue value) => value is CirValue.Int i ? i.Value : throw Fail($"uses a {TypeOf(value)} as an integer");
+
+	private static double AsDouble(CirValue value) => ((CirValue.Float)value).Value;
+
+	private static CirValue.Slice AsSlice(CirValue value) => value as CirValue.Slice ?? throw Fail($"uses a {TypeOf(value)} as an array");
+
+	private static bool Truth(CirValue value) => value is CirValue.Bool b ? b.Value : throw Fail($"branches on a {TypeOf(value)}");
+
+	// The LLVM type of a value, as the emitter's `LlvmTypeOf` would give its expression.
+	private static string TypeOf(CirValue value) => value switch {
+		CirValue.Int i => $"i{i.Bits}",
+		CirValue.Bool => "i1",
+		CirValue.Float f => f.Single ? "float" : "double",
+		CirValue.Slice => "{ ptr, i64 }",
+		_ => "ptr"
+	};
+
+	private static int IntBits(string type) => type switch {
+		"i8" => 8,
+		"i16" => 16,
+		"i32" => 32,
+		"i64" => 64,
+		_ => 0
+	};
+
+	private static int Width(string type) => type switch {
+		"i1" => 1,
+		"float" => 32,
+		"double" => 64,
+		_ => IntBits(type)
+	};
+
+	// A CIR type as the LLVM emitter lowers it, reduced to the shapes values come in.
+	private static string LoweredType(CirType type) => type switch {
+		CirType.Void => "void",
+		CirType.Nullable n => LoweredType(n.Inner),
+		CirType.Array => "{ ptr, i64 }",
+		CirType.Named { FullyQualifiedName: var name } => name switch {
+			"f32" or "float" => "float",
+			"f64" or "double" or "real" => "double",
+			"bool" or "bit" => "i1",
+			"char" => "i8",
+			"void" => "void",
+			_ => IntegerTypes.Bits(name) is var bits and > 0 ? $"i{bits}" : "ptr"
+		},
+		_ => "ptr"
+	};
+}
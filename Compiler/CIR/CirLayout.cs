@@ -0,0 +1,88 @@
+// Copyright (c) 2026.The Cloth contributors.
+//
+// CirLayout.cs is part of the Cloth Compiler.
+//
+// Use, modification, and distribution of this file are governed by the
+// license terms provided with the Cloth Compiler source distribution.
+
+using Compiler.Semantics;
+
+namespace Compiler.CIR;
+
+// Byte layout of the structs the LLVM emitter declares for classes, under the x64 data
+// layout: each field at the next offset its alignment allows, the whole struct rounded up to
+// its largest alignment. Shared by the emitter (struct types, `dereferenceable` sizes), the
+// `field-layout` pass and the `--dump` report, so all three agree on every offset.
+public static class CirLayout {
+	// Root-to-leaf fields of `classFqn`: the root's (vtable header included), then each
+	// descendant's in chain order with its duplicate `__vtable__` skipped. An ancestor's fields
+	// therefore sit at the same offsets in every descendant, which upcasts and the vtable-walk
+	// casts rely on. The visited set guards against a malformed BaseClass ring (the registry's
+	// cycle detector prevents these in normal compiles).
+	public static List<CirField> Flatten(IReadOnlyDictionary<string, CirTypeDecl.Class> classes, string classFqn) {
+		var chain = new List<CirTypeDecl.Class>();
+		var visited = new HashSet<string>();
+		var cursor = classFqn;
+		while (!string.IsNullOrEmpty(cursor) && classes.TryGetValue(cursor, out var cls)) {
+			if (!visited.Add(cursor)) break;
+			chain.Insert(0, cls);
+			cursor = cls.BaseClass;
+		}
+
+		var result = new List<CirField>();
+		for (var i = 0; i < chain.Count; i++)
+			result.AddRange(i == 0 ? chain[i].Fields : chain[i].Fields.Where(f => f.Name != SymbolRegistry.VtableFieldName));
+		return result;
+	}
+
+	// Size and alignment of a value of `type` stored in a struct, following `LlvmType`:
+	// scalars at their width, a slice as `{ ptr, i64 }`, a class, enum, interface or string
+	// reference as a pointer. Null for the types whose storage isn't settled — a tuple, a
+	// generic instance and `void` — which the emitter only stands in for with a `ptr`.
+	public static (long Size, long Align)? ExactSizeOf(CirType type) => type switch {
+		CirType.Nullable n => ExactSizeOf(n.Inner),
+		CirType.Array => (16, 8),
+		CirType.Ptr or CirType.Any => (8, 8),
+		CirType.Named n => n.FullyQualifiedName switch {
+			"bool" or "bit" or "i8" or "u8" or "byte" or "sbyte" or "char" => (1, 1),
+			"i16" or "u16" or "short" => (2, 2),
+			"i32" or "u32" or "int" or "uint" or "unsigned" or "f32" or "float" => (4, 4),
+			"void" => null,
+			_ => (8, 8)
+		},
+		_ => null
+	};
+
+	// `ExactSizeOf`, with a pointer slot for the types it can't size. Good enough to pack by,
+	// where a wrong guess only costs padding.
+	public static (long Size, long Align) SizeOf(CirType type) => ExactSizeOf(type) ?? (8, 8);
+
+	// Lay out fields of `types` in order from offset 0. No fields lays out as the single
+	// pointer slot the emitter gives a field-less class.
+	public static CirStructLayout Of(IReadOnlyList<CirType> types) {
+		if (types.Count == 0) return new CirStructLayout([], 8, 8, 0, Exact: true);
+
+		var offsets = new long[types.Count];
+		long offset = 0, maxAlign = 1, used = 0;
+		var exact = true;
+		for (var i = 0; i < types.Count; i++) {
+			exact &= ExactSizeOf(types[i]) != null;
+			var (size, align) = SizeOf(types[i]);
+			offsets[i] = AlignUp(offset, align);
+			offset = offsets[i] + size;
+			used += size;
+			maxAlign = Math.Max(maxAlign, align);
+		}
+
+		var total = AlignUp(offset, maxAlign);
+		return new CirStructLayout(offsets, offset, total, total - used, exact);
+	}
+
+	public static long AlignUp(long offset, long align) => (offset + align - 1) / align * align;
+}
+
+// `Offsets[i]` is field i's byte offset. `End` is where the last field ends, which is where
+// a descendant's first own field can start; `Size` is the padded struct size, and `Padding`
+// the bytes of it no field occupies. `Exact` is false when some field's size was a guess
+// (`ExactSizeOf` returned null), so the figures can't be promised to LLVM.
+public sealed record CirStructLayout(IReadOnlyList<long> Offsets, long End, long Size, long Padding, bool Exact);
@@ -14,7 +14,100 @@ namespace Compiler.CIR;
 // `InterfaceIds` maps each known interface FQN to its 0-based bit position in that bitmap;
 // the LLVM emitter consults it from `EmitTypeCheck` / `EmitDowncast` to look up the
 // correct byte/bit at runtime for `x is Iface` / `x as Iface`.
-public sealed record CirModule(List<CirTypeDecl> Types, List<CirFunction> Functions, List<CirVtable> Vtables, List<CirStaticField> StaticFields, int InterfaceCount = 0, Dictionary<string, int>? InterfaceIds = null);
+//
+// The lists are the module's canonical, ordered contents; the `…By*` properties are
+// read-only lookup indexes over them, built once on first use (and safe to build from
+// several emitter threads at once — every builder produces the same index). Consumers
+// must treat the lists as frozen after construction: a pass that rewrites the module
+// produces a new record (`with` drops the indexes so they are rebuilt from the new lists).
+// `DispatchLayout` is derived from `Vtables` and `DispatchSlots` (one entry per global slot
+// ID) the same way.
+public sealed record CirModule(List<CirTypeDecl> Types, List<CirFunction> Functions, List<CirVtable> Vtables, List<CirStaticField> StaticFields, int InterfaceCount = 0, Dictionary<string, int>? InterfaceIds = null, List<CirDispatchSlot>? DispatchSlots = null) {
+	private Index? _index;
+	private CirDispatchLayout? _dispatchLayout;
+
+	private CirModule(CirModule original) {
+		Types = original.Types;
+		Functions = original.Functions;
+		Vtables = original.Vtables;
+		StaticFields = original.StaticFields;
+		InterfaceCount = original.InterfaceCount;
+		InterfaceIds = original.InterfaceIds;
+		DispatchSlots = original.DispatchSlots;
+	}
+
+	// Mangled name → function. Several `@Extern` declarations may alias one C symbol; the
+	// first one registered wins, matching the order the emitter declares them in.
+	public IReadOnlyDictionary<string, CirFunction> FunctionsByName => GetIndex().Functions;
+
+	// FQN → type declaration of any kind, plus typed views for the two kinds with layout.
+	// A redeclared FQN maps to its last declaration, as the emitter's layout pass sees it.
+	public IReadOnlyDictionary<string, CirTypeDecl> TypesByFqn => GetIndex().Types;
+	public IReadOnlyDictionary<string, CirTypeDecl.Class> ClassesByFqn => GetIndex().Classes;
+	public IReadOnlyDictionary<string, CirTypeDecl.Enum> EnumsByFqn => GetIndex().Enums;
+
+	// Class FQN → vtable.
+	public IReadOnlyDictionary<string, CirVtable> VtablesByFqn => GetIndex().Vtables;
+
+	// Where each vtable slot sits in the emitted, compacted method rows.
+	public CirDispatchLayout DispatchLayout => _dispatchLayout ??= new CirDispatchLayout(Vtables, DispatchSlots ?? []);
+
+	// `{ClassFqn}.{Name}` → static / class-level-const field.
+	public IReadOnlyDictionary<string, CirStaticField> StaticFieldsByName => GetIndex().StaticFields;
+
+	// Null when the callee isn't part of this module (runtime helpers, unresolved symbols).
+	public CirFunction? FindFunction(string mangledName) => FunctionsByName.GetValueOrDefault(mangledName);
+
+	public static string StaticFieldKey(string classFqn, string name) => $"{classFqn}.{name}";
+
+	private Index GetIndex() => _index ??= new Index(this);
+
+	private sealed class Index {
+		public readonly Dictionary<string, CirFunction> Functions;
+		public readonly Dictionary<string, CirTypeDecl> Types;
+		public readonly Dictionary<string, CirTypeDecl.Class> Classes = new();
+		public readonly Dictionary<string, CirTypeDecl.Enum> Enums = new();
+		public readonly Dictionary<string, CirVtable> Vtables;
+		public readonly Dictionary<string, CirStaticField> StaticFields;
+
+		public Index(CirModule module) {
+			Functions = new Dictionary<string, CirFunction>(module.Functions.Count);
+			foreach (var fn in module.Functions)
+				Functions.TryAdd(fn.MangledName, fn);
+
+			Types = new Dictionary<string, CirTypeDecl>(module.Types.Count);
+			foreach (var type in module.Types) {
+				switch (type) {
+					case CirTypeDecl.Class c:
+						Types[c.FullyQualifiedName] = c;
+						Classes[c.FullyQualifiedName] = c;
+						break;
+					case CirTypeDecl.Enum e:
+						Types[e.FullyQualifiedName] = e;
+						Enums[e.FullyQualifiedName] = e;
+						break;
+					case CirTypeDecl.Struct s:
+						Types[s.FullyQualifiedName] = s;
+						break;
+					case CirTypeDecl.Interface i:
+						Types[i.FullyQualifiedName] = i;
+						break;
+					case CirTypeDecl.Trait t:
+						Types[t.FullyQualifiedName] = t;
+						break;
+				}
+			}
+
+			Vtables = new Dictionary<string, CirVtable>(module.Vtables.Count);
+			foreach (var vt in module.Vtables)
+				Vtables[vt.ClassFqn] = vt;
+
+			StaticFields = new Dictionary<string, CirStaticField>(module.StaticFields.Count);
+			foreach (var sf in module.StaticFields)
+				StaticFields[StaticFieldKey(sf.ClassFqn, sf.Name)] = sf;
+		}
+	}
+}
 
 // One module-level entry per `static`/class-level-`const` field. The LLVM emitter
 // produces one global per record (`@<mangled-fqn>`) initialized from `Initializer`.
@@ -25,10 +118,12 @@ public sealed record CirModule(List<CirTypeDecl> Types, List<CirFunction> Functi
 public sealed record CirStaticField(string ClassFqn, string Name, CirType Type, CirExpr? Initializer, bool IsConst, bool IsExtern);
 
 // One vtable per class. `ParentClassFqn` references the next link in the inheritance chain
-// (or null at the root), driving runtime parent-walks during class→class downcasts.
+// (or null at the root); the emitter follows it to lay out each vtable's ancestor display,
+// which answers class `is` / `as` checks without walking the chain at run time.
 // `Slots[i]` is the mangled CIR symbol of the function at global interface-method slot `i`,
 // or null when the class doesn't implement that slot's method. The list length is uniform
-// across all vtables in a module (= VtableSize). `IsExtern` is true for classes defined in
+// across all vtables in a module (= VtableSize); the emitted rows are compacted from it by
+// `CirDispatchLayout`. `IsExtern` is true for classes defined in
 // a dependency project (e.g. the standard library) — the LLVM emitter emits an `external`
 // declaration rather than a definition, so the linker resolves the symbol against the
 // dependency's compiled `.lib` instead of producing a duplicate definition.
@@ -17,7 +17,12 @@ public static class CirPrinter {
 
 		sb.AppendLine("  Types:");
 		foreach (var type in module.Types)
-			PrintTypeDecl(sb, type, indent: 4);
+			PrintTypeDecl(sb, module, type, indent: 4);
+
+		// Methods rows only, at 8 bytes per function pointer — the part of every vtable that
+		// grows with the program's interface methods.
+		var dispatch = module.DispatchLayout;
+		sb.AppendLine($"  Dispatch: {dispatch.TableCount} vtables x {dispatch.RowSize} slots = {dispatch.TableCount * dispatch.RowSize * 8} bytes (unpacked {dispatch.SlotCount} slots = {dispatch.TableCount * dispatch.SlotCount * 8} bytes)");
 
 		sb.AppendLine("  Functions:");
 		foreach (var fn in module.Functions)
@@ -31,7 +36,7 @@ public static class CirPrinter {
 	// Type declarations
 	// -------------------------------------------------------------------------
 
-	private static void PrintTypeDecl(StringBuilder sb, CirTypeDecl decl, int indent) {
+	private static void PrintTypeDecl(StringBuilder sb, CirModule module, CirTypeDecl decl, int indent) {
 		var pad = new string(' ', indent);
 		switch (decl) {
 			case CirTypeDecl.Class c:
@@ -40,9 +45,20 @@ public static class CirPrinter {
 				if (c.Interfaces.Count > 0) sb.Append($" is {string.Join(", ", c.Interfaces)}");
 				if (c.IsPrototype) sb.Append(" [prototype]");
 				if (c.IsConst) sb.Append(" [const]");
+				if (c.IsCompact) sb.Append(" [compact]");
 				sb.AppendLine(" {");
-				foreach (var f in c.Fields)
-					sb.AppendLine($"{pad}  field {f.Name}: {PrintType(f.Type)}{(f.IsConst ? " [const]" : "")}{(f.Initializer != null ? $" = {PrintExpr(f.Initializer)}" : "")}");
+				// `@N` is the field's byte offset in the flattened struct; an inheriting class's
+				// `__vtable__` shares the root's slot at 0.
+				var flat = CirLayout.Flatten(module.ClassesByFqn, c.FullyQualifiedName);
+				var layout = CirLayout.Of(flat.Select(f => f.Type).ToList());
+				foreach (var f in c.Fields) {
+					var index = flat.FindIndex(x => x.Name == f.Name);
+					var offset = index < 0 ? 0 : layout.Offsets[index];
+					sb.AppendLine($"{pad}  field {f.Name}: {PrintType(f.Type)} @{offset}{(f.IsConst ? " [const]" : "")}{(f.Initializer != null ? $" = {PrintExpr(f.Initializer)}" : "")}");
+				}
+				sb.AppendLine($"{pad}  layout: {layout.Size} bytes, {layout.Padding} padding{(layout.Exact ? "" : " (estimated)")}");
+				if (module.VtablesByFqn.TryGetValue(c.FullyQualifiedName, out var vtable) && vtable.Slots.Any(slot => slot != null))
+					PrintVtable(sb, vtable, module.DispatchLayout, pad);
 				sb.AppendLine($"{pad}}}");
 				break;
 
@@ -74,6 +90,15 @@ public static class CirPrinter {
 		}
 	}
 
+	// Only the occupied slots — the slot list spans every interface method in the module.
+	// Each is shown with its global slot ID and, after `@`, its position in the packed row.
+	private static void PrintVtable(StringBuilder sb, CirVtable vtable, CirDispatchLayout layout, string pad) {
+		sb.AppendLine($"{pad}  vtable{(vtable.IsExtern ? " [extern]" : "")}:");
+		for (var i = 0; i < vtable.Slots.Count; i++)
+			if (vtable.Slots[i] is { } slot)
+				sb.AppendLine($"{pad}    [{i} @{layout.PositionOf(i)}] {slot}");
+	}
+
 	// -------------------------------------------------------------------------
 	// Functions
 	// -------------------------------------------------------------------------
@@ -88,9 +113,9 @@ public static class CirPrinter {
 			CirFunctionKind.StaticMethod => "static fn",
 			_ => "fn"
 		};
-		var paramStr = string.Join(", ", fn.Parameters.Select(p => $"{p.Name}: {PrintType(p.Type)}"));
+		var paramStr = string.Join(", ", fn.Parameters.Select(p => $"{p.Name}: {PrintType(p.Type)}{(p.Transfer ? "!" : "")}"));
 		var ret = PrintType(fn.ReturnType);
-		var extern_ = fn.IsExtern ? " [extern]" : "";
+		var extern_ = (fn.IsExtern ? " [extern]" : fn.HasRegion ? " [region]" : "") + (fn.IsBench ? fn.BenchInput is { } input ? $" [bench {input}]" : " [bench]" : "");
 
 		sb.AppendLine($"{pad}{kind} {fn.MangledName}({paramStr}) -> {ret}{extern_} {{");
 		foreach (var stmt in fn.Body)
@@ -171,7 +196,7 @@ public static class CirPrinter {
 				break;
 
 			case CirStmt.ForIn fi:
-				sb.AppendLine($"{pad}for ({fi.ElementName}: {PrintType(fi.ElementType)} in {PrintExpr(fi.Iterable)}) {{");
+				sb.AppendLine($"{pad}{(fi.Parallel ? "parallel " : "")}for ({fi.ElementName}: {PrintType(fi.ElementType)} in {PrintExpr(fi.Iterable)}) {{");
 				foreach (var s in fi.Body) PrintStmt(sb, s, indent + 2);
 				sb.AppendLine($"{pad}}}");
 				break;
@@ -200,7 +225,7 @@ public static class CirPrinter {
 				break;
 
 			case CirStmt.Delete d:
-				sb.AppendLine($"{pad}delete {PrintExpr(d.Expression)}");
+				sb.AppendLine($"{pad}delete{(d.OnStack ? " [stack]" : "")} {PrintExpr(d.Expression)}");
 				break;
 
 			case CirStmt.Block b:
@@ -208,6 +233,12 @@ public static class CirPrinter {
 				foreach (var s in b.Body) PrintStmt(sb, s, indent + 2);
 				sb.AppendLine($"{pad}}}");
 				break;
+
+			case CirStmt.Join j:
+				sb.AppendLine($"{pad}join {{");
+				foreach (var task in j.Tasks) sb.AppendLine($"{pad}  spawn {PrintExpr(task)}");
+				sb.AppendLine($"{pad}}}");
+				break;
 		}
 	}
 
@@ -230,11 +261,13 @@ public static class CirPrinter {
 
 		CirExpr.FieldAccess fa => $"{PrintExpr(fa.Target)}->{fa.FieldName}",
 		CirExpr.StaticAccess sa => $"{sa.TypeFqn}::{sa.MemberName}",
+		CirExpr.ArrayLength al => $"{PrintExpr(al.Target)}::LENGTH",
+		CirExpr.Index { Checked: false } i => $"(unchecked {PrintExpr(i.Target)}[{PrintExpr(i.Idx)}])",
 		CirExpr.Index i => $"{PrintExpr(i.Target)}[{PrintExpr(i.Idx)}]",
 
 		CirExpr.Call c => $"{c.MangledName}({string.Join(", ", c.Args.Select(PrintExpr))})",
 		CirExpr.IndirectCall ic => $"(*{PrintExpr(ic.Callee)})({string.Join(", ", ic.Args.Select(PrintExpr))})",
-		CirExpr.Alloc a => $"alloc {PrintType(a.Type)} via {a.CtorMangledName}({string.Join(", ", a.Args.Select(PrintExpr))})",
+		CirExpr.Alloc a => $"alloc{(a.InRegion ? " [region]" : a.OnStack ? " [stack]" : "")} {PrintType(a.Type)} via {a.CtorMangledName}({string.Join(", ", a.Args.Select(PrintExpr))})",
 
 		CirExpr.Cast c => $"({(c.IsSafe ? "safe " : "")}cast<{PrintType(c.TargetType)}> {PrintExpr(c.Value)})",
 		CirExpr.TypeCheck t => $"({PrintExpr(t.Value)} is {PrintType(t.TargetType)})",
@@ -254,6 +287,7 @@ public static class CirPrinter {
 		CirType.Named n => n.FullyQualifiedName,
 		CirType.Ptr p => $"*{PrintType(p.Inner)}",
 		CirType.Nullable n => $"{PrintType(n.Inner)}?",
+		CirType.Array { Inline: true } a => $"inline {PrintType(a.Element)}[]",
 		CirType.Array a => $"{PrintType(a.Element)}[]",
 		CirType.Tuple t => $"({string.Join(", ", t.Elements.Select(PrintType))})",
 		CirType.Generic g => $"{g.FullyQualifiedName}<{string.Join(", ", g.Args.Select(PrintType))}>",
@@ -29,7 +29,9 @@ public abstract record CirStmt {
 	// Init is a full statement (typically LocalDecl) to support: for (let i = 0; ...)
 	public sealed record For(CirStmt Init, CirExpr Condition, CirExpr Iterator, List<CirStmt> Body) : CirStmt;
 
-	public sealed record ForIn(CirType ElementType, string ElementName, CirExpr Iterable, List<CirStmt> Body) : CirStmt;
+	// `Parallel` (a `parallel for`) lets the iterations run concurrently on the runtime's
+	// thread pool; the analyzer has checked that they only write their own state.
+	public sealed record ForIn(CirType ElementType, string ElementName, CirExpr Iterable, List<CirStmt> Body, bool Parallel = false) : CirStmt;
 
 	public sealed record Switch(CirExpr Subject, List<CirSwitchCase> Cases) : CirStmt;
 
@@ -39,12 +41,18 @@ public abstract record CirStmt {
 
 	public sealed record Throw(CirExpr Expression) : CirStmt;
 
-	// Manual destruction: runs the destructor for ClassFqn (when defined) and frees the
-	// underlying heap allocation via libc free(). ClassFqn is captured at CIR-lowering time
-	// so the LLVM emitter doesn't need to re-infer the target's type.
-	public sealed record Delete(CirExpr Expression, string ClassFqn) : CirStmt;
+	// Manual destruction: runs the destructor for ClassFqn (when defined) and returns the
+	// allocation to the runtime's size-class pool (libc free() for arrays). ClassFqn is captured at CIR-lowering time
+	// so the LLVM emitter doesn't need to re-infer the target's type. `OnStack` marks the
+	// delete of a frame-allocated object (`Alloc.OnStack`): only the destructor runs.
+	public sealed record Delete(CirExpr Expression, string ClassFqn, bool OnStack = false) : CirStmt;
 
 	public sealed record Block(List<CirStmt> Body) : CirStmt;
+
+	// `join { spawn ...; }`: evaluates each task's operands, runs the tasks concurrently on the
+	// runtime's thread pool and waits for all of them. Each task is an expression evaluated
+	// for its effect — a call, as lowered, though passes may rewrite it.
+	public sealed record Join(List<CirExpr> Tasks) : CirStmt;
 }
 
 // Pattern == null means 'default'
@@ -14,7 +14,8 @@ public abstract record CirType {
 
 	public sealed record Nullable(CirType Inner) : CirType;
 
-	public sealed record Array(CirType Element) : CirType;
+	// `Inline` (set by `InlineArrays`) stores class elements by value in the buffer.
+	public sealed record Array(CirType Element, bool Inline = false) : CirType;
 
 	public sealed record Tuple(List<CirType> Elements) : CirType;
 
@@ -9,7 +9,9 @@ namespace Compiler.CIR;
 
 // Type layout records — no method bodies, those live in CirFunction.
 public abstract record CirTypeDecl {
-	public sealed record Class(string FullyQualifiedName, string? BaseClass, List<string> Interfaces, List<CirField> Fields, bool IsPrototype, bool IsConst) : CirTypeDecl;
+	// `Fields` is the class's own contribution to the struct, in layout order. `IsCompact`
+	// (`@Compact`, or a `fieldLayout = "compact"` build) lets the `field-layout` pass reorder it.
+	public sealed record Class(string FullyQualifiedName, string? BaseClass, List<string> Interfaces, List<CirField> Fields, bool IsPrototype, bool IsConst, bool IsCompact = false) : CirTypeDecl;
 
 	public sealed record Struct(string FullyQualifiedName, List<CirField> Fields) : CirTypeDecl;
 
@@ -0,0 +1,40 @@
+// Copyright (c) 2026.The Cloth contributors.
+//
+// CirValue.cs is part of the Cloth Compiler.
+//
+// Use, modification, and distribution of this file are governed by the
+// license terms provided with the Cloth Compiler source distribution.
+
+namespace Compiler.CIR;
+
+// A value computed by `CirInterpreter`, as the emitted code would hold it in a register of
+// the expression's LLVM type.
+public abstract record CirValue {
+	// An `iN` register (`Bits` of 8, 16, 32 or 64), sign-extended into `Value`.
+	public sealed record Int(long Value, int Bits) : CirValue;
+
+	public sealed record Bool(bool Value) : CirValue;
+
+	// A `double`, or a `float` when `Single` (`Value` is then exactly representable as one).
+	public sealed record Float(double Value, bool Single) : CirValue;
+
+	// A pointer to string literal `Value`'s pooled constant.
+	public sealed record Str(string Value) : CirValue;
+
+	public sealed record Null : CirValue;
+
+	// A pointer to an enum case's singleton global.
+	public sealed record EnumCase(string EnumFqn, string CaseName) : CirValue;
+
+	// A `{ ptr, i64 }` slice: `Length` elements of `Array` from `Offset` on. Slices of one
+	// array share it, as they share a buffer at run time.
+	public sealed record Slice(CirArray Array, int Offset, int Length) : CirValue;
+}
+
+// The buffer behind one or more slices. `Owner` identifies the evaluation that allocated it:
+// an initializer may read another static's arrays but not write them.
+public sealed class CirArray(CirType elementType, CirValue[] items, int owner) {
+	public CirType ElementType { get; } = elementType;
+	public CirValue[] Items { get; } = items;
+	public int Owner { get; } = owner;
+}
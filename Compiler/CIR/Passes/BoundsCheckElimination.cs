@@ -0,0 +1,220 @@
+// Copyright (c) 2026.The Cloth contributors.
+//
+// BoundsCheckElimination.cs is part of the Cloth Compiler.
+//
+// Use, modification, and distribution of this file are governed by the
+// license terms provided with the Cloth Compiler source distribution.
+
+using System.Globalization;
+
+namespace Compiler.CIR.Passes;
+
+// Drops the `0 <= i < length` test from `arr[i]` accesses a counted loop already proves in
+// range. The recognized shape is
+//
+//   for (T i = c; i < arr::LENGTH; i++ / ++i) { ... arr[i] ... }
+//
+// with `c` a non-negative literal, `T` an integer type, and neither `i` nor `arr` written,
+// redeclared, or (for a field chain like `this.data`) possibly mutated by a call anywhere in
+// the body. The loop test runs before every iteration with the same `i` the access uses, so
+// the index is `>= c >= 0` and `< length`. For-in loops need nothing: their element access
+// is generated unchecked already.
+//
+// A 64-bit counter can't wrap before reaching the length. A narrower one could — past its
+// maximum the increment wraps, negative or (unsigned) to zero, while `i < length` still
+// holds — so the loop is versioned on the array being no longer than `2^(bits-1) - 1`: the
+// unchecked loop runs when it is, the original checked one otherwise, with the locals it
+// declares renamed so the two copies don't share a name. The limit is the signed one for
+// unsigned counters too, since the emitter sign-extends a narrow counter both for the test
+// against the `i64` length and for the index.
+//
+// The pass only removes checks it proves redundant, so it runs at every optimization level.
+public sealed class BoundsCheckElimination : CirPass {
+	public override string Name => "bounds-check-elim";
+
+	public override int MinOptLevel => 0;
+
+	public override CirModule Run(CirModule module, CirPassContext context) =>
+		RewriteFunctions(module, fn => new LoopRewriter().RewriteBlock(fn.Body));
+
+	private sealed class LoopRewriter : CirRewriter {
+		// Numbers the checked copies of the function's versioned loops.
+		private int _versions;
+
+		protected override IEnumerable<CirStmt> RewriteInBlock(CirStmt stmt) {
+			// Inner loops first, so nested `for`s are each matched against their own counter.
+			var rewritten = Rewrite(stmt);
+			if (rewritten is not CirStmt.For f || !TryMatch(f, out var counter, out var array, out var counterType)) {
+				yield return rewritten;
+				yield break;
+			}
+
+			var marker = new ProvenIndexMarker(counter, array);
+			var body = marker.RewriteBlock(f.Body);
+			if (ReferenceEquals(body, f.Body)) {
+				yield return rewritten;
+				yield break;
+			}
+
+			var counterBits = IntegerTypes.Bits(counterType);
+			if (counterBits == 64) {
+				yield return f with { Body = body };
+				yield break;
+			}
+
+			var max = (1L << (counterBits - 1)) - 1;
+			var fits = new CirExpr.Binary(new CirExpr.ArrayLength(array), CirBinOp.LtEq, new CirExpr.Cast(new CirExpr.IntLit(max.ToString(CultureInfo.InvariantCulture)), new CirType.Named("i64"), false));
+			var original = new LocalRenamer(DeclaredNames(f), $".v{++_versions}").Rewrite(f);
+			yield return new CirStmt.If(fits, [f with { Body = body }], [], [original]);
+		}
+	}
+
+	// Every name `f` declares: the counter and the locals of its body, nested loops included.
+	private static HashSet<string> DeclaredNames(CirStmt.For f) {
+		var scanner = new DeclarationScanner();
+		scanner.Rewrite(f);
+		return scanner.Names;
+	}
+
+	private sealed class DeclarationScanner : CirRewriter {
+		public readonly HashSet<string> Names = new();
+
+		public override CirStmt Rewrite(CirStmt stmt) {
+			switch (stmt) {
+				case CirStmt.LocalDecl ld:
+					Names.Add(ld.Name);
+					break;
+				case CirStmt.TupleDecl td:
+					foreach (var (_, name) in td.Bindings) Names.Add(name);
+					break;
+				case CirStmt.ForIn fi:
+					Names.Add(fi.ElementName);
+					break;
+			}
+
+			return RewriteChildren(stmt);
+		}
+	}
+
+	// Appends `suffix` to each of `names`, at its declaration and at every use. The names are
+	// declared inside the renamed statement, so no use outside it refers to them.
+	private sealed class LocalRenamer(HashSet<string> names, string suffix) : CirRewriter {
+		public override CirExpr Rewrite(CirExpr expr) {
+			var rewritten = RewriteChildren(expr);
+			return rewritten is CirExpr.Local l && names.Contains(l.Name) ? l with { Name = l.Name + suffix } : rewritten;
+		}
+
+		public override CirStmt Rewrite(CirStmt stmt) => RewriteChildren(stmt) switch {
+			CirStmt.LocalDecl ld when names.Contains(ld.Name) => ld with { Name = ld.Name + suffix },
+			CirStmt.TupleDecl td => td with { Bindings = td.Bindings.Select(b => names.Contains(b.Name) ? (b.Type, b.Name + suffix) : b).ToList() },
+			CirStmt.ForIn fi when names.Contains(fi.ElementName) => fi with { ElementName = fi.ElementName + suffix },
+			var other => other
+		};
+	}
+
+	// Clears `Checked` on every `array[counter]` in a loop body already shown not to write
+	// either operand.
+	private sealed class ProvenIndexMarker(string counter, CirExpr array) : CirRewriter {
+		public override CirExpr Rewrite(CirExpr expr) {
+			var rewritten = RewriteChildren(expr);
+			return rewritten is CirExpr.Index { Checked: true, Idx: CirExpr.Local l } ix && l.Name == counter && ix.Target == array
+				? ix with { Checked = false }
+				: rewritten;
+		}
+	}
+
+	private static bool TryMatch(CirStmt.For f, out string counter, out CirExpr array, out string counterType) {
+		counter = "";
+		array = null!;
+		counterType = "";
+
+		// The literal start value may arrive wrapped in the widening cast to the counter's type.
+		if (f.Init is not CirStmt.LocalDecl { Type: CirType.Named type, Init: { } initExpr } init) return false;
+		if ((initExpr is CirExpr.Cast cast ? cast.Value : initExpr) is not CirExpr.IntLit start) return false;
+		if (!long.TryParse(start.Value, NumberStyles.Integer, CultureInfo.InvariantCulture, out var startValue) || startValue < 0) return false;
+		if (IntegerTypes.Bits(type.FullyQualifiedName) == 0) return false;
+		counterType = type.FullyQualifiedName;
+		counter = init.Name;
+
+		var bound = f.Condition switch {
+			CirExpr.Binary { Op: CirBinOp.Lt, Left: var l, Right: CirExpr.ArrayLength len } when IsLocal(StripWidening(l), init.Name) => len.Target,
+			CirExpr.Binary { Op: CirBinOp.Gt, Left: CirExpr.ArrayLength len, Right: var r } when IsLocal(StripWidening(r), init.Name) => len.Target,
+			_ => null
+		};
+		if (bound == null || !IsStableArray(bound)) return false;
+		array = bound;
+
+		if (f.Iterator is not CirExpr.Unary { Op: CirUnOp.PostInc or CirUnOp.PreInc, Operand: var operand } || !IsLocal(operand, counter)) return false;
+
+		var writes = new WriteScanner(counter, array);
+		foreach (var s in f.Body) writes.Rewrite(s);
+		return !writes.Disqualified;
+	}
+
+	// The comparison may see the counter through a widening cast to the length's `i64`.
+	private static CirExpr StripWidening(CirExpr expr) =>
+		expr is CirExpr.Cast { Value: var inner, TargetType: CirType.Named { FullyQualifiedName: "i64" } } ? inner : expr;
+
+	private static bool IsLocal(CirExpr expr, string name) => expr is CirExpr.Local l && l.Name == name;
+
+	// A local, or a field chain rooted at a local or `this` — expressions that read the same
+	// slice every time unless something in the loop writes it.
+	private static bool IsStableArray(CirExpr expr) => expr switch {
+		CirExpr.Local or CirExpr.ThisPtr => true,
+		CirExpr.FieldAccess fa => IsStableArray(fa.Target),
+		_ => false
+	};
+
+	// Read-only walk (returns every node unchanged) that flags anything in a loop body that
+	// could change the counter or the array between the loop test and an access.
+	private sealed class WriteScanner : CirRewriter {
+		private readonly HashSet<string> _locals = new();
+		private readonly HashSet<string> _fields = new();
+
+		public bool Disqualified { get; private set; }
+
+		public WriteScanner(string counter, CirExpr array) {
+			_locals.Add(counter);
+			for (var e = array; e is CirExpr.FieldAccess fa; e = fa.Target)
+				_fields.Add(fa.FieldName);
+			var root = array;
+			while (root is CirExpr.FieldAccess fa) root = fa.Target;
+			if (root is CirExpr.Local l) _locals.Add(l.Name);
+		}
+
+		public override CirStmt Rewrite(CirStmt stmt) {
+			switch (stmt) {
+				case CirStmt.LocalDecl ld when _locals.Contains(ld.Name):
+				case CirStmt.TupleDecl td when td.Bindings.Any(b => _locals.Contains(b.Name)):
+				case CirStmt.ForIn fi when _locals.Contains(fi.ElementName):
+					Disqualified = true;
+					break;
+				case CirStmt.Assign a when WritesTracked(a.Target):
+					Disqualified = true;
+					break;
+			}
+
+			return RewriteChildren(stmt);
+		}
+
+		public override CirExpr Rewrite(CirExpr expr) {
+			switch (expr) {
+				case CirExpr.Unary { Op: CirUnOp.PreInc or CirUnOp.PreDec or CirUnOp.PostInc or CirUnOp.PostDec, Operand: var operand } when WritesTracked(operand):
+					Disqualified = true;
+					break;
+				// A callee can reassign any field; locals are out of its reach.
+				case CirExpr.Call or CirExpr.IndirectCall or CirExpr.VirtualCall or CirExpr.Alloc when _fields.Count > 0:
+					Disqualified = true;
+					break;
+			}
+
+			return RewriteChildren(expr);
+		}
+
+		private bool WritesTracked(CirExpr target) => target switch {
+			CirExpr.Local l => _locals.Contains(l.Name),
+			CirExpr.FieldAccess fa => _fields.Contains(fa.FieldName),
+			_ => false
+		};
+	}
+}
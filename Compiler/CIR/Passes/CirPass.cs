@@ -0,0 +1,46 @@
+// Copyright (c) 2026.The Cloth contributors.
+//
+// CirPass.cs is part of the Cloth Compiler.
+//
+// Use, modification, and distribution of this file are governed by the
+// license terms provided with the Cloth Compiler source distribution.
+
+using Compiler.Configs;
+using Compiler.Configs.Profiles;
+using Compiler.Pgo;
+
+namespace Compiler.CIR.Passes;
+
+// One module-to-module transformation in the `CirPassManager` pipeline. A pass returns the
+// module it was given when it changes nothing, and a new record otherwise — the input
+// module (and its lists) are never mutated. `MinOptLevel` is the lowest profile `-O` level
+// the pass runs at, so a debug build can skip the transformations that reshape code.
+public abstract class CirPass {
+	public abstract string Name { get; }
+
+	public virtual int MinOptLevel => 1;
+
+	public abstract CirModule Run(CirModule module, CirPassContext context);
+
+	// Rewrite every function body with `rewrite`, keeping the original function (and, when
+	// no body changed, the original module) wherever the result is reference-equal.
+	protected static CirModule RewriteFunctions(CirModule module, Func<CirFunction, List<CirStmt>> rewrite) {
+		List<CirFunction>? functions = null;
+		for (var i = 0; i < module.Functions.Count; i++) {
+			var fn = module.Functions[i];
+			var body = rewrite(fn);
+			if (functions == null && ReferenceEquals(body, fn.Body)) continue;
+			functions ??= module.Functions.Take(i).ToList();
+			functions.Add(ReferenceEquals(body, fn.Body) ? fn : fn with { Body = body });
+		}
+
+		return functions == null ? module : module with { Functions = functions };
+	}
+}
+
+// What a pass may consult about the build: the optimization settings, whether the
+// module is a whole program (an executable) or a library other projects will call into,
+// and — in a `--pgo=use` build — the counts a profiling run recorded.
+public sealed record CirPassContext(ProfileSettings Profile, OutputType OutputType, PgoProfile? Pgo = null);
+
+public sealed record CirPassTiming(string Pass, TimeSpan Elapsed);
@@ -0,0 +1,47 @@
+// Copyright (c) 2026.The Cloth contributors.
+//
+// CirPassManager.cs is part of the Cloth Compiler.
+//
+// Use, modification, and distribution of this file are governed by the
+// license terms provided with the Cloth Compiler source distribution.
+
+using System.Diagnostics;
+
+namespace Compiler.CIR.Passes;
+
+// Runs the CIR optimization pipeline between CIR generation and LLVM emission. Passes run
+// in registration order; each is skipped when the profile's `-O` level is below its
+// `MinOptLevel`, and the ones that run are timed individually into `Timings`.
+//
+// The default order matters: devirtualization turns virtual calls into direct calls the
+// inliner can see, inlining exposes literal returns to constant folding, folding turns
+// conditions into the literals dead-code elimination prunes on, array inlining and stack
+// promotion see only the calls that survived (devirtualized ones with exact callee
+// summaries), and dead-function elimination runs last so it sees the calls the earlier
+// passes removed. Field layout touches only class structs, never code, so it goes first.
+public sealed class CirPassManager(IReadOnlyList<CirPass> passes) {
+	public static CirPassManager Default() => new(new CirPass[] {
+		new FieldLayout(),
+		new Devirtualization(),
+		new Inlining(),
+		new ConstantFolding(),
+		new DeadCodeElimination(),
+		new BoundsCheckElimination(),
+		new InlineArrays(),
+		new StackPromotion(),
+		new DeadFunctionElimination()
+	});
+
+	public List<CirPassTiming> Timings { get; } = new();
+
+	public CirModule Run(CirModule module, CirPassContext context) {
+		foreach (var pass in passes) {
+			if (context.Profile.OptLevel < pass.MinOptLevel) continue;
+			var stopwatch = Stopwatch.StartNew();
+			module = pass.Run(module, context);
+			Timings.Add(new CirPassTiming(pass.Name, stopwatch.Elapsed));
+		}
+
+		return module;
+	}
+}
@@ -0,0 +1,245 @@
+// Copyright (c) 2026.The Cloth contributors.
+//
+// CirRewriter.cs is part of the Cloth Compiler.
+//
+// Use, modification, and distribution of this file are governed by the
+// license terms provided with the Cloth Compiler source distribution.
+
+namespace Compiler.CIR.Passes;
+
+// Bottom-up CIR tree rewriter. Passes override `Rewrite(CirExpr)` / `Rewrite(CirStmt)` for
+// the nodes they transform and call `RewriteChildren` to recurse into the rest. A node whose
+// children all come back unchanged is returned as-is (reference-equal), so a pass that
+// changes nothing allocates nothing and callers can detect "no change" with `ReferenceEquals`.
+// `RewriteInBlock` lets a pass replace one statement with zero or more in its enclosing list;
+// overriding `RewriteBlock` lets it edit the list as a whole.
+public abstract class CirRewriter {
+	public virtual CirExpr Rewrite(CirExpr expr) => RewriteChildren(expr);
+
+	public virtual CirStmt Rewrite(CirStmt stmt) => RewriteChildren(stmt);
+
+	protected virtual IEnumerable<CirStmt> RewriteInBlock(CirStmt stmt) {
+		yield return Rewrite(stmt);
+	}
+
+	public virtual List<CirStmt> RewriteBlock(List<CirStmt> block) {
+		List<CirStmt>? result = null;
+		for (var i = 0; i < block.Count; i++) {
+			var replaced = RewriteInBlock(block[i]).ToList();
+			if (result == null && replaced.Count == 1 && ReferenceEquals(replaced[0], block[i])) continue;
+			result ??= block.Take(i).ToList();
+			result.AddRange(replaced);
+		}
+
+		return result ?? block;
+	}
+
+	protected CirExpr RewriteChildren(CirExpr expr) {
+		switch (expr) {
+			case CirExpr.Binary b: {
+				var left = Rewrite(b.Left);
+				var right = Rewrite(b.Right);
+				return ReferenceEquals(left, b.Left) && ReferenceEquals(right, b.Right) ? b : b with { Left = left, Right = right };
+			}
+			case CirExpr.Unary u: {
+				var operand = Rewrite(u.Operand);
+				return ReferenceEquals(operand, u.Operand) ? u : u with { Operand = operand };
+			}
+			case CirExpr.FieldAccess fa: {
+				var target = Rewrite(fa.Target);
+				return ReferenceEquals(target, fa.Target) ? fa : fa with { Target = target };
+			}
+			case CirExpr.ArrayLit al: {
+				var elements = RewriteList(al.Elements);
+				return ReferenceEquals(elements, al.Elements) ? al : al with { Elements = elements };
+			}
+			case CirExpr.ArrayLength al: {
+				var target = Rewrite(al.Target);
+				return ReferenceEquals(target, al.Target) ? al : al with { Target = target };
+			}
+			case CirExpr.NewArray na: {
+				var sizes = RewriteList(na.Sizes);
+				return ReferenceEquals(sizes, na.Sizes) ? na : na with { Sizes = sizes };
+			}
+			case CirExpr.Subslice ss: {
+				var target = Rewrite(ss.Target);
+				var lo = Rewrite(ss.Lo);
+				var hi = Rewrite(ss.Hi);
+				return ReferenceEquals(target, ss.Target) && ReferenceEquals(lo, ss.Lo) && ReferenceEquals(hi, ss.Hi) ? ss : ss with { Target = target, Lo = lo, Hi = hi };
+			}
+			case CirExpr.Index ix: {
+				var target = Rewrite(ix.Target);
+				var idx = Rewrite(ix.Idx);
+				return ReferenceEquals(target, ix.Target) && ReferenceEquals(idx, ix.Idx) ? ix : ix with { Target = target, Idx = idx };
+			}
+			case CirExpr.Call c: {
+				var args = RewriteList(c.Args);
+				return ReferenceEquals(args, c.Args) ? c : c with { Args = args };
+			}
+			case CirExpr.IndirectCall ic: {
+				var callee = Rewrite(ic.Callee);
+				var args = RewriteList(ic.Args);
+				return ReferenceEquals(callee, ic.Callee) && ReferenceEquals(args, ic.Args) ? ic : ic with { Callee = callee, Args = args };
+			}
+			case CirExpr.VirtualCall vc: {
+				var receiver = Rewrite(vc.Receiver);
+				var args = RewriteList(vc.Args);
+				return ReferenceEquals(receiver, vc.Receiver) && ReferenceEquals(args, vc.Args) ? vc : vc with { Receiver = receiver, Args = args };
+			}
+			case CirExpr.Downcast dc: {
+				var receiver = Rewrite(dc.Receiver);
+				return ReferenceEquals(receiver, dc.Receiver) ? dc : dc with { Receiver = receiver };
+			}
+			case CirExpr.Alloc a: {
+				var args = RewriteList(a.Args);
+				return ReferenceEquals(args, a.Args) ? a : a with { Args = args };
+			}
+			case CirExpr.Cast c: {
+				var value = Rewrite(c.Value);
+				return ReferenceEquals(value, c.Value) ? c : c with { Value = value };
+			}
+			case CirExpr.TypeCheck tc: {
+				var value = Rewrite(tc.Value);
+				return ReferenceEquals(value, tc.Value) ? tc : tc with { Value = value };
+			}
+			case CirExpr.Ternary t: {
+				var cond = Rewrite(t.Condition);
+				var then = Rewrite(t.Then);
+				var @else = Rewrite(t.Else);
+				return ReferenceEquals(cond, t.Condition) && ReferenceEquals(then, t.Then) && ReferenceEquals(@else, t.Else) ? t : t with { Condition = cond, Then = then, Else = @else };
+			}
+			case CirExpr.NullCoalesce nc: {
+				var left = Rewrite(nc.Left);
+				var right = Rewrite(nc.Right);
+				return ReferenceEquals(left, nc.Left) && ReferenceEquals(right, nc.Right) ? nc : nc with { Left = left, Right = right };
+			}
+			case CirExpr.TupleLit tl: {
+				var elements = RewriteList(tl.Elements);
+				return ReferenceEquals(elements, tl.Elements) ? tl : tl with { Elements = elements };
+			}
+			case CirExpr.Range r: {
+				var start = Rewrite(r.Start);
+				var end = Rewrite(r.End);
+				return ReferenceEquals(start, r.Start) && ReferenceEquals(end, r.End) ? r : r with { Start = start, End = end };
+			}
+			default:
+				// Leaves: literals, locals, `this`, static / enum / vtable references.
+				return expr;
+		}
+	}
+
+	protected CirStmt RewriteChildren(CirStmt stmt) {
+		switch (stmt) {
+			case CirStmt.LocalDecl ld: {
+				var init = ld.Init == null ? null : Rewrite(ld.Init);
+				return ReferenceEquals(init, ld.Init) ? ld : ld with { Init = init };
+			}
+			case CirStmt.TupleDecl td: {
+				var init = Rewrite(td.Init);
+				return ReferenceEquals(init, td.Init) ? td : td with { Init = init };
+			}
+			case CirStmt.Assign a: {
+				var target = Rewrite(a.Target);
+				var value = Rewrite(a.Value);
+				return ReferenceEquals(target, a.Target) && ReferenceEquals(value, a.Value) ? a : a with { Target = target, Value = value };
+			}
+			case CirStmt.Expr e: {
+				var expression = Rewrite(e.Expression);
+				return ReferenceEquals(expression, e.Expression) ? e : e with { Expression = expression };
+			}
+			case CirStmt.Discard d: {
+				var expression = Rewrite(d.Expression);
+				return ReferenceEquals(expression, d.Expression) ? d : d with { Expression = expression };
+			}
+			case CirStmt.Return r: {
+				var value = r.Value == null ? null : Rewrite(r.Value);
+				return ReferenceEquals(value, r.Value) ? r : r with { Value = value };
+			}
+			case CirStmt.If i: {
+				var cond = Rewrite(i.Condition);
+				var then = RewriteBlock(i.Then);
+				var changed = !ReferenceEquals(cond, i.Condition) || !ReferenceEquals(then, i.Then);
+				var elseIfs = new List<(CirExpr Cond, List<CirStmt> Body)>(i.ElseIfs.Count);
+				foreach (var (c, b) in i.ElseIfs) {
+					var c2 = Rewrite(c);
+					var b2 = RewriteBlock(b);
+					changed |= !ReferenceEquals(c2, c) || !ReferenceEquals(b2, b);
+					elseIfs.Add((c2, b2));
+				}
+
+				var @else = i.Else == null ? null : RewriteBlock(i.Else);
+				changed |= !ReferenceEquals(@else, i.Else);
+				return changed ? new CirStmt.If(cond, then, elseIfs, @else) : i;
+			}
+			case CirStmt.While w: {
+				var cond = Rewrite(w.Condition);
+				var body = RewriteBlock(w.Body);
+				return ReferenceEquals(cond, w.Condition) && ReferenceEquals(body, w.Body) ? w : w with { Condition = cond, Body = body };
+			}
+			case CirStmt.DoWhile dw: {
+				var body = RewriteBlock(dw.Body);
+				var cond = Rewrite(dw.Condition);
+				return ReferenceEquals(body, dw.Body) && ReferenceEquals(cond, dw.Condition) ? dw : dw with { Body = body, Condition = cond };
+			}
+			case CirStmt.For f: {
+				var init = Rewrite(f.Init);
+				var cond = Rewrite(f.Condition);
+				var iter = Rewrite(f.Iterator);
+				var body = RewriteBlock(f.Body);
+				return ReferenceEquals(init, f.Init) && ReferenceEquals(cond, f.Condition) && ReferenceEquals(iter, f.Iterator) && ReferenceEquals(body, f.Body)
+					? f
+					: f with { Init = init, Condition = cond, Iterator = iter, Body = body };
+			}
+			case CirStmt.ForIn fi: {
+				var iterable = Rewrite(fi.Iterable);
+				var body = RewriteBlock(fi.Body);
+				return ReferenceEquals(iterable, fi.Iterable) && ReferenceEquals(body, fi.Body) ? fi : fi with { Iterable = iterable, Body = body };
+			}
+			case CirStmt.Switch sw: {
+				var subject = Rewrite(sw.Subject);
+				var changed = !ReferenceEquals(subject, sw.Subject);
+				var cases = new List<CirSwitchCase>(sw.Cases.Count);
+				foreach (var c in sw.Cases) {
+					var pattern = c.Pattern == null ? null : Rewrite(c.Pattern);
+					var body = RewriteBlock(c.Body);
+					var same = ReferenceEquals(pattern, c.Pattern) && ReferenceEquals(body, c.Body);
+					changed |= !same;
+					cases.Add(same ? c : new CirSwitchCase(pattern, body));
+				}
+
+				return changed ? new CirStmt.Switch(subject, cases) : sw;
+			}
+			case CirStmt.Throw t: {
+				var expression = Rewrite(t.Expression);
+				return ReferenceEquals(expression, t.Expression) ? t : t with { Expression = expression };
+			}
+			case CirStmt.Delete d: {
+				var expression = Rewrite(d.Expression);
+				return ReferenceEquals(expression, d.Expression) ? d : d with { Expression = expression };
+			}
+			case CirStmt.Block b: {
+				var body = RewriteBlock(b.Body);
+				return ReferenceEquals(body, b.Body) ? b : b with { Body = body };
+			}
+			case CirStmt.Join j: {
+				var tasks = RewriteList(j.Tasks);
+				return ReferenceEquals(tasks, j.Tasks) ? j : j with { Tasks = tasks };
+			}
+			default:
+				// `break` / `continue`.
+				return stmt;
+		}
+	}
+
+	private List<CirExpr> RewriteList(List<CirExpr> exprs) {
+		List<CirExpr>? result = null;
+		for (var i = 0; i < exprs.Count; i++) {
+			var rewritten = Rewrite(exprs[i]);
+			if (result == null && ReferenceEquals(rewritten, exprs[i])) continue;
+			result ??= exprs.Take(i).ToList();
+			result.Add(rewritten);
+		}
+
+		return result ?? exprs;
+	}
+}
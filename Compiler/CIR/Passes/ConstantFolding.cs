@@ -0,0 +1,233 @@
+// Copyright (c) 2026.The Cloth contributors.
+//
+// ConstantFolding.cs is part of the Cloth Compiler.
+//
+// Use, modification, and distribution of this file are governed by the
+// license terms provided with the Cloth Compiler source distribution.
+
+using System.Globalization;
+using Compiler.Semantics;
+
+namespace Compiler.CIR.Passes;
+
+// Evaluates operators whose operands are literals, and propagates locals bound once to a
+// constant into their reads.
+//
+// Integer folding reproduces the arithmetic the LLVM emitter would generate: a bare literal
+// is typed by its smallest signed fit, a binary operation runs at the wider operand's width
+// and wraps, and division, shifts and comparisons are signed. A folded value keeps that
+// width — a bare literal when its own fit matches, otherwise the literal cast to the width's
+// type — so the expression around it is lowered exactly as before. Operations LLVM leaves
+// undefined (division by zero, `MIN / -1`, oversized shifts), `^`, and float arithmetic are
+// left for run time.
+//
+// A local is propagated when its declaration is the only binding of that name in the
+// function, nothing assigns or increments it, and its initializer folds to an integer or
+// boolean constant. Its reads become the constant (at the declared type) and the
+// declaration is dropped.
+public sealed class ConstantFolding : CirPass {
+	public override string Name => "const-fold";
+
+	public override CirModule Run(CirModule module, CirPassContext context) => RewriteFunctions(module, fn => {
+		var folder = new Folder(PropagationCandidates(fn));
+		var body = folder.RewriteBlock(fn.Body);
+		if (folder.Propagated.Count == 0) return body;
+
+		var reads = new ReadScanner();
+		reads.RewriteBlock(body);
+		var dead = folder.Propagated.Where(name => !reads.Names.Contains(name)).ToHashSet();
+		return dead.Count == 0 ? body : new DeclRemover(dead).RewriteBlock(body);
+	});
+
+	private readonly record struct IntConst(long Value, int Bits, string Name, bool Typed);
+
+	private sealed class Folder(HashSet<string> candidates) : CirRewriter {
+		private readonly Dictionary<string, CirExpr> _constants = new();
+
+		public IReadOnlyCollection<string> Propagated => _constants.Keys;
+
+		public override CirExpr Rewrite(CirExpr expr) {
+			if (expr is CirExpr.Local l) return _constants.GetValueOrDefault(l.Name, expr);
+
+			var rewritten = RewriteChildren(expr);
+			var folded = Fold(rewritten);
+			return folded == null || folded.Equals(rewritten) ? rewritten : folded;
+		}
+
+		public override CirStmt Rewrite(CirStmt stmt) {
+			var rewritten = RewriteChildren(stmt);
+			if (rewritten is CirStmt.LocalDecl { Init: { } init } ld && candidates.Contains(ld.Name) && AsConstant(init, ld.Type) is { } constant)
+				_constants[ld.Name] = constant;
+			return rewritten;
+		}
+	}
+
+	private static CirExpr? Fold(CirExpr expr) => expr switch {
+		CirExpr.Binary b => FoldBinary(b),
+		CirExpr.Unary u => FoldUnary(u),
+		CirExpr.Cast c => FoldCast(c),
+		_ => null
+	};
+
+	private static CirExpr? FoldBinary(CirExpr.Binary b) {
+		if (b.Left is CirExpr.BoolLit lb && b.Right is CirExpr.BoolLit rb) {
+			return b.Op switch {
+				CirBinOp.And => new CirExpr.BoolLit(lb.Value && rb.Value),
+				CirBinOp.Or => new CirExpr.BoolLit(lb.Value || rb.Value),
+				CirBinOp.Eq => new CirExpr.BoolLit(lb.Value == rb.Value),
+				CirBinOp.NotEq => new CirExpr.BoolLit(lb.Value != rb.Value),
+				_ => null
+			};
+		}
+
+		if (!TryGetInt(b.Left, out var l) || !TryGetInt(b.Right, out var r)) return null;
+
+		bool? comparison = b.Op switch {
+			CirBinOp.Eq => l.Value == r.Value,
+			CirBinOp.NotEq => l.Value != r.Value,
+			CirBinOp.Lt => l.Value < r.Value,
+			CirBinOp.LtEq => l.Value <= r.Value,
+			CirBinOp.Gt => l.Value > r.Value,
+			CirBinOp.GtEq => l.Value >= r.Value,
+			_ => null
+		};
+		if (comparison is { } holds) return new CirExpr.BoolLit(holds);
+
+		// Both sides widen to the wider operand; on a tie a typed operand names the result.
+		var wide = r.Bits > l.Bits || (r.Bits == l.Bits && r.Typed && !l.Typed) ? r : l;
+		var bits = wide.Bits;
+		var divisible = r.Value != 0 && !(r.Value == -1 && l.Value == IntegerTypes.Wrap(1L << (bits - 1), bits));
+		long? value = b.Op switch {
+			CirBinOp.Add => unchecked(l.Value + r.Value),
+			CirBinOp.Sub => unchecked(l.Value - r.Value),
+			CirBinOp.Mul => unchecked(l.Value * r.Value),
+			CirBinOp.Div when divisible => l.Value / r.Value,
+			CirBinOp.Rem when divisible => l.Value % r.Value,
+			CirBinOp.BitAnd => l.Value & r.Value,
+			CirBinOp.BitOr => l.Value | r.Value,
+			CirBinOp.Shl when r.Value >= 0 && r.Value < bits => l.Value << (int)r.Value,
+			CirBinOp.Shr when r.Value >= 0 && r.Value < bits => l.Value >> (int)r.Value,
+			_ => null
+		};
+
+		return value is { } v ? Materialize(IntegerTypes.Wrap(v, bits), wide.Name) : null;
+	}
+
+	private static CirExpr? FoldUnary(CirExpr.Unary u) {
+		if (u.Op == CirUnOp.Not) return u.Operand is CirExpr.BoolLit b ? new CirExpr.BoolLit(!b.Value) : null;
+		if (u.Op is not (CirUnOp.Neg or CirUnOp.BitNot) || !TryGetInt(u.Operand, out var c)) return null;
+		return Materialize(IntegerTypes.Wrap(u.Op == CirUnOp.Neg ? unchecked(-c.Value) : ~c.Value, c.Bits), c.Name);
+	}
+
+	// A cast of a constant converts the way the emitter's cast would: truncated when the
+	// target is narrower, otherwise sign- or zero-extended by the target's signedness. A
+	// cast applied directly to a literal already is a constant and is left as written.
+	private static CirExpr? FoldCast(CirExpr.Cast c) {
+		if (c.TargetType is not CirType.Named { FullyQualifiedName: var name }) return null;
+		if (name == "bool") return c.Value as CirExpr.BoolLit;
+
+		var bits = IntegerTypes.Bits(name);
+		if (bits == 0 || c.Value is CirExpr.IntLit || !TryGetInt(c.Value, out var src)) return null;
+		var value = bits > src.Bits && !IntegerTypes.IsSigned(name) ? src.Value & ((1L << src.Bits) - 1) : src.Value;
+		return Materialize(IntegerTypes.Wrap(value, bits), name);
+	}
+
+	// The value a local of declared type `type` holds after `init` is stored into it, when
+	// that value is a constant.
+	private static CirExpr? AsConstant(CirExpr init, CirType? type) {
+		if (type is not CirType.Named { FullyQualifiedName: var name }) return null;
+		if (name == "bool") return init as CirExpr.BoolLit;
+
+		var bits = IntegerTypes.Bits(name);
+		return bits > 0 && TryGetInt(init, out var c) ? Materialize(IntegerTypes.Wrap(c.Value, bits), name) : null;
+	}
+
+	// Integer constants are a bare decimal literal (typed by its smallest fit) or a decimal
+	// literal cast to an integer type. Other literal spellings are left alone: the emitter
+	// writes literal text into the IR verbatim.
+	private static bool TryGetInt(CirExpr expr, out IntConst constant) {
+		constant = default;
+		switch (expr) {
+			case CirExpr.IntLit i when TryParseDecimal(i.Value, out var value): {
+				var fit = TypeInference.SmallestSignedFit(i.Value);
+				constant = new IntConst(value, IntegerTypes.Bits(fit), fit, false);
+				return true;
+			}
+			case CirExpr.Cast { Value: CirExpr.IntLit i, TargetType: CirType.Named t } when IntegerTypes.Bits(t.FullyQualifiedName) > 0 && TryParseDecimal(i.Value, out var value): {
+				var bits = IntegerTypes.Bits(t.FullyQualifiedName);
+				constant = new IntConst(IntegerTypes.Wrap(value, bits), bits, t.FullyQualifiedName, true);
+				return true;
+			}
+			default:
+				return false;
+		}
+	}
+
+	private static bool TryParseDecimal(string text, out long value) =>
+		long.TryParse(text, NumberStyles.AllowLeadingSign, CultureInfo.InvariantCulture, out value);
+
+	// `value` as a constant of integer type `name`.
+	private static CirExpr Materialize(long value, string name) {
+		var literal = new CirExpr.IntLit(value.ToString(CultureInfo.InvariantCulture));
+		return TypeInference.SmallestSignedFit(literal.Value) == name ? literal : new CirExpr.Cast(literal, new CirType.Named(name), false);
+	}
+
+	private static HashSet<string> PropagationCandidates(CirFunction fn) {
+		var scanner = new BindingScanner();
+		foreach (var p in fn.Parameters) scanner.Bind(p.Name);
+		scanner.RewriteBlock(fn.Body);
+		return scanner.Declared.Where(name => scanner.Bindings[name] == 1 && !scanner.Written.Contains(name)).ToHashSet();
+	}
+
+	// Read-only walk counting how often each local name is bound and recording which names
+	// are assigned or incremented.
+	private sealed class BindingScanner : CirRewriter {
+		public readonly Dictionary<string, int> Bindings = new();
+		public readonly HashSet<string> Declared = new();
+		public readonly HashSet<string> Written = new();
+
+		public void Bind(string name) => Bindings[name] = Bindings.GetValueOrDefault(name) + 1;
+
+		public override CirStmt Rewrite(CirStmt stmt) {
+			switch (stmt) {
+				case CirStmt.LocalDecl ld:
+					Bind(ld.Name);
+					Declared.Add(ld.Name);
+					break;
+				case CirStmt.TupleDecl td:
+					foreach (var (_, name) in td.Bindings) Bind(name);
+					break;
+				case CirStmt.ForIn fi:
+					Bind(fi.ElementName);
+					break;
+				case CirStmt.Assign { Target: CirExpr.Local l }:
+					Written.Add(l.Name);
+					break;
+			}
+
+			return RewriteChildren(stmt);
+		}
+
+		public override CirExpr Rewrite(CirExpr expr) {
+			if (expr is CirExpr.Unary { Op: CirUnOp.PreInc or CirUnOp.PreDec or CirUnOp.PostInc or CirUnOp.PostDec, Operand: CirExpr.Local l })
+				Written.Add(l.Name);
+			return RewriteChildren(expr);
+		}
+	}
+
+	private sealed class ReadScanner : CirRewriter {
+		public readonly HashSet<string> Names = new();
+
+		public override CirExpr Rewrite(CirExpr expr) {
+			if (expr is CirExpr.Local l) Names.Add(l.Name);
+			return RewriteChildren(expr);
+		}
+	}
+
+	private sealed class DeclRemover(HashSet<string> names) : CirRewriter {
+		protected override IEnumerable<CirStmt> RewriteInBlock(CirStmt stmt) {
+			if (stmt is CirStmt.LocalDecl ld && names.Contains(ld.Name)) yield break;
+			yield return Rewrite(stmt);
+		}
+	}
+}
@@ -0,0 +1,65 @@
+// Copyright (c) 2026.The Cloth contributors.
+//
+// DeadCodeElimination.cs is part of the Cloth Compiler.
+//
+// Use, modification, and distribution of this file are governed by the
+// license terms provided with the Cloth Compiler source distribution.
+
+namespace Compiler.CIR.Passes;
+
+// Removes code that can never run: the arms of an `if` / `else if` chain and of a ternary
+// whose condition is a literal (usually one `ConstantFolding` produced), `while (false)`
+// loops, and the statements following a `return`, `break`, `continue` or `throw` in the
+// same block. A taken arm's statements are spliced into the enclosing block — the emitter
+// gives blocks no scope of their own, so this doesn't change what any name refers to.
+public sealed class DeadCodeElimination : CirPass {
+	public override string Name => "dce";
+
+	public override CirModule Run(CirModule module, CirPassContext context) =>
+		RewriteFunctions(module, fn => new Pruner().RewriteBlock(fn.Body));
+
+	private sealed class Pruner : CirRewriter {
+		public override CirExpr Rewrite(CirExpr expr) {
+			var rewritten = RewriteChildren(expr);
+			return rewritten is CirExpr.Ternary { Condition: CirExpr.BoolLit c } t ? c.Value ? t.Then : t.Else : rewritten;
+		}
+
+		public override List<CirStmt> RewriteBlock(List<CirStmt> block) {
+			var body = base.RewriteBlock(block);
+			var end = body.FindIndex(s => s is CirStmt.Return or CirStmt.Break or CirStmt.Continue or CirStmt.Throw);
+			return end < 0 || end == body.Count - 1 ? body : body.Take(end + 1).ToList();
+		}
+
+		protected override IEnumerable<CirStmt> RewriteInBlock(CirStmt stmt) {
+			var rewritten = Rewrite(stmt);
+			return rewritten switch {
+				CirStmt.If i => Prune(i),
+				CirStmt.While { Condition: CirExpr.BoolLit { Value: false } } => [],
+				_ => [rewritten]
+			};
+		}
+
+		// Drop the arms whose condition is `false`; the first arm whose condition is `true`
+		// becomes the `else` (or, when no arm precedes it, replaces the whole statement).
+		private static IEnumerable<CirStmt> Prune(CirStmt.If i) {
+			var arms = new List<(CirExpr Cond, List<CirStmt> Body)> { (i.Condition, i.Then) };
+			arms.AddRange(i.ElseIfs);
+			if (!arms.Any(a => a.Cond is CirExpr.BoolLit)) return [i];
+
+			var live = new List<(CirExpr Cond, List<CirStmt> Body)>();
+			var @else = i.Else;
+			foreach (var arm in arms) {
+				if (arm.Cond is CirExpr.BoolLit { Value: false }) continue;
+				if (arm.Cond is CirExpr.BoolLit { Value: true }) {
+					@else = arm.Body;
+					break;
+				}
+
+				live.Add(arm);
+			}
+
+			if (live.Count == 0) return @else ?? [];
+			return [new CirStmt.If(live[0].Cond, live[0].Body, live.Skip(1).ToList(), @else)];
+		}
+	}
+}
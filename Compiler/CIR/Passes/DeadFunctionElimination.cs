@@ -0,0 +1,88 @@
+// Copyright (c) 2026.The Cloth contributors.
+//
+// DeadFunctionElimination.cs is part of the Cloth Compiler.
+//
+// Use, modification, and distribution of this file are governed by the
+// license terms provided with the Cloth Compiler source distribution.
+
+using Compiler.Configs;
+
+namespace Compiler.CIR.Passes;
+
+// Drops methods, static methods and fragments that nothing can call. Only an executable is
+// a whole program; a library's functions are called from other projects, so libraries are
+// left untouched.
+//
+// The roots are every function reached without a CIR call — constructors (the entry point
+// and every `new`), destructors, the synthesized enum helpers, `@Extern` declarations and
+// `@Bench` methods (called by a `cloth bench` driver) — plus every vtable slot and anything
+// static-field, field or enum-case initializers call.
+// Whatever a kept function calls or allocates is kept in turn.
+public sealed class DeadFunctionElimination : CirPass {
+	public override string Name => "dead-fn-elim";
+
+	public override CirModule Run(CirModule module, CirPassContext context) {
+		if (context.OutputType != OutputType.Executable) return module;
+
+		var refs = new ReferenceScanner();
+		var pending = new Stack<CirFunction>();
+		void Reach(string mangledName) {
+			if (refs.Reached.Add(mangledName) && module.FindFunction(mangledName) is { } fn) pending.Push(fn);
+		}
+
+		foreach (var fn in module.Functions.Where(IsRoot)) Reach(fn.MangledName);
+		foreach (var slot in module.Vtables.SelectMany(v => v.Slots).OfType<string>()) Reach(slot);
+		foreach (var sf in module.StaticFields)
+			if (sf.Initializer != null) refs.Rewrite(sf.Initializer);
+		foreach (var type in module.Types) {
+			switch (type) {
+				case CirTypeDecl.Class c:
+					foreach (var f in c.Fields)
+						if (f.Initializer != null) refs.Rewrite(f.Initializer);
+					break;
+				case CirTypeDecl.Enum e:
+					foreach (var arg in e.Cases.SelectMany(ec => ec.ConstructorArgs)) refs.Rewrite(arg);
+					break;
+			}
+		}
+
+		do {
+			foreach (var name in refs.TakeFound()) Reach(name);
+			while (pending.Count > 0) refs.RewriteBlock(pending.Pop().Body);
+		} while (refs.HasFound);
+
+		var kept = module.Functions.Where(fn => refs.Reached.Contains(fn.MangledName)).ToList();
+		return kept.Count == module.Functions.Count ? module : module with { Functions = kept };
+	}
+
+	private static bool IsRoot(CirFunction fn) =>
+		fn.IsExtern || fn.IsBench || fn.Kind is not (CirFunctionKind.Method or CirFunctionKind.StaticMethod or CirFunctionKind.Fragment);
+
+	// Read-only walk collecting the functions that calls and allocations name.
+	private sealed class ReferenceScanner : CirRewriter {
+		private List<string> _found = new();
+
+		public readonly HashSet<string> Reached = new();
+
+		public bool HasFound => _found.Count > 0;
+
+		public List<string> TakeFound() {
+			var found = _found;
+			_found = new List<string>();
+			return found;
+		}
+
+		public override CirExpr Rewrite(CirExpr expr) {
+			switch (expr) {
+				case CirExpr.Call c when !Reached.Contains(c.MangledName):
+					_found.Add(c.MangledName);
+					break;
+				case CirExpr.Alloc a when !Reached.Contains(a.CtorMangledName):
+					_found.Add(a.CtorMangledName);
+					break;
+			}
+
+			return RewriteChildren(expr);
+		}
+	}
+}
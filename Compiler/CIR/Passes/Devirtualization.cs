@@ -0,0 +1,140 @@
+// Copyright (c) 2026.The Cloth contributors.
+//
+// Devirtualization.cs is part of the Cloth Compiler.
+//
+// Use, modification, and distribution of this file are governed by the
+// license terms provided with the Cloth Compiler source distribution.
+
+using Compiler.Configs;
+using Compiler.Pgo;
+
+namespace Compiler.CIR.Passes;
+
+// Class-hierarchy analysis over the module's vtables: turns virtual calls whose slot has
+// one possible target into direct calls, and slots with two targets into a class test
+// guarding two direct calls. Only an executable sees every class that can exist at run
+// time, so libraries keep their virtual calls.
+//
+// A slot's possible targets are the distinct functions any vtable holds for it. That is a
+// superset of what the receiver's static type allows — every class that can reach the call
+// implements the slot's interface or prototype method — so a single target is exact. For
+// two targets `A` and `B`, the guard is `receiver is K` where `K` is a class every
+// `A`-holding vtable descends from and no `B`-holding one does; when neither target has
+// such a class the call stays virtual. The receiver is evaluated by the guard and again
+// by the call, so bimorphic sites also need a receiver without side effects.
+//
+// Targets must be defined in this module with a `this` parameter: cross-project methods
+// have no signature here to call directly.
+//
+// With a profile (`--pgo=use`), a slot the hierarchy can't resolve gets a guard for its
+// hot target instead — the one whose function took at least `HotShare` of the entries
+// recorded across the slot's targets — when some class separates that target's holders
+// from the rest. The call stays virtual behind the guard. Entry counts are per function,
+// not per call site, so this follows the program's overall mix. Only value-returning calls
+// get one: a void call would need an `if`, which would shift the function's PGO counter
+// layout away from the one the profile was recorded against.
+public sealed class Devirtualization : CirPass {
+	private const double HotShare = 0.75;
+
+	public override string Name => "devirtualize";
+
+	public override CirModule Run(CirModule module, CirPassContext context) {
+		if (context.OutputType != OutputType.Executable) return module;
+
+		var hierarchy = new Hierarchy(module, context.Pgo);
+		return RewriteFunctions(module, fn => new CallRewriter(hierarchy).RewriteBlock(fn.Body));
+	}
+
+	private sealed class Hierarchy(CirModule module, PgoProfile? profile) {
+		private readonly Dictionary<int, Dispatch?> _dispatch = new();
+
+		public Dispatch? For(int slot) {
+			if (_dispatch.TryGetValue(slot, out var cached)) return cached;
+			return _dispatch[slot] = Resolve(slot);
+		}
+
+		private Dispatch? Resolve(int slot) {
+			var holders = module.Vtables
+				.Where(v => slot < v.Slots.Count && v.Slots[slot] != null)
+				.GroupBy(v => v.Slots[slot]!)
+				.ToList();
+			if (holders.Count == 0) return null;
+			if (holders.Count <= 2 && holders.All(g => IsDirectlyCallable(g.Key))) {
+				if (holders.Count == 1) return new Dispatch(holders[0].Key, null, null);
+
+				foreach (var (guarded, other) in new[] { (holders[0], holders[1]), (holders[1], holders[0]) }) {
+					if (GuardClass(guarded, other) is { } root)
+						return new Dispatch(guarded.Key, root, other.Key);
+				}
+			}
+
+			return HotGuard(holders);
+		}
+
+		private Dispatch? HotGuard(List<IGrouping<string, CirVtable>> holders) {
+			if (profile == null) return null;
+			var counts = holders.Select(g => profile.EntryCount(g.Key)).ToList();
+			var hot = counts.IndexOf(counts.Max());
+			var total = counts.Sum();
+			if (total == 0 || counts[hot] < HotShare * total || !IsDirectlyCallable(holders[hot].Key)) return null;
+
+			var others = holders.Where((_, i) => i != hot).SelectMany(g => g).ToList();
+			return GuardClass(holders[hot], others) is { } root ? new Dispatch(holders[hot].Key, root, null) : null;
+		}
+
+		// A class every `guarded` vtable descends from and no `other` one does.
+		private string? GuardClass(IEnumerable<CirVtable> guarded, IEnumerable<CirVtable> other) {
+			var root = guarded.FirstOrDefault(candidate => guarded.All(v => DescendsFrom(v.ClassFqn, candidate.ClassFqn)));
+			return root != null && !other.Any(v => DescendsFrom(v.ClassFqn, root.ClassFqn)) ? root.ClassFqn : null;
+		}
+
+		private bool IsDirectlyCallable(string mangledName) =>
+			module.FindFunction(mangledName) is { IsExtern: false, IsStatic: false, Parameters: [{ Name: "this" }, ..] };
+
+		private bool DescendsFrom(string classFqn, string ancestorFqn) {
+			var visited = new HashSet<string>();
+			for (var cursor = classFqn; cursor != null && visited.Add(cursor); cursor = module.VtablesByFqn.GetValueOrDefault(cursor)?.ParentClassFqn)
+				if (cursor == ancestorFqn) return true;
+			return false;
+		}
+	}
+
+	// `Target` alone for a monomorphic slot; otherwise `Target` when the receiver is a
+	// `GuardClass` and `Fallback` when it isn't — the virtual call itself when null.
+	private sealed record Dispatch(string Target, string? GuardClass, string? Fallback);
+
+	private sealed class CallRewriter(Hierarchy hierarchy) : CirRewriter {
+		public override CirExpr Rewrite(CirExpr expr) {
+			var rewritten = RewriteChildren(expr);
+			if (rewritten is not CirExpr.VirtualCall vc || hierarchy.For(vc.SlotId) is not { } dispatch) return rewritten;
+			if (dispatch.GuardClass == null) return DirectCall(dispatch.Target, vc);
+			if (vc.ReturnType is CirType.Void || !IsPure(vc.Receiver)) return rewritten;
+			return new CirExpr.Ternary(Guard(dispatch, vc), DirectCall(dispatch.Target, vc), dispatch.Fallback is { } fallback ? DirectCall(fallback, vc) : vc);
+		}
+
+		// A void bimorphic call can't be a ternary operand, so as a statement it becomes an `if`.
+		protected override IEnumerable<CirStmt> RewriteInBlock(CirStmt stmt) {
+			if (stmt is CirStmt.Expr { Expression: CirExpr.VirtualCall { ReturnType: CirType.Void } call }) {
+				var vc = (CirExpr.VirtualCall)RewriteChildren(call);
+				if (hierarchy.For(vc.SlotId) is { GuardClass: not null, Fallback: not null } dispatch && IsPure(vc.Receiver)) {
+					yield return new CirStmt.If(Guard(dispatch, vc), [new CirStmt.Expr(DirectCall(dispatch.Target, vc))], [], [new CirStmt.Expr(DirectCall(dispatch.Fallback!, vc))]);
+					yield break;
+				}
+			}
+
+			yield return Rewrite(stmt);
+		}
+
+		private static CirExpr Guard(Dispatch dispatch, CirExpr.VirtualCall vc) =>
+			new CirExpr.TypeCheck(vc.Receiver, new CirType.Named(dispatch.GuardClass!));
+
+		private static CirExpr.Call DirectCall(string target, CirExpr.VirtualCall vc) =>
+			new(target, [vc.Receiver, ..vc.Args]);
+
+		private static bool IsPure(CirExpr expr) => expr switch {
+			CirExpr.Local or CirExpr.ThisPtr => true,
+			CirExpr.FieldAccess fa => IsPure(fa.Target),
+			_ => false
+		};
+	}
+}
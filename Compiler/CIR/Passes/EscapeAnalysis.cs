@@ -0,0 +1,177 @@
+// Copyright (c) 2026.The Cloth contributors.
+//
+// EscapeAnalysis.cs is part of the Cloth Compiler.
+//
+// Use, modification, and distribution of this file are governed by the
+// license terms provided with the Cloth Compiler source distribution.
+
+namespace Compiler.CIR.Passes;
+
+// Which parameters of the module's functions may let their argument outlive the call,
+// shared by the passes that place objects somewhere other than the heap (`StackPromotion`,
+// `InlineArrays`). A parameter escapes under the `UseScanner` rules applied to its own
+// function, iterated to a least fixpoint over the call graph so recursion settles: start
+// from "nothing escapes" and add parameters until stable.
+//
+// Calls into other projects or `@Extern` code escape everything. A virtual call is checked
+// against every function its slot can dispatch to, which is only the whole set in an
+// executable — in a library a subclass elsewhere may override it, so virtual-call
+// arguments escape there.
+internal sealed class EscapeSummaries {
+	private readonly CirModule _module;
+	private readonly bool _wholeProgram;
+	private readonly HashSet<(string Fn, int Index)> _escaping = new();
+
+	// Slot → the distinct functions a virtual call through it can reach, gathered from the
+	// vtables once rather than per call site.
+	private readonly string[][] _slotTargets;
+
+	public EscapeSummaries(CirModule module, bool wholeProgram) {
+		_module = module;
+		_wholeProgram = wholeProgram;
+
+		var slotCount = module.Vtables.Count == 0 ? 0 : module.Vtables.Max(v => v.Slots.Count);
+		_slotTargets = Enumerable.Range(0, slotCount)
+			.Select(slot => module.Vtables.Where(v => slot < v.Slots.Count).Select(v => v.Slots[slot]).OfType<string>().Distinct().ToArray())
+			.ToArray();
+
+		var pending = module.Functions.Where(fn => !fn.IsExtern)
+			.SelectMany(fn => fn.Parameters.Select((_, i) => (Fn: fn, Index: i)))
+			.ToList();
+		bool changed;
+		do {
+			changed = false;
+			foreach (var (fn, index) in pending) {
+				if (_escaping.Contains((fn.MangledName, index))) continue;
+				var scanner = new UseScanner(this, fn.Parameters[index].Name, isParameter: true);
+				scanner.RewriteBlock(fn.Body);
+				if (!scanner.Escaped) continue;
+				_escaping.Add((fn.MangledName, index));
+				changed = true;
+			}
+		} while (changed);
+	}
+
+	public bool ParamEscapes(string mangledName, int index) =>
+		_module.FindFunction(mangledName) is not { IsExtern: false } fn || index >= fn.Parameters.Count || _escaping.Contains((mangledName, index));
+
+	public bool VirtualParamEscapes(int slot, int index) {
+		if (!_wholeProgram || slot >= _slotTargets.Length) return true;
+		var targets = _slotTargets[slot];
+		return targets.Length == 0 || targets.Any(t => ParamEscapes(t, index));
+	}
+}
+
+// Walks a body looking for a use of a tracked pointer — local `name`, or `this` for the
+// `this` parameter — that could copy it out. The uses that can't are a field read or write
+// through it, an `is` test, a `==` / `!=` comparison, `delete` of a local, and passing it
+// to a parameter that doesn't escape in its callee. Anything else (a return, a store, an
+// alias `let y = x`, a cast, an argument to an unknown callee) is an escape, and so is
+// reassigning it. Subclasses widen what counts as tracked. Read-only: every override
+// returns its input.
+internal class UseScanner(EscapeSummaries summaries, string name, bool isParameter) : CirRewriter {
+	public bool Escaped { get; protected set; }
+
+	protected virtual bool IsTracked(CirExpr expr) => expr switch {
+		CirExpr.Local l => l.Name == name,
+		CirExpr.ThisPtr => name == "this",
+		_ => false
+	};
+
+	// Whether `x == null` / `x != null` on a tracked value is a harmless use.
+	protected virtual bool AllowsComparison => true;
+
+	// Visit the parts of an accepted tracked use that are themselves evaluated.
+	protected virtual void ScanTracked(CirExpr expr) { }
+
+	public override CirExpr Rewrite(CirExpr expr) {
+		if (Escaped) return expr;
+		switch (expr) {
+			case var _ when IsTracked(expr):
+				Escaped = true;
+				return expr;
+			case CirExpr.FieldAccess fa when IsTracked(fa.Target):
+				ScanTracked(fa.Target);
+				return expr;
+			case CirExpr.TypeCheck tc when IsTracked(tc.Value):
+				ScanTracked(tc.Value);
+				return expr;
+			case CirExpr.Binary { Op: CirBinOp.Eq or CirBinOp.NotEq } b when AllowsComparison && (IsTracked(b.Left) || IsTracked(b.Right)):
+				ScanOperand(b.Left);
+				ScanOperand(b.Right);
+				return expr;
+			case CirExpr.Call c:
+				ScanArgs(c.Args, 0, i => summaries.ParamEscapes(c.MangledName, i));
+				return expr;
+			case CirExpr.Alloc a:
+				ScanArgs(a.Args, 1, i => summaries.ParamEscapes(a.CtorMangledName, i));
+				return expr;
+			case CirExpr.VirtualCall vc:
+				ScanArgs([vc.Receiver, ..vc.Args], 0, i => summaries.VirtualParamEscapes(vc.SlotId, i));
+				return expr;
+			default:
+				return RewriteChildren(expr);
+		}
+	}
+
+	public override CirStmt Rewrite(CirStmt stmt) {
+		if (Escaped) return stmt;
+		switch (stmt) {
+			// A callee deleting its parameter takes the object's storage with it.
+			case CirStmt.Delete { Expression: CirExpr.Local or CirExpr.ThisPtr } d when IsTracked(d.Expression):
+				Escaped |= isParameter;
+				return stmt;
+			case CirStmt.Assign { Target: var t } when IsTracked(t):
+			case CirStmt.LocalDecl ld when isParameter && ld.Name == name:
+				Escaped = true;
+				return stmt;
+			default:
+				return RewriteChildren(stmt);
+		}
+	}
+
+	private void ScanOperand(CirExpr operand) {
+		if (IsTracked(operand)) ScanTracked(operand);
+		else Rewrite(operand);
+	}
+
+	// Argument `i` of a call goes to callee parameter `offset + i`.
+	protected void ScanArgs(List<CirExpr> args, int offset, Func<int, bool> paramEscapes) {
+		for (var i = 0; i < args.Count && !Escaped; i++) {
+			if (!IsTracked(args[i])) Rewrite(args[i]);
+			else if (paramEscapes(offset + i)) Escaped = true;
+			else ScanTracked(args[i]);
+		}
+	}
+}
+
+// Every name a function body binds (locals, tuple bindings, for-in elements) with how often,
+// and the initializer of each `let`.
+internal sealed class DeclCounter : CirRewriter {
+	private readonly Dictionary<string, int> _counts = new();
+
+	public readonly Dictionary<string, CirExpr> Inits = new();
+
+	// Bound exactly once in `fn`'s body and not shadowing one of its parameters.
+	public bool IsUnique(string name, CirFunction fn) =>
+		_counts.GetValueOrDefault(name) == 1 && fn.Parameters.All(p => p.Name != name);
+
+	public override CirStmt Rewrite(CirStmt stmt) {
+		switch (stmt) {
+			case CirStmt.LocalDecl ld:
+				Count(ld.Name);
+				if (ld.Init != null) Inits[ld.Name] = ld.Init;
+				break;
+			case CirStmt.TupleDecl td:
+				foreach (var (_, name) in td.Bindings) Count(name);
+				break;
+			case CirStmt.ForIn fi:
+				Count(fi.ElementName);
+				break;
+		}
+
+		return RewriteChildren(stmt);
+	}
+
+	private void Count(string name) => _counts[name] = _counts.GetValueOrDefault(name) + 1;
+}
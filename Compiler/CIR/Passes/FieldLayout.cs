@@ -0,0 +1,97 @@
+// Copyright (c) 2026.The Cloth contributors.
+//
+// FieldLayout.cs is part of the Cloth Compiler.
+//
+// Use, modification, and distribution of this file are governed by the
+// license terms provided with the Cloth Compiler source distribution.
+
+using Compiler.Semantics;
+
+namespace Compiler.CIR.Passes;
+
+// Reorders the own fields of each compact class — `@Compact`, or every class in a
+// `fieldLayout = "compact"` build — so mixed `bool` / `i32` / `i64` / slice fields pack
+// without the padding declaration order leaves between them.
+//
+// Only a class's own contribution moves. Its ancestors' fields stay a prefix of its struct,
+// so upcasts and the vtable-walk casts still find every inherited field where the ancestor
+// put it, and the `__vtable__` header and an inner class's `__outer__` keep their leading
+// slots. From the ancestors' end offset, each step takes the most-aligned field that fits
+// without padding, falling back to the least-aligned one when nothing does: a parent that
+// ends on a `bool` has its tail filled by the child's small fields before the wide ones
+// start. Ties keep declaration order. Field accesses are resolved by name against the
+// flattened layout, and the destructor's field order was fixed at lowering, so the struct
+// type is all that changes.
+//
+// Layout is opted into, not an optimization, so the pass runs at `-O0` too: a debug and a
+// release build of the same sources lay a `@Compact` class out alike.
+public sealed class FieldLayout : CirPass {
+	public override string Name => "field-layout";
+
+	public override int MinOptLevel => 0;
+
+	public override CirModule Run(CirModule module, CirPassContext context) {
+		var classes = module.ClassesByFqn;
+		if (!context.Profile.CompactLayout && !classes.Values.Any(c => c.IsCompact)) return module;
+
+		// Ancestors are laid out first, since each child packs against its parent's end.
+		var laidOut = new Dictionary<string, CirTypeDecl.Class>();
+		CirTypeDecl.Class LayOut(CirTypeDecl.Class cls) {
+			if (laidOut.TryGetValue(cls.FullyQualifiedName, out var done)) return done;
+			laidOut[cls.FullyQualifiedName] = cls; // a BaseClass ring stops here
+			if (cls.BaseClass != null && classes.TryGetValue(cls.BaseClass, out var parent)) LayOut(parent);
+
+			if (cls.IsCompact || context.Profile.CompactLayout) {
+				var inherited = cls.BaseClass == null ? new List<CirField>() : CirLayout.Flatten(laidOut, cls.BaseClass);
+				var start = inherited.Count == 0 ? 0 : CirLayout.Of(inherited.Select(f => f.Type).ToList()).End;
+				cls = cls with { Fields = Pack(cls.Fields, start, inherits: inherited.Count > 0), IsCompact = true };
+			}
+
+			return laidOut[cls.FullyQualifiedName] = cls;
+		}
+
+		var types = module.Types.Select(t => t is CirTypeDecl.Class c ? LayOut(c) : t).ToList();
+		return module with { Types = types };
+	}
+
+	// `fields` reordered to start at `offset`. A class that `inherits` shares the root's
+	// vtable slot, so its own `__vtable__` takes no space after the ancestors' fields.
+	private static List<CirField> Pack(List<CirField> fields, long offset, bool inherits) {
+		var result = fields.Where(IsHeader).ToList();
+		foreach (var header in result)
+			if (!inherits || header.Name != SymbolRegistry.VtableFieldName)
+				offset = Place(offset, header);
+
+		var remaining = fields.Where(f => !IsHeader(f)).ToList();
+		while (remaining.Count > 0) {
+			CirField? next = null;
+			foreach (var f in remaining) {
+				var (size, align) = CirLayout.SizeOf(f.Type);
+				if (offset % align != 0) continue;
+				if (next == null) {
+					next = f;
+					continue;
+				}
+
+				var best = CirLayout.SizeOf(next.Type);
+				if (align > best.Align || (align == best.Align && size > best.Size)) next = f;
+			}
+
+			next ??= remaining.MinBy(f => CirLayout.SizeOf(f.Type).Align)!;
+			remaining.Remove(next);
+			result.Add(next);
+			offset = Place(offset, next);
+		}
+
+		return result;
+	}
+
+	// The offset just past `field` laid out at the first slot from `offset` it aligns to.
+	private static long Place(long offset, CirField field) {
+		var (size, align) = CirLayout.SizeOf(field.Type);
+		return CirLayout.AlignUp(offset, align) + size;
+	}
+
+	private static bool IsHeader(CirField f) =>
+		f.Name is SymbolRegistry.VtableFieldName or SymbolRegistry.InnerOuterFieldName;
+}
@@ -0,0 +1,154 @@
+// Copyright (c) 2026.The Cloth contributors.
+//
+// InlineArrays.cs is part of the Cloth Compiler.
+//
+// Use, modification, and distribution of this file are governed by the
+// license terms provided with the Cloth Compiler source distribution.
+
+using Compiler.Configs;
+
+namespace Compiler.CIR.Passes;
+
+// Stores the elements of `let xs = new C[n]` inline — one buffer of `n` `C` instances rather
+// than `n` pointers to separately allocated ones — when no program can tell the difference.
+// The local's type and the `NewArray` become `Inline`; the emitter lays the buffer out as
+// consecutive structs, constructs `xs[i] = new C(...)` in place, hands out element addresses
+// for `xs[i]` and for-in bindings, and on `delete xs` runs the destructors in one pass over
+// the buffer before freeing it once. When `C` has a destructor each slot also carries a
+// constructed flag, so slots never assigned aren't destroyed — as a null pointer wasn't.
+//
+// `C` must be a concrete class nothing extends, so every element is exactly a `C`; only an
+// executable sees every subclass, so libraries keep pointer arrays. `xs` must be declared
+// once and never reassigned, and may only be indexed, measured (`::LENGTH`), iterated
+// (directly or through a sub-slice) and deleted. Element values — `xs[i]` and for-in
+// bindings — follow `UseScanner`'s rules, minus null comparisons: they can't be bound to
+// another local, stored, returned or deleted, so no pointer to an element outlives the
+// array or sees a slot rebuilt under it. A slot may be (re)built only by `xs[i] = new C(...)`
+// outside any loop over `xs`, with constructor arguments that don't read `xs`.
+public sealed class InlineArrays : CirPass {
+	public override string Name => "inline-arrays";
+
+	public override CirModule Run(CirModule module, CirPassContext context) {
+		if (context.OutputType != OutputType.Executable) return module;
+
+		var extended = module.ClassesByFqn.Values.Select(c => c.BaseClass).OfType<string>().ToHashSet();
+		var summaries = new EscapeSummaries(module, wholeProgram: true);
+		return RewriteFunctions(module, fn => {
+			var decls = new DeclCounter();
+			decls.RewriteBlock(fn.Body);
+			var inlined = new HashSet<string>();
+			foreach (var (name, init) in decls.Inits) {
+				if (init is not CirExpr.NewArray { ElementType: CirType.Named element, Sizes.Count: 1, Inline: false } || !decls.IsUnique(name, fn)) continue;
+				if (!module.ClassesByFqn.TryGetValue(element.FullyQualifiedName, out var cls) || cls.IsPrototype || extended.Contains(cls.FullyQualifiedName)) continue;
+				// `delete xs` hands each element to the destructor, which mustn't keep it.
+				var dtor = module.FindFunction($"{cls.FullyQualifiedName}.~{cls.FullyQualifiedName[(cls.FullyQualifiedName.LastIndexOf('.') + 1)..]}");
+				if (dtor != null && summaries.ParamEscapes(dtor.MangledName, 0)) continue;
+
+				var scanner = new ArrayUseScanner(summaries, name, element, binding => decls.IsUnique(binding, fn));
+				scanner.RewriteBlock(fn.Body);
+				if (!scanner.Escaped) inlined.Add(name);
+			}
+
+			return inlined.Count == 0 ? fn.Body : new Inliner(inlined).RewriteBlock(fn.Body);
+		});
+	}
+
+	private sealed class Inliner(HashSet<string> inlined) : CirRewriter {
+		public override CirStmt Rewrite(CirStmt stmt) =>
+			stmt is CirStmt.LocalDecl { Init: CirExpr.NewArray na } ld && inlined.Contains(ld.Name)
+				? ld with { Type = new CirType.Array(na.ElementType, Inline: true), Init = na with { Inline = true } }
+				: RewriteChildren(stmt);
+	}
+
+	// Tracks the element values of array `array`: `array[i]` and the bindings of for-in loops
+	// over it. A bare use of `array` outside the allowed shapes is an escape.
+	private sealed class ArrayUseScanner(EscapeSummaries summaries, string array, CirType.Named element, Func<string, bool> isUniqueBinding)
+		: UseScanner(summaries, array, isParameter: false) {
+		private readonly EscapeSummaries _summaries = summaries;
+		private readonly HashSet<string> _bindings = new();
+		private int _loopDepth;
+
+		protected override bool IsTracked(CirExpr expr) => expr switch {
+			CirExpr.Index { Target: CirExpr.Local l } => l.Name == array,
+			CirExpr.Local l => _bindings.Contains(l.Name),
+			_ => false
+		};
+
+		protected override bool AllowsComparison => false;
+
+		protected override void ScanTracked(CirExpr expr) {
+			if (expr is CirExpr.Index ix) Rewrite(ix.Idx);
+		}
+
+		public override CirExpr Rewrite(CirExpr expr) {
+			switch (expr) {
+				case CirExpr.Local l when l.Name == array:
+					Escaped = true;
+					return expr;
+				case CirExpr.ArrayLength { Target: CirExpr.Local l } when l.Name == array:
+					return expr;
+				default:
+					return base.Rewrite(expr);
+			}
+		}
+
+		public override CirStmt Rewrite(CirStmt stmt) {
+			if (Escaped) return stmt;
+			switch (stmt) {
+				case CirStmt.Assign { Op: CirAssignOp.Assign, Target: CirExpr.Index { Target: CirExpr.Local l } ix, Value: CirExpr.Alloc { InRegion: false, OnStack: false } alloc } when l.Name == array:
+					if (_loopDepth > 0 || alloc.Type != element || _summaries.ParamEscapes(alloc.CtorMangledName, 0) || alloc.Args.Any(ReadsArray)) {
+						Escaped = true;
+						return stmt;
+					}
+
+					Rewrite(ix.Idx);
+					Rewrite(alloc);
+					return stmt;
+				case CirStmt.ForIn { Iterable: CirExpr.Local l } fi when l.Name == array:
+					ScanLoop(fi);
+					return stmt;
+				case CirStmt.ForIn { Iterable: CirExpr.Subslice { Target: CirExpr.Local l } ss } fi when l.Name == array:
+					Rewrite(ss.Lo);
+					Rewrite(ss.Hi);
+					ScanLoop(fi);
+					return stmt;
+				case CirStmt.Delete { Expression: CirExpr.Local l } when l.Name == array:
+					return stmt;
+				case CirStmt.Delete { Expression: var e } when IsTracked(e):
+					Escaped = true;
+					return stmt;
+				default:
+					return base.Rewrite(stmt);
+			}
+		}
+
+		private void ScanLoop(CirStmt.ForIn fi) {
+			if (!isUniqueBinding(fi.ElementName)) {
+				Escaped = true;
+				return;
+			}
+
+			_bindings.Add(fi.ElementName);
+			_loopDepth++;
+			RewriteBlock(fi.Body);
+			_loopDepth--;
+		}
+
+		// A constructor argument that reads the array would see the slot already zeroed for
+		// the in-place build, where a pointer array would still hold the old element.
+		private bool ReadsArray(CirExpr arg) {
+			var finder = new ArrayReadFinder(array, _bindings);
+			finder.Rewrite(arg);
+			return finder.Found;
+		}
+	}
+
+	private sealed class ArrayReadFinder(string array, HashSet<string> bindings) : CirRewriter {
+		public bool Found { get; private set; }
+
+		public override CirExpr Rewrite(CirExpr expr) {
+			if (expr is CirExpr.Local l && (l.Name == array || bindings.Contains(l.Name))) Found = true;
+			return Found ? expr : RewriteChildren(expr);
+		}
+	}
+}
@@ -0,0 +1,137 @@
+// Copyright (c) 2026.The Cloth contributors.
+//
+// Inlining.cs is part of the Cloth Compiler.
+//
+// Use, modification, and distribution of this file are governed by the
+// license terms provided with the Cloth Compiler source distribution.
+
+namespace Compiler.CIR.Passes;
+
+// Replaces direct calls to one-line accessors with the value they return. A callee qualifies
+// when its whole body is `return e;` and `e` is a literal, a static field, or a field of
+// `this` of exactly the return type — the synthesized enum getters, `getX() { return this.x; }`,
+// `static func answer(): i32 { return 42; }`. Virtual calls are left alone: their target
+// isn't known until run time.
+//
+// The callee may take no parameter besides `this`, so a call's arguments are at most the
+// receiver and nothing is skipped or evaluated twice. The receiver itself has to be a
+// place the emitter can read the field through: `this` or a local whose declared class is
+// the callee's class or a subclass of it, or an enum case for an enum getter.
+public sealed class Inlining : CirPass {
+	public override string Name => "inline";
+
+	public override CirModule Run(CirModule module, CirPassContext context) =>
+		RewriteFunctions(module, fn => new CallInliner(module, LocalTypes(fn)).RewriteBlock(fn.Body));
+
+	private sealed class CallInliner(CirModule module, Dictionary<string, CirType> locals) : CirRewriter {
+		public override CirExpr Rewrite(CirExpr expr) {
+			var rewritten = RewriteChildren(expr);
+			return rewritten is CirExpr.Call call && module.FindFunction(call.MangledName) is { } callee && Inline(callee, call.Args) is { } value
+				? value
+				: rewritten;
+		}
+
+		private CirExpr? Inline(CirFunction callee, List<CirExpr> args) {
+			if (callee.IsExtern || callee.Kind is not (CirFunctionKind.Method or CirFunctionKind.StaticMethod)) return null;
+			if (callee.Body is not [CirStmt.Return { Value: { } value }] || args.Count != callee.Parameters.Count) return null;
+
+			if (args.Count == 0) return value is CirExpr.FieldAccess ? null : AsReturnType(value, callee.ReturnType);
+			if (args.Count != 1 || callee.Parameters[0] is not { Name: "this", Type: CirType.Ptr { Inner: CirType.Named owner } }) return null;
+
+			if (value is CirExpr.FieldAccess { Target: CirExpr.ThisPtr, FieldName: var field }) {
+				return FieldType(owner.FullyQualifiedName, field) == callee.ReturnType && IsReceiverOf(args[0], owner.FullyQualifiedName)
+					? new CirExpr.FieldAccess(args[0], field)
+					: null;
+			}
+
+			// A literal or static-field return drops the receiver, so it must be side-effect free.
+			return args[0] is CirExpr.ThisPtr or CirExpr.Local or CirExpr.EnumCaseRef ? AsReturnType(value, callee.ReturnType) : null;
+		}
+
+		private bool IsReceiverOf(CirExpr receiver, string ownerFqn) {
+			var fqn = receiver switch {
+				CirExpr.ThisPtr => locals.GetValueOrDefault("this") is CirType.Ptr { Inner: CirType.Named n } ? n.FullyQualifiedName : null,
+				CirExpr.Local l => locals.GetValueOrDefault(l.Name) switch {
+					CirType.Ptr { Inner: CirType.Named n } => n.FullyQualifiedName,
+					CirType.Named n => n.FullyQualifiedName,
+					_ => null
+				},
+				CirExpr.EnumCaseRef ec => ec.EnumFqn,
+				_ => null
+			};
+
+			if (fqn == null) return false;
+			if (module.EnumsByFqn.ContainsKey(ownerFqn)) return fqn == ownerFqn;
+			for (var cursor = fqn; cursor != null && module.ClassesByFqn.TryGetValue(cursor, out var cls); cursor = cls.BaseClass)
+				if (cursor == ownerFqn) return true;
+			return false;
+		}
+
+		// Declared type of `field` on a class (searching its ancestors) or an enum; null when unknown.
+		private CirType? FieldType(string ownerFqn, string field) {
+			if (module.EnumsByFqn.TryGetValue(ownerFqn, out var e)) {
+				return field switch {
+					"__ordinal__" => new CirType.Named("i32"),
+					"__name__" => new CirType.Named("string"),
+					_ => e.Parameters.FirstOrDefault(p => p.Name == field)?.Type
+				};
+			}
+
+			var visited = new HashSet<string>();
+			for (var cursor = ownerFqn; cursor != null && visited.Add(cursor) && module.ClassesByFqn.TryGetValue(cursor, out var cls); cursor = cls.BaseClass)
+				if (cls.Fields.FirstOrDefault(f => f.Name == field) is { } decl)
+					return decl.Type;
+			return null;
+		}
+	}
+
+	// `value` typed as `returnType`, or null when it's not a constant or static field of that
+	// type. A bare integer literal is typed by its smallest fit, so it's cast to the return type.
+	private static CirExpr? AsReturnType(CirExpr value, CirType returnType) {
+		var name = (returnType as CirType.Named)?.FullyQualifiedName;
+		return value switch {
+			CirExpr.IntLit when name != null && IntegerTypes.Bits(name) > 0 => new CirExpr.Cast(value, returnType, false),
+			CirExpr.Cast { Value: CirExpr.IntLit or CirExpr.BoolLit } c when c.TargetType == returnType => value,
+			CirExpr.BoolLit when name == "bool" => value,
+			CirExpr.StrLit when name == "string" => value,
+			CirExpr.CharLit when name == "char" => value,
+			CirExpr.FloatLit when name is "f64" or "double" => value,
+			CirExpr.StaticFieldRef sr when sr.Type == returnType => value,
+			_ => null
+		};
+	}
+
+	// Declared type of every parameter and local that's bound to a single type in `fn`.
+	private static Dictionary<string, CirType> LocalTypes(CirFunction fn) {
+		var scanner = new DeclScanner();
+		foreach (var p in fn.Parameters) scanner.Declare(p.Name, p.Type);
+		scanner.RewriteBlock(fn.Body);
+		return scanner.Types.Where(kv => !scanner.Ambiguous.Contains(kv.Key)).ToDictionary(kv => kv.Key, kv => kv.Value);
+	}
+
+	private sealed class DeclScanner : CirRewriter {
+		public readonly Dictionary<string, CirType> Types = new();
+		public readonly HashSet<string> Ambiguous = new();
+
+		public void Declare(string name, CirType? type) {
+			if (type == null || (Types.TryGetValue(name, out var existing) && existing != type)) Ambiguous.Add(name);
+			else Types[name] = type;
+		}
+
+		public override CirStmt Rewrite(CirStmt stmt) {
+			switch (stmt) {
+				case CirStmt.LocalDecl ld:
+					Declare(ld.Name, ld.Type);
+					break;
+				case CirStmt.TupleDecl td:
+					foreach (var (type, name) in td.Bindings) Declare(name, type);
+					break;
+				case CirStmt.ForIn fi:
+					Declare(fi.ElementName, fi.ElementType);
+					break;
+			}
+
+			return RewriteChildren(stmt);
+		}
+	}
+}
@@ -0,0 +1,26 @@
+// Copyright (c) 2026.The Cloth contributors.
+//
+// IntegerTypes.cs is part of the Cloth Compiler.
+//
+// Use, modification, and distribution of this file are governed by the
+// license terms provided with the Cloth Compiler source distribution.
+
+namespace Compiler.CIR.Passes;
+
+// Integer CIR type names as the LLVM emitter lowers them.
+internal static class IntegerTypes {
+	// Bit width of an integer CIR type name; 0 for anything else.
+	public static int Bits(string name) => name switch {
+		"i64" or "u64" or "long" => 64,
+		"i32" or "u32" or "int" or "uint" or "unsigned" => 32,
+		"i16" or "u16" or "short" => 16,
+		"i8" or "u8" or "byte" or "sbyte" => 8,
+		_ => 0
+	};
+
+	// Names the emitter widens with `sext` in an explicit cast; every other integer name zero-extends.
+	public static bool IsSigned(string name) => name is "i8" or "i16" or "i32" or "i64" or "int" or "long" or "short";
+
+	// `value` truncated to `bits` and sign-extended back: what an `iN` register holds.
+	public static long Wrap(long value, int bits) => bits >= 64 ? value : (value << (64 - bits)) >> (64 - bits);
+}
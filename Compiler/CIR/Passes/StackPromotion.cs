@@ -0,0 +1,55 @@
+// Copyright (c) 2026.The Cloth contributors.
+//
+// StackPromotion.cs is part of the Cloth Compiler.
+//
+// Use, modification, and distribution of this file are governed by the
+// license terms provided with the Cloth Compiler source distribution.
+
+using Compiler.Configs;
+
+namespace Compiler.CIR.Passes;
+
+// Escape analysis: moves `let x = new T(...)` into the function's frame when the object
+// can't outlive the call. The allocation becomes `Alloc { OnStack = true }` (an entry-block
+// slot, re-zeroed at the `new`) and each `delete x` becomes `Delete { OnStack = true }`,
+// which runs the destructor where the `delete` was but frees nothing.
+//
+// `x` qualifies when it's declared exactly once, never reassigned, and every use of it is
+// one `UseScanner` accepts — its constructor's `this` included, since the constructor is
+// the first function the object is passed to.
+public sealed class StackPromotion : CirPass {
+	public override string Name => "stack-promote";
+
+	public override CirModule Run(CirModule module, CirPassContext context) {
+		var summaries = new EscapeSummaries(module, context.OutputType == OutputType.Executable);
+		return RewriteFunctions(module, fn => {
+			var promoted = Candidates(fn).Where(c => !Escapes(summaries, fn.Body, c.Name, c.Alloc)).Select(c => c.Name).ToHashSet();
+			return promoted.Count == 0 ? fn.Body : new Promoter(promoted).RewriteBlock(fn.Body);
+		});
+	}
+
+	// Locals bound once, by a plain (non-region) `new`, and not shadowing a parameter.
+	private static List<(string Name, CirExpr.Alloc Alloc)> Candidates(CirFunction fn) {
+		var decls = new DeclCounter();
+		decls.RewriteBlock(fn.Body);
+		return decls.Inits
+			.Where(kv => kv.Value is CirExpr.Alloc { InRegion: false, OnStack: false } && decls.IsUnique(kv.Key, fn))
+			.Select(kv => (kv.Key, (CirExpr.Alloc)kv.Value))
+			.ToList();
+	}
+
+	private static bool Escapes(EscapeSummaries summaries, List<CirStmt> body, string name, CirExpr.Alloc alloc) {
+		if (summaries.ParamEscapes(alloc.CtorMangledName, 0)) return true;
+		var scanner = new UseScanner(summaries, name, isParameter: false);
+		scanner.RewriteBlock(body);
+		return scanner.Escaped;
+	}
+
+	private sealed class Promoter(HashSet<string> promoted) : CirRewriter {
+		public override CirStmt Rewrite(CirStmt stmt) => stmt switch {
+			CirStmt.LocalDecl { Init: CirExpr.Alloc alloc } ld when promoted.Contains(ld.Name) => ld with { Init = alloc with { OnStack = true } },
+			CirStmt.Delete { Expression: CirExpr.Local l } d when promoted.Contains(l.Name) => d with { OnStack = true },
+			_ => RewriteChildren(stmt)
+		};
+	}
+}
@@ -0,0 +1,98 @@
+// Copyright (c) 2026.The Cloth contributors.
+//
+// AnalysisCache.cs is part of the Cloth Compiler.
+//
+// Use, modification, and distribution of this file are governed by the
+// license terms provided with the Cloth Compiler source distribution.
+
+using System.Collections.Concurrent;
+using System.Security.Cryptography;
+using Compiler.Semantics;
+using FrontEnd.Parser.AST;
+
+namespace Compiler.Cache;
+
+// Per-unit semantic analysis kept from earlier builds in this process, next to the parsed
+// units of `UnitCache`. A unit's walk reads nothing but its own tree and the symbol registry
+// (see `SemanticAnalyzer.InferDeclarationsParallel`), so its diagnostics and inferred types
+// can be replayed while the tree is the one `UnitCache` handed out last time and the
+// `AnalysisContext` — everything outside the unit that the registry is built from — is the
+// same. A declaration change anywhere re-walks every unit: names resolve through direct
+// FQNs as well as imports, so an import graph would miss some of a unit's dependencies. So
+// does a body change that alters what its function may write (`SymbolRegistry.Effects`),
+// which the race check of every caller reads.
+//
+// `BuildCache` keeps the same results on disk for builds in later processes, keyed by file
+// content instead of tree identity. The registry itself is rebuilt every build, and lowering
+// and emission stay whole-program: the CIR passes (inlining, devirtualization, escape
+// analysis, dispatch coloring) look across units, so no unit's CIR or IR is a function of its
+// own source alone.
+public sealed class AnalysisCache {
+	private readonly ConcurrentDictionary<string, Snapshot> _projects = new(StringComparer.Ordinal);
+
+	private int _reanalyzed;
+
+	// Units walked (rather than replayed) since the last `TakeReanalyzedCount`.
+	public int TakeReanalyzedCount() => Interlocked.Exchange(ref _reanalyzed, 0);
+
+	// The stored results of `units` still valid under `context`, keyed by file path, for
+	// `SemanticAnalyzer.Reusable`. Empty when the project at `sourceRoot` wasn't analyzed
+	// under the same context.
+	public IReadOnlyDictionary<string, UnitAnalysis> Reusable(string sourceRoot, AnalysisContext context, IReadOnlyList<(CompilationUnit Unit, string FilePath)> units) {
+		var result = new Dictionary<string, UnitAnalysis>(StringComparer.Ordinal);
+		if (!_projects.TryGetValue(Path.GetFullPath(sourceRoot), out var last) || !last.Context.Matches(context)) return result;
+
+		foreach (var (unit, filePath) in units)
+			if (last.Units.TryGetValue(filePath, out var cached) && cached.Unit.Equals(unit))
+				result[filePath] = cached.Analysis;
+		return result;
+	}
+
+	// Replace the project's results with this build's, `results[i]` being `units[i]`'s. Files
+	// gone from the build drop out with the old snapshot.
+	public void Store(string sourceRoot, AnalysisContext context, IReadOnlyList<(CompilationUnit Unit, string FilePath)> units, IReadOnlyList<UnitAnalysis> results, int reanalyzed) {
+		var entries = new Dictionary<string, (CompilationUnit, UnitAnalysis)>(StringComparer.Ordinal);
+		for (var i = 0; i < units.Count; i++)
+			entries[units[i].FilePath] = (units[i].Unit, results[i]);
+		_projects[Path.GetFullPath(sourceRoot)] = new Snapshot(context, entries);
+		Interlocked.Add(ref _reanalyzed, reanalyzed);
+	}
+
+	private sealed record Snapshot(AnalysisContext Context, Dictionary<string, (CompilationUnit Unit, UnitAnalysis Analysis)> Units);
+}
+
+// What a unit's analysis depends on besides its own tree: the project's local declarations
+// and write effects, fingerprinted through their `SymbolMetadata` serialization (slot
+// positions aside, which the walk doesn't read), together with the bytes of the dependency
+// metadata and source files and the `allowLeaks` flag; and, within one process, the
+// dependency units themselves, which `UnitCache` keeps while their files are unchanged. A
+// `CompilationUnit` compares its lists by reference, so two units are equal only when they
+// come from the same parse. `Key` is the fingerprint alone, which `BuildCache` stores next
+// to each unit's results on disk.
+public sealed class AnalysisContext {
+	private readonly byte[] _fingerprint;
+	private readonly IReadOnlyList<CompilationUnit> _externUnits;
+
+	private AnalysisContext(byte[] fingerprint, IReadOnlyList<CompilationUnit> externUnits) {
+		_fingerprint = fingerprint;
+		_externUnits = externUnits;
+	}
+
+	public static AnalysisContext Of(SymbolRegistry symbols, IReadOnlyList<(CompilationUnit Unit, string FilePath)> externUnits, IEnumerable<string> metadataFiles, bool allowLeaks) {
+		using var buffer = new MemoryStream();
+		SymbolMetadata.FromRegistry(symbols, _ => 0).Write(buffer);
+		foreach (var path in metadataFiles.Concat(externUnits.Select(u => u.FilePath))) {
+			var bytes = File.ReadAllBytes(path);
+			buffer.Write(BitConverter.GetBytes(bytes.Length));
+			buffer.Write(bytes);
+		}
+
+		buffer.WriteByte(allowLeaks ? (byte)1 : (byte)0);
+		return new AnalysisContext(SHA256.HashData(buffer.ToArray()), externUnits.Select(u => u.Unit).ToList());
+	}
+
+	public string Key => Convert.ToHexString(_fingerprint);
+
+	public bool Matches(AnalysisContext other) =>
+		_fingerprint.AsSpan().SequenceEqual(other._fingerprint) && _externUnits.SequenceEqual(other._externUnits);
+}
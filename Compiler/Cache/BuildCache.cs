@@ -0,0 +1,226 @@
+// Copyright (c) 2026.The Cloth contributors.
+//
+// BuildCache.cs is part of the Cloth Compiler.
+//
+// Use, modification, and distribution of this file are governed by the
+// license terms provided with the Cloth Compiler source distribution.
+
+using System.Collections.Concurrent;
+using System.Security.Cryptography;
+using System.Text;
+using System.Text.Json;
+using Compiler.LLVM;
+using Compiler.Semantics;
+using FrontEnd.File;
+using FrontEnd.Parser.AST;
+using FrontEnd.Token;
+
+namespace Compiler.Cache;
+
+// Persistent incremental-build state under `build/.cache/`. The manifest records the content
+// hash of every input file (user + extern sources, dependency metadata), plus a fingerprint
+// of the compiler binary and of the build configuration. Each layer below is keyed by what
+// its output is a function of, so a one-file edit redoes only what that file reaches:
+//
+// - When no input changed, the last emitted IR is restored verbatim and the frontend,
+//   analysis, lowering, and emission are skipped entirely — one file per codegen unit,
+//   restored under its original name.
+// - Otherwise every file is parsed and the registry rebuilt (both need the whole program;
+//   trees are only kept in memory, by `UnitCache`), but a unit whose content hash and
+//   `AnalysisContext.Key` match what the last build stored replays its analysis instead of
+//   being walked (`ReusableAnalyses`).
+// - Lowering and emission look across units, so a codegen unit's IR is no function of one
+//   file; its object is keyed by the IR itself, and only units whose IR changed go through
+//   the backend again (`TryRestoreObject`).
+//
+// The cache files deliberately avoid the `.o` / `.ll` extensions the CLI's post-build
+// cleanup deletes.
+public sealed class BuildCache {
+	private const string ManifestFileName = "manifest.json";
+	private const string AnalysisFileName = "analysis.json";
+	private const string ObjectDirName = "objects";
+
+	private static readonly JsonSerializerOptions JsonOptions = new() {
+		WriteIndented = true
+	};
+
+	private readonly string _cacheDir;
+	private readonly string _fingerprint;
+	private readonly CacheManifest? _previous;
+	private readonly Dictionary<string, string> _currentHashes;
+
+	// Object keys this build restored or stored; `PruneObjects` drops every other one.
+	private readonly ConcurrentDictionary<string, byte> _objectsInUse = new(StringComparer.Ordinal);
+
+	private BuildCache(string cacheDir, string fingerprint, CacheManifest? previous, Dictionary<string, string> currentHashes) {
+		_cacheDir = cacheDir;
+		_fingerprint = fingerprint;
+		_previous = previous;
+		_currentHashes = currentHashes;
+	}
+
+	// True when nothing the build depends on changed since the manifest was written and the
+	// IR from that build is still on disk.
+	public bool IsClean => _previous != null && InputsUnchanged(_previous) && Enumerable.Range(0, _previous.IrFiles.Count).All(i => File.Exists(CachedIrPath(i)));
+
+	// The same input files as `previous` recorded, each with the same content hash.
+	private bool InputsUnchanged(CacheManifest previous) =>
+		previous.Files.Count == _currentHashes.Count && _currentHashes.All(f => previous.Files.TryGetValue(f.Key, out var cached) && cached.Hash == f.Value);
+
+	// Unit `i`'s IR is cached as `unit<i>.ir`; the manifest keeps its original file name.
+	private string CachedIrPath(int unit) => Path.Combine(_cacheDir, $"unit{unit}.ir");
+
+	// `configText` is the raw build.toml contents and `profileKey` anything else that changes
+	// codegen without appearing in the file (a dependency built under a consumer's profile).
+	public static BuildCache Open(string projectRoot, string configText, string profileKey, IEnumerable<string> sourceFiles) {
+		var cacheDir = Path.Combine(projectRoot, "build", ".cache");
+		var fingerprint = Hash(CompilerVersion() + "\n" + profileKey + "\n" + configText);
+
+		var hashes = new Dictionary<string, string>(StringComparer.Ordinal);
+		foreach (var path in sourceFiles)
+			hashes[Path.GetFullPath(path)] = Hash(File.ReadAllBytes(path));
+
+		CacheManifest? previous = null;
+		var manifestPath = Path.Combine(cacheDir, ManifestFileName);
+		if (File.Exists(manifestPath)) {
+			try {
+				previous = JsonSerializer.Deserialize<CacheManifest>(File.ReadAllText(manifestPath), JsonOptions);
+			}
+			catch (JsonException) {
+				// Corrupt or from an older layout: treat as a cold cache.
+			}
+
+			// A manifest without IR file names predates codegen units; rebuild once.
+			if (previous != null && (previous.Fingerprint != fingerprint || previous.IrFiles == null)) previous = null;
+		}
+
+		return new BuildCache(cacheDir, fingerprint, previous, hashes);
+	}
+
+	// Copy the cached IR back into `buildDir` under the names it was emitted with, in
+	// emission order. Only valid when `IsClean`.
+	public IReadOnlyList<string> RestoreIr(string buildDir) {
+		Directory.CreateDirectory(buildDir);
+		var paths = new List<string>(_previous!.IrFiles.Count);
+		for (var i = 0; i < _previous.IrFiles.Count; i++) {
+			var llPath = Path.Combine(buildDir, _previous.IrFiles[i]);
+			File.Copy(CachedIrPath(i), llPath, overwrite: true);
+			paths.Add(llPath);
+		}
+
+		return paths;
+	}
+
+	// Record the current input hashes and the IR units they produced (`LlvmEmitter.Emit`
+	// order) as the new baseline. A unit emitted in memory is written straight into the cache.
+	public void Store(IReadOnlyList<LlvmUnit> units) {
+		var files = _currentHashes.ToDictionary(f => f.Key, f => new CachedFile(f.Value), StringComparer.Ordinal);
+
+		Directory.CreateDirectory(_cacheDir);
+		for (var i = 0; i < units.Count; i++) {
+			if (units[i].Ir is { } ir) File.WriteAllText(CachedIrPath(i), ir, new UTF8Encoding(false));
+			else File.Copy(units[i].Path, CachedIrPath(i), overwrite: true);
+		}
+
+		var irFiles = units.Select(unit => Path.GetFileName(unit.Path)).ToList();
+		File.WriteAllText(Path.Combine(_cacheDir, ManifestFileName), JsonSerializer.Serialize(new CacheManifest(_fingerprint, files, irFiles), JsonOptions));
+	}
+
+	// The analyses of `units` an earlier build stored, by file path, for each unit whose file
+	// still has the same content and was analyzed under the same `context`. Inferred types get
+	// spans in the unit's file, which `SpanPosition` matches to the fresh parse's.
+	public IReadOnlyDictionary<string, UnitAnalysis> ReusableAnalyses(AnalysisContext context, IReadOnlyList<(CompilationUnit Unit, string FilePath)> units) {
+		var result = new Dictionary<string, UnitAnalysis>(StringComparer.Ordinal);
+		var stored = ReadJson<Dictionary<string, CachedAnalysis>>(Path.Combine(_cacheDir, AnalysisFileName));
+		if (stored == null) return result;
+
+		foreach (var (_, filePath) in units) {
+			if (!stored.TryGetValue(Path.GetFullPath(filePath), out var cached) || cached.Context != context.Key) continue;
+			if (!_currentHashes.TryGetValue(Path.GetFullPath(filePath), out var hash) || cached.Hash != hash) continue;
+			var file = new ClothFile(filePath, Path.GetFileNameWithoutExtension(filePath), "", true);
+			result[filePath] = new UnitAnalysis(cached.Log, cached.Types.Select(t => {
+				var span = new TokenSpan(t.Start, t.End, t.StartLine, t.EndLine, t.StartColumn, t.EndColumn, file);
+				return KeyValuePair.Create(span, SemanticAnalyzer.InferredType(t.Type, span));
+			}).ToList());
+		}
+
+		return result;
+	}
+
+	// Record this build's analyses, `results[i]` being `units[i]`'s, in place of the last ones.
+	public void StoreAnalyses(AnalysisContext context, IReadOnlyList<(CompilationUnit Unit, string FilePath)> units, IReadOnlyList<UnitAnalysis> results) {
+		var entries = new Dictionary<string, CachedAnalysis>(StringComparer.Ordinal);
+		for (var i = 0; i < units.Count; i++) {
+			var path = Path.GetFullPath(units[i].FilePath);
+			if (!_currentHashes.TryGetValue(path, out var hash)) continue;
+			var types = results[i].InferredVarTypes.Select(t => new CachedInferredType(t.Key.Start, t.Key.End, t.Key.StartLine, t.Key.EndLine, t.Key.StartColumn, t.Key.EndColumn, SemanticAnalyzer.InferredCanonical(t.Value))).ToList();
+			entries[path] = new CachedAnalysis(hash, context.Key, results[i].Log, types);
+		}
+
+		Directory.CreateDirectory(_cacheDir);
+		File.WriteAllText(Path.Combine(_cacheDir, AnalysisFileName), JsonSerializer.Serialize(entries, JsonOptions));
+	}
+
+	// Key of the object the backend makes of `unit`: its IR under this build's fingerprint,
+	// plus `variant` for whatever else changes the object (backend, instrumentation).
+	public string ObjectKey(LlvmUnit unit, string variant) {
+		var ir = unit.Ir is { } text ? Encoding.UTF8.GetBytes(text) : File.ReadAllBytes(unit.Path);
+		return Hash(Encoding.UTF8.GetBytes(_fingerprint + "\n" + variant + "\n").Concat(ir).ToArray());
+	}
+
+	// Copy the object stored under `key` to `objPath`; false when there is none.
+	public bool TryRestoreObject(string key, string objPath) {
+		var cached = CachedObjectPath(key);
+		if (!File.Exists(cached)) return false;
+		File.Copy(cached, objPath, overwrite: true);
+		_objectsInUse[key] = 0;
+		return true;
+	}
+
+	public void StoreObject(string key, string objPath) {
+		Directory.CreateDirectory(Path.Combine(_cacheDir, ObjectDirName));
+		File.Copy(objPath, CachedObjectPath(key), overwrite: true);
+		_objectsInUse[key] = 0;
+	}
+
+	// Delete the stored objects this build neither restored nor stored, so edits don't pile
+	// up objects of IR that no longer exists.
+	public void PruneObjects() {
+		var dir = Path.Combine(_cacheDir, ObjectDirName);
+		if (!Directory.Exists(dir)) return;
+		foreach (var path in Directory.EnumerateFiles(dir))
+			if (!_objectsInUse.ContainsKey(Path.GetFileNameWithoutExtension(path)))
+				File.Delete(path);
+	}
+
+	private string CachedObjectPath(string key) => Path.Combine(_cacheDir, ObjectDirName, key + ".obj");
+
+	private static T? ReadJson<T>(string path) where T : class {
+		if (!File.Exists(path)) return null;
+		try {
+			return JsonSerializer.Deserialize<T>(File.ReadAllText(path), JsonOptions);
+		}
+		catch (JsonException) {
+			return null;
+		}
+	}
+
+	// Assembly version plus module version ID — the MVID changes on every rebuild of the
+	// compiler, so a dev build never reuses IR produced by a different compiler binary.
+	private static string CompilerVersion() {
+		var assembly = typeof(BuildCache).Assembly;
+		return $"{assembly.GetName().Version}+{assembly.ManifestModule.ModuleVersionId}";
+	}
+
+	private static string Hash(string text) => Hash(Encoding.UTF8.GetBytes(text));
+
+	private static string Hash(byte[] bytes) => Convert.ToHexString(SHA256.HashData(bytes));
+}
+
+public sealed record CacheManifest(string Fingerprint, Dictionary<string, CachedFile> Files, List<string> IrFiles);
+
+public sealed record CachedFile(string Hash);
+
+public sealed record CachedAnalysis(string Hash, string Context, string Log, List<CachedInferredType> Types);
+
+public sealed record CachedInferredType(int Start, int End, int StartLine, int EndLine, int StartColumn, int EndColumn, string Type);
@@ -0,0 +1,55 @@
+// Copyright (c) 2026.The Cloth contributors.
+//
+// UnitCache.cs is part of the Cloth Compiler.
+//
+// Use, modification, and distribution of this file are governed by the
+// license terms provided with the Cloth Compiler source distribution.
+
+using System.Collections.Concurrent;
+using FrontEnd.Parser.AST;
+
+namespace Compiler.Cache;
+
+// In-memory parse results for a host that runs many builds in one process (`cloth build
+// --watch`, `cloth serve`). A file is re-lexed and re-parsed only when its size or last-write
+// time changed since it was cached, so a one-file edit re-parses one file — dependency
+// sources included. `BuildCache` still decides whether the rest of the pipeline runs at all;
+// this makes the `parse` / `parse-extern` phases incremental, and `Analyses` the per-unit
+// part of `analyze`. Units are never mutated after parsing, so one can safely feed any
+// number of builds.
+public sealed class UnitCache {
+	private readonly ConcurrentDictionary<string, Entry> _units = new(StringComparer.Ordinal);
+
+	// Analysis of the units handed out here, replayed while a unit's tree is unchanged.
+	public AnalysisCache Analyses { get; } = new();
+
+	private int _reparsed;
+
+	// Files parsed (rather than reused) since the last `TakeReparsedCount`.
+	public int TakeReparsedCount() => Interlocked.Exchange(ref _reparsed, 0);
+
+	// The cached unit for `path` while the file is unchanged, otherwise `parse()`'s result,
+	// which replaces it. Safe to call from parallel workers.
+	public CompilationUnit GetOrParse(string path, Func<CompilationUnit> parse) {
+		var fullPath = Path.GetFullPath(path);
+		var info = new FileInfo(fullPath);
+		var stamp = (info.Length, info.LastWriteTimeUtc);
+		if (_units.TryGetValue(fullPath, out var cached) && cached.Stamp == stamp) return cached.Unit;
+
+		var unit = parse();
+		Interlocked.Increment(ref _reparsed);
+		_units[fullPath] = new Entry(stamp, unit);
+		return unit;
+	}
+
+	// Drop the entries of files under `root` that no longer exist, so a long-lived host
+	// doesn't keep deleted files' trees alive.
+	public void Prune(string root) {
+		var prefix = Path.GetFullPath(root);
+		foreach (var path in _units.Keys)
+			if (path.StartsWith(prefix, StringComparison.Ordinal) && !File.Exists(path))
+				_units.TryRemove(path, out _);
+	}
+
+	private sealed record Entry((long Length, DateTime LastWrite) Stamp, CompilationUnit Unit);
+}
@@ -6,10 +6,18 @@
 // license terms provided with the Cloth Compiler source distribution.
 
 using System.Diagnostics;
+using System.Runtime.ExceptionServices;
+using System.Security.Cryptography;
+using System.Text;
+using Compiler.Cache;
 using Compiler.CIR;
+using Compiler.CIR.Passes;
 using Compiler.Configs;
+using Compiler.Configs.Profiles;
 using Compiler.LLVM;
+using Compiler.Pgo;
 using Compiler.Semantics;
+using FrontEnd.Error;
 using FrontEnd.File;
 using FrontEnd.Lexer;
 using FrontEnd.Parser;
@@ -22,7 +30,55 @@ namespace Compiler;
 /// The compiler performs parsing, semantic analysis, intermediate representation (CIR) generation,
 /// and optional LLVM emission for the specified output type (e.g., executable or library).
 /// </summary>
-public class Compiler(string projectRoot) {
+/// <param name="projectRoot">The directory containing the project's build.toml.</param>
+/// <param name="profileOverride">
+/// Optimization settings to use instead of the project's own <c>[build] profile</c>. Set when a
+/// dependency is built on behalf of a consumer, so the library matches the consumer's profile.
+/// </param>
+public class Compiler(string projectRoot, ProfileSettings? profileOverride = null) {
+	/// <summary>
+	/// When true (the default), reuse the previous build's IR from <c>build/.cache</c> if no source
+	/// file, dependency source, build.toml, or compiler binary changed. Callers that need the
+	/// <see cref="CIR.CirModule"/> itself (e.g. <c>--dump</c>) turn this off.
+	/// </summary>
+	public bool Incremental { get; init; } = true;
+
+	/// <summary>
+	/// The profile-guided optimization step of this build (<c>--pgo=...</c>). <see cref="PgoMode.Instrument"/>
+	/// links a binary that writes its branch counts to <c>build/pgo/</c> when run;
+	/// <see cref="PgoMode.Use"/> merges those counts and optimizes with them. Only executables take part.
+	/// </summary>
+	public PgoMode Pgo { get; init; } = PgoMode.None;
+
+	/// <summary>
+	/// When true, link <c>build/&lt;Name&gt;-bench</c> for <c>cloth bench</c> instead of the program: its
+	/// <c>main</c> lists and times the project's <c>@Bench</c> methods rather than running the entry class.
+	/// Only executables take part.
+	/// </summary>
+	public bool Bench { get; init; }
+
+	/// <summary>
+	/// Parsed units kept from earlier builds in this process (<c>cloth build --watch</c>, <c>cloth serve</c>).
+	/// When set, only source files that changed since they were cached are lexed and parsed again, the
+	/// analysis of unchanged units is replayed while no declaration changed (<see cref="AnalysisCache"/>),
+	/// and dependencies built on this compiler's behalf share it. Null for a one-shot build.
+	/// </summary>
+	public UnitCache? Units { get; init; }
+
+	/// <summary>
+	/// Wall-clock time of each CIR optimization pass the last <see cref="Compile"/> ran, in pipeline
+	/// order. Empty when the build was satisfied from the cache or the profile runs no passes.
+	/// </summary>
+	public IReadOnlyList<CirPassTiming> PassTimings { get; private set; } = [];
+
+	/// <summary>
+	/// Wall-clock time, allocated bytes and GC collections of each phase the last <see cref="Compile"/> ran
+	/// (parsing, symbol registration, analysis, lowering, passes, emission, the external tools), in the order
+	/// they started. Builds of missing dependencies are included, tagged with the dependency's project name,
+	/// right after the consumer's <c>dependencies</c> phase that contains them.
+	/// </summary>
+	public IReadOnlyList<PhaseTiming> PhaseTimings { get; private set; } = [];
+
 	/// <summary>
 	/// Compiles all source files in the project, processes dependencies (if any), and generates
 	/// the complete CIR module representing the project's intermediate representation. This method
@@ -31,83 +87,306 @@ public class Compiler(string projectRoot) {
 	/// </summary>
 	/// <returns>
 	/// A <see cref="CIR.CirModule"/> that encapsulates the types and functions generated during the
-	/// compilation process, representing the intermediate state of the program.
+	/// compilation process, representing the intermediate state of the program; or null when
+	/// <see cref="Incremental"/> is set and the build was satisfied from the cache without lowering.
 	/// </returns>
-	public CIR.CirModule Compile() {
+	public CIR.CirModule? Compile() {
 		var tomlPath = Path.Combine(projectRoot, "build.toml");
 		if (!File.Exists(tomlPath)) {
 			Console.Error.WriteLine($"Error: build.toml not found in '{projectRoot}'");
-			Environment.Exit(1);
+			FatalErrors.Exit(1);
 		}
 
 		var config = ConfigReader.Read(tomlPath);
+		var profile = profileOverride ?? ResolveProfile(config, tomlPath);
+		var backend = ResolveBackend(config, tomlPath);
+		var codegenUnits = ResolveCodegenUnits(config, tomlPath);
+		var phases = new PhaseRecorder(config.Project.Name);
+		PhaseTimings = phases.Timings;
 		var sourceRoot = Path.Combine(projectRoot, config.Build.Source);
 
 		if (!Directory.Exists(sourceRoot)) {
 			Console.Error.WriteLine($"Error: source directory '{sourceRoot}' does not exist");
-			Environment.Exit(1);
+			FatalErrors.Exit(1);
 		}
 
-		var units = ParseUnits(sourceRoot);
+		var sourceFiles = CollectSourceFiles(sourceRoot);
 
-		// For executable builds, also parse the source of each Cloth dependency so the
-		// CirGenerator can register their method signatures (used by compile-time dispatch
-		// and by the LLVM emitter's `declare` lines for cross-project calls).
-		var externUnits = new List<(CompilationUnit Unit, string FilePath)>();
+		if (Pgo != PgoMode.None && config.Build.OutputType != OutputType.Executable) {
+			Console.Error.WriteLine($"Error: --pgo needs an executable project, but '{projectRoot}' has output={ClothConfig.OutputTypeToString(config.Build.OutputType)}");
+			FatalErrors.Exit(1);
+		}
+
+		if (Bench && config.Build.OutputType != OutputType.Executable) {
+			Console.Error.WriteLine($"Error: cloth bench needs an executable project, but '{projectRoot}' has output={ClothConfig.OutputTypeToString(config.Build.OutputType)}");
+			FatalErrors.Exit(1);
+		}
+
+		// The profile is code's input like any source file, so its digest keys the cache.
+		var pgoText = Pgo == PgoMode.Use ? phases.Measure("pgo-merge", () => MergePgoProfiles(config)) : null;
+		var pgoProfile = pgoText == null ? null : PgoProfile.Parse(pgoText, PgoProfile.TextProfilePath(projectRoot, config.Project.Name));
+		var rawProfilePattern = Pgo == PgoMode.Instrument ? PgoProfile.RawProfilePattern(projectRoot, config.Project.Name) : null;
+		if (rawProfilePattern != null) Directory.CreateDirectory(PgoProfile.ProfileDirectory(projectRoot));
+		var profileKey = Pgo == PgoMode.None ? profile.ToString() : $"{profile} pgo={ClothConfig.PgoModeToString(Pgo)}";
+		if (pgoText != null) profileKey += " " + Convert.ToHexString(SHA256.HashData(Encoding.UTF8.GetBytes(pgoText)));
+		if (Bench) profileKey += " bench";
+
+		// For executable builds, the registry also needs each Cloth dependency's signatures
+		// (used by compile-time dispatch and by the LLVM emitter's `declare` lines for
+		// cross-project calls). Prefer the precompiled metadata installed next to the
+		// dependency's `.lib`; fall back to parsing its sources when none is cached yet.
+		var externFiles = new List<string>();
+		var externMetadata = new List<SymbolMetadata>();
+		var metadataFiles = new List<string>();
 		if (config.Build.OutputType == OutputType.Executable) {
-			foreach (var (name, _) in config.Dependencies) {
+			foreach (var (name, version) in config.Dependencies) {
+				var metadataPath = Path.Combine(StdlibCacheDir(name, version), SymbolMetadata.FileName);
+				var metadata = SymbolMetadata.TryRead(metadataPath);
+				if (metadata != null) {
+					metadata.Library = name;
+					externMetadata.Add(metadata);
+					metadataFiles.Add(metadataPath);
+					continue;
+				}
+
 				var depRoot = ResolveStdlibRoot(name);
 				if (depRoot == null) continue;
 				var depConfig = ConfigReader.Read(Path.Combine(depRoot, "build.toml"));
 				var depSourceRoot = Path.Combine(depRoot, depConfig.Build.Source);
 				if (Directory.Exists(depSourceRoot))
-					externUnits.AddRange(ParseUnits(depSourceRoot));
+					externFiles.AddRange(CollectSourceFiles(depSourceRoot));
 			}
 		}
 
-		// Build the cross-cutting symbol registry once over all units (user + extern). Both the
-		// analyzer and CIR generator read from the same registry — keeps their views in sync.
-		var symbols = SymbolRegistry.Build(units, externUnits);
+		var cache = Incremental ? phases.Measure("cache-check", () => BuildCache.Open(projectRoot, File.ReadAllText(tomlPath), profileKey, sourceFiles.Concat(externFiles).Concat(metadataFiles))) : null;
+		IReadOnlyList<LlvmUnit> irUnits;
+		CirModule? module = null;
+		var inProcess = CompilesInProcess(backend, profile);
 
-		var analyzer = new SemanticAnalyzer(units, sourceRoot, symbols, externUnits, config.Build.AllowLeaks);
-		analyzer.Analyze(requireMain: config.Build.OutputType == OutputType.Executable);
+		if (cache is { IsClean: true }) {
+			irUnits = phases.Measure("cache-restore", () => cache.RestoreIr(Path.Combine(projectRoot, "build"))).Select(path => new LlvmUnit(path)).ToList();
+		}
+		else {
+			var units = phases.Measure("parse", () => ParseUnits(sourceFiles));
+			var externUnits = phases.Measure("parse-extern", () => ParseUnits(externFiles));
+
+			// Build the cross-cutting symbol registry once over all units (user + extern). Both the
+			// analyzer and CIR generator read from the same registry — keeps their views in sync.
+			var symbols = phases.Measure("symbols", () => SymbolRegistry.Build(units, externUnits, externMetadata, phases));
+
+			// Units whose contents and surroundings are unchanged since an earlier build replay its
+			// analysis: from the build cache on disk, or from a long-lived host's last build of
+			// this project.
+			var analysisContext = Units != null || cache != null ? AnalysisContext.Of(symbols, externUnits, metadataFiles, config.Build.AllowLeaks) : null;
+			var reusable = new Dictionary<string, UnitAnalysis>(StringComparer.Ordinal);
+			if (analysisContext != null) {
+				foreach (var (path, analysis) in cache?.ReusableAnalyses(analysisContext, units) ?? new Dictionary<string, UnitAnalysis>()) reusable[path] = analysis;
+				foreach (var (path, analysis) in Units?.Analyses.Reusable(sourceRoot, analysisContext, units) ?? new Dictionary<string, UnitAnalysis>()) reusable[path] = analysis;
+			}
+
+			var analyzer = new SemanticAnalyzer(units, sourceRoot, symbols, externUnits, config.Build.AllowLeaks) {
+				Reusable = analysisContext != null ? reusable : null
+			};
+			phases.Measure("analyze", () => analyzer.Analyze(requireMain: config.Build.OutputType == OutputType.Executable));
+			if (analysisContext != null) {
+				Units?.Analyses.Store(sourceRoot, analysisContext, units, analyzer.UnitResults, analyzer.WalkedCount);
+				cache?.StoreAnalyses(analysisContext, units, analyzer.UnitResults);
+			}
+
+			var cirGenerator = new CirGenerator(symbols, config.Build.OutputType);
+			var lowered = phases.Measure("lower", () => cirGenerator.Generate(units, analyzer.InferredVarTypes));
+			var passes = CirPassManager.Default();
+			module = phases.Measure("passes", () => passes.Run(lowered, new CirPassContext(profile, config.Build.OutputType, pgoProfile)));
+			PassTimings = passes.Timings;
+
+			// Libraries publish their signatures and vtable slot positions so dependents can skip
+			// parsing their sources. Written into build/ so a later cache-hit build can still
+			// install it. A library whose metadata can't carry everything publishes none, and a
+			// stale file from an earlier build goes too.
+			if (config.Build.OutputType == OutputType.Library) {
+				var metadata = SymbolMetadata.FromRegistry(symbols, module.DispatchLayout.PositionOf);
+				var metadataPath = Path.Combine(projectRoot, "build", SymbolMetadata.FileName);
+				if (metadata.RequiresSources) File.Delete(metadataPath);
+				else metadata.Write(metadataPath);
+			}
 
-		var cirGenerator = new CirGenerator(symbols);
-		var module = cirGenerator.Generate(units, analyzer.InferredVarTypes);
+			var emitter = new LlvmEmitter(module, config, projectRoot, Pgo, pgoProfile, Bench);
+			// The in-process backend takes the IR straight from memory; clang reads it from build/.
+			irUnits = phases.Measure("emit", () => inProcess ? emitter.EmitToMemory(codegenUnits) : emitter.Emit(codegenUnits).Select(path => new LlvmUnit(path)).ToList());
 
-		var emitter = new LlvmEmitter(module, config, projectRoot);
-		var llPath = emitter.Emit();
+			if (cache != null) phases.Measure("cache-store", () => cache.Store(irUnits));
+		}
 
 		if (config.Build.OutputType == OutputType.Library) {
-			BuildLibrary(llPath, config, projectRoot);
+			BuildLibrary(irUnits, config, projectRoot, profile, inProcess, phases, cache);
 		}
 		else {
-			var libsToLink = ResolveDependencies(config);
-			InvokeClang(llPath, config, projectRoot, libsToLink);
+			var libsToLink = phases.Measure("dependencies", () => ResolveDependencies(config, profile, phases));
+
+			// A single unit compiled by clang is compiled and linked in one invocation.
+			// Otherwise the units are compiled to objects in parallel and clang only links.
+			// With a build cache the objects go through it, so the one-invocation shortcut is skipped.
+			var linkInputs = !inProcess && irUnits.Count == 1 && cache == null ? [irUnits[0].Path] : phases.Measure("codegen", () => CompileObjects(irUnits, profile, inProcess, rawProfilePattern, cache));
+			var exeStem = Bench ? config.Project.Name + "-bench" : config.Project.Name;
+			phases.Measure("link", () => InvokeClang(linkInputs, exeStem, projectRoot, libsToLink, profile, rawProfilePattern));
 		}
 
 		return module;
 	}
 
 	/// <summary>
-	/// Parses all source files located in the specified source root directory and converts them into a list of compilation units.
+	/// Resolves the optimization settings declared by the project's <c>[build]</c> table.
+	/// An unknown profile name or out-of-range <c>optLevel</c> is reported against the
+	/// build.toml and terminates the process.
+	/// </summary>
+	/// <param name="config">The parsed project configuration.</param>
+	/// <param name="tomlPath">The path of the build.toml, used in the error message.</param>
+	/// <returns>The effective <see cref="ProfileSettings"/> for this build.</returns>
+	private static ProfileSettings ResolveProfile(ClothConfig config, string tomlPath) {
+		try {
+			return ProfileSettings.Resolve(config.Build);
+		}
+		catch (ArgumentException e) {
+			Console.Error.WriteLine($"Error: {e.Message} in '{tomlPath}'");
+			FatalErrors.Exit(1);
+			return null!;
+		}
+	}
+
+	/// <summary>
+	/// Resolves the code generation backend declared by the project's <c>[build] backend</c> key.
+	/// An unknown backend name is reported against the build.toml and terminates the process.
+	/// </summary>
+	/// <param name="config">The parsed project configuration.</param>
+	/// <param name="tomlPath">The path of the build.toml, used in the error message.</param>
+	/// <returns>The <see cref="CodegenBackend"/> for this build.</returns>
+	private static CodegenBackend ResolveBackend(ClothConfig config, string tomlPath) {
+		try {
+			return ClothConfig.StringToBackend(config.Build.Backend);
+		}
+		catch (ArgumentException e) {
+			Console.Error.WriteLine($"Error: {e.Message} in '{tomlPath}'");
+			FatalErrors.Exit(1);
+			return default;
+		}
+	}
+
+	/// <summary>
+	/// Whether this build's objects come from the in-process LLVM backend. Under <c>backend = "inprocess"</c>,
+	/// bitcode profiles still compile through <c>clang -c -flto=thin</c>, the only writer of the module summary
+	/// a ThinLTO link needs (see <see cref="InProcessBackend.Supports"/>).
+	/// </summary>
+	/// <param name="backend">The configured <see cref="CodegenBackend"/>.</param>
+	/// <param name="profile">The effective optimization settings.</param>
+	/// <returns>True when the in-process backend compiles the IR units.</returns>
+	private static bool CompilesInProcess(CodegenBackend backend, ProfileSettings profile) =>
+		backend == CodegenBackend.InProcess && InProcessBackend.Supports(profile);
+
+	/// <summary>
+	/// Resolves the <c>[build] codegenUnits</c> key: the number of units function bodies are split into
+	/// for parallel emission and compilation, with 0 meaning one per processor. A negative count is
+	/// reported against the build.toml and terminates the process.
+	/// </summary>
+	/// <param name="config">The parsed project configuration.</param>
+	/// <param name="tomlPath">The path of the build.toml, used in the error message.</param>
+	/// <returns>The effective number of codegen units, at least 1.</returns>
+	private static int ResolveCodegenUnits(ClothConfig config, string tomlPath) {
+		var units = config.Build.CodegenUnits;
+		if (units < 0) {
+			Console.Error.WriteLine($"Error: Invalid codegenUnits: {units} (expected 0 or more) in '{tomlPath}'");
+			FatalErrors.Exit(1);
+		}
+
+		return units == 0 ? Environment.ProcessorCount : units;
+	}
+
+	/// <summary>
+	/// Merges the raw profiles the project's <c>--pgo=instrument</c> runs left in <c>build/pgo/</c> into
+	/// <c>build/pgo/&lt;Name&gt;.proftext</c> with <c>llvm-profdata merge -text</c>. With no raw profiles left,
+	/// an earlier merge is used as-is. Missing profile data, or a missing <c>llvm-profdata</c>, is reported
+	/// and terminates the process.
+	/// </summary>
+	/// <param name="config">The parsed project configuration.</param>
+	/// <returns>The merged profile in <c>llvm-profdata</c>'s text format.</returns>
+	private string MergePgoProfiles(ClothConfig config) {
+		var pgoDir = PgoProfile.ProfileDirectory(projectRoot);
+		var textPath = PgoProfile.TextProfilePath(projectRoot, config.Project.Name);
+		var rawPaths = Directory.Exists(pgoDir) ? Directory.GetFiles(pgoDir, $"{config.Project.Name}-*.profraw") : [];
+		if (rawPaths.Length > 0) {
+			Array.Sort(rawPaths, StringComparer.Ordinal);
+			try {
+				RunTool("llvm-profdata", ["merge", "-text", "-o", textPath, .. rawPaths]);
+			}
+			catch (FileNotFoundException) {
+				Console.Error.WriteLine("Error: llvm-profdata not found in PATH; --pgo=use needs it to merge the recorded profiles");
+				FatalErrors.Exit(1);
+			}
+		}
+
+		if (!File.Exists(textPath)) {
+			Console.Error.WriteLine($"Error: no profile data in '{pgoDir}'. Build with --pgo=instrument and run the program first (cloth run --pgo=instrument)");
+			FatalErrors.Exit(1);
+		}
+
+		return File.ReadAllText(textPath);
+	}
+
+	/// <summary>
+	/// Collects every ".co" file under the specified source root, sorted by path (ordinal) so that parse
+	/// order, cache manifests, and everything downstream are independent of filesystem enumeration order.
+	/// </summary>
+	/// <param name="sourceRoot">The root directory to search, including its subdirectories.</param>
+	/// <returns>The sorted list of source file paths.</returns>
+	private static List<string> CollectSourceFiles(string sourceRoot) {
+		var paths = Directory.EnumerateFiles(sourceRoot, "*.co", SearchOption.AllDirectories).ToList();
+		paths.Sort(StringComparer.Ordinal);
+		return paths;
+	}
+
+	/// <summary>
+	/// Parses the specified source files and converts them into a list of compilation units.
 	/// Each compilation unit represents a single parsed source file, including its structure, imports, and types.
+	/// Files are lexed and parsed in parallel, but the result keeps the order of <paramref name="paths"/>, so the
+	/// symbol registry, diagnostics, and emitted IR are identical to a serial build regardless of scheduling.
+	/// With <see cref="Units"/> set, files unchanged since an earlier build in this process are taken from it.
 	/// </summary>
-	/// <param name="sourceRoot">
-	/// The root directory containing the source files to parse. All files with the extension ".co" within this directory
-	/// and its subdirectories will be processed.
+	/// <param name="paths">
+	/// The source files to parse, as returned by <see cref="CollectSourceFiles"/>.
 	/// </param>
 	/// <returns>
 	/// A list of tuples where each tuple consists of a parsed <see cref="CompilationUnit"/> representing a source file
-	/// and the corresponding file path.
+	/// and the corresponding file path, in input order.
 	/// </returns>
-	private static List<(CompilationUnit Unit, string FilePath)> ParseUnits(string sourceRoot) {
-		var result = new List<(CompilationUnit Unit, string FilePath)>();
-		foreach (var filePath in Directory.EnumerateFiles(sourceRoot, "*.co", SearchOption.AllDirectories)) {
-			var fileName = Path.GetFileNameWithoutExtension(filePath);
-			var clothFile = new ClothFile(filePath, fileName);
-			var unit = new Parser(new Lexer(clothFile)).Parse();
-			result.Add((unit, filePath));
+	private List<(CompilationUnit Unit, string FilePath)> ParseUnits(List<string> paths) {
+		// Each slot is written by exactly one worker, so no synchronization is needed beyond
+		// the join at the end of Parallel.For. A worker's lexer and parser diagnostics are
+		// captured (see `FatalErrors.Capture`) and replayed here in path order, stopping at the
+		// first fatal one, so the report is a serial parse's whatever the scheduling.
+		var units = new CompilationUnit[paths.Count];
+		var logs = new StringWriter[paths.Count];
+		var outcomes = new Exception?[paths.Count];
+		Parallel.For(0, paths.Count, i => {
+			var fileName = Path.GetFileNameWithoutExtension(paths[i]);
+			CompilationUnit Parse() => new Parser(new Lexer(new ClothFile(paths[i], fileName))).Parse();
+			logs[i] = new StringWriter();
+			FatalErrors.Capture = logs[i];
+			try {
+				units[i] = Units != null ? Units.GetOrParse(paths[i], Parse) : Parse();
+			}
+			catch (Exception e) {
+				outcomes[i] = e;
+			}
+			finally {
+				FatalErrors.Capture = null;
+			}
+		});
+
+		var result = new List<(CompilationUnit Unit, string FilePath)>(paths.Count);
+		for (var i = 0; i < paths.Count; i++) {
+			Console.Error.Write(logs[i].ToString());
+			if (outcomes[i] is CompilationAbortedException aborted) FatalErrors.Exit(aborted.ExitCode);
+			if (outcomes[i] is { } failure) ExceptionDispatchInfo.Capture(failure).Throw();
+			result.Add((units[i], paths[i]));
 		}
 
 		return result;
@@ -116,10 +395,11 @@ public class Compiler(string projectRoot) {
 	/// <summary>
 	/// Builds a static library from the provided LLVM intermediate representation (IR) file.
 	/// This method compiles the LLVM IR file into an object file, creates a static library,
-	/// and installs the library into a versioned cache directory for reusability.
+	/// and installs the library into a versioned cache directory for reusability, together with the
+	/// library's <see cref="SymbolMetadata"/> so dependent builds can load its signatures without parsing.
 	/// </summary>
-	/// <param name="llPath">
-	/// The file path to the LLVM IR file that serves as the input for the build process.
+	/// <param name="irUnits">
+	/// The LLVM IR units (one per codegen unit), on disk or in memory, that serve as the input for the build process.
 	/// </param>
 	/// <param name="config">
 	/// The configuration object containing project-specific build and dependency information.
@@ -128,22 +408,85 @@ public class Compiler(string projectRoot) {
 	/// <param name="projectRoot">
 	/// The root directory of the project, used to resolve paths for build outputs and cache installation.
 	/// </param>
-	private static void BuildLibrary(string llPath, ClothConfig config, string projectRoot) {
+	/// <param name="profile">
+	/// The optimization settings. When <see cref="ProfileSettings.EmitBitcode"/> is set, the archive holds
+	/// ThinLTO bitcode rather than native code so consumers can inline across the library boundary.
+	/// </param>
+	/// <param name="inProcess">
+	/// Whether the objects are produced by the in-process LLVM backend rather than <c>clang -c</c> child processes.
+	/// </param>
+	/// <param name="phases">Records the object compilation and archiving as the <c>codegen</c> and <c>archive</c> phases.</param>
+	/// <param name="cache">The build cache objects are restored from and stored in, or null for a non-incremental build.</param>
+	private static void BuildLibrary(IReadOnlyList<LlvmUnit> irUnits, ClothConfig config, string projectRoot, ProfileSettings profile, bool inProcess, PhaseRecorder phases, BuildCache? cache) {
 		var buildDir = Path.Combine(projectRoot, "build");
-		var objPath = Path.Combine(buildDir, config.Project.Name + ".o");
 
-		RunTool("clang", new[] { "-c", llPath, "-o", objPath });
+		// Bitcode profiles put bitcode into the .o files; llvm-lib indexes bitcode members
+		// natively, so the archive step is the same for both kinds.
+		var objPaths = phases.Measure("codegen", () => CompileObjects(irUnits, profile, inProcess, cache: cache));
 
-		var libPath = Path.Combine(buildDir, "cloth.lib");
-		RunTool("llvm-lib", new[] { "/OUT:" + libPath, objPath });
+		var libPath = Path.Combine(buildDir, profile.LibraryFileName);
+		phases.Measure("archive", () => RunTool("llvm-lib", ["/OUT:" + libPath, .. objPaths]));
 
 		var cacheDir = StdlibCacheDir("cloth", config.Project.Version);
 		Directory.CreateDirectory(cacheDir);
-		var installedLib = Path.Combine(cacheDir, "cloth.lib");
+		var installedLib = Path.Combine(cacheDir, profile.LibraryFileName);
 		File.Copy(libPath, installedLib, overwrite: true);
+
+		var metadataPath = Path.Combine(buildDir, SymbolMetadata.FileName);
+		var installedMetadata = Path.Combine(cacheDir, SymbolMetadata.FileName);
+		if (File.Exists(metadataPath)) File.Copy(metadataPath, installedMetadata, overwrite: true);
+		else File.Delete(installedMetadata);
 		Console.WriteLine($"Library installed: {installedLib}");
 	}
 
+	/// <summary>
+	/// Compiles each LLVM IR unit to an object file next to its path (<c>X.ll</c> to <c>X.o</c>). The units are
+	/// independent, so they are compiled in parallel.
+	/// </summary>
+	/// <param name="irUnits">
+	/// The LLVM IR units to compile. Units emitted in memory are only produced for the in-process backend.
+	/// </param>
+	/// <param name="profile">
+	/// The optimization settings. With <see cref="ProfileSettings.Lto"/> (<c>-flto=thin -c</c>) the objects
+	/// hold ThinLTO bitcode instead of native code.
+	/// </param>
+	/// <param name="inProcess">
+	/// Whether each object is produced by the in-process LLVM backend rather than a <c>clang -c</c> child process.
+	/// </param>
+	/// <param name="rawProfilePattern">
+	/// For a <c>--pgo=instrument</c> build, where the binary writes its profiles; the IR's
+	/// <c>llvm.instrprof.increment</c> counters are then lowered against the profiling runtime.
+	/// </param>
+	/// <param name="cache">
+	/// When set, a unit whose IR an earlier build already compiled under the same settings gets that object back
+	/// instead of being compiled again.
+	/// </param>
+	/// <returns>The object file paths, in the order of <paramref name="irUnits"/>.</returns>
+	private static List<string> CompileObjects(IReadOnlyList<LlvmUnit> irUnits, ProfileSettings profile, bool inProcess, string? rawProfilePattern = null, BuildCache? cache = null) {
+		var objPaths = irUnits.Select(unit => Path.ChangeExtension(unit.Path, ".o")).ToList();
+		var variant = (inProcess ? "in-process" : "clang") + (rawProfilePattern != null ? " instrument=" + rawProfilePattern : "");
+		Parallel.For(0, irUnits.Count, i => {
+			var key = cache?.ObjectKey(irUnits[i], variant);
+			if (key != null && cache!.TryRestoreObject(key, objPaths[i])) return;
+
+			if (inProcess) {
+				InProcessBackend.Compile(irUnits[i], objPaths[i], profile, instrument: rawProfilePattern != null);
+			}
+			else {
+				var compileArgs = new List<string> { "-c" };
+				compileArgs.AddRange(profile.ClangFlags());
+				if (rawProfilePattern != null) compileArgs.Add($"-fprofile-instr-generate={rawProfilePattern}");
+				compileArgs.AddRange([irUnits[i].Path, "-o", objPaths[i]]);
+				RunTool("clang", compileArgs.ToArray());
+			}
+
+			if (key != null) cache!.StoreObject(key, objPaths[i]);
+		});
+
+		cache?.PruneObjects();
+		return objPaths;
+	}
+
 	/// <summary>
 	/// Resolves a list of library dependencies required for compiling the project.
 	/// This method scans the specified configuration for declared dependencies,
@@ -153,27 +496,34 @@ public class Compiler(string projectRoot) {
 	/// The configuration object containing dependency information. This includes a dictionary
 	/// mapping dependency names to their required versions.
 	/// </param>
+	/// <param name="profile">
+	/// The consumer's optimization settings. Cached libraries are looked up by the profile's library
+	/// file name, and missing ones are built with the same settings.
+	/// </param>
+	/// <param name="phases">Receives the <see cref="PhaseTimings"/> of each dependency built here.</param>
 	/// <returns>
 	/// A list of file paths to the resolved and cached library files required for the project compilation.
 	/// If a dependency cannot be resolved, the process will exit with an error.
 	/// </returns>
-	private List<string> ResolveDependencies(ClothConfig config) {
+	private List<string> ResolveDependencies(ClothConfig config, ProfileSettings profile, PhaseRecorder phases) {
 		var libs = new List<string>();
 		foreach (var (name, version) in config.Dependencies) {
-			var libPath = FindCachedLib(name, version);
+			var libPath = FindCachedLib(name, version, profile.LibraryFileName);
 			if (libPath == null) {
 				var stdlibRoot = ResolveStdlibRoot(name);
 				if (stdlibRoot == null) {
 					Console.Error.WriteLine($"Error: cannot locate the Cloth standard library for dependency '{name}={version}'.\n" + "  Tried (in order):\n" + "    1. CLOTH_STDLIB_PATH environment variable\n" + $"    2. {Path.Combine(AppContext.BaseDirectory, "Standard-Library")}\n" + "    3. Walking up from the compiler binary's directory\n" + "  Set CLOTH_STDLIB_PATH or place Standard-Library next to the compiler binary.");
-					Environment.Exit(1);
+					FatalErrors.Exit(1);
 				}
 
 				Console.WriteLine($"Building dependency '{name}' from {stdlibRoot}...");
-				new Compiler(stdlibRoot).Compile();
-				libPath = FindCachedLib(name, version);
+				var dependency = new Compiler(stdlibRoot, profile) { Units = Units };
+				dependency.Compile();
+				phases.Include(dependency.PhaseTimings);
+				libPath = FindCachedLib(name, version, profile.LibraryFileName);
 				if (libPath == null) {
 					Console.Error.WriteLine($"Error: dependency '{name}={version}' build did not produce a .lib in cache");
-					Environment.Exit(1);
+					FatalErrors.Exit(1);
 				}
 			}
 
@@ -195,19 +545,22 @@ public class Compiler(string projectRoot) {
 	/// The version of the dependency to locate in the cache. Version pinning may not be enforced, in which case
 	/// this method may return any cached version of the named dependency.
 	/// </param>
+	/// <param name="libFileName">
+	/// The archive file name to look for inside the version directory (see <see cref="ProfileSettings.LibraryFileName"/>).
+	/// </param>
 	/// <returns>
 	/// The full file system path to the cached library file if found; otherwise, null if no matching or compatible
 	/// library file is located in the cache.
 	/// </returns>
-	private static string? FindCachedLib(string name, string version) {
-		var exact = Path.Combine(StdlibCacheDir(name, version), "cloth.lib");
+	private static string? FindCachedLib(string name, string version, string libFileName) {
+		var exact = Path.Combine(StdlibCacheDir(name, version), libFileName);
 		if (File.Exists(exact)) return exact;
 
 		var nameDir = Path.Combine(UserCacheRoot(), $"{name}-*");
 		var libRoot = Path.Combine(Environment.GetFolderPath(Environment.SpecialFolder.UserProfile), ".cloth", "lib");
 		if (!Directory.Exists(libRoot)) return null;
 		foreach (var dir in Directory.EnumerateDirectories(libRoot, $"{name}-*")) {
-			var candidate = Path.Combine(dir, "cloth.lib");
+			var candidate = Path.Combine(dir, libFileName);
 			if (File.Exists(candidate)) {
 				Console.WriteLine($"note: stdlib version pin '{version}' not enforced; using {dir}");
 				return candidate;
@@ -299,11 +652,12 @@ public class Compiler(string projectRoot) {
 	/// This method attempts to execute the "clang" tool with the specified arguments and writes the resulting executable
 	/// to the build output directory. If Clang is not found in the system's PATH, a manual invocation command is suggested.
 	/// </summary>
-	/// <param name="llPath">
-	/// The full path to the LLVM IR file that serves as input for the Clang compiler.
+	/// <param name="inputs">
+	/// The project's own inputs for the Clang compiler: the LLVM IR file of a single-unit build, or the object
+	/// files produced by <see cref="CompileObjects"/>.
 	/// </param>
-	/// <param name="config">
-	/// The build configuration, which provides project-level details such as the name of the target executable and other build parameters.
+	/// <param name="exeStem">
+	/// The executable's file name without extension: the project name, or <c>&lt;Name&gt;-bench</c> for a <see cref="Bench"/> build.
 	/// </param>
 	/// <param name="projectRoot">
 	/// The root directory of the project, which is used to determine the build output directory.
@@ -311,16 +665,27 @@ public class Compiler(string projectRoot) {
 	/// <param name="extraInputs">
 	/// An enumerable collection of additional input files that are passed to the Clang compiler during execution.
 	/// </param>
+	/// <param name="profile">
+	/// The optimization settings; supplies the <c>-O</c> level and, for LTO profiles, ThinLTO plus lld as the linker.
+	/// </param>
+	/// <param name="rawProfilePattern">
+	/// For a <c>--pgo=instrument</c> build, where the binary writes its profiles; also links the profiling runtime.
+	/// </param>
 	/// <exception cref="FileNotFoundException">
 	/// Thrown when the Clang tool is not found in the system's PATH.
 	/// </exception>
-	private static void InvokeClang(string llPath, ClothConfig config, string projectRoot, IEnumerable<string> extraInputs) {
+	private static void InvokeClang(IReadOnlyList<string> inputs, string exeStem, string projectRoot, IEnumerable<string> extraInputs, ProfileSettings profile, string? rawProfilePattern = null) {
 		var buildDir = Path.Combine(projectRoot, "build");
-		var exeName = config.Project.Name + (OperatingSystem.IsWindows() ? ".exe" : "");
+		var exeName = exeStem + (OperatingSystem.IsWindows() ? ".exe" : "");
 		var exePath = Path.Combine(buildDir, exeName);
 
-		var args = new List<string> { llPath };
+		var args = new List<string>(profile.ClangFlags());
+		if (rawProfilePattern != null) args.Add($"-fprofile-instr-generate={rawProfilePattern}");
+		args.AddRange(inputs);
 		args.AddRange(extraInputs);
+
+		// ThinLTO needs an LTO-capable linker to read the bitcode members of the stdlib archive.
+		if (profile.Lto) args.Add("-fuse-ld=lld");
 		args.Add("-o");
 		args.Add(exePath);
 
@@ -375,7 +740,7 @@ public class Compiler(string projectRoot) {
 			if (proc.ExitCode != 0) {
 				Console.Error.Write(proc.StandardError.ReadToEnd());
 				Console.Error.Write(proc.StandardOutput.ReadToEnd());
-				Environment.Exit(1);
+				FatalErrors.Exit(1);
 			}
 		}
 	}
@@ -5,6 +5,7 @@
 // Use, modification, and distribution of this file are governed by the
 // license terms provided with the Cloth Compiler source distribution.
 
+using Compiler.Configs.Profiles;
 using Compiler.Configs.Sections;
 
 namespace Compiler.Configs;
@@ -27,4 +28,43 @@ public record ClothConfig {
 		OutputType.Object => "object",
 		_ => throw new ArgumentException($"Invalid output type: {type}")
 	};
+
+	public static BuildProfile StringToProfile(string str) => str switch {
+		"debug" => BuildProfile.Debug,
+		"release" => BuildProfile.Release,
+		"release-lto" => BuildProfile.ReleaseLto,
+		_ => throw new ArgumentException($"Invalid build profile: {str}")
+	};
+
+	public static string ProfileToString(BuildProfile profile) => profile switch {
+		BuildProfile.Debug => "debug",
+		BuildProfile.Release => "release",
+		BuildProfile.ReleaseLto => "release-lto",
+		_ => throw new ArgumentException($"Invalid build profile: {profile}")
+	};
+
+	public static CodegenBackend StringToBackend(string str) => str switch {
+		"clang" => CodegenBackend.Clang,
+		"inprocess" => CodegenBackend.InProcess,
+		_ => throw new ArgumentException($"Invalid backend: {str}")
+	};
+
+	public static string BackendToString(CodegenBackend backend) => backend switch {
+		CodegenBackend.Clang => "clang",
+		CodegenBackend.InProcess => "inprocess",
+		_ => throw new ArgumentException($"Invalid backend: {backend}")
+	};
+
+	public static PgoMode StringToPgoMode(string str) => str switch {
+		"instrument" => PgoMode.Instrument,
+		"use" => PgoMode.Use,
+		_ => throw new ArgumentException($"Invalid PGO mode: {str} (expected 'instrument' or 'use')")
+	};
+
+	public static string PgoModeToString(PgoMode mode) => mode switch {
+		PgoMode.None => "none",
+		PgoMode.Instrument => "instrument",
+		PgoMode.Use => "use",
+		_ => throw new ArgumentException($"Invalid PGO mode: {mode}")
+	};
 }
\ No newline at end of file
@@ -0,0 +1,17 @@
+// Copyright (c) 2026.The Cloth contributors.
+//
+// CodegenBackend.cs is part of the Cloth Compiler.
+//
+// Use, modification, and distribution of this file are governed by the
+// license terms provided with the Cloth Compiler source distribution.
+
+namespace Compiler.Configs;
+
+// How the emitted IR becomes native code, selected by `[build] backend = "..."`.
+// `Clang` spawns `clang -c` per output; `InProcess` compiles the IR from memory through
+// the LLVM C API (`LLVM.InProcessBackend`), except under bitcode profiles, which need
+// clang's ThinLTO summary. Linking is out of scope for either: both link with clang.
+public enum CodegenBackend {
+	Clang,
+	InProcess
+}
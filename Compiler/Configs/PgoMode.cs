@@ -0,0 +1,19 @@
+// Copyright (c) 2026.The Cloth contributors.
+//
+// PgoMode.cs is part of the Cloth Compiler.
+//
+// Use, modification, and distribution of this file are governed by the
+// license terms provided with the Cloth Compiler source distribution.
+
+namespace Compiler.Configs;
+
+// Profile-guided optimization step, selected on the command line by `--pgo=instrument` /
+// `--pgo=use` rather than in build.toml, since a project alternates between the two without
+// editing its configuration. `Instrument` builds a binary that counts how often each branch
+// runs and writes the counts under `build/pgo/`; `Use` merges those counts and optimizes
+// with them (`Pgo.PgoProfile`). Dependencies are never instrumented.
+public enum PgoMode {
+	None,
+	Instrument,
+	Use
+}
@@ -0,0 +1,17 @@
+// Copyright (c) 2026.The Cloth contributors.
+//
+// BuildProfile.cs is part of the Cloth Compiler.
+//
+// Use, modification, and distribution of this file are governed by the
+// license terms provided with the Cloth Compiler source distribution.
+
+namespace Compiler.Configs.Profiles;
+
+// Named optimization presets selectable via `[build] profile = "..."`. The TOML spelling
+// ("debug" / "release" / "release-lto") is mapped by `ClothConfig.StringToProfile`, since
+// `release-lto` isn't a valid enum identifier for Tomlyn to bind against directly.
+public enum BuildProfile {
+	Debug,
+	Release,
+	ReleaseLto
+}
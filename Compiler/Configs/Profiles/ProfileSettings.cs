@@ -0,0 +1,56 @@
+// Copyright (c) 2026.The Cloth contributors.
+//
+// ProfileSettings.cs is part of the Cloth Compiler.
+//
+// Use, modification, and distribution of this file are governed by the
+// license terms provided with the Cloth Compiler source distribution.
+
+using Compiler.Configs.Sections;
+
+namespace Compiler.Configs.Profiles;
+
+// Concrete backend knobs a `BuildProfile` expands to. `OptLevel` is the clang `-O<n>`
+// level; `Lto` turns on ThinLTO for both the compile and the final link; `EmitBitcode`
+// makes library builds archive LLVM bitcode instead of native objects, so a consumer's
+// LTO link can inline across the `.lib` boundary (stdlib calls like `cloth.io.Out`).
+// `CompactLayout` (`fieldLayout = "compact"`, off in every profile) reorders class fields.
+public sealed record ProfileSettings(BuildProfile Profile, int OptLevel, bool Lto, bool EmitBitcode) {
+	public bool CompactLayout { get; init; }
+
+	public static ProfileSettings For(BuildProfile profile) => profile switch {
+		BuildProfile.Debug => new ProfileSettings(profile, 0, false, false),
+		BuildProfile.Release => new ProfileSettings(profile, 2, false, false),
+		BuildProfile.ReleaseLto => new ProfileSettings(profile, 2, true, true),
+		_ => throw new ArgumentException($"Invalid build profile: {profile}")
+	};
+
+	// Resolve the effective settings for a `[build]` table: the named profile's defaults,
+	// with an explicit `optLevel` taking precedence over the profile's `-O` level, and the
+	// `fieldLayout` choice on top.
+	public static ProfileSettings Resolve(BuildSection build) {
+		var settings = For(ClothConfig.StringToProfile(build.Profile));
+		if (build.OptLevel is { } level) {
+			if (level is < 0 or > 3) throw new ArgumentException($"Invalid optLevel: {level} (expected 0-3)");
+			settings = settings with { OptLevel = level };
+		}
+
+		settings = build.FieldLayout switch {
+			"declared" => settings,
+			"compact" => settings with { CompactLayout = true },
+			_ => throw new ArgumentException($"Invalid fieldLayout: {build.FieldLayout} (expected \"declared\" or \"compact\")")
+		};
+
+		return settings;
+	}
+
+	// `-O<n>` plus ThinLTO when enabled. Shared by every clang invocation that compiles IR.
+	public IEnumerable<string> ClangFlags() {
+		yield return $"-O{OptLevel}";
+		if (Lto) yield return "-flto=thin";
+	}
+
+	// File name of the installed library for this profile. Bitcode and optimized archives
+	// live next to the plain -O0 `cloth.lib` under distinct names, so a release build never
+	// picks up a debug stdlib from the cache (or vice versa).
+	public string LibraryFileName => EmitBitcode ? "cloth.bc.lib" : OptLevel == 0 ? "cloth.lib" : $"cloth.O{OptLevel}.lib";
+}
@@ -17,4 +17,26 @@ public record BuildSection {
 	// iterating on incomplete code; the build still produces a binary. Default false:
 	// leaks are errors, matching the deterministic-destruction language model.
 	public bool AllowLeaks { get; init; } = false;
+
+	// Optimization preset: "debug" (-O0), "release" (-O2), or "release-lto" (-O2 plus
+	// ThinLTO and bitcode stdlib archives). See `Profiles.ProfileSettings`.
+	public string Profile { get; init; } = "debug";
+
+	// Explicit clang `-O` level (0-3). When set, overrides the level implied by `Profile`
+	// without changing its LTO behaviour.
+	public int? OptLevel { get; init; }
+
+	// Native code generation: "clang" (spawn `clang -c` on the emitted .ll) or "inprocess"
+	// (compile the IR from memory through the LLVM C API, no child process and no .ll).
+	// Bitcode profiles compile with clang under either, and clang always links.
+	public string Backend { get; init; } = "clang";
+
+	// Number of codegen units function bodies are split into; each is emitted and compiled
+	// to its own object in parallel, then linked. 1 keeps a single .ll; 0 uses one unit per
+	// processor.
+	public int CodegenUnits { get; init; } = 1;
+
+	// Class struct layout: "declared" keeps each class's fields in source order; "compact"
+	// lets the `field-layout` pass reorder every class's own fields as `@Compact` does for one.
+	public string FieldLayout { get; init; } = "declared";
 }
\ No newline at end of file
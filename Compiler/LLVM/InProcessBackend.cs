@@ -0,0 +1,120 @@
+// Copyright (c) 2026.The Cloth contributors.
+//
+// InProcessBackend.cs is part of the Cloth Compiler.
+//
+// Use, modification, and distribution of this file are governed by the
+// license terms provided with the Cloth Compiler source distribution.
+
+using System.Runtime.InteropServices;
+using System.Text;
+using Compiler.Configs.Profiles;
+
+namespace Compiler.LLVM;
+
+// `[build] backend = "inprocess"`: turns the emitter's IR into an object file through the
+// LLVM C API instead of a `clang -c` child process. The IR is handed over in memory
+// (`LlvmEmitter.EmitToMemory`) and parsed from a memory buffer; only a unit restored from
+// the build cache is read from its file. The optimization pipeline is the one clang would
+// pick for the same flags — `default<On>` — followed by `instrprof` for a `--pgo=instrument`
+// build, as clang lowers front-end counters after optimization. The profile file then comes
+// from `LLVM_PROFILE_FILE` (`cloth run`).
+//
+// Bitcode profiles are not compiled here (`Supports`): a ThinLTO link needs each bitcode
+// object to carry a module summary, and the C API's bitcode writer writes none — the
+// ThinLTO bitcode writer is only reachable from C++. Those units go through
+// `clang -c -flto=thin` as with the clang backend.
+//
+// Linking is out of scope: the C API has no linker, so executables are still linked by
+// clang and libraries archived by llvm-lib.
+public static class InProcessBackend {
+	private static readonly object InitLock = new();
+	private static bool _targetsInitialized;
+
+	// Whether this backend can produce `profile`'s objects.
+	public static bool Supports(ProfileSettings profile) => !profile.EmitBitcode;
+
+	// Compile `unit` to the object file `outPath`. Every LLVM failure (missing library, parse
+	// error, unknown triple, codegen error) is reported and exits, like a failed `clang -c`.
+	public static void Compile(LlvmUnit unit, string outPath, ProfileSettings profile, bool instrument = false) {
+		try {
+			CompileCore(unit, outPath, profile, instrument);
+		}
+		catch (Exception e) when (e is DllNotFoundException or EntryPointNotFoundException) {
+			LlvmError.BackendUnavailable.WithMessage($"{e.Message} (set {LlvmNative.LibraryPathVariable} to the LLVM 15+ shared library, or use backend = \"clang\")").Render();
+		}
+	}
+
+	private static void CompileCore(LlvmUnit unit, string outPath, ProfileSettings profile, bool instrument) {
+		InitializeTargets();
+
+		var context = LlvmNative.LLVMContextCreate();
+		try {
+			IntPtr buffer, message;
+			if (unit.Ir != null) {
+				var bytes = Encoding.UTF8.GetBytes(unit.Ir);
+				buffer = LlvmNative.LLVMCreateMemoryBufferWithMemoryRangeCopy(bytes, (nuint)bytes.Length, unit.Path);
+			}
+			else if (LlvmNative.LLVMCreateMemoryBufferWithContentsOfFile(unit.Path, out buffer, out message) != 0) {
+				Fail($"cannot read '{unit.Path}': {LlvmNative.TakeMessage(message)}");
+			}
+
+			if (LlvmNative.LLVMParseIRInContext(context, buffer, out var module, out message) != 0)
+				Fail($"cannot parse '{unit.Path}': {LlvmNative.TakeMessage(message)}");
+
+			try {
+				var triple = Marshal.PtrToStringUTF8(LlvmNative.LLVMGetTarget(module)) ?? "";
+				if (LlvmNative.LLVMGetTargetFromTriple(triple, out var target, out message) != 0)
+					Fail($"no backend for target '{triple}': {LlvmNative.TakeMessage(message)}");
+
+				var machine = LlvmNative.LLVMCreateTargetMachine(target, triple, "generic", "", profile.OptLevel, LlvmNative.RelocDefault, LlvmNative.CodeModelDefault);
+				try {
+					RunPipeline(module, machine, profile, instrument);
+					if (LlvmNative.LLVMTargetMachineEmitToFile(machine, module, outPath, LlvmNative.CodeGenFileTypeObject, out message) != 0)
+						Fail($"code generation failed: {LlvmNative.TakeMessage(message)}");
+				}
+				finally {
+					LlvmNative.LLVMDisposeTargetMachine(machine);
+				}
+			}
+			finally {
+				LlvmNative.LLVMDisposeModule(module);
+			}
+		}
+		finally {
+			LlvmNative.LLVMContextDispose(context);
+		}
+	}
+
+	private static void RunPipeline(IntPtr module, IntPtr machine, ProfileSettings profile, bool instrument) {
+		var pipeline = $"default<O{profile.OptLevel}>";
+		if (instrument) pipeline += ",instrprof";
+		var options = LlvmNative.LLVMCreatePassBuilderOptions();
+		try {
+			var error = LlvmNative.LLVMRunPasses(module, pipeline, machine, options);
+			if (error != IntPtr.Zero)
+				Fail($"pass pipeline '{pipeline}' failed: {LlvmNative.TakeError(error)}");
+		}
+		finally {
+			LlvmNative.LLVMDisposePassBuilderOptions(options);
+		}
+	}
+
+	// Register the backends `LlvmEmitter.ResolveTriple` can produce. Process-wide and
+	// idempotent in LLVM, but guarded anyway since dependency builds can share the process.
+	private static void InitializeTargets() {
+		lock (InitLock) {
+			if (_targetsInitialized) return;
+			LlvmNative.LLVMInitializeX86TargetInfo();
+			LlvmNative.LLVMInitializeX86Target();
+			LlvmNative.LLVMInitializeX86TargetMC();
+			LlvmNative.LLVMInitializeX86AsmPrinter();
+			LlvmNative.LLVMInitializeAArch64TargetInfo();
+			LlvmNative.LLVMInitializeAArch64Target();
+			LlvmNative.LLVMInitializeAArch64TargetMC();
+			LlvmNative.LLVMInitializeAArch64AsmPrinter();
+			_targetsInitialized = true;
+		}
+	}
+
+	private static void Fail(string message) => LlvmError.BackendFailed.WithMessage(message).Render();
+}
@@ -5,10 +5,15 @@
 // Use, modification, and distribution of this file are governed by the
 // license terms provided with the Cloth Compiler source distribution.
 
+using System.Collections.Concurrent;
 using System.Globalization;
+using System.Numerics;
 using System.Text;
 using Compiler.CIR;
+using Compiler.CIR.Passes;
 using Compiler.Configs;
+using Compiler.Configs.Profiles;
+using Compiler.Pgo;
 using Compiler.Semantics;
 
 namespace Compiler.LLVM;
@@ -21,10 +26,11 @@ public sealed class LlvmEmitter {
 	private readonly ClothConfig _config;
 	private readonly string _projectRoot;
 
-	private readonly Dictionary<string, CirTypeDecl.Class> _classByFqn = new();
-	// Enum FQN → CIR enum decl. Parallel to `_classByFqn`. Lets `EmitFieldGep` /
-	// `LlvmTypeOf` resolve a field reference when the receiver is an enum singleton.
-	private readonly Dictionary<string, CirTypeDecl.Enum> _enumByFqn = new();
+	// Views over the module's prebuilt indexes (`CirModule.ClassesByFqn` / `EnumsByFqn`).
+	// The enum table lets `EmitFieldGep` / `LlvmTypeOf` resolve a field reference when the
+	// receiver is an enum singleton.
+	private readonly IReadOnlyDictionary<string, CirTypeDecl.Class> _classByFqn;
+	private readonly IReadOnlyDictionary<string, CirTypeDecl.Enum> _enumByFqn;
 	// classFqn → flattened field layout (root-to-leaf), with the vtable header only
 	// contributed by the root. Lazily populated by GetFlattenedFields and used by both
 	// struct-type emission and field-GEP indexing so a child instance can read/write
@@ -35,6 +41,9 @@ public sealed class LlvmEmitter {
 
 	private readonly List<string> _strings = new();
 	private readonly Dictionary<string, int> _stringIndex = new();
+	// Pool indices referenced from this emitter's function bodies. Only consulted by
+	// function units, which carry private copies of just those constants.
+	private readonly HashSet<int> _usedStrings = new();
 
 	// CirFunctions whose IsExtern == true. Keyed by MangledName (literal C symbol for @Extern,
 	// or dotted CIR FQN for cross-project externs). Provides proper signatures for `declare` lines.
@@ -49,27 +58,68 @@ public sealed class LlvmEmitter {
 	private bool _needsIntPowHelper;
 	private bool _needsLibmPow;
 
-	// Set by `EmitIndexLoad` when any `arr[i]` access fires. Drives the lazy emission of
-	// the `@__cloth_panic_bounds` helper and the libc `fprintf` / `stderr` declarations
-	// used by it.
+	// Set by `EmitIndexLoad` when any checked `arr[i]` access fires (and by sub-slices).
+	// Drives the lazy emission of the `@__cloth_panic_bounds` helper and the
+	// libc `fprintf` / `stderr` declarations used by it.
 	private bool _needsBoundsPanic;
 
+	// Set by `EmitAlloc` / `EmitDelete` when a body allocates or frees a class instance
+	// (`@__cloth_pool_*`), and by `EmitFunction` for a `@Region` body (`@__cloth_region_*`).
+	private bool _needsPool;
+	private bool _needsRegion;
+
+	// Set when a `switch` dispatches on string literals or the module defines an enum's
+	// `valueOf(string)` (`@__cloth_str_hash`, plus `strcmp` to confirm a match).
+	private bool _needsStrHash;
+
+	// Set when a body runs a `parallel for` or a `join` (`@__cloth_par_for` and the thread
+	// pool behind it).
+	private bool _needsParallel;
+
 	// C-symbol → number of leading fixed parameters for variadic externs.
 	// Populated when multiple @Extern declarations alias to the same C symbol with different
 	// signatures (e.g. _printf_i32, _printf_i64 both → "printf"); the LLVM declare and call
 	// syntax must use variadic form so each call site can pass its own argument types.
 	private readonly Dictionary<string, int> _variadicLeading = new();
 
+	// Metadata nodes of this unit, numbered by first use and written after its function
+	// bodies. TBAA tags and loop properties are only attached when the profile optimizes
+	// (`_optimize`), as clang leaves them out at -O0.
+	private readonly bool _optimize;
+	private readonly List<string> _metadataNodes = new();
+	private readonly Dictionary<string, int> _metadataIds = new();
+
+	// Profile-guided optimization (`PgoCounters` layout). An instrumented build bumps the
+	// current function's counters through `llvm.instrprof.increment` on `@__profn_<fn>`;
+	// a profile-use build looks the function's recorded counts up in `_pgoProfile` and turns
+	// them into branch weights. `_pgoCounts` is null when the function has no usable counts.
+	private const string InstrProfIncrementDecl = "declare void @llvm.instrprof.increment(ptr, i64, i32, i32)";
+	private readonly PgoMode _pgo;
+	private readonly PgoProfile? _pgoProfile;
+	private PgoCounters? _pgoCounters;
+	private long[]? _pgoCounts;
+	private string _pgoNameGlobal = "";
+
+	// A `cloth bench` build: `main` drives the `@Bench` methods (`EmitBenchEntry`) instead of
+	// constructing the entry class.
+	private readonly bool _bench;
+
 	// Per-function state
 	private int _tempCounter;
 	private string _currentThisFqn = "";
 	private CirType _currentReturnType = new CirType.Void();
+	private bool _currentHasRegion;
 	private readonly List<string> _allocaLines = new();
 	private readonly List<string> _prologueLines = new();
 	private readonly List<string> _bodyLines = new();
 	private bool _blockTerminated;
 	private readonly Dictionary<string, string> _localAddrMap = new();
 	private readonly Dictionary<string, CirType> _localTypeMap = new();
+	private string _currentLlvmName = "";
+
+	// Workers outlined from the current function's parallel loops and joins (`EmitWorker`),
+	// written out right after it.
+	private readonly List<string> _workerFns = new();
 
 	// Stack of (continueLabel, breakLabel) per enclosing loop. `break;` jumps to the top
 	// frame's break label; `continue;` to its continue label. Pushed at the start of a loop
@@ -77,113 +127,234 @@ public sealed class LlvmEmitter {
 	// hard error in LLVM (no terminator target), so the analyzer should reject those.
 	private readonly Stack<(string Continue, string Break)> _loopStack = new();
 
-	public LlvmEmitter(CirModule module, ClothConfig config, string projectRoot) {
+	// Output buffer for the `.ll` stream. Function bodies are written line by line, so a
+	// larger buffer keeps the number of underlying file writes small.
+	private const int WriterBufferSize = 1 << 16;
+
+	public LlvmEmitter(CirModule module, ClothConfig config, string projectRoot, PgoMode pgo = PgoMode.None, PgoProfile? pgoProfile = null, bool bench = false) {
 		_module = module;
 		_config = config;
 		_projectRoot = projectRoot;
+		_classByFqn = module.ClassesByFqn;
+		_enumByFqn = module.EnumsByFqn;
+		_optimize = ProfileSettings.Resolve(config.Build).OptLevel > 0;
+		_pgo = pgo;
+		_pgoProfile = pgoProfile;
+		_bench = bench;
+	}
 
-		foreach (var t in _module.Types) {
-			if (t is CirTypeDecl.Class c)
-				_classByFqn[c.FullyQualifiedName] = c;
-			else if (t is CirTypeDecl.Enum e)
-				_enumByFqn[e.FullyQualifiedName] = e;
-		}
+	// Worker for one codegen unit (see `Emit(int)`). Shares every module-wide table the
+	// parent filled in `PreScan` — read-only from here on — and gets its own per-function
+	// state, helper flags, and layout cache so units can be emitted concurrently.
+	private LlvmEmitter(LlvmEmitter parent) {
+		_module = parent._module;
+		_config = parent._config;
+		_projectRoot = parent._projectRoot;
+		_classByFqn = parent._classByFqn;
+		_enumByFqn = parent._enumByFqn;
+		_flattenedFields = new Dictionary<string, List<CirField>>(parent._flattenedFields);
+		_definedFns = parent._definedFns;
+		_externDecls = parent._externDecls;
+		_strings = parent._strings;
+		_stringIndex = parent._stringIndex;
+		_externFns = parent._externFns;
+		_externLlvmName = parent._externLlvmName;
+		_variadicLeading = parent._variadicLeading;
+		_enumExternFqns = parent._enumExternFqns;
+		_needsLibmPow = parent._needsLibmPow;
+		_optimize = parent._optimize;
+		_pgo = parent._pgo;
+		_pgoProfile = parent._pgoProfile;
+		_bench = parent._bench;
 	}
 
+	// Streams the module to `build/<Name>.ll`. Every section is written as soon as it's
+	// produced — the pre-scan has already pooled every string literal and extern the
+	// header sections need, so nothing emitted in a function body is ever back-patched.
 	public string Emit() {
-		var llText = Build();
+		var llPath = UnitPath(null);
+		using (var writer = CreateUnitWriter(llPath))
+			Emit(writer);
+		return llPath;
+	}
+
+	// Split emission for `[build] codegenUnits`. The module-level sections (types, strings,
+	// externs, vtables, statics, enums, helpers, `main`) stay in `build/<Name>.ll`; function
+	// bodies are divided across up to `codegenUnits` extra files `build/<Name>.cgu<k>.ll`,
+	// emitted in parallel, that reference everything outside themselves through `declare` /
+	// `external` lines. Each file is a complete module, so the backend can compile them
+	// concurrently and link the objects. Returns the globals unit first. With one unit this
+	// is exactly `Emit()`.
+	public IReadOnlyList<string> Emit(int codegenUnits) {
+		if (codegenUnits <= 1) return [Emit()];
+		return EmitUnits(codegenUnits, unit => CreateUnitWriter(UnitPath(unit))).Select(UnitPath).ToList();
+	}
+
+	// The units `Emit(int)` writes, kept as IR text in memory for the in-process backend to
+	// parse directly. Each unit's `Path` is the file `Emit(int)` would have written it to,
+	// which names its object. Unlike the streaming form, the whole module is resident.
+	public IReadOnlyList<LlvmUnit> EmitToMemory(int codegenUnits) {
+		var texts = new ConcurrentDictionary<int, StringWriter>();
+		TextWriter Open(int? unit) => texts[unit ?? -1] = new StringWriter();
+
+		if (codegenUnits <= 1) {
+			using (var writer = Open(null))
+				Emit(writer);
+			return [new LlvmUnit(UnitPath(null), texts[-1].ToString())];
+		}
+
+		return EmitUnits(codegenUnits, Open).Select(unit => new LlvmUnit(UnitPath(unit), texts[unit ?? -1].ToString())).ToList();
+	}
+
+	// Split emission through `open`, which supplies the writer for the globals unit (null)
+	// and for each function unit `k`. Returns the units in emission order.
+	private List<int?> EmitUnits(int codegenUnits, Func<int?, TextWriter> open) {
+		using var writer = open(null);
+		PreScan();
+		EmitModuleGlobals(writer);
+
+		var partitions = PartitionFunctions(codegenUnits);
+		var units = new List<int?> { null };
+		units.AddRange(Enumerable.Range(0, partitions.Count).Select(k => (int?)k));
+		var workers = new LlvmEmitter[partitions.Count];
+		Parallel.For(0, partitions.Count, k => {
+			workers[k] = new LlvmEmitter(this);
+			using var unitWriter = open(k);
+			workers[k].EmitFunctionUnit(unitWriter, partitions[k]);
+		});
+
+		// The lazily-emitted helpers live in the globals unit, so it needs every unit's flags.
+		foreach (var worker in workers) {
+			_needsIntPowHelper |= worker._needsIntPowHelper;
+			_needsBoundsPanic |= worker._needsBoundsPanic;
+			_needsPool |= worker._needsPool;
+			_needsRegion |= worker._needsRegion;
+			_needsStrHash |= worker._needsStrHash;
+			_needsParallel |= worker._needsParallel;
+		}
+
+		EmitModuleTrailer(writer);
+		EmitSection(writer, w => EmitFunctionDeclarations(w, new HashSet<string>()));
+		return units;
+	}
+
+	// `build/<Name>.ll` for the whole module (or the globals unit), `build/<Name>.cgu<k>.ll`
+	// for function unit `k`.
+	private string UnitPath(int? unit) {
 		var buildDir = Path.Combine(_projectRoot, "build");
 		Directory.CreateDirectory(buildDir);
-		var llPath = Path.Combine(buildDir, _config.Project.Name + ".ll");
-		File.WriteAllText(llPath, llText, new UTF8Encoding(false));
-		return llPath;
+		var suffix = unit is { } k ? $".cgu{k}" : "";
+		return Path.Combine(buildDir, _config.Project.Name + suffix + ".ll");
 	}
 
+	private static StreamWriter CreateUnitWriter(string path) =>
+		new(path, false, new UTF8Encoding(false), WriterBufferSize);
+
 	// -------------------------------------------------------------------------
 	// Module assembly
 	// -------------------------------------------------------------------------
 
-	private string Build() {
+	// Write the module as LLVM IR text to `writer`. Peak memory is bounded by the largest
+	// single function (its alloca / prologue / body line lists), not by the module size.
+	public void Emit(TextWriter writer) {
 		PreScan();
+		EmitModuleGlobals(writer);
 
-		var sb = new StringBuilder();
-		sb.AppendLine("; Generated by the Cloth Compiler");
-		sb.AppendLine($"source_filename = \"{_config.Project.Name}\"");
-		sb.AppendLine("target datalayout = \"e-m:w-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128\"");
-		sb.AppendLine($"target triple = \"{ResolveTriple(_config.Build.Target)}\"");
-		sb.AppendLine();
-
-		var types = EmitStructTypes();
-		if (types.Length > 0) {
-			sb.Append(types);
-			sb.AppendLine();
+		foreach (var fn in _module.Functions) {
+			if (!IsLoweredFunction(fn)) continue;
+			EmitFunction(writer, fn);
+			writer.WriteLine();
 		}
 
-		var strs = EmitStringGlobals();
-		if (strs.Length > 0) {
-			sb.Append(strs);
-			sb.AppendLine();
-		}
+		EmitModuleTrailer(writer);
+		EmitMetadata(writer);
+	}
 
-		var externs = EmitExternDecls();
-		if (externs.Length > 0) {
-			sb.Append(externs);
-			sb.AppendLine();
-		}
+	// Header plus every module-level section that precedes the function bodies.
+	private void EmitModuleGlobals(TextWriter writer) {
+		EmitHeader(writer);
+
+		// Each section is followed by a blank separator line, omitted when it's empty.
+		EmitSection(writer, EmitStructTypes);
+		EmitSection(writer, EmitStringGlobals);
+		EmitSection(writer, EmitExternDecls);
+		EmitSection(writer, EmitVtableGlobals);
+		EmitSection(writer, EmitStaticFieldGlobals);
+		EmitSection(writer, EmitEnumGlobals);
+		EmitSection(writer, EmitConstantArrays);
+		EmitSection(writer, EmitEnumSyntheticFunctions);
+	}
 
-		var vtables = EmitVtableGlobals();
-		if (vtables.Length > 0) {
-			sb.Append(vtables);
-			sb.AppendLine();
+	// Lazily-required helpers and the `main` entry point, after the function bodies.
+	private void EmitModuleTrailer(TextWriter writer) {
+		// Integer pow helper: lazy-emitted exponentiation-by-squaring (set in PreScan when
+		// any `^` uses two integer operands). Float pow is declared as an extern up in
+		// PreScan and routed to libm at the call site.
+		if (_needsIntPowHelper) {
+			writer.WriteLine(EmitIntPowHelper());
+			writer.WriteLine();
 		}
 
-		var statics = EmitStaticFieldGlobals();
-		if (statics.Length > 0) {
-			sb.Append(statics);
-			sb.AppendLine();
+		// Bounds-check panic helper. Called from every out-of-range `arr[i]` site with
+		// the (i64 idx, i64 len) pair; prints a diagnostic to stderr and aborts.
+		if (_needsBoundsPanic) {
+			writer.WriteLine(EmitBoundsPanicHelper());
+			writer.WriteLine();
 		}
 
-		var enums = EmitEnumGlobals();
-		if (enums.Length > 0) {
-			sb.Append(enums);
-			sb.AppendLine();
+		// Allocator helpers behind `new` / `delete` and `@Region` bodies.
+		if (_needsPool) {
+			writer.WriteLine(EmitPoolHelpers());
+			writer.WriteLine();
 		}
 
-		var enumFunctions = EmitEnumSyntheticFunctions();
-		if (enumFunctions.Length > 0) {
-			sb.Append(enumFunctions);
-			sb.AppendLine();
+		if (_needsRegion) {
+			writer.WriteLine(EmitRegionHelpers());
+			writer.WriteLine();
 		}
 
-		foreach (var fn in _module.Functions) {
-			if (fn.IsExtern) continue;
-			// Compiler-synthesized enum helpers (e.g. `valueOf(string)`, `values()`) have
-			// their LLVM bodies emitted by `EmitEnumSyntheticFunctions` below, not through
-			// the normal CIR-to-LLVM path. Skipping here avoids emitting a malformed empty
-			// define.
-			if (fn.Kind is CirFunctionKind.EnumValueOf or CirFunctionKind.EnumValues) continue;
-			sb.Append(EmitFunction(fn));
-			sb.AppendLine();
+		if (_needsStrHash) {
+			writer.WriteLine(EmitStrHashHelper());
+			writer.WriteLine();
 		}
 
-		// Integer pow helper: lazy-emitted exponentiation-by-squaring (set in PreScan when
-		// any `^` uses two integer operands). Float pow is declared as an extern up in
-		// PreScan and routed to libm at the call site.
-		if (_needsIntPowHelper) {
-			sb.AppendLine(EmitIntPowHelper());
-			sb.AppendLine();
+		if (_needsParallel) {
+			writer.WriteLine(EmitParallelHelpers());
+			writer.WriteLine();
 		}
 
-		// Bounds-check panic helper. Called from every out-of-range `arr[i]` site with
-		// the (i64 idx, i64 len) pair; prints a diagnostic to stderr and aborts.
-		if (_needsBoundsPanic) {
-			sb.AppendLine(EmitBoundsPanicHelper());
-			sb.AppendLine();
+		if (_pgo == PgoMode.Instrument) {
+			writer.WriteLine(InstrProfIncrementDecl);
+			writer.WriteLine();
 		}
 
 		if (_config.Build.OutputType == OutputType.Executable)
-			sb.Append(EmitMainEntry());
-		return sb.ToString();
+			EmitMainEntry(writer);
+	}
+
+	private void EmitHeader(TextWriter writer) {
+		writer.WriteLine("; Generated by the Cloth Compiler");
+		writer.WriteLine($"source_filename = \"{_config.Project.Name}\"");
+		// i686 needs its own layout: 32-bit pointers, and the `_name@N` decoration of
+		// `x86_stdcallcc` symbols that the Win32 import libraries export.
+		var layout = IsI686
+			? "e-m:x-p:32:32-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:32-n8:16:32-a:0:32-S32"
+			: "e-m:w-p270:32:32-p271:32:32-p272:64:64-i64:64-i128:128-f80:128-n8:16:32:64-S128";
+		writer.WriteLine($"target datalayout = \"{layout}\"");
+		writer.WriteLine($"target triple = \"{ResolveTriple(_config.Build.Target)}\"");
+		writer.WriteLine();
+	}
+
+	// Functions that go through `EmitFunction`. Externs have no body here, and the
+	// compiler-synthesized enum helpers (e.g. `valueOf(string)`, `values()`) have their
+	// LLVM bodies emitted by `EmitEnumSyntheticFunctions`, not through the normal
+	// CIR-to-LLVM path — lowering them would produce a malformed empty define.
+	private static bool IsLoweredFunction(CirFunction fn) =>
+		!fn.IsExtern && fn.Kind is not (CirFunctionKind.EnumValueOf or CirFunctionKind.EnumValues);
+
+	// Run a section emitter and follow it with a blank line if it wrote anything.
+	private static void EmitSection(TextWriter writer, Func<TextWriter, bool> section) {
+		if (section(writer)) writer.WriteLine();
 	}
 
 	// Bounds-check panic helper. Each `arr[i]` call site emits a check + branch that
@@ -225,6 +396,412 @@ public sealed class LlvmEmitter {
 		"}"
 	});
 
+	// 64-bit FNV-1a over a NUL-terminated string, matching `StringHash` at compile time.
+	// `linkonce_odr` like the pool helpers, so every library's copy folds into one.
+	private static string EmitStrHashHelper() => string.Join("\n", new[] {
+		"define linkonce_odr i64 @__cloth_str_hash(ptr %s) {",
+		"entry:",
+		"  br label %loop",
+		"loop:",
+		"  %h = phi i64 [ -3750763034362895579, %entry ], [ %h_next, %iter ]",
+		"  %p = phi ptr [ %s, %entry ], [ %p_next, %iter ]",
+		"  %c = load i8, ptr %p",
+		"  %done = icmp eq i8 %c, 0",
+		"  br i1 %done, label %exit, label %iter",
+		"iter:",
+		"  %byte = zext i8 %c to i64",
+		"  %mix = xor i64 %h, %byte",
+		"  %h_next = mul i64 %mix, 1099511628211",
+		"  %p_next = getelementptr inbounds i8, ptr %p, i64 1",
+		"  br label %loop",
+		"exit:",
+		"  ret i64 %h",
+		"}"
+	});
+
+	// Thread pool behind `parallel for` and `join`, started on first use: one Win32 thread per
+	// active processor (up to 64) besides the caller, parked on the `wake` semaphore between
+	// jobs. `__cloth_par_for(fn, env, n, grain)` runs `fn(env, lo, hi)` over `[0, n)` cut into
+	// chunks of `grain` indices (0 picks about eight chunks per thread). Each participant is
+	// dealt a contiguous run of chunks, packed as `lo << 32 | hi` in its own cache line of
+	// `@__cloth_par_ranges`; it pops chunks off the front of its run, and once that is empty
+	// steals the upper half of another's with a compare-and-swap. The call returns when every
+	// participant has signalled `done`. One job runs at a time: a `parallel for` or `join`
+	// reached while the pool is busy — nested in another's body — runs serially in place.
+	//
+	// The helpers are `linkonce_odr` like the pool helpers, so every library's copy folds into
+	// one, and with it the pool.
+	private string EmitParallelHelpers() => string.Join("\n", new[] {
+		"@__cloth_par_threads = linkonce_odr global i32 0, align 4",
+		"@__cloth_par_busy = linkonce_odr global i32 0, align 4",
+		"@__cloth_par_wake = linkonce_odr global ptr null, align 8",
+		"@__cloth_par_done = linkonce_odr global ptr null, align 8",
+		"@__cloth_par_next = linkonce_odr global i32 0, align 4",
+		"@__cloth_par_fn = linkonce_odr global ptr null, align 8",
+		"@__cloth_par_env = linkonce_odr global ptr null, align 8",
+		"@__cloth_par_n = linkonce_odr global i64 0, align 8",
+		"@__cloth_par_grain = linkonce_odr global i64 0, align 8",
+		"@__cloth_par_parts = linkonce_odr global i64 0, align 8",
+		"@__cloth_par_ranges = linkonce_odr global [64 x [8 x i64]] zeroinitializer, align 64",
+		"define linkonce_odr void @__cloth_par_for(ptr %fn, ptr %env, i64 %n, i64 %grain) {",
+		"entry:",
+		"  %small = icmp slt i64 %n, 2",
+		"  br i1 %small, label %serial, label %claim",
+		"claim:",
+		"  %claimed = cmpxchg ptr @__cloth_par_busy, i32 0, i32 1 seq_cst seq_cst",
+		"  %won = extractvalue { i32, i1 } %claimed, 1",
+		"  br i1 %won, label %pool, label %serial",
+		"pool:",
+		"  %known = load i32, ptr @__cloth_par_threads",
+		"  %started = icmp ne i32 %known, 0",
+		"  br i1 %started, label %ready, label %start",
+		"start:",
+		"  %fresh = call i32 @__cloth_par_start()",
+		"  br label %ready",
+		"ready:",
+		"  %threads32 = phi i32 [ %known, %pool ], [ %fresh, %start ]",
+		"  %threads = zext i32 %threads32 to i64",
+		"  %auto = icmp eq i64 %grain, 0",
+		"  %target = mul i64 %threads, 8",
+		"  %g_round = add i64 %n, %target",
+		"  %g_num = sub i64 %g_round, 1",
+		"  %g_auto = udiv i64 %g_num, %target",
+		"  %g = select i1 %auto, i64 %g_auto, i64 %grain",
+		"  %c_round = add i64 %n, %g",
+		"  %c_num = sub i64 %c_round, 1",
+		"  %chunks = udiv i64 %c_num, %g",
+		"  %few = icmp ult i64 %chunks, %threads",
+		"  %parts = select i1 %few, i64 %chunks, i64 %threads",
+		"  %alone = icmp ult i64 %parts, 2",
+		"  br i1 %alone, label %unclaim, label %deal",
+		"unclaim:",
+		"  store atomic i32 0, ptr @__cloth_par_busy seq_cst, align 4",
+		"  br label %serial",
+		"serial:",
+		"  call void %fn(ptr %env, i64 0, i64 %n)",
+		"  ret void",
+		"deal:",
+		"  store ptr %fn, ptr @__cloth_par_fn",
+		"  store ptr %env, ptr @__cloth_par_env",
+		"  store i64 %n, ptr @__cloth_par_n",
+		"  store i64 %g, ptr @__cloth_par_grain",
+		"  store i64 %parts, ptr @__cloth_par_parts",
+		"  store i32 1, ptr @__cloth_par_next",
+		"  br label %deal_loop",
+		"deal_loop:",
+		"  %p = phi i64 [ 0, %deal ], [ %p_next, %deal_loop ]",
+		"  %lo_scaled = mul i64 %chunks, %p",
+		"  %lo = udiv i64 %lo_scaled, %parts",
+		"  %p_next = add i64 %p, 1",
+		"  %hi_scaled = mul i64 %chunks, %p_next",
+		"  %hi = udiv i64 %hi_scaled, %parts",
+		"  %lo_bits = shl i64 %lo, 32",
+		"  %range = or i64 %lo_bits, %hi",
+		"  %slot = getelementptr [64 x [8 x i64]], ptr @__cloth_par_ranges, i64 0, i64 %p, i64 0",
+		"  store atomic i64 %range, ptr %slot seq_cst, align 8",
+		"  %dealt = icmp eq i64 %p_next, %parts",
+		"  br i1 %dealt, label %wake, label %deal_loop",
+		"wake:",
+		"  %helpers = sub i64 %parts, 1",
+		"  %helpers32 = trunc i64 %helpers to i32",
+		"  %wake_sem = load ptr, ptr @__cloth_par_wake",
+		$"  call {WinApiCc}i32 @ReleaseSemaphore(ptr %wake_sem, i32 %helpers32, ptr null)",
+		"  call void @__cloth_par_run(i64 0)",
+		"  %done_sem = load ptr, ptr @__cloth_par_done",
+		"  br label %wait",
+		"wait:",
+		"  %w = phi i64 [ 0, %wake ], [ %w_next, %wait ]",
+		$"  call {WinApiCc}i32 @WaitForSingleObject(ptr %done_sem, i32 -1)",
+		"  %w_next = add i64 %w, 1",
+		"  %joined = icmp eq i64 %w_next, %helpers",
+		"  br i1 %joined, label %finish, label %wait",
+		"finish:",
+		"  store atomic i32 0, ptr @__cloth_par_busy seq_cst, align 4",
+		"  ret void",
+		"}",
+		"define linkonce_odr void @__cloth_par_chunk(i64 %c) {",
+		"entry:",
+		"  %fn = load ptr, ptr @__cloth_par_fn",
+		"  %env = load ptr, ptr @__cloth_par_env",
+		"  %n = load i64, ptr @__cloth_par_n",
+		"  %g = load i64, ptr @__cloth_par_grain",
+		"  %lo = mul i64 %c, %g",
+		"  %end = add i64 %lo, %g",
+		"  %over = icmp ugt i64 %end, %n",
+		"  %hi = select i1 %over, i64 %n, i64 %end",
+		"  call void %fn(ptr %env, i64 %lo, i64 %hi)",
+		"  ret void",
+		"}",
+		"define linkonce_odr void @__cloth_par_run(i64 %self) {",
+		"entry:",
+		"  %parts = load i64, ptr @__cloth_par_parts",
+		"  %own = getelementptr [64 x [8 x i64]], ptr @__cloth_par_ranges, i64 0, i64 %self, i64 0",
+		"  br label %pop",
+		"pop:",
+		"  %r = load atomic i64, ptr %own seq_cst, align 8",
+		"  %lo = lshr i64 %r, 32",
+		"  %hi = and i64 %r, 4294967295",
+		"  %empty = icmp uge i64 %lo, %hi",
+		"  br i1 %empty, label %scan_start, label %take",
+		"take:",
+		"  %lo_next = add i64 %lo, 1",
+		"  %lo_bits = shl i64 %lo_next, 32",
+		"  %rest = or i64 %lo_bits, %hi",
+		"  %popped = cmpxchg ptr %own, i64 %r, i64 %rest seq_cst seq_cst",
+		"  %ok = extractvalue { i64, i1 } %popped, 1",
+		"  br i1 %ok, label %run_own, label %pop",
+		"run_own:",
+		"  call void @__cloth_par_chunk(i64 %lo)",
+		"  br label %pop",
+		"scan_start:",
+		"  br label %scan",
+		"scan:",
+		"  %k = phi i64 [ 1, %scan_start ], [ %k_next, %scan_next ]",
+		"  %more = icmp ult i64 %k, %parts",
+		"  br i1 %more, label %probe, label %exit",
+		"probe:",
+		"  %victim_raw = add i64 %self, %k",
+		"  %victim = urem i64 %victim_raw, %parts",
+		"  %vslot = getelementptr [64 x [8 x i64]], ptr @__cloth_par_ranges, i64 0, i64 %victim, i64 0",
+		"  br label %split_try",
+		"split_try:",
+		"  %vr = load atomic i64, ptr %vslot seq_cst, align 8",
+		"  %vlo = lshr i64 %vr, 32",
+		"  %vhi = and i64 %vr, 4294967295",
+		"  %has = icmp ult i64 %vlo, %vhi",
+		"  br i1 %has, label %split, label %scan_next",
+		"split:",
+		"  %size = sub i64 %vhi, %vlo",
+		"  %size_round = add i64 %size, 1",
+		"  %half = lshr i64 %size_round, 1",
+		"  %mid = sub i64 %vhi, %half",
+		"  %vlo_bits = shl i64 %vlo, 32",
+		"  %kept = or i64 %vlo_bits, %mid",
+		"  %stolen = cmpxchg ptr %vslot, i64 %vr, i64 %kept seq_cst seq_cst",
+		"  %stole = extractvalue { i64, i1 } %stolen, 1",
+		"  br i1 %stole, label %run_stolen, label %split_try",
+		"run_stolen:",
+		"  %mine_lo = add i64 %mid, 1",
+		"  %mine_bits = shl i64 %mine_lo, 32",
+		"  %mine = or i64 %mine_bits, %vhi",
+		"  store atomic i64 %mine, ptr %own seq_cst, align 8",
+		"  call void @__cloth_par_chunk(i64 %mid)",
+		"  br label %pop",
+		"scan_next:",
+		"  %k_next = add i64 %k, 1",
+		"  br label %scan",
+		"exit:",
+		"  ret void",
+		"}",
+		$"define linkonce_odr {WinApiCc}i32 @__cloth_par_worker(ptr %arg) {{",
+		"entry:",
+		"  %wake_sem = load ptr, ptr @__cloth_par_wake",
+		"  %done_sem = load ptr, ptr @__cloth_par_done",
+		"  br label %loop",
+		"loop:",
+		$"  call {WinApiCc}i32 @WaitForSingleObject(ptr %wake_sem, i32 -1)",
+		"  %id32 = atomicrmw add ptr @__cloth_par_next, i32 1 seq_cst",
+		"  %id = zext i32 %id32 to i64",
+		"  call void @__cloth_par_run(i64 %id)",
+		$"  call {WinApiCc}i32 @ReleaseSemaphore(ptr %done_sem, i32 1, ptr null)",
+		"  br label %loop",
+		"}",
+		"define linkonce_odr i32 @__cloth_par_start() {",
+		"entry:",
+		$"  %cpus = call {WinApiCc}i32 @GetActiveProcessorCount(i16 -1)",
+		"  %many = icmp ugt i32 %cpus, 64",
+		"  %capped = select i1 %many, i32 64, i32 %cpus",
+		$"  %wake_sem = call {WinApiCc}ptr @CreateSemaphoreW(ptr null, i32 0, i32 64, ptr null)",
+		$"  %done_sem = call {WinApiCc}ptr @CreateSemaphoreW(ptr null, i32 0, i32 64, ptr null)",
+		"  store ptr %wake_sem, ptr @__cloth_par_wake",
+		"  store ptr %done_sem, ptr @__cloth_par_done",
+		"  %have_wake = icmp ne ptr %wake_sem, null",
+		"  %have_done = icmp ne ptr %done_sem, null",
+		"  %have = and i1 %have_wake, %have_done",
+		"  %limit = select i1 %have, i32 %capped, i32 1",
+		"  br label %spawn",
+		"spawn:",
+		"  %i = phi i32 [ 1, %entry ], [ %i_next, %spawned ]",
+		"  %live = phi i32 [ 1, %entry ], [ %live_next, %spawned ]",
+		"  %more = icmp ult i32 %i, %limit",
+		"  br i1 %more, label %create, label %ready",
+		"create:",
+		$"  %h = call {WinApiCc}ptr @CreateThread(ptr null, {SizeT} 0, ptr @__cloth_par_worker, ptr null, i32 0, ptr null)",
+		"  %created = icmp ne ptr %h, null",
+		"  br i1 %created, label %close, label %spawned",
+		"close:",
+		$"  call {WinApiCc}i32 @CloseHandle(ptr %h)",
+		"  br label %spawned",
+		"spawned:",
+		"  %one = zext i1 %created to i32",
+		"  %live_next = add i32 %live, %one",
+		"  %i_next = add i32 %i, 1",
+		"  br label %spawn",
+		"ready:",
+		"  store i32 %live, ptr @__cloth_par_threads",
+		"  ret i32 %live",
+		"}"
+	});
+
+	// Size-class pool behind `new` and `delete`. Class `k` holds blocks of at least `8 * k`
+	// bytes, for `k` up to 32 (256 bytes); larger objects go straight to calloc / free. Freed
+	// blocks are pushed onto their class's free list — one per thread, so no locking — and
+	// popped (and re-zeroed) by the next allocation of that class, so short-lived objects
+	// stop round-tripping through the C heap. Blocks are never returned to the OS.
+	//
+	// An allocation takes the class that rounds its size up; a free files the block under
+	// the class that rounds the freed size *down*. The freed size is the static type's, which
+	// for `delete base` of a subclass instance is smaller than the block — rounding down keeps
+	// every listed block at least as large as its class, whichever way it was allocated.
+	// Every block is a single calloc, so plain `free` stays valid on pooled memory too.
+	//
+	// The helpers are `linkonce_odr` so the copies in a program's libraries fold into one.
+	// An allocated block is off every list, so `__cloth_pool_alloc` returns `noalias` like
+	// `malloc`.
+	private static string EmitPoolHelpers() => string.Join("\n", new[] {
+		"@__cloth_pool_free_lists = linkonce_odr thread_local global [32 x ptr] zeroinitializer, align 8",
+		"define linkonce_odr noalias ptr @__cloth_pool_alloc(i64 %size) {",
+		"entry:",
+		"  %round = add i64 %size, 7",
+		"  %class = lshr i64 %round, 3",
+		"  %idx = sub i64 %class, 1",
+		"  %pooled = icmp ult i64 %idx, 32",
+		"  br i1 %pooled, label %pool, label %heap",
+		"pool:",
+		"  %head = getelementptr [32 x ptr], ptr @__cloth_pool_free_lists, i64 0, i64 %idx",
+		"  %block = load ptr, ptr %head",
+		"  %bytes = shl i64 %class, 3",
+		"  %empty = icmp eq ptr %block, null",
+		"  br i1 %empty, label %fresh, label %reuse",
+		"reuse:",
+		"  %next = load ptr, ptr %block",
+		"  store ptr %next, ptr %head",
+		"  call void @llvm.memset.p0.i64(ptr %block, i8 0, i64 %bytes, i1 false)",
+		"  ret ptr %block",
+		"fresh:",
+		"  %new = call ptr @calloc(i64 1, i64 %bytes)",
+		"  ret ptr %new",
+		"heap:",
+		"  %obj = call ptr @calloc(i64 1, i64 %size)",
+		"  ret ptr %obj",
+		"}",
+		"define linkonce_odr void @__cloth_pool_free(ptr %obj, i64 %size) {",
+		"entry:",
+		"  %isnull = icmp eq ptr %obj, null",
+		"  br i1 %isnull, label %done, label %sized",
+		"sized:",
+		"  %class = lshr i64 %size, 3",
+		"  %idx = sub i64 %class, 1",
+		"  %pooled = icmp ult i64 %idx, 32",
+		"  br i1 %pooled, label %push, label %heap",
+		"push:",
+		"  %head = getelementptr [32 x ptr], ptr @__cloth_pool_free_lists, i64 0, i64 %idx",
+		"  %top = load ptr, ptr %head",
+		"  store ptr %top, ptr %obj",
+		"  store ptr %obj, ptr %head",
+		"  br label %done",
+		"heap:",
+		"  call void @free(ptr %obj)",
+		"  br label %done",
+		"done:",
+		"  ret void",
+		"}"
+	});
+
+	// Arena behind a `@Region` body. The region is a `{ chunks, cursor, limit, finalizers }`
+	// record in the function's frame; `__cloth_region_alloc` bumps `cursor` through zeroed
+	// chunks of at least 4 KiB (each chained through its first 16 bytes), and for an object
+	// with a destructor also pushes a `{ next, obj, dtor }` node, itself region-allocated.
+	// `__cloth_region_release` runs at every return: it calls the destructors newest first,
+	// i.e. in reverse allocation order, then frees the chunks in one sweep.
+	private static string EmitRegionHelpers() => string.Join("\n", new[] {
+		"define linkonce_odr ptr @__cloth_region_alloc(ptr %r, i64 %size, ptr %dtor) {",
+		"entry:",
+		"  %round = add i64 %size, 15",
+		"  %need = and i64 %round, -16",
+		"  %cursorp = getelementptr { ptr, ptr, ptr, ptr }, ptr %r, i32 0, i32 1",
+		"  %limitp = getelementptr { ptr, ptr, ptr, ptr }, ptr %r, i32 0, i32 2",
+		"  %cursor = load ptr, ptr %cursorp",
+		"  %limit = load ptr, ptr %limitp",
+		"  %ci = ptrtoint ptr %cursor to i64",
+		"  %li = ptrtoint ptr %limit to i64",
+		"  %room = sub i64 %li, %ci",
+		"  %fits = icmp ult i64 %need, %room",
+		"  br i1 %fits, label %bump, label %grow",
+		"grow:",
+		"  %want = add i64 %need, 16",
+		"  %large = icmp ugt i64 %want, 4096",
+		"  %chunksz = select i1 %large, i64 %want, i64 4096",
+		"  %chunk = call ptr @calloc(i64 1, i64 %chunksz)",
+		"  %chunksp = getelementptr { ptr, ptr, ptr, ptr }, ptr %r, i32 0, i32 0",
+		"  %prev = load ptr, ptr %chunksp",
+		"  store ptr %prev, ptr %chunk",
+		"  store ptr %chunk, ptr %chunksp",
+		"  %first = getelementptr i8, ptr %chunk, i64 16",
+		"  %end = getelementptr i8, ptr %chunk, i64 %chunksz",
+		"  store ptr %end, ptr %limitp",
+		"  br label %bump",
+		"bump:",
+		"  %obj = phi ptr [ %cursor, %entry ], [ %first, %grow ]",
+		"  %next = getelementptr i8, ptr %obj, i64 %need",
+		"  store ptr %next, ptr %cursorp",
+		"  %hasdtor = icmp ne ptr %dtor, null",
+		"  br i1 %hasdtor, label %track, label %done",
+		"track:",
+		"  %node = call ptr @__cloth_region_alloc(ptr %r, i64 24, ptr null)",
+		"  %finp = getelementptr { ptr, ptr, ptr, ptr }, ptr %r, i32 0, i32 3",
+		"  %top = load ptr, ptr %finp",
+		"  store ptr %top, ptr %node",
+		"  %nobj = getelementptr { ptr, ptr, ptr }, ptr %node, i32 0, i32 1",
+		"  store ptr %obj, ptr %nobj",
+		"  %ndtor = getelementptr { ptr, ptr, ptr }, ptr %node, i32 0, i32 2",
+		"  store ptr %dtor, ptr %ndtor",
+		"  store ptr %node, ptr %finp",
+		"  br label %done",
+		"done:",
+		"  ret ptr %obj",
+		"}",
+		"define linkonce_odr void @__cloth_region_release(ptr %r) {",
+		"entry:",
+		"  %finp = getelementptr { ptr, ptr, ptr, ptr }, ptr %r, i32 0, i32 3",
+		"  %newest = load ptr, ptr %finp",
+		"  br label %finalize",
+		"finalize:",
+		"  %node = phi ptr [ %newest, %entry ], [ %older, %run ]",
+		"  %more = icmp ne ptr %node, null",
+		"  br i1 %more, label %run, label %sweep",
+		"run:",
+		"  %nobj = getelementptr { ptr, ptr, ptr }, ptr %node, i32 0, i32 1",
+		"  %obj = load ptr, ptr %nobj",
+		"  %ndtor = getelementptr { ptr, ptr, ptr }, ptr %node, i32 0, i32 2",
+		"  %dtor = load ptr, ptr %ndtor",
+		"  call void %dtor(ptr %obj)",
+		"  %older = load ptr, ptr %node",
+		"  br label %finalize",
+		"sweep:",
+		"  %chunksp = getelementptr { ptr, ptr, ptr, ptr }, ptr %r, i32 0, i32 0",
+		"  %firstchunk = load ptr, ptr %chunksp",
+		"  br label %walk",
+		"walk:",
+		"  %chunk = phi ptr [ %firstchunk, %sweep ], [ %nextchunk, %drop ]",
+		"  %cmore = icmp ne ptr %chunk, null",
+		"  br i1 %cmore, label %drop, label %done",
+		"drop:",
+		"  %nextchunk = load ptr, ptr %chunk",
+		"  call void @free(ptr %chunk)",
+		"  br label %walk",
+		"done:",
+		"  ret void",
+		"}"
+	});
+
+	// Win32 functions (and the thread entry point `CreateThread` calls) use `__stdcall`. On
+	// x86_64 and arm64 that is the C convention; on i686 it is its own, and `SIZE_T`
+	// arguments shrink to 32 bits with the pointers.
+	private bool IsI686 => ResolveTriple(_config.Build.Target).StartsWith("i686-");
+	private string WinApiCc => IsI686 ? "x86_stdcallcc " : "";
+	private string SizeT => IsI686 ? "i32" : "i64";
+
 	private static string ResolveTriple(string target) => target switch {
 		"x64_86" or "x86_64" or "" => "x86_64-pc-windows-msvc",
 		"x86" => "i686-pc-windows-msvc",
@@ -278,6 +855,11 @@ public sealed class LlvmEmitter {
 				ScanStmt(stmt);
 		}
 
+		// Static initializers' string literals, for the constants `EmitStaticFieldGlobals` writes.
+		foreach (var sf in _module.StaticFields)
+			if (sf.Initializer != null)
+				ScanExpr(sf.Initializer);
+
 		foreach (var t in _module.Types) {
 			if (t is CirTypeDecl.Class c) {
 				foreach (var f in c.Fields)
@@ -300,6 +882,8 @@ public sealed class LlvmEmitter {
 		// regardless of whether the user code actually invokes either form.
 		_externDecls["calloc"] = "declare ptr @calloc(i64, i64)";
 		_externDecls["free"] = "declare void @free(ptr)";
+		// Re-zeroes a recycled block in `__cloth_pool_alloc`.
+		_externDecls["llvm.memset.p0.i64"] = "declare void @llvm.memset.p0.i64(ptr, i8, i64, i1)";
 		// Used by failed `as` downcasts to halt the program.
 		_externDecls["abort"] = "declare void @abort()";
 		// libm `pow` is only declared when `^` operates on at least one float operand
@@ -307,11 +891,21 @@ public sealed class LlvmEmitter {
 		// helper emitted by `EmitIntPowHelper`.
 		if (_needsLibmPow) _externDecls["pow"] = "declare double @pow(double, double)";
 
+		// The synthesized `valueOf(string)` of every enum defined here hashes its argument
+		// into a perfect-hash table of the case names.
+		if (_module.Types.Any(t => t is CirTypeDecl.Enum { Cases.Count: > 0 } e && !_enumExternFqns.Contains(e.FullyQualifiedName)))
+			_needsStrHash = true;
+
 		// libc `strcmp` is declared whenever the module defines at least one enum, since
-		// the synthesized `valueOf(string)` for every enum uses it for string equality.
-		if (_module.Types.Any(t => t is CirTypeDecl.Enum))
+		// the synthesized `valueOf(string)` for every enum uses it for string equality, and
+		// when a string `switch` confirms its hash match with it.
+		if (_needsStrHash || _module.Types.Any(t => t is CirTypeDecl.Enum))
 			_externDecls["strcmp"] = "declare i32 @strcmp(ptr, ptr)";
 
+		// Each `values()` copies its enum's constant case table into the slice it returns.
+		if (_module.Types.Any(t => t is CirTypeDecl.Enum { Cases.Count: > 0 } e && !_enumExternFqns.Contains(e.FullyQualifiedName)))
+			_externDecls["llvm.memcpy.p0.p0.i64"] = "declare void @llvm.memcpy.p0.p0.i64(ptr, ptr, i64, i1)";
+
 		// Bounds-check helper needs `printf` to write a panic message and `fflush` to
 		// drain stdout before aborting (printf's line buffer is normally dropped on
 		// abort). Both are declared when any `arr[i]` access is present
@@ -323,6 +917,27 @@ public sealed class LlvmEmitter {
 			if (!_externDecls.ContainsKey("fflush"))
 				_externDecls["fflush"] = "declare i32 @fflush(ptr)";
 		}
+
+		// The benchmark driver parses its arguments with `strtoll`, reads the Windows
+		// performance counter, and prints names and timings with `printf`.
+		if (_bench) {
+			if (!_externDecls.ContainsKey("printf"))
+				_externDecls["printf"] = "declare i32 @printf(ptr, ...)";
+			_externDecls["strtoll"] = "declare i64 @strtoll(ptr, ptr, i32)";
+			_externDecls["QueryPerformanceCounter"] = $"declare {WinApiCc}i32 @QueryPerformanceCounter(ptr)";
+			_externDecls["QueryPerformanceFrequency"] = $"declare {WinApiCc}i32 @QueryPerformanceFrequency(ptr)";
+		}
+
+		// The thread pool behind `parallel for` and `join` is built on Win32 threads and
+		// semaphores, matching the windows-msvc triple.
+		if (_needsParallel) {
+			_externDecls["CreateThread"] = $"declare {WinApiCc}ptr @CreateThread(ptr, {SizeT}, ptr, ptr, i32, ptr)";
+			_externDecls["CloseHandle"] = $"declare {WinApiCc}i32 @CloseHandle(ptr)";
+			_externDecls["CreateSemaphoreW"] = $"declare {WinApiCc}ptr @CreateSemaphoreW(ptr, i32, i32, ptr)";
+			_externDecls["ReleaseSemaphore"] = $"declare {WinApiCc}i32 @ReleaseSemaphore(ptr, i32, ptr)";
+			_externDecls["WaitForSingleObject"] = $"declare {WinApiCc}i32 @WaitForSingleObject(ptr, i32)";
+			_externDecls["GetActiveProcessorCount"] = $"declare {WinApiCc}i32 @GetActiveProcessorCount(i16)";
+		}
 	}
 
 	private void ScanStmt(CirStmt stmt) {
@@ -369,11 +984,17 @@ public sealed class LlvmEmitter {
 				foreach (var s in f.Body) ScanStmt(s);
 				break;
 			case CirStmt.ForIn fi:
+				_needsParallel |= fi.Parallel;
 				ScanExpr(fi.Iterable);
 				foreach (var s in fi.Body) ScanStmt(s);
 				break;
+			case CirStmt.Join j:
+				_needsParallel = true;
+				foreach (var t in j.Tasks) ScanExpr(t);
+				break;
 			case CirStmt.Switch sw:
 				ScanExpr(sw.Subject);
+				if (sw.Cases.Any(c => c.Pattern != null) && sw.Cases.All(c => c.Pattern is null or CirExpr.StrLit)) _needsStrHash = true;
 				foreach (var c in sw.Cases) {
 					if (c.Pattern != null) ScanExpr(c.Pattern);
 					foreach (var s in c.Body) ScanStmt(s);
@@ -412,9 +1033,9 @@ public sealed class LlvmEmitter {
 			case CirExpr.Unary u: ScanExpr(u.Operand); break;
 			case CirExpr.FieldAccess fa: ScanExpr(fa.Target); break;
 			case CirExpr.Index i:
-				// Every `arr[i]` access fires the bounds-panic helper at emission. Set the
-				// flag here so PreScan can declare `printf` before externs are emitted.
-				_needsBoundsPanic = true;
+				// Every checked `arr[i]` access fires the bounds-panic helper at emission. Set
+				// the flag here so PreScan can declare `printf` before externs are emitted.
+				_needsBoundsPanic |= i.Checked;
 				ScanExpr(i.Target);
 				ScanExpr(i.Idx);
 				break;
@@ -501,44 +1122,60 @@ public sealed class LlvmEmitter {
 	// Sections
 	// -------------------------------------------------------------------------
 
-	private string EmitStructTypes() {
-		var sb = new StringBuilder();
+	// Each section writes its lines straight to the output and returns whether it wrote
+	// anything, so `Emit` knows whether to follow it with a separator line.
+
+	private bool EmitStructTypes(TextWriter writer) {
 		foreach (var t in _module.Types) {
-			if (t is CirTypeDecl.Class c) {
-				var name = StructName(c.FullyQualifiedName);
-				var flat = GetFlattenedFields(c.FullyQualifiedName);
-				if (flat.Count == 0) {
-					sb.AppendLine($"{name} = type {{ ptr }}");
-					continue;
-				}
+			var fqn = t switch {
+				CirTypeDecl.Class c => c.FullyQualifiedName,
+				CirTypeDecl.Enum e => e.FullyQualifiedName,
+				_ => null
+			};
+			if (fqn != null) writer.WriteLine($"{StructName(fqn)} = type {{ {string.Join(", ", StructFieldTypes(fqn)!)} }}");
+		}
 
-				var fieldTypes = string.Join(", ", flat.Select(f => LlvmType(f.Type)));
-				sb.AppendLine($"{name} = type {{ {fieldTypes} }}");
-			}
-			else if (t is CirTypeDecl.Enum e) {
-				// `%enum.<fqn> = type { i32 ordinal, ptr name, <param-types...> }`. The two
-				// leading slots are built-in (driven by `getOrdinal()` / `name()`); user
-				// parameters follow in declaration order.
-				var name = StructName(e.FullyQualifiedName);
-				var fieldTypes = new List<string> { "i32", "ptr" };
-				fieldTypes.AddRange(e.Parameters.Select(p => LlvmType(p.Type)));
-				sb.AppendLine($"{name} = type {{ {string.Join(", ", fieldTypes)} }}");
-			}
+		return _module.Types.Any(t => t is CirTypeDecl.Class or CirTypeDecl.Enum);
+	}
+
+	// LLVM field types of a class or enum struct; null for any other name. A class uses its
+	// flattened layout (a field-less one still gets a slot). An enum is
+	// `{ i32 ordinal, ptr name, <param-types...> }`: the two leading slots are built-in
+	// (driven by `getOrdinal()` / `name()`); user parameters follow in declaration order.
+	private List<string>? StructFieldTypes(string fqn) {
+		if (_classByFqn.ContainsKey(fqn)) {
+			var flat = GetFlattenedFields(fqn);
+			return flat.Count == 0 ? ["ptr"] : flat.Select(f => LlvmType(f.Type)).ToList();
 		}
 
-		return sb.ToString();
+		if (_enumByFqn.TryGetValue(fqn, out var e))
+			return ["i32", "ptr", ..e.Parameters.Select(p => LlvmType(p.Type))];
+		return null;
+	}
+
+	// Byte size of a class or enum struct under the module's data layout, for
+	// `dereferenceable`; null when it isn't known exactly, since overclaiming would let LLVM
+	// load past the object. The enum's two built-in slots are an `i32` and a `string`.
+	private long? StructSize(string fqn) {
+		CirStructLayout layout;
+		if (_classByFqn.ContainsKey(fqn))
+			layout = CirLayout.Of(GetFlattenedFields(fqn).Select(f => f.Type).ToList());
+		else if (_enumByFqn.TryGetValue(fqn, out var e))
+			layout = CirLayout.Of([new CirType.Named("i32"), new CirType.Named("string"), ..e.Parameters.Select(p => p.Type)]);
+		else
+			return null;
+		return layout.Exact ? layout.Size : null;
 	}
 
 	private static string MangleEnumCaseGlobal(string enumFqn, string caseName) =>
 		MangleToLlvm($"enum.{enumFqn}.{caseName}");
 
 	// Emit one `@enum.<fqn>.<CASE> = constant ...` per case across all enums in the
-	// module. Each case's user-supplied constructor args are folded to LLVM literal
-	// constants via the static-field folder; the two built-in slots (ordinal, name) are
+	// module. Each case's user-supplied constructor args are evaluated to LLVM constants
+	// by the static-field interpreter; the two built-in slots (ordinal, name) are
 	// always literal. Extern enums get `external constant` declarations so the linker
 	// resolves them against the dependency's `.lib`.
-	private string EmitEnumGlobals() {
-		var sb = new StringBuilder();
+	private bool EmitEnumGlobals(TextWriter writer) {
 		foreach (var t in _module.Types) {
 			if (t is not CirTypeDecl.Enum e) continue;
 			var structTy = StructName(e.FullyQualifiedName);
@@ -547,7 +1184,7 @@ public sealed class LlvmEmitter {
 			foreach (var c in e.Cases) {
 				var globalName = MangleEnumCaseGlobal(e.FullyQualifiedName, c.Name);
 				if (isExtern) {
-					sb.AppendLine($"@{globalName} = external constant {structTy}");
+					writer.WriteLine($"@{globalName} = external constant {structTy}");
 					continue;
 				}
 
@@ -560,25 +1197,17 @@ public sealed class LlvmEmitter {
 				};
 				for (var i = 0; i < c.ConstructorArgs.Count; i++) {
 					var paramTy = LlvmType(e.Parameters[i].Type);
-					var folded = FoldStaticInitializer(c.ConstructorArgs[i]);
-					if (folded != null) {
-						initParts.Add($"{paramTy} {FormatLlvmConstant(folded.Value, paramTy)}");
-						continue;
-					}
-					// String literals don't fold to a numeric value; pool them and emit a `ptr`.
-					if (c.ConstructorArgs[i] is CirExpr.StrLit s) {
-						var idx = PoolStringIndex(s.Value);
-						initParts.Add($"ptr @.str.{idx}");
-						continue;
+					if (!Interpreter.TryEvaluate(c.ConstructorArgs[i], e.Parameters[i].Type, out var value, out var reason)) {
+						LlvmError.UnsupportedExpression.WithMessage($"enum case '{e.FullyQualifiedName}.{c.Name}' arg {i} is not a compile-time constant: it {reason}").Render();
+						return true;
 					}
-					LlvmError.UnsupportedExpression.WithMessage($"enum case '{e.FullyQualifiedName}.{c.Name}' arg {i} is not a compile-time constant").Render();
-					return sb.ToString();
+					initParts.Add($"{paramTy} {FormatConstantValue(value, paramTy, writable: false)}");
 				}
 
-				sb.AppendLine($"@{globalName} = constant {structTy} {{ {string.Join(", ", initParts)} }}");
+				writer.WriteLine($"@{globalName} = constant {structTy} {{ {string.Join(", ", initParts)} }}");
 			}
 		}
-		return sb.ToString();
+		return _module.Types.Any(t => t is CirTypeDecl.Enum { Cases.Count: > 0 });
 	}
 
 	// Add a string literal to the pool (if not already present) and return its index so
@@ -599,69 +1228,154 @@ public sealed class LlvmEmitter {
 	private readonly HashSet<string> _enumExternFqns = new();
 
 	// Emit synthesized per-enum functions that don't go through the normal CIR pipeline:
-	// `valueOf(string)` (chained `strcmp` against each case name) and `values()` (heap-
-	// allocate an `[N x ptr]` buffer and wrap as a slice). Skips extern enums — those
-	// bodies live in the dependency's `.lib`.
-	private string EmitEnumSyntheticFunctions() {
-		var sb = new StringBuilder();
+	// `valueOf(string)` (a perfect-hash lookup over the case names) and `values()` (a fresh
+	// copy of a constant `[N x ptr]` of the case globals). Skips extern enums — those bodies
+	// live in the dependency's `.lib`.
+	private bool EmitEnumSyntheticFunctions(TextWriter writer) {
 		foreach (var t in _module.Types) {
 			if (t is not CirTypeDecl.Enum e) continue;
 			if (_enumExternFqns.Contains(e.FullyQualifiedName)) continue;
-			EmitEnumValueOfBody(sb, e);
-			EmitEnumValuesBody(sb, e);
+			EmitEnumValueOfBody(writer, e);
+			EmitEnumValuesBody(writer, e);
 		}
-		return sb.ToString();
+		return _module.Types.Any(t => t is CirTypeDecl.Enum e && !_enumExternFqns.Contains(e.FullyQualifiedName));
 	}
 
-	private void EmitEnumValueOfBody(StringBuilder sb, CirTypeDecl.Enum e) {
+	// `valueOf(string)` hashes the name with `@__cloth_str_hash`, picks its slot in a table
+	// of case pointers through `PerfectHash`, and confirms with one `strcmp` against that
+	// case's name — a miss is an empty slot or a failed compare. Enums with at most
+	// `ValueOfBucketKeys` cases need no displacement table, so the lookup is a single load.
+	// Should no perfect hash turn up (names with equal 64-bit hashes), the body falls back
+	// to a `strcmp` per case.
+	private void EmitEnumValueOfBody(TextWriter writer, CirTypeDecl.Enum e) {
 		var mangled = MangleToLlvm($"{e.FullyQualifiedName}.valueOf__string");
-		sb.AppendLine($"define ptr @{mangled}(ptr %name) {{");
-		sb.AppendLine("entry:");
+		var table = e.Cases.Count > 0 ? PerfectHash(e.Cases.Select(c => StringHash(c.Name)).ToList()) : null;
+		if (table is { } t) {
+			var caseGlobals = t.Slots.Select(i => i < 0 ? "ptr null" : $"ptr @{MangleEnumCaseGlobal(e.FullyQualifiedName, e.Cases[i].Name)}");
+			writer.WriteLine($"@{mangled}.slots = private unnamed_addr constant [{t.Slots.Length} x ptr] [{string.Join(", ", caseGlobals)}]");
+			if (t.Displacements.Length > 1)
+				writer.WriteLine($"@{mangled}.disp = private unnamed_addr constant [{t.Displacements.Length} x i32] [{string.Join(", ", t.Displacements.Select(d => $"i32 {d}"))}]");
+		}
+
+		writer.WriteLine($"define ptr @{mangled}(ptr %name) {{");
+		writer.WriteLine("entry:");
 		if (e.Cases.Count == 0) {
-			sb.AppendLine("  ret ptr null");
-			sb.AppendLine("}");
+			writer.WriteLine("  ret ptr null");
+			writer.WriteLine("}");
 			return;
 		}
-		sb.AppendLine($"  br label %check0");
+
+		if (table is { } pt) {
+			writer.WriteLine("  %hash = call i64 @__cloth_str_hash(ptr %name)");
+			var disp = pt.Displacements[0].ToString(CultureInfo.InvariantCulture);
+			if (pt.Displacements.Length > 1) {
+				writer.WriteLine("  %hi = lshr i64 %hash, 32");
+				writer.WriteLine($"  %bucket = and i64 %hi, {pt.Displacements.Length - 1}");
+				writer.WriteLine($"  %disp.addr = getelementptr inbounds [{pt.Displacements.Length} x i32], ptr @{mangled}.disp, i64 0, i64 %bucket");
+				writer.WriteLine("  %disp.32 = load i32, ptr %disp.addr");
+				writer.WriteLine("  %disp = zext i32 %disp.32 to i64");
+				disp = "%disp";
+			}
+
+			writer.WriteLine($"  %key = xor i64 %hash, {disp}");
+			writer.WriteLine($"  %mixed = mul i64 %key, {unchecked((long)PerfectHashMultiplier)}");
+			writer.WriteLine($"  %slot = lshr i64 %mixed, {64 - BitOperations.Log2((uint)pt.Slots.Length)}");
+			writer.WriteLine($"  %case.addr = getelementptr inbounds [{pt.Slots.Length} x ptr], ptr @{mangled}.slots, i64 0, i64 %slot");
+			writer.WriteLine("  %case = load ptr, ptr %case.addr");
+			writer.WriteLine("  %empty = icmp eq ptr %case, null");
+			writer.WriteLine("  br i1 %empty, label %miss, label %check");
+			writer.WriteLine("check:");
+			writer.WriteLine($"  %case.name.addr = getelementptr inbounds {StructName(e.FullyQualifiedName)}, ptr %case, i32 0, i32 1");
+			writer.WriteLine("  %case.name = load ptr, ptr %case.name.addr");
+			writer.WriteLine("  %cmp = call i32 @strcmp(ptr %name, ptr %case.name)");
+			writer.WriteLine("  %eq = icmp eq i32 %cmp, 0");
+			writer.WriteLine("  br i1 %eq, label %match, label %miss");
+			writer.WriteLine("match:");
+			writer.WriteLine("  ret ptr %case");
+			writer.WriteLine("miss:");
+			writer.WriteLine("  ret ptr null");
+			writer.WriteLine("}");
+			return;
+		}
+
+		writer.WriteLine($"  br label %check0");
 		for (var i = 0; i < e.Cases.Count; i++) {
 			var c = e.Cases[i];
 			var nameStrIdx = PoolStringIndex(c.Name);
 			var nextLabel = i + 1 < e.Cases.Count ? $"check{i + 1}" : "miss";
-			sb.AppendLine($"check{i}:");
-			sb.AppendLine($"  %cmp{i} = call i32 @strcmp(ptr %name, ptr @.str.{nameStrIdx})");
-			sb.AppendLine($"  %eq{i} = icmp eq i32 %cmp{i}, 0");
-			sb.AppendLine($"  br i1 %eq{i}, label %match{i}, label %{nextLabel}");
-			sb.AppendLine($"match{i}:");
-			sb.AppendLine($"  ret ptr @{MangleEnumCaseGlobal(e.FullyQualifiedName, c.Name)}");
-		}
-		sb.AppendLine("miss:");
-		sb.AppendLine("  ret ptr null");
-		sb.AppendLine("}");
-	}
-
-	// `values(): EnumType[]` — heap-allocate `N` pointer slots, store each case global
-	// in turn, build a slice over the buffer. The result is owned by the caller (must
-	// be `delete`d when no longer needed; if `delete` on a class-element array becomes a
-	// pattern, the element walk should free each only if it owns them — which it doesn't
-	// here, since the case globals are static constants).
-	private void EmitEnumValuesBody(StringBuilder sb, CirTypeDecl.Enum e) {
+			writer.WriteLine($"check{i}:");
+			writer.WriteLine($"  %cmp{i} = call i32 @strcmp(ptr %name, ptr @.str.{nameStrIdx})");
+			writer.WriteLine($"  %eq{i} = icmp eq i32 %cmp{i}, 0");
+			writer.WriteLine($"  br i1 %eq{i}, label %match{i}, label %{nextLabel}");
+			writer.WriteLine($"match{i}:");
+			writer.WriteLine($"  ret ptr @{MangleEnumCaseGlobal(e.FullyQualifiedName, c.Name)}");
+		}
+		writer.WriteLine("miss:");
+		writer.WriteLine("  ret ptr null");
+		writer.WriteLine("}");
+	}
+
+	// A perfect hash over the 64-bit hashes of `n` keys: `Slots` (a power of two, at least
+	// `n * 5 / 4`) holds each key's index at `((hash ^ d) * PerfectHashMultiplier) >> (64 -
+	// log2 Slots)`, and -1 in the unused slots. `d` is `Displacements[(hash >> 32) &
+	// (Displacements.Length - 1)]`, chosen bucket by bucket, largest first, so the bucket's
+	// keys land on free slots (hash-and-displace). Null when two keys share a hash or a
+	// bucket finds no displacement within `PerfectHashTries`.
+	private static (int[] Slots, uint[] Displacements)? PerfectHash(List<long> hashes) {
+		if (hashes.Distinct().Count() != hashes.Count) return null;
+
+		var slots = new int[Math.Max(2, BitOperations.RoundUpToPowerOf2((uint)(hashes.Count + hashes.Count / 4)))];
+		Array.Fill(slots, -1);
+		var bits = BitOperations.Log2((uint)slots.Length);
+		var displacements = new uint[hashes.Count <= ValueOfBucketKeys ? 1 : BitOperations.RoundUpToPowerOf2((uint)((hashes.Count + ValueOfBucketKeys - 1) / ValueOfBucketKeys))];
+		int SlotOf(long hash, uint d) => (int)((((ulong)hash ^ d) * PerfectHashMultiplier) >> (64 - bits));
+
+		var buckets = Enumerable.Range(0, hashes.Count)
+			.GroupBy(i => (int)(((ulong)hashes[i] >> 32) & (uint)(displacements.Length - 1)))
+			.OrderByDescending(g => g.Count());
+		foreach (var bucket in buckets) {
+			var placed = false;
+			for (var d = 0u; d < PerfectHashTries && !placed; d++) {
+				var taken = bucket.Select(i => SlotOf(hashes[i], d)).ToList();
+				if (taken.Distinct().Count() != taken.Count || taken.Any(s => slots[s] >= 0)) continue;
+				foreach (var (i, s) in bucket.Zip(taken)) slots[s] = i;
+				displacements[bucket.Key] = d;
+				placed = true;
+			}
+
+			if (!placed) return null;
+		}
+
+		return (slots, displacements);
+	}
+
+	private const ulong PerfectHashMultiplier = 0x9E3779B97F4A7C15UL;
+	private const uint PerfectHashTries = 1 << 16;
+	private const int ValueOfBucketKeys = 4;
+
+	// `values(): EnumType[]` — a fresh slice the caller owns and may `delete` or write
+	// through, filled with one `memcpy` from a constant `[N x ptr]` of the case globals.
+	// The case globals are static, so deleting the slice frees only its buffer.
+	private void EmitEnumValuesBody(TextWriter writer, CirTypeDecl.Enum e) {
 		var mangled = MangleToLlvm($"{e.FullyQualifiedName}.values");
 		var n = e.Cases.Count;
-		sb.AppendLine($"define {{ ptr, i64 }} @{mangled}() {{");
-		sb.AppendLine("entry:");
-		// Element size — every variant pointer is just `ptr`, so 8 bytes on 64-bit. Use
-		// the GEP-null trick to stay target-agnostic.
-		sb.AppendLine($"  %eltsz.ptr = getelementptr ptr, ptr null, i64 1");
-		sb.AppendLine($"  %eltsz = ptrtoint ptr %eltsz.ptr to i64");
-		sb.AppendLine($"  %data = call ptr @calloc(i64 {n}, i64 %eltsz)");
-		for (var i = 0; i < n; i++) {
-			sb.AppendLine($"  %slot{i} = getelementptr ptr, ptr %data, i64 {i}");
-			sb.AppendLine($"  store ptr @{MangleEnumCaseGlobal(e.FullyQualifiedName, e.Cases[i].Name)}, ptr %slot{i}");
-		}
-		sb.AppendLine($"  %slice0 = insertvalue {{ ptr, i64 }} undef, ptr %data, 0");
-		sb.AppendLine($"  %slice = insertvalue {{ ptr, i64 }} %slice0, i64 {n}, 1");
-		sb.AppendLine($"  ret {{ ptr, i64 }} %slice");
-		sb.AppendLine("}");
+		var caseGlobals = e.Cases.Select(c => $"ptr @{MangleEnumCaseGlobal(e.FullyQualifiedName, c.Name)}");
+		if (n > 0) writer.WriteLine($"@{mangled}.all = private unnamed_addr constant [{n} x ptr] [{string.Join(", ", caseGlobals)}]");
+		writer.WriteLine($"define {{ ptr, i64 }} @{mangled}() {{");
+		writer.WriteLine("entry:");
+		// Element size — every case pointer is just `ptr`. The GEP-null trick keeps it
+		// target-agnostic.
+		writer.WriteLine("  %eltsz.ptr = getelementptr ptr, ptr null, i64 1");
+		writer.WriteLine("  %eltsz = ptrtoint ptr %eltsz.ptr to i64");
+		writer.WriteLine($"  %data = call ptr @calloc(i64 {n}, i64 %eltsz)");
+		if (n > 0) {
+			writer.WriteLine($"  %bytes = mul i64 %eltsz, {n}");
+			writer.WriteLine($"  call void @llvm.memcpy.p0.p0.i64(ptr %data, ptr @{mangled}.all, i64 %bytes, i1 false)");
+		}
+		writer.WriteLine("  %slice0 = insertvalue { ptr, i64 } undef, ptr %data, 0");
+		writer.WriteLine($"  %slice = insertvalue {{ ptr, i64 }} %slice0, i64 {n}, 1");
+		writer.WriteLine("  ret { ptr, i64 } %slice");
+		writer.WriteLine("}");
 	}
 
 	// Map an enum field name (built-in `__ordinal__` / `__name__`, or a declared
@@ -675,106 +1389,97 @@ public sealed class LlvmEmitter {
 		return (-1, new CirType.Any());
 	}
 
-	// Build the flattened layout for `classFqn`: root's fields first (including the vtable
-	// header), then each descendant's contributions in chain order with the duplicate
-	// vtable field skipped. This preserves the invariant that an ancestor pointer cast to
-	// a descendant pointer sees the same offsets for shared fields. A defensive visited-
-	// set guards against malformed BaseClass rings (the registry-level cycle detector
-	// already prevents these in normal compiles, but LLVM can't see the registry).
+	// The flattened layout for `classFqn` (`CirLayout.Flatten`): root's fields first, vtable
+	// header included, then each descendant's own in chain order. A descendant's constructor
+	// stores its own vtable through the root's `__vtable__` slot at offset 0.
 	private List<CirField> GetFlattenedFields(string classFqn) {
 		if (_flattenedFields.TryGetValue(classFqn, out var cached)) return cached;
 
-		var chain = new List<string>();
-		var visited = new HashSet<string>();
-		var cursor = classFqn;
-		while (!string.IsNullOrEmpty(cursor) && _classByFqn.TryGetValue(cursor, out var cls)) {
-			if (!visited.Add(cursor)) break;
-			chain.Insert(0, cursor);
-			cursor = cls.BaseClass;
-		}
-
-		var result = new List<CirField>();
-		for (var i = 0; i < chain.Count; i++) {
-			var cls = _classByFqn[chain[i]];
-			if (i == 0) {
-				result.AddRange(cls.Fields);
-			}
-			else {
-				// Skip the descendant's `__vtable__` field — the root already contributed one
-				// at offset 0, and `this.__vtable__ = &__vtable_<Self>` simply overwrites
-				// that slot at construction time for each level of the chain.
-				result.AddRange(cls.Fields.Where(f => f.Name != SymbolRegistry.VtableFieldName));
-			}
-		}
-
+		var result = CirLayout.Flatten(_classByFqn, classFqn);
 		_flattenedFields[classFqn] = result;
 		return result;
 	}
 
-	private string EmitStringGlobals() {
-		var sb = new StringBuilder();
+	private bool EmitStringGlobals(TextWriter writer) {
 		for (var i = 0; i < _strings.Count; i++) {
 			var (encoded, byteCount) = EncodeStringConstant(_strings[i]);
-			sb.AppendLine($"@.str.{i} = private unnamed_addr constant [{byteCount} x i8] c\"{encoded}\", align 1");
+			writer.WriteLine($"@.str.{i} = private unnamed_addr constant [{byteCount} x i8] c\"{encoded}\", align 1");
 		}
 
-		return sb.ToString();
+		return _strings.Count > 0;
 	}
 
-	private string EmitExternDecls() {
-		var sb = new StringBuilder();
+	private bool EmitExternDecls(TextWriter writer) {
 		foreach (var line in _externDecls.Values)
-			sb.AppendLine(line);
-		return sb.ToString();
+			writer.WriteLine(line);
+		return _externDecls.Count > 0;
 	}
 
-	// One global per class with `IsList` non-empty. Each global is a constant array of
-	// function pointers, sized to the program-wide VtableSize. Slots that the class doesn't
-	// implement contain `null`; populated slots reference the implementing function (either
-	// a class-side override or an interface's default-impl symbol). Function symbols are
-	// LLVM-mangled at reference time, matching how function definitions are emitted.
-	private string EmitVtableGlobals() {
-		var sb = new StringBuilder();
+	// One global per class with `IsList` non-empty. Each global holds a constant array of
+	// function pointers laid out by `CirModule.DispatchLayout`, whose compacted row size is
+	// the same for every class. Positions the class doesn't fill contain `null`; populated
+	// ones reference the implementing function (either a class-side override or an
+	// interface's default-impl symbol). Function symbols are LLVM-mangled at reference time,
+	// matching how function definitions are emitted.
+	//
+	// Layout: `{ ptr parent_vt, ptr display, ptr implements, i32 depth, [N x ptr] methods }`.
+	// The display lists the class's ancestor vtables from the root down to itself, so entry
+	// `d` names its ancestor at depth `d` — see `EmitClassDisplayCheck`. The implements bitmap
+	// encodes which interfaces the class transitively implements, indexed by
+	// `SymbolRegistry.InterfaceIds`. Both live in globals of their own so that every header
+	// field sits at the same offset whatever the module's row size and interface count: code
+	// compiled against a dependency's vtables reads them with its own constants.
+	private bool EmitVtableGlobals(TextWriter writer) {
 		var bitmapBytes = (_module.InterfaceCount + 7) / 8;
 		var bitmapTy = $"[{bitmapBytes} x i8]";
+		var size = VtableSlotCount();
 		foreach (var vt in _module.Vtables) {
-			var size = vt.Slots.Count;
 			var globalName = MangleVtableGlobal(vt.ClassFqn);
-			// Layout: `{ ptr parent_vt, [N x ptr] methods, [B x i8] implements }`. The
-			// trailing bitmap encodes which interfaces the class transitively implements,
-			// indexed by `SymbolRegistry.InterfaceIds`. Appending the bitmap at the end
-			// leaves existing field-0 (parent) and field-1 (methods) GEPs unchanged.
-			var structTy = $"{{ ptr, [{size} x ptr], {bitmapTy} }}";
 
 			// Extern vtables (classes defined in a dependency project) are declared, not
 			// defined — the linker resolves them against the dependency's `.lib`. Emitting
 			// a definition here would produce `LNK2005: multiply defined symbol` at link time.
 			if (vt.IsExtern) {
-				sb.AppendLine($"@{globalName} = external constant {structTy}");
+				writer.WriteLine($"@{globalName} = external constant {VtableHeaderType}");
 				continue;
 			}
 
-			var parentRef = vt.ParentClassFqn == null ? "ptr null" : $"ptr @{MangleVtableGlobal(vt.ParentClassFqn)}";
+			var display = AncestorVtables(vt.ClassFqn);
+			var displayTy = $"[{display.Count} x ptr]";
+			writer.WriteLine($"@{globalName}.display = private unnamed_addr constant {displayTy} [{string.Join(", ", display.Select(fqn => $"ptr @{MangleVtableGlobal(fqn)}"))}]");
 			var bitmapInit = bitmapBytes == 0
-				? $"{bitmapTy} zeroinitializer"
-				: $"{bitmapTy} [{string.Join(", ", vt.ImplementsBits.Select(b => $"i8 {b}"))}]";
+				? "zeroinitializer"
+				: $"[{string.Join(", ", vt.ImplementsBits.Select(b => $"i8 {b}"))}]";
+			writer.WriteLine($"@{globalName}.implements = private unnamed_addr constant {bitmapTy} {bitmapInit}");
 
-			if (size == 0) {
-				sb.AppendLine($"@{globalName} = constant {structTy} {{ {parentRef}, [0 x ptr] zeroinitializer, {bitmapInit} }}");
-				continue;
-			}
-
-			var entries = vt.Slots.Select(slot => slot == null ? "ptr null" : $"ptr @{MangleToLlvm(slot)}");
-			sb.AppendLine($"@{globalName} = constant {structTy} {{ {parentRef}, [{size} x ptr] [{string.Join(", ", entries)}], {bitmapInit} }}");
+			var parentRef = vt.ParentClassFqn == null ? "ptr null" : $"ptr @{MangleVtableGlobal(vt.ParentClassFqn)}";
+			var header = $"{parentRef}, ptr @{globalName}.display, ptr @{globalName}.implements, i32 {display.Count - 1}";
+			var entries = _module.DispatchLayout.Row(vt).Select(slot => slot == null ? "ptr null" : $"ptr @{MangleToLlvm(slot)}");
+			var methodsInit = size == 0 ? "zeroinitializer" : $"[{string.Join(", ", entries)}]";
+			writer.WriteLine($"@{globalName} = constant {{ ptr, ptr, ptr, i32, [{size} x ptr] }} {{ {header}, [{size} x ptr] {methodsInit} }}");
 		}
 
-		return sb.ToString();
+		return _module.Vtables.Count > 0;
 	}
 
-	// Vtable size constant — number of interface-method slots in every class's vtable
-	// (uniform across the program). Stored on `_module` indirectly through `CirVtable.Slots`,
-	// but easier to read here for GEPs that need the array length.
-	private int VtableSlotCount() => _module.Vtables.Count > 0 ? _module.Vtables[0].Slots.Count : 0;
+	// Length of every class's methods row (uniform across the module) after
+	// `CirDispatchLayout` has packed the global slots.
+	private int VtableSlotCount() => _module.DispatchLayout.RowSize;
+
+	// The vtable struct with its methods row left open: every GEP into a vtable goes through
+	// it, and it declares the vtables other units and projects define.
+	private const string VtableHeaderType = "{ ptr, ptr, ptr, i32, [0 x ptr] }";
+
+	// Vtable FQNs of `classFqn` and its ancestors, root first and `classFqn` last. A class's
+	// depth is its index in the list and is the same in every project that sees the class,
+	// since each compiles the whole parent chain from its dependencies' declarations.
+	private List<string> AncestorVtables(string classFqn) {
+		var chain = new List<string>();
+		for (var cursor = classFqn; cursor != null && !chain.Contains(cursor); cursor = _module.VtablesByFqn.GetValueOrDefault(cursor)?.ParentClassFqn)
+			chain.Add(cursor);
+		chain.Reverse();
+		return chain;
+	}
 
 	// LLVM-safe symbol for a class's vtable global. Reuses MangleToLlvm so dotted FQNs
 	// produce valid IR identifiers (e.g. `__vtable_hello_world_Speaker`).
@@ -786,85 +1491,120 @@ public sealed class LlvmEmitter {
 	private static string MangleStaticGlobal(string classFqn, string fieldName) =>
 		MangleToLlvm($"{classFqn}.{fieldName}");
 
-	// Folded values for already-emitted static fields, keyed by `{ClassFqn}.{Name}`. The
-	// initializer for one static can reference another via a `StaticFieldRef`; we look it
-	// up here during emission so the initializer compiles to a literal LLVM constant.
-	private readonly Dictionary<string, double> _foldedStatics = new();
+	// Compile-time values of the static fields and enum case arguments (`CirInterpreter`),
+	// shared by the two sections so a static's value is computed only once.
+	private CirInterpreter? _interpreter;
+
+	// Arrays the constant initializers' slices point into, in first-use order, each written
+	// as a private `@.arr.<n>` global by `EmitConstantArrays`. An array a non-`const` static
+	// can reach is writable; the rest are read-only constants.
+	private readonly Dictionary<CirArray, int> _constantArrayIds = new(ReferenceEqualityComparer.Instance);
+	private readonly List<CirArray> _constantArrays = new();
+	private readonly HashSet<CirArray> _writableArrays = new(ReferenceEqualityComparer.Instance);
+
+	private CirInterpreter Interpreter => _interpreter ??= new CirInterpreter(_module);
 
 	// Emit one `@<mangled>` LLVM global per static / class-level-const field. Local fields
-	// get a constant or global initializer (folded at compile time); extern fields (from
+	// get a constant or global initializer (evaluated at compile time); extern fields (from
 	// dependency projects) get an `external` declaration so the linker resolves them
 	// against the dependency's `.lib`.
-	private string EmitStaticFieldGlobals() {
-		var sb = new StringBuilder();
+	private bool EmitStaticFieldGlobals(TextWriter writer) {
 		foreach (var sf in _module.StaticFields) {
 			var globalName = MangleStaticGlobal(sf.ClassFqn, sf.Name);
 			var llvmTy = LlvmType(sf.Type);
 			var linkage = sf.IsConst ? "constant" : "global";
 
 			if (sf.IsExtern) {
-				sb.AppendLine($"@{globalName} = external {linkage} {llvmTy}");
+				writer.WriteLine($"@{globalName} = external {linkage} {llvmTy}");
 				continue;
 			}
 
 			if (sf.Initializer == null) {
-				sb.AppendLine($"@{globalName} = {linkage} {llvmTy} zeroinitializer");
+				writer.WriteLine($"@{globalName} = {linkage} {llvmTy} zeroinitializer");
 				continue;
 			}
 
-			var folded = FoldStaticInitializer(sf.Initializer);
-			if (folded == null) {
-				LlvmError.UnsupportedExpression.WithMessage($"initializer for static field '{sf.ClassFqn}.{sf.Name}' is not a compile-time constant").Render();
-				return sb.ToString();
+			if (!Interpreter.TryEvaluateStatic(sf, out var value, out var reason)) {
+				LlvmError.UnsupportedExpression.WithMessage($"initializer for static field '{sf.ClassFqn}.{sf.Name}' is not a compile-time constant: it {reason}").Render();
+				return true;
 			}
 
-			_foldedStatics[$"{sf.ClassFqn}.{sf.Name}"] = folded.Value;
-			sb.AppendLine($"@{globalName} = {linkage} {llvmTy} {FormatLlvmConstant(folded.Value, llvmTy)}");
+			writer.WriteLine($"@{globalName} = {linkage} {llvmTy} {FormatConstantValue(value, llvmTy, writable: !sf.IsConst)}");
 		}
 
-		return sb.ToString();
+		return _module.StaticFields.Count > 0;
 	}
 
-	// Fold a CIR expression to a numeric constant at compile time. Supports integer/float
-	// literals, unary `-`, binary arithmetic over folded operands, and references to other
-	// static fields whose values are already in `_foldedStatics`. Returns null when the
-	// expression isn't constant-foldable.
-	private double? FoldStaticInitializer(CirExpr e) {
-		switch (e) {
-			case CirExpr.IntLit i:
-				return double.TryParse(i.Value, System.Globalization.NumberStyles.Integer | System.Globalization.NumberStyles.AllowLeadingSign, System.Globalization.CultureInfo.InvariantCulture, out var iv) ? iv : null;
-			case CirExpr.FloatLit f:
-				return double.TryParse(f.Value, System.Globalization.NumberStyles.Float, System.Globalization.CultureInfo.InvariantCulture, out var fv) ? fv : null;
-			case CirExpr.BoolLit b:
-				return b.Value ? 1.0 : 0.0;
-			case CirExpr.StaticFieldRef sr:
-				return _foldedStatics.TryGetValue($"{sr.ClassFqn}.{sr.Name}", out var v) ? v : null;
-			case CirExpr.Unary u:
-				var operand = FoldStaticInitializer(u.Operand);
-				if (operand == null) return null;
-				return u.Op switch {
-					CirUnOp.Neg => -operand,
-					_ => null
-				};
-			case CirExpr.Binary b:
-				var l = FoldStaticInitializer(b.Left);
-				var r = FoldStaticInitializer(b.Right);
-				if (l == null || r == null) return null;
-				return b.Op switch {
-					CirBinOp.Add => l + r,
-					CirBinOp.Sub => l - r,
-					CirBinOp.Mul => l * r,
-					CirBinOp.Div => r != 0 ? l / r : null,
-					CirBinOp.Rem => r != 0 ? l % r : null,
-					CirBinOp.Pow => Math.Pow(l.Value, r.Value),
-					_ => null
-				};
-			case CirExpr.Cast c:
-				return FoldStaticInitializer(c.Value);
+	// An interpreted value as the LLVM constant of type `llvmTy`. A slice points into its
+	// array's `@.arr.<n>` global (registered here), offset by a constant GEP when it starts
+	// past the first element.
+	private string FormatConstantValue(CirValue value, string llvmTy, bool writable) {
+		switch (value) {
+			case CirValue.Int i:
+				return i.Value.ToString(CultureInfo.InvariantCulture);
+			case CirValue.Bool b:
+				return b.Value ? "1" : "0";
+			case CirValue.Float f:
+				return FormatLlvmConstant(f.Value, llvmTy);
+			case CirValue.Str s:
+				return $"@.str.{PoolStringIndex(s.Value)}";
+			case CirValue.EnumCase ec:
+				return $"@{MangleEnumCaseGlobal(ec.EnumFqn, ec.CaseName)}";
+			case CirValue.Slice { Length: 0 }:
+				return "{ ptr null, i64 0 }";
+			case CirValue.Slice sl: {
+				var global = $"@.arr.{ConstantArrayId(sl.Array, writable)}";
+				var data = sl.Offset == 0 ? global : $"getelementptr inbounds ([{sl.Array.Items.Length} x {LlvmType(sl.Array.ElementType)}], ptr {global}, i64 0, i64 {sl.Offset})";
+				return $"{{ ptr {data}, i64 {sl.Length} }}";
+			}
+			default:
+				return "null";
 		}
-		return null;
 	}
 
+	// Registers `array` (and the arrays its elements point into) for `EmitConstantArrays`.
+	private int ConstantArrayId(CirArray array, bool writable) {
+		var known = _constantArrayIds.TryGetValue(array, out var id);
+		if (!known) {
+			id = _constantArrays.Count;
+			_constantArrayIds[array] = id;
+			_constantArrays.Add(array);
+		}
+
+		if ((writable && _writableArrays.Add(array)) || !known) {
+			foreach (var item in array.Items)
+				if (item is CirValue.Slice { Length: > 0 } nested)
+					ConstantArrayId(nested.Array, writable);
+		}
+
+		return id;
+	}
+
+	// The arrays behind the constant slices of `EmitStaticFieldGlobals` and `EmitEnumGlobals`:
+	// read-only data for `const` tables, so they cost nothing at startup and sit in shared pages.
+	private bool EmitConstantArrays(TextWriter writer) {
+		for (var i = 0; i < _constantArrays.Count; i++) {
+			var array = _constantArrays[i];
+			var writable = _writableArrays.Contains(array);
+			var elemTy = LlvmType(array.ElementType);
+			var items = array.Items.All(IsZeroValue) ? "zeroinitializer"
+				: $"[{string.Join(", ", array.Items.Select(item => $"{elemTy} {FormatConstantValue(item, elemTy, writable)}"))}]";
+			var linkage = writable ? "private global" : "private unnamed_addr constant";
+			writer.WriteLine($"@.arr.{i} = {linkage} [{array.Items.Length} x {elemTy}] {items}, align 8");
+		}
+
+		return _constantArrays.Count > 0;
+	}
+
+	private static bool IsZeroValue(CirValue value) => value switch {
+		CirValue.Int i => i.Value == 0,
+		CirValue.Bool b => !b.Value,
+		CirValue.Float f => BitConverter.DoubleToInt64Bits(f.Value) == 0,
+		CirValue.Null => true,
+		CirValue.Slice sl => sl.Length == 0,
+		_ => false
+	};
+
 	// Format a folded numeric value as an LLVM constant matching the target type.
 	// Floats use IEEE-754 hex form. LLVM requires `float`-typed hex constants to round-
 	// trip exactly through IEEE-754 double (per LangRef), so for `float` we cast the
@@ -883,14 +1623,220 @@ public sealed class LlvmEmitter {
 		return ((long) value).ToString(System.Globalization.CultureInfo.InvariantCulture);
 	}
 
+	// -------------------------------------------------------------------------
+	// Codegen units
+	// -------------------------------------------------------------------------
+
+	// Greedy longest-first split of the lowered functions into at most `count` buckets of
+	// roughly equal statement weight. Deterministic: ties go to the lowest bucket, and each
+	// bucket keeps module order, so the same module always produces the same unit files.
+	private List<List<CirFunction>> PartitionFunctions(int count) {
+		var functions = _module.Functions.Where(IsLoweredFunction).ToList();
+		var weights = functions.Select(fn => StatementWeight(fn.Body) + 1).ToArray();
+		var order = Enumerable.Range(0, functions.Count).OrderByDescending(i => weights[i]).ThenBy(i => i);
+
+		var buckets = Enumerable.Range(0, Math.Min(count, functions.Count)).Select(_ => new List<int>()).ToList();
+		var loads = new long[buckets.Count];
+		foreach (var i in order) {
+			var target = 0;
+			for (var b = 1; b < loads.Length; b++)
+				if (loads[b] < loads[target]) target = b;
+			buckets[target].Add(i);
+			loads[target] += weights[i];
+		}
+
+		return buckets.Select(bucket => bucket.Order().Select(i => functions[i]).ToList()).ToList();
+	}
+
+	// Number of statements, nested bodies included — a cheap proxy for emitted IR size.
+	private static int StatementWeight(IEnumerable<CirStmt> body) {
+		var total = 0;
+		foreach (var stmt in body) {
+			total++;
+			total += stmt switch {
+				CirStmt.If i => StatementWeight(i.Then) + i.ElseIfs.Sum(e => StatementWeight(e.Item2)) + (i.Else == null ? 0 : StatementWeight(i.Else)),
+				CirStmt.While w => StatementWeight(w.Body),
+				CirStmt.DoWhile dw => StatementWeight(dw.Body),
+				CirStmt.For f => StatementWeight(f.Body),
+				CirStmt.ForIn fi => StatementWeight(fi.Body),
+				CirStmt.Switch sw => sw.Cases.Sum(c => StatementWeight(c.Body)),
+				CirStmt.Block b => StatementWeight(b.Body),
+				CirStmt.Join j => j.Tasks.Count,
+				_ => 0
+			};
+		}
+
+		return total;
+	}
+
+	// One function unit: the shared type definitions and externs, `external` declarations
+	// for the globals unit's data, the unit's own function bodies, then `declare` lines for
+	// every function it may call in another unit and private copies of the strings it uses.
+	// Declarations and string constants come after the bodies so they can be limited to
+	// what the bodies actually needed.
+	private void EmitFunctionUnit(TextWriter writer, List<CirFunction> functions) {
+		EmitHeader(writer);
+		EmitSection(writer, EmitStructTypes);
+		EmitSection(writer, EmitExternDecls);
+		EmitSection(writer, EmitGlobalDeclarations);
+
+		foreach (var fn in functions) {
+			EmitFunction(writer, fn);
+			writer.WriteLine();
+		}
+
+		EmitSection(writer, w => EmitFunctionDeclarations(w, functions.Select(fn => fn.MangledName).ToHashSet()));
+		EmitSection(writer, EmitHelperDeclarations);
+		EmitSection(writer, EmitUsedStringGlobals);
+		EmitMetadata(writer);
+	}
+
+	// `external` counterparts of the vtable, static-field, and enum-case globals defined in
+	// the globals unit.
+	private bool EmitGlobalDeclarations(TextWriter writer) {
+		var wrote = false;
+		foreach (var vt in _module.Vtables) {
+			writer.WriteLine($"@{MangleVtableGlobal(vt.ClassFqn)} = external constant {VtableHeaderType}");
+			wrote = true;
+		}
+
+		foreach (var sf in _module.StaticFields) {
+			writer.WriteLine($"@{MangleStaticGlobal(sf.ClassFqn, sf.Name)} = external {(sf.IsConst ? "constant" : "global")} {LlvmType(sf.Type)}");
+			wrote = true;
+		}
+
+		foreach (var t in _module.Types) {
+			if (t is not CirTypeDecl.Enum e) continue;
+			foreach (var c in e.Cases) {
+				writer.WriteLine($"@{MangleEnumCaseGlobal(e.FullyQualifiedName, c.Name)} = external constant {StructName(e.FullyQualifiedName)}");
+				wrote = true;
+			}
+		}
+
+		return wrote;
+	}
+
+	// `declare` lines for the lowered functions not defined in this unit.
+	private bool EmitFunctionDeclarations(TextWriter writer, IReadOnlySet<string> definedHere) {
+		var wrote = false;
+		foreach (var fn in _module.Functions) {
+			if (!IsLoweredFunction(fn) || definedHere.Contains(fn.MangledName)) continue;
+			var paramTypes = string.Join(", ", fn.Parameters.Select(p => LlvmType(p.Type)));
+			writer.WriteLine($"declare {LlvmType(fn.ReturnType)} @{MangleToLlvm(fn.MangledName)}({paramTypes})");
+			wrote = true;
+		}
+
+		return wrote;
+	}
+
+	// `declare` lines for the globals unit's synthesized functions: the enum helpers, and
+	// whichever lazily-emitted helpers this unit's bodies called.
+	private bool EmitHelperDeclarations(TextWriter writer) {
+		var wrote = false;
+		foreach (var t in _module.Types) {
+			if (t is not CirTypeDecl.Enum e || _enumExternFqns.Contains(e.FullyQualifiedName)) continue;
+			writer.WriteLine($"declare ptr @{MangleToLlvm($"{e.FullyQualifiedName}.valueOf__string")}(ptr)");
+			writer.WriteLine($"declare {{ ptr, i64 }} @{MangleToLlvm($"{e.FullyQualifiedName}.values")}()");
+			wrote = true;
+		}
+
+		if (_needsIntPowHelper) {
+			writer.WriteLine("declare i64 @cloth_pow_i64(i64, i64)");
+			wrote = true;
+		}
+
+		if (_needsBoundsPanic) {
+			writer.WriteLine("declare void @__cloth_panic_bounds(i64, i64)");
+			wrote = true;
+		}
+
+		if (_needsStrHash) {
+			writer.WriteLine("declare i64 @__cloth_str_hash(ptr)");
+			wrote = true;
+		}
+
+		if (_needsParallel) {
+			writer.WriteLine("declare void @__cloth_par_for(ptr, ptr, i64, i64)");
+			wrote = true;
+		}
+
+		if (_needsPool) {
+			writer.WriteLine("declare noalias ptr @__cloth_pool_alloc(i64)");
+			writer.WriteLine("declare void @__cloth_pool_free(ptr, i64)");
+			wrote = true;
+		}
+
+		if (_pgo == PgoMode.Instrument) {
+			writer.WriteLine(InstrProfIncrementDecl);
+			wrote = true;
+		}
+
+		if (_needsRegion) {
+			writer.WriteLine("declare ptr @__cloth_region_alloc(ptr, i64, ptr)");
+			writer.WriteLine("declare void @__cloth_region_release(ptr)");
+			wrote = true;
+		}
+
+		return wrote;
+	}
+
+	// String constants are `private`, so every unit carries its own copy of the ones its
+	// bodies reference (same `@.str.<idx>` numbering as the globals unit).
+	private bool EmitUsedStringGlobals(TextWriter writer) {
+		foreach (var idx in _usedStrings.Order()) {
+			var (encoded, byteCount) = EncodeStringConstant(_strings[idx]);
+			writer.WriteLine($"@.str.{idx} = private unnamed_addr constant [{byteCount} x i8] c\"{encoded}\", align 1");
+		}
+
+		return _usedStrings.Count > 0;
+	}
+
+	// `!<id> = <node>` for every metadata node this unit's bodies attached.
+	private void EmitMetadata(TextWriter writer) {
+		for (var id = 0; id < _metadataNodes.Count; id++)
+			writer.WriteLine($"!{id} = {_metadataNodes[id]}");
+	}
+
+	// Id of a uniqued metadata node, allocated on first use.
+	private int MetadataNode(string node) {
+		if (_metadataIds.TryGetValue(node, out var id)) return id;
+		id = _metadataNodes.Count;
+		_metadataNodes.Add(node);
+		_metadataIds[node] = id;
+		return id;
+	}
+
+	// `, !tbaa !<tag>` for a field or element access of LLVM type `llvmTy`. Scalar TBAA: one
+	// type per LLVM scalar under a Cloth root. Cloth never reinterprets memory — a field or
+	// slot is only loaded and stored at its declared type, and the allocator helpers and
+	// memsets that recycle storage are untagged, which aliases everything — so accesses of
+	// different scalar types can't touch the same bytes. Aggregates stay untagged.
+	private string Tbaa(string llvmTy) {
+		if (!_optimize || llvmTy is not ("i1" or "i8" or "i16" or "i32" or "i64" or "float" or "double" or "ptr")) return "";
+		var root = MetadataNode("!{!\"Cloth TBAA\"}");
+		var type = MetadataNode($"!{{!\"{llvmTy}\", !{root}, i64 0}}");
+		return $", !tbaa !{MetadataNode($"!{{!{type}, !{type}, i64 0}}")}";
+	}
+
+	// `, !llvm.loop !<id>` for a loop's latch branch: a fresh distinct node listing the
+	// loop's properties, or nothing when there are none or the profile doesn't optimize.
+	private string LoopMetadata(IReadOnlyList<string> properties) {
+		if (!_optimize || properties.Count == 0) return "";
+		var ids = properties.Select(p => $"!{MetadataNode(p)}").ToList();
+		var id = _metadataNodes.Count;
+		_metadataNodes.Add($"distinct !{{!{id}, {string.Join(", ", ids)}}}");
+		return $", !llvm.loop !{id}";
+	}
+
 	// -------------------------------------------------------------------------
 	// Functions
 	// -------------------------------------------------------------------------
 
-	private string EmitFunction(CirFunction fn) {
+	private void EmitFunction(TextWriter writer, CirFunction fn) {
 		_tempCounter = 0;
 		_currentThisFqn = "";
 		_currentReturnType = fn.ReturnType;
+		_currentHasRegion = fn.HasRegion;
 		_allocaLines.Clear();
 		_prologueLines.Clear();
 		_bodyLines.Clear();
@@ -900,10 +1846,12 @@ public sealed class LlvmEmitter {
 		_loopStack.Clear();
 
 		var llvmName = MangleToLlvm(fn.MangledName);
+		_currentLlvmName = llvmName;
+		BeginPgoFunction(writer, fn, llvmName);
 		var paramSigParts = new List<string>();
 		foreach (var p in fn.Parameters) {
 			var ty = LlvmType(p.Type);
-			paramSigParts.Add($"{ty} %{p.Name}");
+			paramSigParts.Add($"{ty}{ParamAttributes(p)} %{p.Name}");
 
 			var addr = $"%{p.Name}.addr";
 			_allocaLines.Add($"  {addr} = alloca {ty}, align 8");
@@ -918,29 +1866,96 @@ public sealed class LlvmEmitter {
 		var retTy = LlvmType(fn.ReturnType);
 		var paramSig = string.Join(", ", paramSigParts);
 
+		// A `@Region` body's arena lives in its frame, empty until the first region `new`.
+		if (fn.HasRegion) {
+			_needsRegion = true;
+			_allocaLines.Add("  %__region = alloca { ptr, ptr, ptr, ptr }, align 8");
+			_prologueLines.Add("  store { ptr, ptr, ptr, ptr } zeroinitializer, ptr %__region");
+		}
+
 		foreach (var stmt in fn.Body)
 			EmitStmt(stmt);
 
 		if (!_blockTerminated) {
+			EmitRegionRelease();
 			_bodyLines.Add(fn.ReturnType is CirType.Void ? "  ret void" : $"  ret {retTy} {DefaultValue(fn.ReturnType)}");
 		}
 
-		var sb = new StringBuilder();
-		sb.AppendLine($"define {retTy} @{llvmName}({paramSig}) {{");
-		sb.AppendLine("entry:");
-		foreach (var line in _allocaLines) sb.AppendLine(line);
-		foreach (var line in _prologueLines) sb.AppendLine(line);
-		foreach (var line in _bodyLines) sb.AppendLine(line);
-		sb.AppendLine("}");
-		return sb.ToString();
+		// Allocas are collected separately so they all land in the entry block, which is
+		// what `mem2reg` promotes — so the body can't be written until it's complete. The
+		// line lists are reused across functions and only ever hold one function's body.
+		writer.WriteLine($"define {retTy} @{llvmName}({paramSig}) {{");
+		writer.WriteLine("entry:");
+		foreach (var line in _allocaLines) writer.WriteLine(line);
+		foreach (var line in _prologueLines) writer.WriteLine(line);
+		foreach (var line in _bodyLines) writer.WriteLine(line);
+		writer.WriteLine("}");
+
+		foreach (var worker in _workerFns) {
+			writer.WriteLine();
+			writer.Write(worker);
+		}
+
+		_workerFns.Clear();
+	}
+
+	// Lays out `fn`'s PGO counters. An instrumented build writes the function's name global
+	// ahead of its `define` and counts the entry; a profile-use build fetches the counts
+	// recorded against the same layout.
+	private void BeginPgoFunction(TextWriter writer, CirFunction fn, string llvmName) {
+		_pgoCounters = _pgo == PgoMode.None ? null : PgoCounters.For(fn);
+		_pgoCounts = null;
+		if (_pgoCounters == null) return;
+
+		if (_pgo == PgoMode.Use) {
+			var counts = _pgoProfile?.Counts(fn.MangledName, _pgoCounters.Hash);
+			if (counts?.Length == _pgoCounters.Count) _pgoCounts = counts;
+			return;
+		}
+
+		// The profile names functions by their CIR mangled name, unterminated.
+		var (encoded, byteCount) = EncodeStringConstant(fn.MangledName);
+		_pgoNameGlobal = $"@__profn_{llvmName}";
+		writer.WriteLine($"{_pgoNameGlobal} = private constant [{byteCount - 1} x i8] c\"{encoded[..^3]}\"");
+		EmitPgoIncrement(0);
 	}
 
-	private string EmitMainEntry() {
+	// Bump counter `index` of the current function; a no-op unless instrumenting.
+	private void EmitPgoIncrement(int? index) {
+		if (_pgo != PgoMode.Instrument || index is not { } i) return;
+		_bodyLines.Add($"  call void @llvm.instrprof.increment(ptr {_pgoNameGlobal}, i64 {unchecked((long)_pgoCounters!.Hash)}, i32 {_pgoCounters.Count}, i32 {i})");
+	}
+
+	private long PgoCount(int index) => _pgoCounts![index];
+
+	// `, !prof !<id>` weighting a two-way branch by how often each side ran, or nothing
+	// without counts. Weights are 32-bit, so large counts are scaled down together.
+	private string BranchWeights(long taken, long notTaken) {
+		if (_pgoCounts == null) return "";
+		var scale = Math.Max(taken, notTaken) / uint.MaxValue + 1;
+		return $", !prof !{MetadataNode($"!{{!\"branch_weights\", i32 {taken / scale}, i32 {notTaken / scale}}}")}";
+	}
+
+	// What Cloth guarantees about a pointer parameter on entry. `this` always points at a
+	// live instance of at least its static class, and a `Type!` parameter is the only
+	// reference to its object the call can reach (the analyzer's S033 rules).
+	private string ParamAttributes(CirParam p) {
+		if (p is { Name: "this", Type: CirType.Ptr { Inner: CirType.Named named } })
+			return StructSize(named.FullyQualifiedName) is { } size ? $" nonnull dereferenceable({size})" : " nonnull";
+		return p.Transfer && LlvmType(p.Type) == "ptr" ? " noalias" : "";
+	}
+
+	private void EmitMainEntry(TextWriter writer) {
+		if (_bench) {
+			EmitBenchEntry(writer);
+			return;
+		}
+
 		var mainCtor = FindMainCtor();
 		if (mainCtor == null) {
 			if (_config.Build.OutputType == OutputType.Executable)
 				LlvmError.NoEntryPoint.WithMessage($"project '{_config.Project.Name}' has output=executable but no class defines a constructor accepting 'args'").Render();
-			return "";
+			return;
 		}
 
 		var thisParam = mainCtor.Parameters[0];
@@ -953,26 +1968,146 @@ public sealed class LlvmEmitter {
 		var dtorCir = $"{thisFqn}.~{className}";
 		var dtorLlvm = _definedFns.Contains(dtorCir) ? MangleToLlvm(dtorCir) : null;
 
-		var sb = new StringBuilder();
-		sb.AppendLine("define i32 @main(i32 %argc, ptr %argv) {");
-		sb.AppendLine("entry:");
-		sb.AppendLine($"  %instance = alloca {structName}, align 8");
+		writer.WriteLine("define i32 @main(i32 %argc, ptr %argv) {");
+		writer.WriteLine("entry:");
+		writer.WriteLine($"  %instance = alloca {structName}, align 8");
 		// Match the heap-allocation path's zero-init guarantee for stack-allocated Main, so
 		// fields without explicit initializers come up as 0/null/false even at the entry point.
-		sb.AppendLine($"  store {structName} zeroinitializer, ptr %instance, align 8");
+		writer.WriteLine($"  store {structName} zeroinitializer, ptr %instance, align 8");
 		// Wrap C's `(argc, argv)` pair into Cloth's slice runtime `{ ptr, i64 }` so the
 		// `string[] args` parameter sees a normal Cloth array. The data pointer is the
 		// existing argv (each entry already a `char*` / Cloth-`string`-compatible ptr);
 		// length sign-extends from i32 argc.
-		sb.AppendLine("  %argc64 = sext i32 %argc to i64");
-		sb.AppendLine("  %args.tmp = insertvalue { ptr, i64 } undef, ptr %argv, 0");
-		sb.AppendLine("  %args = insertvalue { ptr, i64 } %args.tmp, i64 %argc64, 1");
-		sb.AppendLine($"  call void @{ctorLlvm}(ptr %instance, {{ ptr, i64 }} %args)");
+		writer.WriteLine("  %argc64 = sext i32 %argc to i64");
+		writer.WriteLine("  %args.tmp = insertvalue { ptr, i64 } undef, ptr %argv, 0");
+		writer.WriteLine("  %args = insertvalue { ptr, i64 } %args.tmp, i64 %argc64, 1");
+		writer.WriteLine($"  call void @{ctorLlvm}(ptr %instance, {{ ptr, i64 }} %args)");
 		if (dtorLlvm != null)
-			sb.AppendLine($"  call void @{dtorLlvm}(ptr %instance)");
-		sb.AppendLine("  ret i32 0");
-		sb.AppendLine("}");
-		return sb.ToString();
+			writer.WriteLine($"  call void @{dtorLlvm}(ptr %instance)");
+		writer.WriteLine("  ret i32 0");
+		writer.WriteLine("}");
+	}
+
+	// `main` of a `cloth bench` build. Run without arguments it lists the `@Bench` methods by
+	// CIR name, one per line; run as `<index> <iterations> <samples>` it times `samples` runs
+	// of `iterations` calls to benchmark `index` and prints each run's nanoseconds. Every call
+	// goes through a volatile load of the function pointer, takes its `@Bench(<input>)`
+	// argument from a volatile load, and stores its result into a volatile sink, so LLVM can
+	// neither inline the measured body into the loop, fold it around a constant input, nor
+	// hoist or drop the work. The clock is `QueryPerformanceCounter`, matching the windows-msvc triple.
+	private void EmitBenchEntry(TextWriter writer) {
+		var benches = _module.Functions.Where(fn => fn.IsBench && !fn.IsExtern).ToList();
+		var tableTy = $"[{benches.Count} x ptr]";
+		var table = benches.Count == 0 ? "zeroinitializer" : $"[{string.Join(", ", benches.Select(fn => $"ptr @{MangleToLlvm(fn.MangledName)}"))}]";
+		writer.WriteLine($"@__cloth_bench_fns = private global {tableTy} {table}, align 8");
+		writer.WriteLine("@.cloth_bench_name_fmt = private unnamed_addr constant [4 x i8] c\"%s\\0A\\00\", align 1");
+		writer.WriteLine("@.cloth_bench_ns_fmt = private unnamed_addr constant [6 x i8] c\"%lld\\0A\\00\", align 1");
+		for (var k = 0; k < benches.Count; k++) {
+			var (encoded, byteCount) = EncodeStringConstant(benches[k].MangledName);
+			writer.WriteLine($"@.cloth_bench_name.{k} = private unnamed_addr constant [{byteCount} x i8] c\"{encoded}\", align 1");
+			if (benches[k].ReturnType is not CirType.Void)
+				writer.WriteLine($"@__cloth_bench_sink.{k} = private global {LlvmType(benches[k].ReturnType)} zeroinitializer");
+			if (benches[k].BenchInput is { } input)
+				writer.WriteLine($"@__cloth_bench_input.{k} = private global {LlvmType(benches[k].Parameters[0].Type)} {input}");
+		}
+
+		writer.WriteLine();
+		writer.WriteLine("define private i64 @__cloth_bench_ticks() {");
+		writer.WriteLine("  %t = alloca i64, align 8");
+		writer.WriteLine($"  call {WinApiCc}i32 @QueryPerformanceCounter(ptr %t)");
+		writer.WriteLine("  %v = load i64, ptr %t, align 8");
+		writer.WriteLine("  ret i64 %v");
+		writer.WriteLine("}");
+		writer.WriteLine();
+		// Through double, so a long run's `ticks * 1e9` can't overflow.
+		writer.WriteLine("define private i64 @__cloth_bench_ns(i64 %ticks) {");
+		writer.WriteLine("  %f = alloca i64, align 8");
+		writer.WriteLine($"  call {WinApiCc}i32 @QueryPerformanceFrequency(ptr %f)");
+		writer.WriteLine("  %freq = load i64, ptr %f, align 8");
+		writer.WriteLine("  %t = sitofp i64 %ticks to double");
+		writer.WriteLine("  %hz = sitofp i64 %freq to double");
+		writer.WriteLine("  %s = fdiv double %t, %hz");
+		writer.WriteLine("  %ns = fmul double %s, 1.000000e+09");
+		writer.WriteLine("  %r = fptosi double %ns to i64");
+		writer.WriteLine("  ret i64 %r");
+		writer.WriteLine("}");
+		writer.WriteLine();
+
+		for (var k = 0; k < benches.Count; k++) {
+			var retTy = LlvmType(benches[k].ReturnType);
+			writer.WriteLine($"define private void @__cloth_bench_run.{k}(i64 %iterations, i64 %samples) {{");
+			writer.WriteLine("entry:");
+			writer.WriteLine("  br label %sample");
+			writer.WriteLine("sample:");
+			writer.WriteLine("  %s = phi i64 [ 0, %entry ], [ %s.next, %timed ]");
+			writer.WriteLine("  %more = icmp slt i64 %s, %samples");
+			writer.WriteLine("  br i1 %more, label %start, label %done");
+			writer.WriteLine("start:");
+			writer.WriteLine("  %t0 = call i64 @__cloth_bench_ticks()");
+			writer.WriteLine("  br label %iter");
+			writer.WriteLine("iter:");
+			writer.WriteLine("  %i = phi i64 [ 0, %start ], [ %i.next, %call ]");
+			writer.WriteLine("  %go = icmp slt i64 %i, %iterations");
+			writer.WriteLine("  br i1 %go, label %call, label %timed");
+			writer.WriteLine("call:");
+			writer.WriteLine($"  %fn.addr = getelementptr inbounds {tableTy}, ptr @__cloth_bench_fns, i64 0, i64 {k}");
+			writer.WriteLine("  %fn = load volatile ptr, ptr %fn.addr, align 8");
+			var callArgs = "";
+			if (benches[k].BenchInput != null) {
+				var inputTy = LlvmType(benches[k].Parameters[0].Type);
+				writer.WriteLine($"  %input = load volatile {inputTy}, ptr @__cloth_bench_input.{k}");
+				callArgs = $"{inputTy} %input";
+			}
+
+			if (retTy == "void") {
+				writer.WriteLine($"  call void %fn({callArgs})");
+			}
+			else {
+				writer.WriteLine($"  %r = call {retTy} %fn({callArgs})");
+				writer.WriteLine($"  store volatile {retTy} %r, ptr @__cloth_bench_sink.{k}");
+			}
+
+			writer.WriteLine("  %i.next = add i64 %i, 1");
+			writer.WriteLine("  br label %iter");
+			writer.WriteLine("timed:");
+			writer.WriteLine("  %t1 = call i64 @__cloth_bench_ticks()");
+			writer.WriteLine("  %dt = sub i64 %t1, %t0");
+			writer.WriteLine("  %ns = call i64 @__cloth_bench_ns(i64 %dt)");
+			writer.WriteLine("  call i32 (ptr, ...) @printf(ptr @.cloth_bench_ns_fmt, i64 %ns)");
+			writer.WriteLine("  %s.next = add i64 %s, 1");
+			writer.WriteLine("  br label %sample");
+			writer.WriteLine("done:");
+			writer.WriteLine("  ret void");
+			writer.WriteLine("}");
+			writer.WriteLine();
+		}
+
+		writer.WriteLine("define i32 @main(i32 %argc, ptr %argv) {");
+		writer.WriteLine("entry:");
+		writer.WriteLine("  %listing = icmp slt i32 %argc, 4");
+		writer.WriteLine("  br i1 %listing, label %list, label %run");
+		writer.WriteLine("list:");
+		for (var k = 0; k < benches.Count; k++)
+			writer.WriteLine($"  call i32 (ptr, ...) @printf(ptr @.cloth_bench_name_fmt, ptr @.cloth_bench_name.{k})");
+		writer.WriteLine("  ret i32 0");
+		writer.WriteLine("run:");
+		string[] args = ["index", "iterations", "samples"];
+		for (var a = 0; a < args.Length; a++) {
+			writer.WriteLine($"  %{args[a]}.addr = getelementptr inbounds ptr, ptr %argv, i64 {a + 1}");
+			writer.WriteLine($"  %{args[a]}.str = load ptr, ptr %{args[a]}.addr, align 8");
+			writer.WriteLine($"  %{args[a]} = call i64 @strtoll(ptr %{args[a]}.str, ptr null, i32 10)");
+		}
+
+		writer.WriteLine($"  switch i64 %index, label %unknown [{string.Concat(benches.Select((_, k) => $" i64 {k}, label %bench.{k}"))} ]");
+		for (var k = 0; k < benches.Count; k++) {
+			writer.WriteLine($"bench.{k}:");
+			writer.WriteLine($"  call void @__cloth_bench_run.{k}(i64 %iterations, i64 %samples)");
+			writer.WriteLine("  ret i32 0");
+		}
+
+		writer.WriteLine("unknown:");
+		writer.WriteLine("  ret i32 2");
+		writer.WriteLine("}");
 	}
 
 	private CirFunction? FindMainCtor() {
@@ -1007,7 +2142,9 @@ public sealed class LlvmEmitter {
 			case CirStmt.Continue: EmitContinue(); break;
 			case CirStmt.Delete del: EmitDelete(del); break;
 			case CirStmt.Switch sw: EmitSwitch(sw); break;
+			case CirStmt.ForIn { Parallel: true } fi: EmitParallelForIn(fi); break;
 			case CirStmt.ForIn fi: EmitForIn(fi); break;
+			case CirStmt.Join j: EmitJoin(j); break;
 			case CirStmt.Block b:
 				foreach (var s in b.Body) EmitStmt(s);
 				break;
@@ -1017,14 +2154,17 @@ public sealed class LlvmEmitter {
 		}
 	}
 
-	// `delete obj;` — call the destructor (if defined for the target's class) and free the
-	// heap allocation. Pairs with EmitAlloc's calloc.
+	// `delete obj;` — call the destructor (if defined for the target's class) and return the
+	// allocation to the size-class pool. Pairs with EmitAlloc's `__cloth_pool_alloc`; a target
+	// whose class isn't known here (and an array's data buffer) goes back to `free`.
 	private void EmitDelete(CirStmt.Delete d) {
 		// Array case: the target is a slice `{ ptr, i64 }`. We free the data buffer
 		// (not the slice value, which lives in a stack alloca and dies with the scope).
 		// If the element type is a class, iterate and call each element's dtor first so
-		// owned heap allocations aren't leaked.
+		// owned heap allocations aren't leaked. An inline array's elements live in the
+		// buffer: only the constructed slots are destroyed, and nothing is freed but it.
 		if (d.ClassFqn.EndsWith("[]")) {
+			var inlineSlotTy = InlineSlotType(GetCirArrayResultType(d.Expression));
 			var slice = EmitExpr(d.Expression);
 			var data = FreshTemp();
 			_bodyLines.Add($"  {data} = extractvalue {{ ptr, i64 }} {slice}, 0");
@@ -1035,6 +2175,7 @@ public sealed class LlvmEmitter {
 				var dtorCir = $"{elementCanon}.~{className}";
 				if (_definedFns.Contains(dtorCir)) {
 					var dtorLlvm = MangleToLlvm(dtorCir);
+					var elemSize = EmitSizeOf(StructName(elementCanon));
 					var len = FreshTemp();
 					_bodyLines.Add($"  {len} = extractvalue {{ ptr, i64 }} {slice}, 1");
 
@@ -1059,16 +2200,32 @@ public sealed class LlvmEmitter {
 
 					_bodyLines.Add($"{bodyLabel}:");
 					var slot = FreshTemp();
-					_bodyLines.Add($"  {slot} = getelementptr ptr, ptr {data}, i64 {iVal}");
-					var elem = FreshTemp();
-					_bodyLines.Add($"  {elem} = load ptr, ptr {slot}");
-					var notNull = FreshTemp();
-					_bodyLines.Add($"  {notNull} = icmp ne ptr {elem}, null");
-					_bodyLines.Add($"  br i1 {notNull}, label %{dtorLabel}, label %{iterLabel}");
+					string elem, live;
+					if (inlineSlotTy != null) {
+						_bodyLines.Add($"  {slot} = getelementptr {inlineSlotTy}, ptr {data}, i64 {iVal}");
+						elem = slot;
+						var flagPtr = FreshTemp();
+						_bodyLines.Add($"  {flagPtr} = getelementptr {inlineSlotTy}, ptr {slot}, i32 0, i32 1");
+						var flag = FreshTemp();
+						_bodyLines.Add($"  {flag} = load i8, ptr {flagPtr}");
+						live = FreshTemp();
+						_bodyLines.Add($"  {live} = icmp ne i8 {flag}, 0");
+					}
+					else {
+						_bodyLines.Add($"  {slot} = getelementptr ptr, ptr {data}, i64 {iVal}");
+						elem = FreshTemp();
+						_bodyLines.Add($"  {elem} = load ptr, ptr {slot}");
+						live = FreshTemp();
+						_bodyLines.Add($"  {live} = icmp ne ptr {elem}, null");
+					}
+					_bodyLines.Add($"  br i1 {live}, label %{dtorLabel}, label %{iterLabel}");
 
 					_bodyLines.Add($"{dtorLabel}:");
 					_bodyLines.Add($"  call void @{dtorLlvm}(ptr {elem})");
-					_bodyLines.Add($"  call void @free(ptr {elem})");
+					if (inlineSlotTy == null) {
+						_bodyLines.Add($"  call void @__cloth_pool_free(ptr {elem}, i64 {elemSize})");
+						_needsPool = true;
+					}
 					_bodyLines.Add($"  br label %{iterLabel}");
 
 					_bodyLines.Add($"{iterLabel}:");
@@ -1086,7 +2243,8 @@ public sealed class LlvmEmitter {
 		}
 
 		var ptr = EmitExpr(d.Expression);
-		if (!string.IsNullOrEmpty(d.ClassFqn) && _classByFqn.ContainsKey(d.ClassFqn)) {
+		var knownClass = !string.IsNullOrEmpty(d.ClassFqn) && _classByFqn.ContainsKey(d.ClassFqn);
+		if (knownClass) {
 			// MangleDtor convention: `<TypeFqn>.~<ClassName>`.
 			var className = d.ClassFqn.Contains('.') ? d.ClassFqn[(d.ClassFqn.LastIndexOf('.') + 1)..] : d.ClassFqn;
 			var dtorCir = $"{d.ClassFqn}.~{className}";
@@ -1096,24 +2254,40 @@ public sealed class LlvmEmitter {
 			}
 		}
 
+		// A frame-allocated object's storage goes away with the frame, whichever way a heap
+		// one would have been released.
+		if (d.OnStack) return;
+		if (knownClass) {
+			_bodyLines.Add($"  call void @__cloth_pool_free(ptr {ptr}, i64 {EmitSizeOf(StructName(d.ClassFqn))})");
+			_needsPool = true;
+			return;
+		}
+
 		_bodyLines.Add($"  call void @free(ptr {ptr})");
 	}
 
 	private void EmitIf(CirStmt.If i) {
 		var endLabel = FreshLabel("if_end");
-		EmitIfBranches(i.Condition, i.Then, i.ElseIfs, 0, i.Else, endLabel);
+		EmitIfBranches(i.Condition, i.Then, i.ElseIfs, 0, i.Else, endLabel, _pgoCounters?.FirstArm(i));
 		_bodyLines.Add($"{endLabel}:");
 		_blockTerminated = false;
 	}
 
-	private void EmitIfBranches(CirExpr cond, List<CirStmt> thenBody, List<(CirExpr Cond, List<CirStmt> Body)> elseIfs, int idx, List<CirStmt>? elseBody, string endLabel) {
+	// Condition `idx` of the chain is PGO arm `idx`; the final `else` (written or not) is the
+	// last arm. A condition's branch is weighted by its own arm against every later one.
+	private void EmitIfBranches(CirExpr cond, List<CirStmt> thenBody, List<(CirExpr Cond, List<CirStmt> Body)> elseIfs, int idx, List<CirStmt>? elseBody, string endLabel, int? firstArm) {
 		var thenLabel = FreshLabel("then");
 		var elseLabel = FreshLabel("else");
+		var lastArm = elseIfs.Count + 1;
 		var c = EmitExpr(cond);
-		_bodyLines.Add($"  br i1 {c}, label %{thenLabel}, label %{elseLabel}");
+		var weights = firstArm is { } arm && _pgoCounts != null
+			? BranchWeights(PgoCount(arm + idx), Enumerable.Range(arm + idx + 1, lastArm - idx).Sum(PgoCount))
+			: "";
+		_bodyLines.Add($"  br i1 {c}, label %{thenLabel}, label %{elseLabel}{weights}");
 
 		_bodyLines.Add($"{thenLabel}:");
 		_blockTerminated = false;
+		EmitPgoIncrement(firstArm + idx);
 		foreach (var s in thenBody) EmitStmt(s);
 		if (!_blockTerminated) _bodyLines.Add($"  br label %{endLabel}");
 
@@ -1121,9 +2295,12 @@ public sealed class LlvmEmitter {
 		_blockTerminated = false;
 		if (idx < elseIfs.Count) {
 			var (nextCond, nextBody) = elseIfs[idx];
-			EmitIfBranches(nextCond, nextBody, elseIfs, idx + 1, elseBody, endLabel);
+			EmitIfBranches(nextCond, nextBody, elseIfs, idx + 1, elseBody, endLabel, firstArm);
+			return;
 		}
-		else if (elseBody != null) {
+
+		EmitPgoIncrement(firstArm + lastArm);
+		if (elseBody != null) {
 			foreach (var s in elseBody) EmitStmt(s);
 			if (!_blockTerminated) _bodyLines.Add($"  br label %{endLabel}");
 		}
@@ -1160,11 +2337,17 @@ public sealed class LlvmEmitter {
 		_bodyLines.Add($"  {data} = extractvalue {{ ptr, i64 }} {slice}, 0");
 		var len = FreshTemp();
 		_bodyLines.Add($"  {len} = extractvalue {{ ptr, i64 }} {slice}, 1");
+		EmitElementLoop(fi, data, "0", len, InlineSlotType(GetCirArrayResultType(fi.Iterable)));
+	}
 
+	// The loop of `EmitForIn` over elements `[lo, hi)` of the buffer at `data`, shared with
+	// the workers of a `parallel for`. `inlineSlotTy` is the buffer's slot type when its class
+	// elements are stored inline.
+	private void EmitElementLoop(CirStmt.ForIn fi, string data, string lo, string hi, string? inlineSlotTy) {
 		var iAddr = FreshLabel("forin_i") + ".addr";
 		// Allocas always land in the function entry block — keep them in `_allocaLines`.
 		_allocaLines.Add($"  %{iAddr} = alloca i64, align 8");
-		_bodyLines.Add($"  store i64 0, ptr %{iAddr}");
+		_bodyLines.Add($"  store i64 {lo}, ptr %{iAddr}");
 
 		var condLabel = FreshLabel("forin_cond");
 		var bodyLabel = FreshLabel("forin_body");
@@ -1177,21 +2360,24 @@ public sealed class LlvmEmitter {
 		var iVal = FreshTemp();
 		_bodyLines.Add($"  {iVal} = load i64, ptr %{iAddr}");
 		var cmp = FreshTemp();
-		_bodyLines.Add($"  {cmp} = icmp slt i64 {iVal}, {len}");
+		_bodyLines.Add($"  {cmp} = icmp slt i64 {iVal}, {hi}");
 		_bodyLines.Add($"  br i1 {cmp}, label %{bodyLabel}, label %{endLabel}");
 
 		_bodyLines.Add($"{bodyLabel}:");
 		_blockTerminated = false;
 		var eltTy = LlvmType(fi.ElementType);
 		var eltPtr = FreshTemp();
-		_bodyLines.Add($"  {eltPtr} = getelementptr {eltTy}, ptr {data}, i64 {iVal}");
+		_bodyLines.Add($"  {eltPtr} = getelementptr {inlineSlotTy ?? eltTy}, ptr {data}, i64 {iVal}");
 
 		// Element binding: `let x = elements[i]`. Register a local addr/type so the body
-		// can read `x`.
+		// can read `x`. An inline element's value is its slot's address.
 		var elemAddr = $"%{fi.ElementName}.addr";
 		_allocaLines.Add($"  {elemAddr} = alloca {eltTy}, align 8");
-		var elemVal = FreshTemp();
-		_bodyLines.Add($"  {elemVal} = load {eltTy}, ptr {eltPtr}");
+		var elemVal = eltPtr;
+		if (inlineSlotTy == null) {
+			elemVal = FreshTemp();
+			_bodyLines.Add($"  {elemVal} = load {eltTy}, ptr {eltPtr}{Tbaa(eltTy)}");
+		}
 		_bodyLines.Add($"  store {eltTy} {elemVal}, ptr {elemAddr}");
 		_localAddrMap[fi.ElementName] = elemAddr;
 		_localTypeMap[fi.ElementName] = fi.ElementType;
@@ -1208,22 +2394,295 @@ public sealed class LlvmEmitter {
 		_bodyLines.Add($"  {iCur} = load i64, ptr %{iAddr}");
 		_bodyLines.Add($"  {iNext} = add i64 {iCur}, 1");
 		_bodyLines.Add($"  store i64 {iNext}, ptr %{iAddr}");
-		_bodyLines.Add($"  br label %{condLabel}");
+		_bodyLines.Add($"  br label %{condLabel}{LoopMetadata(ForInLoopProperties(fi))}");
 
 		_bodyLines.Add($"{endLabel}:");
 		_blockTerminated = false;
 	}
 
+	// A for-in runs once per element of a fixed-length slice, so it always terminates:
+	// `mustprogress`. A body that only reads and folds integers into locals is a reduction
+	// the vectorizer can always handle, so it also gets `vectorize.enable`; floating-point
+	// bodies don't, since the hint also licenses reassociating the arithmetic.
+	private List<string> ForInLoopProperties(CirStmt.ForIn fi) {
+		var properties = new List<string> { "!{!\"llvm.loop.mustprogress\"}" };
+		if (IsIntegerLlvmType(LlvmType(fi.ElementType)) && fi.Body.All(IsIntegerReductionStmt))
+			properties.Add("!{!\"llvm.loop.vectorize.enable\", i1 true}");
+		return properties;
+	}
+
+	private bool IsIntegerReductionStmt(CirStmt stmt) => stmt switch {
+		CirStmt.Assign { Target: CirExpr.Local target } a => IsPureIntegerExpr(target) && IsPureIntegerExpr(a.Value),
+		CirStmt.LocalDecl { Init: { } init } ld => ld.Type is { } ty && IsIntegerLlvmType(LlvmType(ty)) && IsPureIntegerExpr(init),
+		_ => false
+	};
+
+	// No calls, allocations, checked accesses or floating point — nothing that can exit the
+	// loop early or needs reassociation. Pow calls a helper, so it's out as well.
+	private bool IsPureIntegerExpr(CirExpr expr) => expr switch {
+		CirExpr.IntLit or CirExpr.BoolLit or CirExpr.CharLit => true,
+		CirExpr.Local l => _localTypeMap.TryGetValue(l.Name, out var ty) && IsIntegerLlvmType(LlvmType(ty)),
+		CirExpr.Binary b => b.Op != CirBinOp.Pow && IsPureIntegerExpr(b.Left) && IsPureIntegerExpr(b.Right),
+		CirExpr.Unary u => IsPureIntegerExpr(u.Operand),
+		CirExpr.Index { Checked: false, Target: CirExpr.Local } ix => IsIntegerLlvmType(LlvmElementTypeOf(ix.Target)) && IsPureIntegerExpr(ix.Idx),
+		CirExpr.ArrayLength { Target: CirExpr.Local } => true,
+		_ => false
+	};
+
+	// `parallel for (T x in xs) { body }` — the loop of `EmitForIn`, outlined into a worker
+	// that runs a sub-range of the elements, and handed to `@__cloth_par_for` with the element
+	// count. The worker's environment is `{ slice, captured locals... }`.
+	private void EmitParallelForIn(CirStmt.ForIn fi) {
+		_needsParallel = true;
+		var slice = EmitExpr(fi.Iterable);
+		var inlineSlotTy = InlineSlotType(GetCirArrayResultType(fi.Iterable));
+		var captures = CapturedLocals(refs => refs.RewriteBlock(fi.Body), fi.ElementName);
+		var envTy = EnvironmentType(captures.Select(c => LlvmType(c.Type)).Prepend("{ ptr, i64 }"));
+		var env = EmitEnvironment(envTy, captures, [("{ ptr, i64 }", slice)]);
+
+		var worker = EmitWorker("par", captures, envTy, 1, () => {
+			var field = FreshTemp();
+			_bodyLines.Add($"  {field} = getelementptr {envTy}, ptr %env, i32 0, i32 0");
+			var loaded = FreshTemp();
+			_bodyLines.Add($"  {loaded} = load {{ ptr, i64 }}, ptr {field}");
+			var data = FreshTemp();
+			_bodyLines.Add($"  {data} = extractvalue {{ ptr, i64 }} {loaded}, 0");
+			EmitElementLoop(fi, data, "%lo", "%hi", inlineSlotTy);
+		});
+
+		var len = FreshTemp();
+		_bodyLines.Add($"  {len} = extractvalue {{ ptr, i64 }} {slice}, 1");
+		_bodyLines.Add($"  call void @__cloth_par_for(ptr @{worker}, ptr {env}, i64 {len}, i64 0)");
+	}
+
+	// `join { spawn ...; }` — every task's operands are evaluated here, in order, before any
+	// task starts (`HoistTaskOperands`). The tasks are outlined into one worker that runs
+	// task `i` for each index `i` of its range, and `@__cloth_par_for` deals the indices out
+	// one per chunk.
+	private void EmitJoin(CirStmt.Join j) {
+		if (j.Tasks.Count == 0) return;
+		_needsParallel = true;
+		var tasks = j.Tasks.Select(HoistTaskOperands).ToList();
+		var captures = CapturedLocals(refs => tasks.ForEach(t => refs.Rewrite(t)), null);
+		var envTy = EnvironmentType(captures.Select(c => LlvmType(c.Type)));
+		var env = EmitEnvironment(envTy, captures, []);
+
+		var worker = EmitWorker("join", captures, envTy, 0, () => {
+			var iAddr = FreshLabel("join_i") + ".addr";
+			_allocaLines.Add($"  %{iAddr} = alloca i64, align 8");
+			_bodyLines.Add($"  store i64 %lo, ptr %{iAddr}");
+			var condLabel = FreshLabel("join_cond");
+			var dispatchLabel = FreshLabel("join_dispatch");
+			var nextLabel = FreshLabel("join_next");
+			var endLabel = FreshLabel("join_end");
+			var taskLabels = tasks.Select(_ => FreshLabel("join_task")).ToList();
+
+			_bodyLines.Add($"  br label %{condLabel}");
+			_bodyLines.Add($"{condLabel}:");
+			var iVal = FreshTemp();
+			_bodyLines.Add($"  {iVal} = load i64, ptr %{iAddr}");
+			var cmp = FreshTemp();
+			_bodyLines.Add($"  {cmp} = icmp slt i64 {iVal}, %hi");
+			_bodyLines.Add($"  br i1 {cmp}, label %{dispatchLabel}, label %{endLabel}");
+
+			_bodyLines.Add($"{dispatchLabel}:");
+			_bodyLines.Add($"  switch i64 {iVal}, label %{nextLabel} [");
+			for (var k = 0; k < tasks.Count; k++)
+				_bodyLines.Add($"    i64 {k}, label %{taskLabels[k]}");
+			_bodyLines.Add("  ]");
+
+			for (var k = 0; k < tasks.Count; k++) {
+				_bodyLines.Add($"{taskLabels[k]}:");
+				_blockTerminated = false;
+				EmitExprStmt(tasks[k]);
+				_bodyLines.Add($"  br label %{nextLabel}");
+			}
+
+			_bodyLines.Add($"{nextLabel}:");
+			var iCur = FreshTemp();
+			_bodyLines.Add($"  {iCur} = load i64, ptr %{iAddr}");
+			var iNext = FreshTemp();
+			_bodyLines.Add($"  {iNext} = add i64 {iCur}, 1");
+			_bodyLines.Add($"  store i64 {iNext}, ptr %{iAddr}");
+			_bodyLines.Add($"  br label %{condLabel}");
+			_bodyLines.Add($"{endLabel}:");
+			_blockTerminated = false;
+		});
+
+		_bodyLines.Add($"  call void @__cloth_par_for(ptr @{worker}, ptr {env}, i64 {tasks.Count}, i64 1)");
+	}
+
+	// Evaluates the operands of a spawned call into fresh frame locals, which the worker then
+	// captures, so the task sees them as they were at the spawn. Literals and `this` are left
+	// in place; a task the passes rewrote into something other than a call is evaluated whole
+	// by the worker.
+	private CirExpr HoistTaskOperands(CirExpr task) {
+		switch (task) {
+			case CirExpr.Call c when !_variadicLeading.ContainsKey(c.MangledName) && _module.FindFunction(c.MangledName) is { } fn:
+				return c with { Args = c.Args.Select((a, i) => i < fn.Parameters.Count ? HoistOperand(a, fn.Parameters[i].Type) : a).ToList() };
+			case CirExpr.VirtualCall vc:
+				return vc with { Receiver = HoistOperand(vc.Receiver, new CirType.Any()), Args = vc.Args.Select((a, i) => HoistOperand(a, vc.ParamTypes[i])).ToList() };
+			default:
+				return task;
+		}
+	}
+
+	private CirExpr HoistOperand(CirExpr operand, CirType type) {
+		if (operand is CirExpr.IntLit or CirExpr.FloatLit or CirExpr.BoolLit or CirExpr.CharLit or CirExpr.StrLit or CirExpr.NullLit or CirExpr.ThisPtr) return operand;
+		var name = FreshLabel("spawn_arg");
+		var ty = LlvmType(type);
+		var addr = $"%{name}.addr";
+		_allocaLines.Add($"  {addr} = alloca {ty}, align 8");
+		_bodyLines.Add($"  store {ty} {EmitExpr(operand)}, ptr {addr}");
+		_localAddrMap[name] = addr;
+		_localTypeMap[name] = type;
+		return new CirExpr.Local(name);
+	}
+
+	// The current function's locals a worker body refers to, minus `bound` (a name the body
+	// binds itself), in first-use order. `this` is always passed along when there is one.
+	private List<(string Name, CirType Type)> CapturedLocals(Action<CirRewriter> visit, string? bound) {
+		var refs = new LocalReferences();
+		if (_localAddrMap.ContainsKey("this")) refs.Add("this");
+		visit(refs);
+		return refs.Names.Where(n => n != bound && _localAddrMap.ContainsKey(n) && _localTypeMap.ContainsKey(n)).Select(n => (n, _localTypeMap[n])).ToList();
+	}
+
+	// Names a CIR tree reads or writes, `this` included, in first-use order.
+	private sealed class LocalReferences : CirRewriter {
+		private readonly HashSet<string> _seen = new();
+
+		public readonly List<string> Names = new();
+
+		public void Add(string name) {
+			if (_seen.Add(name)) Names.Add(name);
+		}
+
+		public override CirExpr Rewrite(CirExpr expr) {
+			if (expr is CirExpr.Local l) Add(l.Name);
+			else if (expr is CirExpr.ThisPtr) Add("this");
+			return RewriteChildren(expr);
+		}
+	}
+
+	private static string EnvironmentType(IEnumerable<string> fieldTypes) {
+		var fields = string.Join(", ", fieldTypes);
+		return fields.Length == 0 ? "{}" : $"{{ {fields} }}";
+	}
+
+	// A frame record of type `envTy` holding `leading`, then the current values of `captures`.
+	// It outlives its workers: `@__cloth_par_for` only returns once they're all done.
+	private string EmitEnvironment(string envTy, List<(string Name, CirType Type)> captures, List<(string Ty, string Value)> leading) {
+		var env = $"%{FreshLabel("par_env")}";
+		_allocaLines.Add($"  {env} = alloca {envTy}, align 8");
+		var fields = leading.Concat(captures.Select(c => (Ty: LlvmType(c.Type), Value: EmitLocalLoad(c.Name)))).ToList();
+		for (var i = 0; i < fields.Count; i++) {
+			var field = FreshTemp();
+			_bodyLines.Add($"  {field} = getelementptr {envTy}, ptr {env}, i32 0, i32 {i}");
+			_bodyLines.Add($"  store {fields[i].Ty} {fields[i].Value}, ptr {field}");
+		}
+
+		return env;
+	}
+
+	// Outlines a parallel region into `internal void @<fn>.<kind>_<n>(ptr %env, i64 %lo, i64 %hi)`,
+	// the shape `@__cloth_par_for` calls on each thread. The worker copies `captures` out of
+	// fields `first...` of the `envTy` record at `%env` into its own locals; `emitRange` then
+	// writes the code for the indices `[%lo, %hi)`. The analyzer rejects writes to captured
+	// locals, so copies behave like the originals. The current function's emission state is set
+	// aside meanwhile, and the worker is written after it. Workers run without the function's
+	// `@Region` arena, which isn't thread-safe: the generator lowers their `new`s as ordinary
+	// pool allocations, owned and freed like any other.
+	private string EmitWorker(string kind, List<(string Name, CirType Type)> captures, string envTy, int first, Action emitRange) {
+		var name = $"{_currentLlvmName}.{FreshLabel(kind)}";
+		var savedTemps = _tempCounter;
+		var savedReturnType = _currentReturnType;
+		var savedHasRegion = _currentHasRegion;
+		var savedTerminated = _blockTerminated;
+		var savedAllocas = _allocaLines.ToList();
+		var savedPrologue = _prologueLines.ToList();
+		var savedBody = _bodyLines.ToList();
+		var savedAddrs = new Dictionary<string, string>(_localAddrMap);
+		var savedTypes = new Dictionary<string, CirType>(_localTypeMap);
+		var savedLoops = _loopStack.ToArray();
+		_currentReturnType = new CirType.Void();
+		_currentHasRegion = false;
+		_blockTerminated = false;
+		_allocaLines.Clear();
+		_prologueLines.Clear();
+		_bodyLines.Clear();
+		_localAddrMap.Clear();
+		_localTypeMap.Clear();
+		_loopStack.Clear();
+
+		for (var i = 0; i < captures.Count; i++) {
+			var (local, type) = captures[i];
+			var ty = LlvmType(type);
+			var addr = $"%{local}.addr";
+			_allocaLines.Add($"  {addr} = alloca {ty}, align 8");
+			var field = FreshTemp();
+			_prologueLines.Add($"  {field} = getelementptr {envTy}, ptr %env, i32 0, i32 {first + i}");
+			var value = FreshTemp();
+			_prologueLines.Add($"  {value} = load {ty}, ptr {field}");
+			_prologueLines.Add($"  store {ty} {value}, ptr {addr}");
+			_localAddrMap[local] = addr;
+			_localTypeMap[local] = type;
+		}
+
+		emitRange();
+		if (!_blockTerminated) _bodyLines.Add("  ret void");
+
+		var text = new StringBuilder();
+		text.AppendLine($"define internal void @{name}(ptr %env, i64 %lo, i64 %hi) {{");
+		text.AppendLine("entry:");
+		foreach (var line in _allocaLines) text.AppendLine(line);
+		foreach (var line in _prologueLines) text.AppendLine(line);
+		foreach (var line in _bodyLines) text.AppendLine(line);
+		text.AppendLine("}");
+		_workerFns.Add(text.ToString());
+
+		_tempCounter = savedTemps;
+		_currentReturnType = savedReturnType;
+		_currentHasRegion = savedHasRegion;
+		_blockTerminated = savedTerminated;
+		_allocaLines.Clear();
+		_allocaLines.AddRange(savedAllocas);
+		_prologueLines.Clear();
+		_prologueLines.AddRange(savedPrologue);
+		_bodyLines.Clear();
+		_bodyLines.AddRange(savedBody);
+		_localAddrMap.Clear();
+		foreach (var (k, v) in savedAddrs) _localAddrMap[k] = v;
+		_localTypeMap.Clear();
+		foreach (var (k, v) in savedTypes) _localTypeMap[k] = v;
+		_loopStack.Clear();
+		foreach (var frame in savedLoops.Reverse()) _loopStack.Push(frame);
+		return name;
+	}
+
 	// `switch (subject) { case pattern: body; default: body; }` — break-by-default per
-	// case (no C-style fall-through). Lowers as a chain of `icmp eq` comparisons against
-	// each case's pattern value. Floating-point subjects use `fcmp oeq`. Enum-typed
-	// subjects compare as pointers (each variant is a singleton global). A `default:`
-	// arm is the miss target; without one, the miss path falls through to switch-end.
-	// `break` inside a case body jumps to switch-end via the loop-stack.
+	// case (no C-style fall-through). A `default:` arm is the miss target; without one, the
+	// miss path falls through to switch-end. `break` inside a case body jumps to switch-end
+	// via the loop-stack. How the arm is found depends on the patterns:
+	//
+	//  - Integer, char and bool constants, and enum cases of an enum defined in this module
+	//    (keyed by the ordinal in slot 0 of `%enum.<fqn>`, since the case globals' addresses
+	//    aren't constants clang can tabulate), go through `EmitKeySearch`: an LLVM `switch`
+	//    when the keys are dense, else a balanced binary search down to dense runs.
+	//  - String literals switch on the subject's `@__cloth_str_hash` against the literals'
+	//    compile-time hashes, then confirm the bucket's candidates with `strcmp`.
+	//  - Anything else is a chain of `icmp eq` / `fcmp oeq` against each pattern in turn.
+	//
+	// A later arm repeating an earlier constant can never match, as in the chain.
+	//
+	// Under PGO case `i` is arm `i` and a missing `default:` the arm after the last case.
+	// With counts, the search and confirm branches are weighted by the arms behind them; in a
+	// chain, each check is weighted by its case against everything tested after it, and
+	// constant, pairwise-distinct patterns are tested hottest first — at most one can match,
+	// so the order is unobservable.
 	private void EmitSwitch(CirStmt.Switch sw) {
 		var subjectVal = EmitExpr(sw.Subject);
 		var subjectTy = LlvmTypeOf(sw.Subject);
-		var cmpOp = subjectTy is "float" or "double" ? "fcmp oeq" : "icmp eq";
 		var endLabel = FreshLabel("switch_end");
 
 		// Split pattern arms from the (at most one) default arm and pre-allocate every
@@ -1239,28 +2698,55 @@ public sealed class LlvmEmitter {
 		for (var i = 0; i < sw.Cases.Count; i++)
 			bodyLabels[i] = FreshLabel(sw.Cases[i].Pattern == null ? "case_default" : "case_body");
 
-		var missLabel = defaultIdx >= 0 ? bodyLabels[defaultIdx] : endLabel;
-
-		// Per-pattern check labels (each block runs one compare + branch). The first one
-		// is what entry falls into; each subsequent check is the failure target of the
-		// previous one.
-		var checkLabels = patternIdx.Select(_ => FreshLabel("check")).ToList();
-
-		// Entry: branch into the first check (or directly to the miss target if there
-		// are no pattern arms).
-		if (checkLabels.Count > 0) _bodyLines.Add($"  br label %{checkLabels[0]}");
-		else _bodyLines.Add($"  br label %{missLabel}");
+		var firstArm = _pgoCounters?.FirstArm(sw);
+		var implicitMiss = defaultIdx < 0 && _pgo == PgoMode.Instrument && firstArm != null ? FreshLabel("switch_miss") : null;
+		var missLabel = defaultIdx >= 0 ? bodyLabels[defaultIdx] : implicitMiss ?? endLabel;
+
+		long ArmCount(int caseIdx) => PgoCount(firstArm!.Value + caseIdx);
+		var weighted = firstArm != null && _pgoCounts != null;
+		var missCount = weighted ? ArmCount(defaultIdx >= 0 ? defaultIdx : sw.Cases.Count) : 0;
+
+		if (SwitchKeys(sw, subjectTy, patternIdx) is { } keyed) {
+			var (keyTy, arms) = keyed;
+			var keyVal = subjectVal;
+			if (keyTy == "i32" && subjectTy == "ptr") {
+				GuardNull(sw.Subject, subjectVal, missLabel);
+				keyVal = FreshTemp();
+				_bodyLines.Add($"  {keyVal} = load i32, ptr {subjectVal}");
+			}
 
-		// Emit one `check<i>: cmp; br` block per pattern arm.
-		for (var k = 0; k < patternIdx.Count; k++) {
-			_bodyLines.Add($"{checkLabels[k]}:");
-			_blockTerminated = false;
-			var caseIdx = patternIdx[k];
-			var pat = EmitExpr(sw.Cases[caseIdx].Pattern!);
-			var cmp = FreshTemp();
-			_bodyLines.Add($"  {cmp} = {cmpOp} {subjectTy} {subjectVal}, {pat}");
-			var nextLabel = k + 1 < checkLabels.Count ? checkLabels[k + 1] : missLabel;
-			_bodyLines.Add($"  br i1 {cmp}, label %{bodyLabels[caseIdx]}, label %{nextLabel}");
+			EmitKeySearch(keyTy, keyVal, arms.Select(a => new SwitchTarget(a.Key, bodyLabels[a.CaseIdx], weighted ? ArmCount(a.CaseIdx) : 0)).ToList(), missLabel, missCount);
+		}
+		else if (subjectTy == "ptr" && patternIdx.Count > 0 && patternIdx.All(i => sw.Cases[i].Pattern is CirExpr.StrLit)) {
+			EmitStringSwitch(sw, subjectVal, patternIdx, bodyLabels, missLabel, weighted ? ArmCount : null, missCount);
+		}
+		else {
+			if (weighted && PatternsCommute(patternIdx.Select(i => sw.Cases[i].Pattern!)))
+				patternIdx = patternIdx.OrderByDescending(ArmCount).ToList();
+			var cmpOp = subjectTy is "float" or "double" ? "fcmp oeq" : "icmp eq";
+
+			// Per-pattern check labels (each block runs one compare + branch). The first one
+			// is what entry falls into; each subsequent check is the failure target of the
+			// previous one.
+			var checkLabels = patternIdx.Select(_ => FreshLabel("check")).ToList();
+
+			// Entry: branch into the first check (or directly to the miss target if there
+			// are no pattern arms).
+			if (checkLabels.Count > 0) _bodyLines.Add($"  br label %{checkLabels[0]}");
+			else _bodyLines.Add($"  br label %{missLabel}");
+
+			// Emit one `check<i>: cmp; br` block per pattern arm.
+			for (var k = 0; k < patternIdx.Count; k++) {
+				_bodyLines.Add($"{checkLabels[k]}:");
+				_blockTerminated = false;
+				var caseIdx = patternIdx[k];
+				var pat = EmitExpr(sw.Cases[caseIdx].Pattern!);
+				var cmp = FreshTemp();
+				_bodyLines.Add($"  {cmp} = {cmpOp} {subjectTy} {subjectVal}, {pat}");
+				var nextLabel = k + 1 < checkLabels.Count ? checkLabels[k + 1] : missLabel;
+				var weights = weighted ? BranchWeights(ArmCount(caseIdx), patternIdx.Skip(k + 1).Sum(ArmCount) + missCount) : "";
+				_bodyLines.Add($"  br i1 {cmp}, label %{bodyLabels[caseIdx]}, label %{nextLabel}{weights}");
+			}
 		}
 
 		// Emit each case body — pattern arms in declaration order, then the default arm
@@ -1269,15 +2755,183 @@ public sealed class LlvmEmitter {
 		for (var i = 0; i < sw.Cases.Count; i++) {
 			_bodyLines.Add($"{bodyLabels[i]}:");
 			_blockTerminated = false;
+			EmitPgoIncrement(firstArm + i);
 			foreach (var s in sw.Cases[i].Body) EmitStmt(s);
 			if (!_blockTerminated) _bodyLines.Add($"  br label %{endLabel}");
 		}
 		_loopStack.Pop();
 
+		if (implicitMiss != null) {
+			_bodyLines.Add($"{implicitMiss}:");
+			EmitPgoIncrement(firstArm + sw.Cases.Count);
+			_bodyLines.Add($"  br label %{endLabel}");
+		}
+
 		_bodyLines.Add($"{endLabel}:");
 		_blockTerminated = false;
 	}
 
+	// One arm a key search can branch to: its key, body label and PGO count (0 without counts).
+	private sealed record SwitchTarget(long Key, string Label, long Count);
+
+	// A run of keys at least this dense is left to one LLVM `switch` (which clang lowers to a
+	// jump table); this many keys or fewer always are, since a few compares beat a split.
+	private const double SwitchDensity = 0.4;
+	private const int SwitchLeafKeys = 4;
+
+	// The key type and per-arm keys of a switch whose patterns are all constants `EmitKeySearch`
+	// can dispatch on, in arm order with repeats dropped; null otherwise. Integer keys are the
+	// pattern's bits at the subject's width, read as signed — the order the search compares in.
+	private (string KeyTy, List<(long Key, int CaseIdx)> Arms)? SwitchKeys(CirStmt.Switch sw, string subjectTy, List<int> patternIdx) {
+		if (patternIdx.Count == 0) return null;
+
+		var keyTy = subjectTy;
+		Func<CirExpr, long?> keyOf;
+		if (IsIntegerLlvmType(subjectTy)) {
+			keyOf = pattern => IntegerPatternValue(pattern) is { } v ? SignedAtWidth(v, BitWidth(subjectTy)) : null;
+		}
+		else if (subjectTy == "ptr" && sw.Cases[patternIdx[0]].Pattern is CirExpr.EnumCaseRef first && _module.EnumsByFqn.TryGetValue(first.EnumFqn, out var decl) && !_enumExternFqns.Contains(first.EnumFqn)) {
+			keyTy = "i32";
+			keyOf = pattern => pattern is CirExpr.EnumCaseRef ec && ec.EnumFqn == decl.FullyQualifiedName && decl.Cases.FirstOrDefault(c => c.Name == ec.CaseName) is { } c ? c.Ordinal : null;
+		}
+		else {
+			return null;
+		}
+
+		var arms = new List<(long Key, int CaseIdx)>();
+		var seen = new HashSet<long>();
+		foreach (var i in patternIdx) {
+			if (keyOf(sw.Cases[i].Pattern!) is not { } key) return null;
+			if (seen.Add(key)) arms.Add((key, i));
+		}
+
+		return (keyTy, arms);
+	}
+
+	private static BigInteger? IntegerPatternValue(CirExpr pattern) => pattern switch {
+		CirExpr.IntLit i when BigInteger.TryParse(i.Value, NumberStyles.AllowLeadingSign, CultureInfo.InvariantCulture, out var v) => v,
+		CirExpr.CharLit c => c.Value,
+		CirExpr.BoolLit b => b.Value ? 1 : 0,
+		CirExpr.Unary { Op: CirUnOp.Neg, Operand: CirExpr.IntLit } neg => -IntegerPatternValue(neg.Operand),
+		CirExpr.Cast { Value: CirExpr.IntLit or CirExpr.CharLit or CirExpr.BoolLit or CirExpr.Unary } cast => IntegerPatternValue(cast.Value),
+		_ => null
+	};
+
+	private static long SignedAtWidth(BigInteger value, int width) {
+		var bits = (long)(ulong)(value & ulong.MaxValue);
+		return width == 64 ? bits : bits << (64 - width) >> (64 - width);
+	}
+
+	// Branches from the current block to the label of the arm whose key `keyVal` equals, or to
+	// `missLabel`. Dense or short runs of the sorted keys are one `switch`; longer sparse ones
+	// split at the median key on `icmp slt` and search each half the same way. A miss isn't
+	// attributed to a key range, so each leaf's default carries the whole miss count.
+	private void EmitKeySearch(string keyTy, string keyVal, List<SwitchTarget> targets, string missLabel, long missCount) {
+		targets = targets.OrderBy(t => t.Key).ToList();
+		Search(0, targets.Count);
+
+		void Search(int lo, int hi) {
+			var count = hi - lo;
+			var span = (double)targets[hi - 1].Key - targets[lo].Key + 1;
+			if (count <= SwitchLeafKeys || count >= SwitchDensity * span) {
+				var run = targets.GetRange(lo, count);
+				var cases = string.Join(" ", run.Select(t => $"{keyTy} {t.Key}, label %{t.Label}"));
+				_bodyLines.Add($"  switch {keyTy} {keyVal}, label %{missLabel} [ {cases} ]{SwitchWeights(missCount, run.Select(t => t.Count))}");
+				return;
+			}
+
+			var mid = lo + count / 2;
+			var below = FreshLabel("switch_lo");
+			var above = FreshLabel("switch_hi");
+			var cmp = FreshTemp();
+			_bodyLines.Add($"  {cmp} = icmp slt {keyTy} {keyVal}, {targets[mid].Key}");
+			_bodyLines.Add($"  br i1 {cmp}, label %{below}, label %{above}{BranchWeights(targets.Skip(lo).Take(mid - lo).Sum(t => t.Count), targets.Skip(mid).Take(hi - mid).Sum(t => t.Count))}");
+			_bodyLines.Add($"{below}:");
+			Search(lo, mid);
+			_bodyLines.Add($"{above}:");
+			Search(mid, hi);
+		}
+	}
+
+	// `switch` on string literals: hash the subject once, find the literals with that hash
+	// through `EmitKeySearch`, and `strcmp` each of them. A null subject matches no case.
+	private void EmitStringSwitch(CirStmt.Switch sw, string subjectVal, List<int> patternIdx, string[] bodyLabels, string missLabel, Func<int, long>? armCount, long missCount) {
+		_needsStrHash = true;
+		GuardNull(sw.Subject, subjectVal, missLabel);
+		var hash = FreshTemp();
+		_bodyLines.Add($"  {hash} = call i64 @__cloth_str_hash(ptr {subjectVal})");
+
+		var buckets = patternIdx
+			.Select(i => (Value: ((CirExpr.StrLit)sw.Cases[i].Pattern!).Value, CaseIdx: i))
+			.DistinctBy(a => a.Value)
+			.GroupBy(a => StringHash(a.Value))
+			.Select(g => (Hash: g.Key, Arms: g.ToList(), Label: FreshLabel("str_bucket")))
+			.ToList();
+		EmitKeySearch("i64", hash, buckets.Select(b => new SwitchTarget(b.Hash, b.Label, armCount == null ? 0 : b.Arms.Sum(a => armCount(a.CaseIdx)))).ToList(), missLabel, missCount);
+
+		foreach (var bucket in buckets) {
+			_bodyLines.Add($"{bucket.Label}:");
+			for (var k = 0; k < bucket.Arms.Count; k++) {
+				var (value, caseIdx) = bucket.Arms[k];
+				var order = FreshTemp();
+				var eq = FreshTemp();
+				_bodyLines.Add($"  {order} = call i32 @strcmp(ptr {subjectVal}, ptr {InternString(value)})");
+				_bodyLines.Add($"  {eq} = icmp eq i32 {order}, 0");
+				var next = k + 1 < bucket.Arms.Count ? FreshLabel("str_next") : missLabel;
+				var weights = armCount == null ? "" : BranchWeights(armCount(caseIdx), bucket.Arms.Skip(k + 1).Sum(a => armCount(a.CaseIdx)));
+				_bodyLines.Add($"  br i1 {eq}, label %{bodyLabels[caseIdx]}, label %{next}{weights}");
+				if (k + 1 < bucket.Arms.Count) _bodyLines.Add($"{next}:");
+			}
+		}
+	}
+
+	// Sends a null `subjectVal` to `missLabel` before the search dereferences it, unless the
+	// subject's static type rules null out.
+	private void GuardNull(CirExpr subject, string subjectVal, string missLabel) {
+		var nonNull = subject switch {
+			CirExpr.EnumCaseRef or CirExpr.StrLit or CirExpr.ThisPtr => true,
+			CirExpr.Local l => _localTypeMap.TryGetValue(l.Name, out var ty) && ty is not CirType.Nullable,
+			_ => false
+		};
+		if (nonNull) return;
+
+		var isNull = FreshTemp();
+		var present = FreshLabel("switch_subject");
+		_bodyLines.Add($"  {isNull} = icmp eq ptr {subjectVal}, null");
+		_bodyLines.Add($"  br i1 {isNull}, label %{missLabel}, label %{present}");
+		_bodyLines.Add($"{present}:");
+	}
+
+	// `!prof` weights of a `switch`: the default first, then each case in order.
+	private string SwitchWeights(long missCount, IEnumerable<long> caseCounts) {
+		if (_pgoCounts == null) return "";
+		var counts = caseCounts.Prepend(missCount).ToList();
+		var scale = counts.Max() / uint.MaxValue + 1;
+		return $", !prof !{MetadataNode($"!{{!\"branch_weights\", {string.Join(", ", counts.Select(c => $"i32 {c / scale}"))}}}")}";
+	}
+
+	// 64-bit FNV-1a over a string's UTF-8 bytes, as `@__cloth_str_hash` computes it at run time.
+	private static long StringHash(string value) {
+		var hash = 14695981039346656037UL;
+		foreach (var b in Encoding.UTF8.GetBytes(value)) {
+			hash ^= b;
+			hash *= 1099511628211UL;
+		}
+
+		return (long)hash;
+	}
+
+	private static bool PatternsCommute(IEnumerable<CirExpr> patterns) {
+		var seen = new HashSet<CirExpr>();
+		return patterns.All(p => IsConstantPattern(p) && seen.Add(p));
+	}
+
+	private static bool IsConstantPattern(CirExpr pattern) => pattern switch {
+		CirExpr.IntLit or CirExpr.CharLit or CirExpr.BoolLit or CirExpr.EnumCaseRef => true,
+		CirExpr.Cast { Value: CirExpr.IntLit or CirExpr.CharLit } => true,
+		_ => false
+	};
+
 	// `while (cond) { body }`. `continue` jumps to the condition block; `break` to the end.
 	private void EmitWhile(CirStmt.While w) {
 		var condLabel = FreshLabel("while_cond");
@@ -1391,24 +3045,47 @@ public sealed class LlvmEmitter {
 	}
 
 	private void EmitAssign(CirStmt.Assign a) {
+		if (a is { Op: CirAssignOp.Assign, Target: CirExpr.Index ix, Value: CirExpr.Alloc alloc } && InlineSlotType(GetCirArrayResultType(ix.Target)) != null) {
+			EmitInlineConstruct(ix, alloc);
+			return;
+		}
+
 		var addr = EmitAddrOf(a.Target);
 		var (targetTy, _) = TypeOfLvalue(a.Target);
 		var llvmTy = LlvmType(targetTy);
 		var rhs = EmitExpr(a.Value);
+		// Locals live in allocas mem2reg promotes; only heap fields and slots are tagged.
+		var tbaa = a.Target is CirExpr.FieldAccess or CirExpr.Index ? Tbaa(llvmTy) : "";
 
 		if (a.Op == CirAssignOp.Assign) {
-			_bodyLines.Add($"  store {llvmTy} {rhs} , ptr {addr}".Replace(" , ", ", "));
+			_bodyLines.Add($"  store {llvmTy} {rhs} , ptr {addr}{tbaa}".Replace(" , ", ", "));
 		}
 		else {
 			var loaded = FreshTemp();
-			_bodyLines.Add($"  {loaded} = load {llvmTy}, ptr {addr}");
+			_bodyLines.Add($"  {loaded} = load {llvmTy}, ptr {addr}{tbaa}");
 			var op = AssignToBinOp(a.Op);
 			var combined = FreshTemp();
 			_bodyLines.Add($"  {combined} = {LlvmBinOp(op, llvmTy)} {llvmTy} {loaded}, {rhs}");
-			_bodyLines.Add($"  store {llvmTy} {combined}, ptr {addr}");
+			_bodyLines.Add($"  store {llvmTy} {combined}, ptr {addr}{tbaa}");
 		}
 	}
 
+	// `arr[i] = new C(...)` into an inline array: build the object in its slot — zeroed like
+	// a fresh allocation — instead of allocating one, then mark the slot constructed when the
+	// class has a destructor to run on `delete arr`.
+	private void EmitInlineConstruct(CirExpr.Index ix, CirExpr.Alloc alloc) {
+		var slot = EmitIndexAddr(ix);
+		var argVals = alloc.Args.Select(EmitExpr).ToList();
+		var fqn = ((CirType.Named)alloc.Type).FullyQualifiedName;
+		var structName = StructName(fqn);
+		_bodyLines.Add($"  call void @llvm.memset.p0.i64(ptr {slot}, i8 0, i64 {EmitSizeOf(structName)}, i1 false)");
+		EmitCtorCall(alloc, slot, argVals);
+		if (!HasInlineFlag(fqn)) return;
+		var flag = FreshTemp();
+		_bodyLines.Add($"  {flag} = getelementptr {{ {structName}, i8 }}, ptr {slot}, i32 0, i32 1");
+		_bodyLines.Add($"  store i8 1, ptr {flag}");
+	}
+
 	private void EmitExprStmt(CirExpr expr) {
 		// Calls and other side-effecting expressions; emit and discard.
 		_ = EmitExpr(expr);
@@ -1416,16 +3093,24 @@ public sealed class LlvmEmitter {
 
 	private void EmitReturn(CirStmt.Return r) {
 		if (r.Value == null) {
+			EmitRegionRelease();
 			_bodyLines.Add("  ret void");
 		}
 		else {
 			var val = EmitExpr(r.Value);
+			EmitRegionRelease();
 			_bodyLines.Add($"  ret {LlvmType(_currentReturnType)} {val}");
 		}
 
 		_blockTerminated = true;
 	}
 
+	// Tear down a `@Region` body's arena ahead of a `ret`. The analyzer keeps region objects
+	// from being returned, so the returned value is already computed and doesn't point into it.
+	private void EmitRegionRelease() {
+		if (_currentHasRegion) _bodyLines.Add("  call void @__cloth_region_release(ptr %__region)");
+	}
+
 	// -------------------------------------------------------------------------
 	// Expressions
 	// -------------------------------------------------------------------------
@@ -1483,7 +3168,8 @@ public sealed class LlvmEmitter {
 	private string EmitFieldLoad(CirExpr.FieldAccess fa) {
 		var (gep, fieldType) = EmitFieldGep(fa);
 		var t = FreshTemp();
-		_bodyLines.Add($"  {t} = load {LlvmType(fieldType)}, ptr {gep}");
+		var llvmTy = LlvmType(fieldType);
+		_bodyLines.Add($"  {t} = load {llvmTy}, ptr {gep}{Tbaa(llvmTy)}");
 		return t;
 	}
 
@@ -1531,20 +3217,23 @@ public sealed class LlvmEmitter {
 		// Pre-evaluate every dimension's size so we don't re-run side effects across
 		// loop iterations. Each ends up as an i64 SSA value.
 		var sizes = na.Sizes.Select(s => CoerceTo(EmitExpr(s), LlvmTypeOf(s), "i64")).ToList();
-		return EmitNewArrayDim(na.ElementType, sizes, 0);
+		return EmitNewArrayDim(na.ElementType, sizes, 0, na.Inline);
 	}
 
 	// Recursive helper: allocate dimension `depth`'s buffer, and if there are inner
 	// dimensions left, run a loop that fills each outer slot with a fresh allocation
 	// of the next level.
-	private string EmitNewArrayDim(CirType leafElementType, List<string> sizes, int depth) {
+	private string EmitNewArrayDim(CirType leafElementType, List<string> sizes, int depth, bool inline = false) {
 		var remaining = sizes.Count - depth;
 		var size = sizes[depth];
 
 		// Element type at this level: leaf when this is the deepest dim, slice-of-slices
-		// (or slice-of-leaf) wrapped as `{ ptr, i64 }` for outer dims.
+		// (or slice-of-leaf) wrapped as `{ ptr, i64 }` for outer dims. An inline leaf is
+		// sized by its slot, and calloc's zeroing leaves every constructed flag clear.
 		var isLeaf = remaining == 1;
-		var thisEltTy = isLeaf ? LlvmType(leafElementType) : "{ ptr, i64 }";
+		var thisEltTy = !isLeaf ? "{ ptr, i64 }"
+			: inline ? InlineSlotType(new CirType.Array(leafElementType, Inline: true))!
+			: LlvmType(leafElementType);
 
 		// sizeof(thisEltTy) via GEP-null trick.
 		var sizePtr = FreshTemp();
@@ -1600,7 +3289,7 @@ public sealed class LlvmEmitter {
 	// for the failure path (idx = lo on panic, so the message is at least informative).
 	// The sub-slice borrows — the user must keep the parent live for its lifetime.
 	private string EmitSubslice(CirExpr.Subslice ss) {
-		_needsBoundsPanic = true;
+		_needsBoundsPanic |= ss.Checked;
 
 		var slice = EmitExpr(ss.Target);
 		var data = FreshTemp();
@@ -1612,28 +3301,23 @@ public sealed class LlvmEmitter {
 		var hi = CoerceTo(EmitExpr(ss.Hi), LlvmTypeOf(ss.Hi), "i64");
 
 		// Bounds: lo < 0, hi > len, lo > hi — any one is a panic.
-		var negLo = FreshTemp();
-		_bodyLines.Add($"  {negLo} = icmp slt i64 {lo}, 0");
-		var hiOver = FreshTemp();
-		_bodyLines.Add($"  {hiOver} = icmp sgt i64 {hi}, {len}");
-		var loGtHi = FreshTemp();
-		_bodyLines.Add($"  {loGtHi} = icmp sgt i64 {lo}, {hi}");
-		var bad1 = FreshTemp();
-		_bodyLines.Add($"  {bad1} = or i1 {negLo}, {hiOver}");
-		var bad = FreshTemp();
-		_bodyLines.Add($"  {bad} = or i1 {bad1}, {loGtHi}");
-		var panicLabel = FreshLabel("subslice_panic");
-		var okLabel = FreshLabel("subslice_ok");
-		_bodyLines.Add($"  br i1 {bad}, label %{panicLabel}, label %{okLabel}");
-		_bodyLines.Add($"{panicLabel}:");
-		_bodyLines.Add($"  call void @__cloth_panic_bounds(i64 {lo}, i64 {len})");
-		_bodyLines.Add($"  unreachable");
-		_bodyLines.Add($"{okLabel}:");
-		_blockTerminated = false;
+		if (ss.Checked) {
+			var negLo = FreshTemp();
+			_bodyLines.Add($"  {negLo} = icmp slt i64 {lo}, 0");
+			var hiOver = FreshTemp();
+			_bodyLines.Add($"  {hiOver} = icmp sgt i64 {hi}, {len}");
+			var loGtHi = FreshTemp();
+			_bodyLines.Add($"  {loGtHi} = icmp sgt i64 {lo}, {hi}");
+			var bad1 = FreshTemp();
+			_bodyLines.Add($"  {bad1} = or i1 {negLo}, {hiOver}");
+			var bad = FreshTemp();
+			_bodyLines.Add($"  {bad} = or i1 {bad1}, {loGtHi}");
+			EmitBoundsPanicBranch(bad, lo, len, "subslice");
+		}
 
-		var eltTy = LlvmType(ss.ElementType);
+		var slotTy = LlvmSlotTypeOf(ss.Target);
 		var newData = FreshTemp();
-		_bodyLines.Add($"  {newData} = getelementptr {eltTy}, ptr {data}, i64 {lo}");
+		_bodyLines.Add($"  {newData} = getelementptr {slotTy}, ptr {data}, i64 {lo}");
 		var newLen = FreshTemp();
 		_bodyLines.Add($"  {newLen} = sub i64 {hi}, {lo}");
 		var sliceWithData = FreshTemp();
@@ -1652,11 +3336,11 @@ public sealed class LlvmEmitter {
 	}
 
 	// Load an element from a slice: `arr[i]`. Extracts the data pointer and length from
-	// the slice, validates the index against `0 <= i < length`, then GEPs to the i-th
-	// element and loads. An out-of-bounds index calls `@__cloth_panic_bounds` (lazy-
-	// emitted in `Build`), which prints a diagnostic and aborts.
+	// the slice, validates the index against `0 <= i < length` (skipped when the access is
+	// unchecked), then GEPs to the i-th element and loads. An out-of-bounds index calls
+	// `@__cloth_panic_bounds` (lazy-emitted in `Build`), which prints a diagnostic and aborts.
 	private string EmitIndexLoad(CirExpr.Index ix) {
-		_needsBoundsPanic = true;
+		_needsBoundsPanic |= ix.Checked;
 
 		var slice = EmitExpr(ix.Target);
 		var data = FreshTemp();
@@ -1668,28 +3352,42 @@ public sealed class LlvmEmitter {
 		var idxTy = LlvmTypeOf(ix.Idx);
 		var idx64 = CoerceTo(idx, idxTy, "i64");
 
-		// Bounds check: signed comparisons cover both negative indices and >= length.
+		if (ix.Checked) EmitIndexBoundsCheck(idx64, len);
+
+		var slotTy = LlvmSlotTypeOf(ix.Target);
+		var slot = FreshTemp();
+		_bodyLines.Add($"  {slot} = getelementptr {slotTy}, ptr {data}, i64 {idx64}");
+		// An inline element is the slot itself.
+		if (InlineSlotType(GetCirArrayResultType(ix.Target)) != null) return slot;
+
+		var eltTy = LlvmElementTypeOf(ix.Target);
+		var t = FreshTemp();
+		_bodyLines.Add($"  {t} = load {eltTy}, ptr {slot}{Tbaa(eltTy)}");
+		return t;
+	}
+
+	// `0 <= idx < len`. Signed comparisons cover both negative indices and >= length.
+	private void EmitIndexBoundsCheck(string idx64, string len) {
 		var neg = FreshTemp();
 		_bodyLines.Add($"  {neg} = icmp slt i64 {idx64}, 0");
 		var oob = FreshTemp();
 		_bodyLines.Add($"  {oob} = icmp sge i64 {idx64}, {len}");
 		var bad = FreshTemp();
 		_bodyLines.Add($"  {bad} = or i1 {neg}, {oob}");
-		var panicLabel = FreshLabel("bounds_panic");
-		var okLabel = FreshLabel("bounds_ok");
+		EmitBoundsPanicBranch(bad, idx64, len);
+	}
+
+	// Branch to a `@__cloth_panic_bounds(idx, len)` + `unreachable` block when `bad` holds;
+	// emission continues in the fall-through block.
+	private void EmitBoundsPanicBranch(string bad, string idx, string len, string labelPrefix = "bounds") {
+		var panicLabel = FreshLabel($"{labelPrefix}_panic");
+		var okLabel = FreshLabel($"{labelPrefix}_ok");
 		_bodyLines.Add($"  br i1 {bad}, label %{panicLabel}, label %{okLabel}");
 		_bodyLines.Add($"{panicLabel}:");
-		_bodyLines.Add($"  call void @__cloth_panic_bounds(i64 {idx64}, i64 {len})");
+		_bodyLines.Add($"  call void @__cloth_panic_bounds(i64 {idx}, i64 {len})");
 		_bodyLines.Add($"  unreachable");
 		_bodyLines.Add($"{okLabel}:");
 		_blockTerminated = false;
-
-		var eltTy = LlvmElementTypeOf(ix.Target);
-		var slot = FreshTemp();
-		_bodyLines.Add($"  {slot} = getelementptr {eltTy}, ptr {data}, i64 {idx64}");
-		var t = FreshTemp();
-		_bodyLines.Add($"  {t} = load {eltTy}, ptr {slot}");
-		return t;
 	}
 
 	// Return the LLVM element type for an array-typed expression. Falls back to `ptr`
@@ -1700,6 +3398,26 @@ public sealed class LlvmEmitter {
 		return arr != null ? LlvmType(arr.Element) : "ptr";
 	}
 
+	// The type one slot of an array's buffer holds — what GEPs into the buffer step over.
+	// Matches the element type except for `Inline` class arrays (see `InlineSlotType`).
+	private string LlvmSlotTypeOf(CirExpr expr) =>
+		InlineSlotType(GetCirArrayResultType(expr)) ?? LlvmElementTypeOf(expr);
+
+	// An `Inline` class array stores each element by value: the class's struct, paired with
+	// an i8 "constructed" flag when the class has a destructor so `delete` skips the slots
+	// nothing was ever built in. The element's value (`arr[i]`, a for-in binding) is the
+	// slot's address, which is also the struct's. Null for every other array.
+	private string? InlineSlotType(CirType.Array? arr) {
+		if (arr is not { Inline: true, Element: CirType.Named named }) return null;
+		var structName = StructName(named.FullyQualifiedName);
+		return HasInlineFlag(named.FullyQualifiedName) ? $"{{ {structName}, i8 }}" : structName;
+	}
+
+	private bool HasInlineFlag(string classFqn) {
+		var className = classFqn.Contains('.') ? classFqn[(classFqn.LastIndexOf('.') + 1)..] : classFqn;
+		return _definedFns.Contains($"{classFqn}.~{className}");
+	}
+
 	// Recover the array type produced by an expression as a `CirType.Array`. Returns null
 	// when the expression isn't array-typed (e.g. a scalar `arr[i]` on a 1-d slice, or a
 	// call whose return type is non-array). Used by both `LlvmElementTypeOf` and
@@ -1711,16 +3429,20 @@ public sealed class LlvmEmitter {
 			case CirExpr.NewArray na: {
 				// Multi-dim `new T[a][b][c]`: the outer result type is `T[][][]`. Wrap the
 				// leaf once per declared dimension.
+				if (na.Inline) return new CirType.Array(na.ElementType, Inline: true);
 				CirType t = na.ElementType;
 				for (var i = 0; i < na.Sizes.Count; i++) t = new CirType.Array(t);
 				return (CirType.Array) t;
 			}
 			case CirExpr.Subslice ss:
-				return new CirType.Array(ss.ElementType);
+				// A sub-slice shares its parent's buffer, so it shares its parent's layout too.
+				return new CirType.Array(ss.ElementType, GetCirArrayResultType(ss.Target)?.Inline ?? false);
 			case CirExpr.Local l when _localTypeMap.TryGetValue(l.Name, out var ty) && ty is CirType.Array arr:
 				return arr;
+			case CirExpr.StaticFieldRef sr:
+				return sr.Type as CirType.Array;
 			case CirExpr.Call c:
-				var fn = _module.Functions.FirstOrDefault(f => f.MangledName == c.MangledName);
+				var fn = _module.FindFunction(c.MangledName);
 				return fn?.ReturnType as CirType.Array;
 			case CirExpr.Index ix:
 				// `target[i]` produces target-element. If target-element is itself an array
@@ -1804,7 +3526,7 @@ public sealed class LlvmEmitter {
 			argTypes = c.Args.Select(LlvmTypeOf).ToList();
 		}
 		else {
-			var callee = _module.Functions.FirstOrDefault(f => f.MangledName == c.MangledName);
+			var callee = _module.FindFunction(c.MangledName);
 			argTypes = callee != null ? callee.Parameters.Select(p => LlvmType(p.Type)).ToList() : Enumerable.Repeat("ptr", c.Args.Count).ToList();
 			while (argTypes.Count < c.Args.Count) argTypes.Add("ptr");
 		}
@@ -1813,7 +3535,7 @@ public sealed class LlvmEmitter {
 		var argList = string.Join(", ", argVals.Select((v, i) => $"{argTypes[i]} {v}"));
 
 		string retTy;
-		var registered = _module.Functions.FirstOrDefault(f => f.MangledName == c.MangledName);
+		var registered = _module.FindFunction(c.MangledName);
 		retTy = registered != null ? LlvmType(registered.ReturnType) : "void";
 
 		string fnTypePrefix = "";
@@ -1834,19 +3556,17 @@ public sealed class LlvmEmitter {
 	}
 
 	// Virtual dispatch through the receiver's `__vtable__` header. Loads the vtable pointer
-	// from offset 0 of the receiver, GEPs to the global slot, loads the function pointer,
-	// and calls it with the receiver passed as the implicit `this` argument.
+	// from offset 0 of the receiver, GEPs to the slot's row position, loads the function
+	// pointer, and calls it with the receiver passed as the implicit `this` argument.
 	private string EmitVirtualCall(CirExpr.VirtualCall vc) {
 		var receiver = EmitExpr(vc.Receiver);
 		// Load the vtable pointer from the receiver's header (offset 0).
 		var vtablePtr = FreshTemp();
 		_bodyLines.Add($"  {vtablePtr} = load ptr, ptr {receiver}, align 8");
-		// GEP into the vtable's methods array. The vtable struct shape is `{ ptr, [N x ptr] }`
-		// — the leading `ptr` is the parent-class vtable used for inheritance walks; field 1
-		// is the interface-method array. Use any size >= SlotId+1 so the GEP is well-typed.
+		// GEP into the vtable's methods array, field 4 after the fixed-size header.
 		var slotAddr = FreshTemp();
-		var vsize = vc.SlotId + 1;
-		_bodyLines.Add($"  {slotAddr} = getelementptr {{ ptr, [{vsize} x ptr] }}, ptr {vtablePtr}, i32 0, i32 1, i32 {vc.SlotId}");
+		var position = _module.DispatchLayout.PositionOf(vc.SlotId);
+		_bodyLines.Add($"  {slotAddr} = getelementptr {VtableHeaderType}, ptr {vtablePtr}, i32 0, i32 4, i32 {position}");
 		// Load the function pointer from the slot.
 		var fnPtr = FreshTemp();
 		_bodyLines.Add($"  {fnPtr} = load ptr, ptr {slotAddr}, align 8");
@@ -1869,63 +3589,62 @@ public sealed class LlvmEmitter {
 		return t;
 	}
 
-	// Emit the runtime parent-chain walk for class identity checks. Loads the receiver's
-	// vtable, compares against the target's vtable global, and on mismatch loads the
-	// parent slot and loops. Returns `(hitLabel, missLabel)` — labels at which the caller
-	// must terminate each branch with the appropriate result handling.
+	// Class subtype check in constant time against the display stored in every vtable. A
+	// receiver is a `T` iff its class sits at least as deep as `T` and its display entry at
+	// `T`'s depth is `T`'s vtable. `T`'s depth is a compile-time constant, so the check is
+	// one depth load and compare (skipped for roots, which every class in their hierarchy
+	// reaches) and one display entry load and compare. Returns `(hitLabel, missLabel)` —
+	// labels at which the caller must terminate each branch with the appropriate result
+	// handling.
 	//
-	// Loop shape:
-	//   entry:    vt0 = load receiver; br loop
-	//   loop:     cur = phi [vt0, entry], [parent, iter]
-	//             match = icmp eq cur, target
-	//             br match → hit | check_null
-	//   check_null: isnull = icmp eq cur, null
-	//             br isnull → miss | iter
-	//   iter:     parent_addr = gep cur, field 0
-	//             parent = load
-	//             br loop
+	// Shape:
+	//   entry:    vt = load receiver
+	//             depth = load gep vt, field 3
+	//             deep = icmp uge depth, d
+	//             br deep → probe | miss
+	//   probe:    display = load gep vt, field 1
+	//             entry = load gep display, d
+	//             match = icmp eq entry, target
+	//             br match → hit | miss
 	//   hit:      <caller's success branch>
 	//   miss:     <caller's failure branch>
-	private (string hitLabel, string missLabel) EmitVtableChainSearch(string receiver, string targetVtableSym) {
-		var entryLabel = FreshLabel("cast_entry");
-		var loopLabel = FreshLabel("cast_loop");
-		var iterLabel = FreshLabel("cast_iter");
-		var checkNullLabel = FreshLabel("cast_chknull");
+	private (string hitLabel, string missLabel) EmitClassDisplayCheck(string receiver, string targetClassFqn) {
 		var hitLabel = FreshLabel("cast_hit");
 		var missLabel = FreshLabel("cast_miss");
+		var targetDepth = AncestorVtables(targetClassFqn).Count - 1;
 
-		var initVt = FreshTemp();
-		var cur = FreshTemp();
-		var match = FreshTemp();
-		var isNull = FreshTemp();
-		var parentAddr = FreshTemp();
-		var parent = FreshTemp();
-		var vsize = VtableSlotCount();
-
-		_bodyLines.Add($"  br label %{entryLabel}");
-		_bodyLines.Add($"{entryLabel}:");
-		_bodyLines.Add($"  {initVt} = load ptr, ptr {receiver}, align 8");
-		_bodyLines.Add($"  br label %{loopLabel}");
-
-		_bodyLines.Add($"{loopLabel}:");
-		_bodyLines.Add($"  {cur} = phi ptr [{initVt}, %{entryLabel}], [{parent}, %{iterLabel}]");
-		_bodyLines.Add($"  {match} = icmp eq ptr {cur}, {targetVtableSym}");
-		_bodyLines.Add($"  br i1 {match}, label %{hitLabel}, label %{checkNullLabel}");
+		var vtablePtr = FreshTemp();
+		_bodyLines.Add($"  {vtablePtr} = load ptr, ptr {receiver}, align 8");
 
-		_bodyLines.Add($"{checkNullLabel}:");
-		_bodyLines.Add($"  {isNull} = icmp eq ptr {cur}, null");
-		_bodyLines.Add($"  br i1 {isNull}, label %{missLabel}, label %{iterLabel}");
+		if (targetDepth > 0) {
+			var probeLabel = FreshLabel("cast_probe");
+			var depthAddr = FreshTemp();
+			var depth = FreshTemp();
+			var deep = FreshTemp();
+			_bodyLines.Add($"  {depthAddr} = getelementptr {VtableHeaderType}, ptr {vtablePtr}, i32 0, i32 3");
+			_bodyLines.Add($"  {depth} = load i32, ptr {depthAddr}, align 4");
+			_bodyLines.Add($"  {deep} = icmp uge i32 {depth}, {targetDepth}");
+			_bodyLines.Add($"  br i1 {deep}, label %{probeLabel}, label %{missLabel}");
+			_bodyLines.Add($"{probeLabel}:");
+		}
 
-		_bodyLines.Add($"{iterLabel}:");
-		_bodyLines.Add($"  {parentAddr} = getelementptr {{ ptr, [{vsize} x ptr] }}, ptr {cur}, i32 0, i32 0");
-		_bodyLines.Add($"  {parent} = load ptr, ptr {parentAddr}, align 8");
-		_bodyLines.Add($"  br label %{loopLabel}");
+		var displayAddr = FreshTemp();
+		var display = FreshTemp();
+		var entryAddr = FreshTemp();
+		var entry = FreshTemp();
+		var match = FreshTemp();
+		_bodyLines.Add($"  {displayAddr} = getelementptr {VtableHeaderType}, ptr {vtablePtr}, i32 0, i32 1");
+		_bodyLines.Add($"  {display} = load ptr, ptr {displayAddr}, align 8");
+		_bodyLines.Add($"  {entryAddr} = getelementptr ptr, ptr {display}, i32 {targetDepth}");
+		_bodyLines.Add($"  {entry} = load ptr, ptr {entryAddr}, align 8");
+		_bodyLines.Add($"  {match} = icmp eq ptr {entry}, @{MangleVtableGlobal(targetClassFqn)}");
+		_bodyLines.Add($"  br i1 {match}, label %{hitLabel}, label %{missLabel}");
 
 		return (hitLabel, missLabel);
 	}
 
 	// `x as T` / `x as? T` for reference downcasts. Two paths:
-	//   * Class target: chain-walks parent vtables looking for the target's vtable global.
+	//   * Class target: checks the target's entry in the receiver's vtable display.
 	//   * Interface target: checks the per-class implements bitmap. Hit → receiver as-is;
 	//     miss → abort (`as`) or null (`as?`).
 	private string EmitDowncast(CirExpr.Downcast dc) {
@@ -1949,7 +3668,7 @@ public sealed class LlvmEmitter {
 			return receiver;
 		}
 
-		var (hitLabel, missLabel) = EmitVtableChainSearch(receiver, $"@{MangleVtableGlobal(dc.TargetClassFqn)}");
+		var (hitLabel, missLabel) = EmitClassDisplayCheck(receiver, dc.TargetClassFqn);
 
 		if (dc.IsSafe) {
 			var doneLabel = FreshLabel("cast_done");
@@ -1975,8 +3694,8 @@ public sealed class LlvmEmitter {
 	}
 
 	// `x is T` — runtime kind check. Two paths:
-	//   * Class target: chain-walks the receiver's vtable parents looking for the target's
-	//     vtable global. Match → true; null parent reached → false.
+	//   * Class target: checks the receiver's vtable display at the target's depth.
+	//     Match → true; too shallow or another class → false.
 	//   * Interface target: looks up the interface ID in the per-class implements bitmap
 	//     appended to every vtable struct (field 2). Bit set → true; bit clear → false.
 	private string EmitTypeCheck(CirExpr.TypeCheck tc) {
@@ -1996,7 +3715,7 @@ public sealed class LlvmEmitter {
 		}
 
 		var classReceiver = EmitExpr(tc.Value);
-		var (hitLabel, missLabel) = EmitVtableChainSearch(classReceiver, $"@{MangleVtableGlobal(targetFqn)}");
+		var (hitLabel, missLabel) = EmitClassDisplayCheck(classReceiver, targetFqn);
 		var doneLabel = FreshLabel("is_done");
 		_bodyLines.Add($"{hitLabel}:");
 		_bodyLines.Add($"  br label %{doneLabel}");
@@ -2009,21 +3728,22 @@ public sealed class LlvmEmitter {
 		return result;
 	}
 
-	// Load the receiver's vtable, GEP to the implements bitmap field (struct field 2),
-	// then to byte `ifaceId / 8`. Mask with `1 << (ifaceId % 8)` and compare against 0
+	// Load the receiver's vtable and from it the implements bitmap pointer (struct field 2),
+	// then byte `ifaceId / 8`. Mask with `1 << (ifaceId % 8)` and compare against 0
 	// to produce an i1. Used by both `EmitTypeCheck` (returns the i1 directly) and
 	// `EmitDowncast` (branches on the i1 for hit/miss).
 	private string EmitImplementsBitCheck(string receiver, int ifaceId) {
-		var bitmapBytes = (_module.InterfaceCount + 7) / 8;
-		var vsize = VtableSlotCount();
 		var byteIdx = ifaceId / 8;
 		var bitMask = 1 << (ifaceId % 8);
 
 		var vtablePtr = FreshTemp();
 		_bodyLines.Add($"  {vtablePtr} = load ptr, ptr {receiver}, align 8");
+		var bitmapAddr = FreshTemp();
+		var bitmap = FreshTemp();
+		_bodyLines.Add($"  {bitmapAddr} = getelementptr {VtableHeaderType}, ptr {vtablePtr}, i32 0, i32 2");
+		_bodyLines.Add($"  {bitmap} = load ptr, ptr {bitmapAddr}, align 8");
 		var byteAddr = FreshTemp();
-		// GEP into field 2 (implements bitmap), then to byte `byteIdx`.
-		_bodyLines.Add($"  {byteAddr} = getelementptr {{ ptr, [{vsize} x ptr], [{bitmapBytes} x i8] }}, ptr {vtablePtr}, i32 0, i32 2, i32 {byteIdx}");
+		_bodyLines.Add($"  {byteAddr} = getelementptr i8, ptr {bitmap}, i32 {byteIdx}");
 		var byteVal = FreshTemp();
 		_bodyLines.Add($"  {byteVal} = load i8, ptr {byteAddr}, align 1");
 		var masked = FreshTemp();
@@ -2116,10 +3836,12 @@ public sealed class LlvmEmitter {
 		return loaded;
 	}
 
-	// `new ClassName(args)` — heap-allocate a zero-initialized instance, run its constructor,
-	// return the pointer. Memory model: `calloc(1, sizeof(struct))` guarantees zero bits, so
-	// fields without explicit initializers come up as 0/null/false. Lifetime is unmanaged
-	// (leaks until explicit `delete`).
+	// `new ClassName(args)` — allocate a zero-initialized instance, run its constructor,
+	// return the pointer. Every allocator hands back zeroed memory, so fields without explicit
+	// initializers come up as 0/null/false. A plain `new` comes from the size-class pool and
+	// lives until its `delete`; a region `new` (`InRegion`) is bump-allocated in the enclosing
+	// `@Region` body's arena, which also records the class's destructor to run at release; a
+	// promoted `new` (`OnStack`) lives in the function's frame.
 	private string EmitAlloc(CirExpr.Alloc a) {
 		if (a.Type is not CirType.Named named) {
 			LlvmError.UnsupportedExpression.WithMessage($"alloc target must be a named class type, got {a.Type.GetType().Name}").Render();
@@ -2129,33 +3851,52 @@ public sealed class LlvmEmitter {
 		var fqn = named.FullyQualifiedName;
 		var structName = StructName(fqn);
 
-		// Compute sizeof(struct) via the GEP-null trick: pointer to element index 1 of a null
-		// pointer is the byte offset of one struct, i.e. its size. ptrtoint converts to i64.
-		var sizePtr = FreshTemp();
-		_bodyLines.Add($"  {sizePtr} = getelementptr {structName}, ptr null, i32 1");
-		var sizeI64 = FreshTemp();
-		_bodyLines.Add($"  {sizeI64} = ptrtoint ptr {sizePtr} to i64");
-
-		// Heap allocation. calloc zeroes the memory, satisfying the "fields default to zero" rule
-		// without an additional memset.
+		var sizeI64 = EmitSizeOf(structName);
 		var obj = FreshTemp();
-		_bodyLines.Add($"  {obj} = call ptr @calloc(i64 1, i64 {sizeI64})");
+		if (a.OnStack) {
+			// Frame slot in the entry block; re-zeroed here since a loop reaches the same `new`
+			// (and so the same slot) once per iteration.
+			_allocaLines.Add($"  {obj} = alloca {structName}, align 16");
+			_bodyLines.Add($"  call void @llvm.memset.p0.i64(ptr {obj}, i8 0, i64 {sizeI64}, i1 false)");
+		}
+		else if (a.InRegion && _currentHasRegion) {
+			var className = fqn.Contains('.') ? fqn[(fqn.LastIndexOf('.') + 1)..] : fqn;
+			var dtorCir = $"{fqn}.~{className}";
+			var dtor = _definedFns.Contains(dtorCir) ? "@" + MangleToLlvm(dtorCir) : "null";
+			_bodyLines.Add($"  {obj} = call ptr @__cloth_region_alloc(ptr %__region, i64 {sizeI64}, ptr {dtor})");
+		}
+		else {
+			_bodyLines.Add($"  {obj} = call ptr @__cloth_pool_alloc(i64 {sizeI64})");
+			_needsPool = true;
+		}
+
+		EmitCtorCall(a, obj, a.Args.Select(EmitExpr).ToList());
+		return obj;
+	}
 
-		// Constructor invocation. Receiver (`this`) is the first arg; user-supplied args follow.
-		// Argument LLVM types come from the constructor's registered signature when available.
+	// Constructor invocation. Receiver (`this`) is the first arg; user-supplied args follow.
+	// Argument LLVM types come from the constructor's registered signature when available.
+	private void EmitCtorCall(CirExpr.Alloc a, string obj, List<string> argVals) {
 		var ctorLlvm = MangleToLlvm(a.CtorMangledName);
-		var argVals = a.Args.Select(EmitExpr).ToList();
 		var argTypes = ResolveCallArgTypes(a.CtorMangledName, argVals.Count, skipReceiver: true);
 		var argList = string.Join(", ", new[] { $"ptr {obj}" }.Concat(argVals.Select((v, i) => $"{argTypes[i]} {v}")));
 		_bodyLines.Add($"  call void @{ctorLlvm}({argList})");
+	}
 
-		return obj;
+	// sizeof(struct) via the GEP-null trick: pointer to element index 1 of a null pointer is
+	// the byte offset of one struct, i.e. its size. ptrtoint converts to i64.
+	private string EmitSizeOf(string structName) {
+		var sizePtr = FreshTemp();
+		_bodyLines.Add($"  {sizePtr} = getelementptr {structName}, ptr null, i32 1");
+		var sizeI64 = FreshTemp();
+		_bodyLines.Add($"  {sizeI64} = ptrtoint ptr {sizePtr} to i64");
+		return sizeI64;
 	}
 
 	// Look up an LLVM-typed argument list for a callee, optionally skipping the leading `this`.
 	// Falls back to opaque `ptr` when the callee isn't in the module table.
 	private List<string> ResolveCallArgTypes(string mangledName, int count, bool skipReceiver) {
-		var fn = _module.Functions.FirstOrDefault(f => f.MangledName == mangledName);
+		var fn = _module.FindFunction(mangledName);
 		if (fn == null) return Enumerable.Repeat("ptr", count).ToList();
 		var src = skipReceiver ? fn.Parameters.Skip(1) : fn.Parameters;
 		var types = src.Select(p => LlvmType(p.Type)).ToList();
@@ -2178,9 +3919,10 @@ public sealed class LlvmEmitter {
 		CirExpr.Local l when _localTypeMap.TryGetValue(l.Name, out var ty) => LlvmType(ty),
 		CirExpr.ThisPtr => "ptr",
 		CirExpr.Cast cast => LlvmType(cast.TargetType),
-		// Field access: walk the chain, look up the named field's type in the parent class's
-		// declared field list. Falls back to ptr if any link in the chain can't be resolved.
-		CirExpr.FieldAccess fa => ResolveTargetFqn(fa.Target) is { } parentFqn && _classByFqn.TryGetValue(parentFqn, out var parentCls) && parentCls.Fields.FirstOrDefault(f => f.Name == fa.FieldName) is { } fld ? LlvmType(fld.Type) : "ptr",
+		// Field access: walk the chain and look the named field up in the parent's flattened
+		// layout (so an ancestor-declared field resolves) or enum layout, as the GEP does.
+		// Falls back to ptr if any link in the chain can't be resolved.
+		CirExpr.FieldAccess fa => TypeOfLvalue(fa) is (var fieldTy, true) ? LlvmType(fieldTy) : "ptr",
 		// Comparisons produce i1; Pow always widens to i64 (integer ops) or double (any
 		// float op) so the helper / libm result isn't truncated. Other arithmetic
 		// produces the wider operand's LLVM type.
@@ -2206,7 +3948,7 @@ public sealed class LlvmEmitter {
 		CirExpr.Subslice => "{ ptr, i64 }",
 		// Look up the callee's return type from the module's function table; fall back to ptr
 		// for unresolved/unknown calls.
-		CirExpr.Call call => _module.Functions.FirstOrDefault(f => f.MangledName == call.MangledName) is { } fn ? LlvmType(fn.ReturnType) : "ptr",
+		CirExpr.Call call => _module.FindFunction(call.MangledName) is { } fn ? LlvmType(fn.ReturnType) : "ptr",
 		// Vtable references are opaque pointers at runtime; virtual call type is recorded.
 		CirExpr.VtableRef => "ptr",
 		CirExpr.VirtualCall vc => LlvmType(vc.ReturnType),
@@ -2456,7 +4198,7 @@ public sealed class LlvmEmitter {
 	// uses, minus the trailing `load`. Returns the slot pointer so callers (e.g.
 	// `EmitAssign` for `arr[i] = v`) can store through it.
 	private string EmitIndexAddr(CirExpr.Index ix) {
-		_needsBoundsPanic = true;
+		_needsBoundsPanic |= ix.Checked;
 
 		var slice = EmitExpr(ix.Target);
 		var data = FreshTemp();
@@ -2468,24 +4210,11 @@ public sealed class LlvmEmitter {
 		var idxTy = LlvmTypeOf(ix.Idx);
 		var idx64 = CoerceTo(idx, idxTy, "i64");
 
-		var neg = FreshTemp();
-		_bodyLines.Add($"  {neg} = icmp slt i64 {idx64}, 0");
-		var oob = FreshTemp();
-		_bodyLines.Add($"  {oob} = icmp sge i64 {idx64}, {len}");
-		var bad = FreshTemp();
-		_bodyLines.Add($"  {bad} = or i1 {neg}, {oob}");
-		var panicLabel = FreshLabel("bounds_panic");
-		var okLabel = FreshLabel("bounds_ok");
-		_bodyLines.Add($"  br i1 {bad}, label %{panicLabel}, label %{okLabel}");
-		_bodyLines.Add($"{panicLabel}:");
-		_bodyLines.Add($"  call void @__cloth_panic_bounds(i64 {idx64}, i64 {len})");
-		_bodyLines.Add($"  unreachable");
-		_bodyLines.Add($"{okLabel}:");
-		_blockTerminated = false;
+		if (ix.Checked) EmitIndexBoundsCheck(idx64, len);
 
-		var eltTy = LlvmElementTypeOf(ix.Target);
+		var slotTy = LlvmSlotTypeOf(ix.Target);
 		var slot = FreshTemp();
-		_bodyLines.Add($"  {slot} = getelementptr {eltTy}, ptr {data}, i64 {idx64}");
+		_bodyLines.Add($"  {slot} = getelementptr {slotTy}, ptr {data}, i64 {idx64}");
 		return slot;
 	}
 
@@ -2537,6 +4266,8 @@ public sealed class LlvmEmitter {
 		// Enum case singletons: the FQN of the value is the enum's FQN. Used by method
 		// calls on `EnumName.CASE.someGetter()`.
 		CirExpr.EnumCaseRef ec => ec.EnumFqn,
+		// `arr[i].field`: the element's class.
+		CirExpr.Index ix => GetCirArrayResultType(ix.Target)?.Element is CirType.Named en ? en.FullyQualifiedName : null,
 		// Nested field-access chains (e.g. `this.__outer__.outerField`): resolve the inner
 		// FieldAccess to its containing class, then look up the named field via the
 		// flattened layout (so an ancestor-declared field still resolves).
@@ -2551,6 +4282,7 @@ public sealed class LlvmEmitter {
 	private string InternString(string value) {
 		// Already collected during pre-scan.
 		var idx = _stringIndex[value];
+		_usedStrings.Add(idx);
 		var (_, byteCount) = EncodeStringConstant(value);
 		var t = FreshTemp();
 		_bodyLines.Add($"  {t} = getelementptr inbounds [{byteCount} x i8], ptr @.str.{idx}, i32 0, i32 0");
@@ -2675,4 +4407,7 @@ public sealed class LlvmEmitter {
 	private static string StructName(string fqn) => "%struct." + MangleToLlvm(fqn);
 
 	private string FreshTemp() => $"%_t{_tempCounter++}";
-}
\ No newline at end of file
+}
+// One emitted codegen unit: its `build/` path, and, when emitted with `EmitToMemory`, its IR
+// text. A null `Ir` means the text is the file at `Path`.
+public sealed record LlvmUnit(string Path, string? Ir = null);
@@ -5,6 +5,8 @@
 // Use, modification, and distribution of this file are governed by the
 // license terms provided with the Cloth Compiler source distribution.
 
+using FrontEnd.Error;
+
 namespace Compiler.LLVM;
 
 public class LlvmError : Exception {
@@ -28,6 +30,10 @@ public class LlvmError : Exception {
 
 	public static readonly LlvmError UnsupportedExpression = new("L004", "unsupported expression kind in LLVM lowering", true);
 
+	public static readonly LlvmError BackendUnavailable = new("L005", "the in-process backend could not load the LLVM shared library", true);
+
+	public static readonly LlvmError BackendFailed = new("L006", "in-process LLVM compilation failed", true);
+
 	public LlvmError WithMessage(string message) => new(_code, _label, _willExit, message);
 
 	public LlvmError Render() {
@@ -36,7 +42,7 @@ public class LlvmError : Exception {
 		if (_message != null)
 			Console.Error.WriteLine($"  = note: {_message}");
 		if (_willExit)
-			Environment.Exit(1);
+			FatalErrors.Exit(1);
 		return this;
 	}
 }
\ No newline at end of file
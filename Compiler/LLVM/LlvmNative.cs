@@ -0,0 +1,147 @@
+// Copyright (c) 2026.The Cloth contributors.
+//
+// LlvmNative.cs is part of the Cloth Compiler.
+//
+// Use, modification, and distribution of this file are governed by the
+// license terms provided with the Cloth Compiler source distribution.
+
+using System.Reflection;
+using System.Runtime.InteropServices;
+
+namespace Compiler.LLVM;
+
+// Minimal P/Invoke surface over the LLVM C API (`llvm-c/*.h`) used by `InProcessBackend`.
+// Only the IR reader, pass builder, and target machine entry points are bound — the module
+// itself still comes from `LlvmEmitter`'s text, so there is no builder API to keep in sync
+// with the emitter. Requires LLVM 15+ (opaque pointers by default).
+internal static class LlvmNative {
+	private const string LibraryName = "LLVM-C";
+
+	// Unversioned names first (LLVM-C.dll on Windows, libLLVM.so / libLLVM.dylib elsewhere),
+	// then the versioned shared objects distributions install without an unversioned link.
+	private static readonly string[] LibraryCandidates = ["LLVM-C", "LLVM", .. Enumerable.Range(15, 8).Reverse().Select(v => $"LLVM-{v}")];
+
+	// Set to a full path to pick a specific LLVM install over the search above.
+	public const string LibraryPathVariable = "CLOTH_LLVM_LIBRARY";
+
+	static LlvmNative() {
+		NativeLibrary.SetDllImportResolver(typeof(LlvmNative).Assembly, Resolve);
+	}
+
+	private static IntPtr Resolve(string libraryName, Assembly assembly, DllImportSearchPath? searchPath) {
+		if (libraryName != LibraryName) return IntPtr.Zero;
+
+		var explicitPath = Environment.GetEnvironmentVariable(LibraryPathVariable);
+		if (!string.IsNullOrWhiteSpace(explicitPath) && NativeLibrary.TryLoad(explicitPath, out var handle))
+			return handle;
+
+		foreach (var candidate in LibraryCandidates)
+			if (NativeLibrary.TryLoad(candidate, assembly, searchPath, out handle))
+				return handle;
+
+		return IntPtr.Zero;
+	}
+
+	// Enum values from llvm-c/TargetMachine.h.
+	public const int CodeGenFileTypeObject = 1;
+	public const int RelocDefault = 0;
+	public const int CodeModelDefault = 0;
+
+	// Copy an LLVM-owned `char*` message into a managed string and free the original.
+	public static string TakeMessage(IntPtr message) {
+		if (message == IntPtr.Zero) return "";
+		var text = Marshal.PtrToStringUTF8(message) ?? "";
+		LLVMDisposeMessage(message);
+		return text;
+	}
+
+	// Same for an `LLVMErrorRef`; consumes the error.
+	public static string TakeError(IntPtr error) {
+		var message = LLVMGetErrorMessage(error);
+		var text = Marshal.PtrToStringUTF8(message) ?? "";
+		LLVMDisposeErrorMessage(message);
+		return text;
+	}
+
+	[DllImport(LibraryName)]
+	public static extern IntPtr LLVMContextCreate();
+
+	[DllImport(LibraryName)]
+	public static extern void LLVMContextDispose(IntPtr context);
+
+	[DllImport(LibraryName)]
+	public static extern int LLVMCreateMemoryBufferWithContentsOfFile([MarshalAs(UnmanagedType.LPUTF8Str)] string path, out IntPtr buffer, out IntPtr message);
+
+	// Copies `data`; the buffer does not keep a reference to it.
+	[DllImport(LibraryName)]
+	public static extern IntPtr LLVMCreateMemoryBufferWithMemoryRangeCopy(byte[] data, nuint length, [MarshalAs(UnmanagedType.LPUTF8Str)] string name);
+
+	// Takes ownership of `buffer` whether or not parsing succeeds.
+	[DllImport(LibraryName)]
+	public static extern int LLVMParseIRInContext(IntPtr context, IntPtr buffer, out IntPtr module, out IntPtr message);
+
+	[DllImport(LibraryName)]
+	public static extern void LLVMDisposeModule(IntPtr module);
+
+	// Returns the module's `target triple`; owned by the module.
+	[DllImport(LibraryName)]
+	public static extern IntPtr LLVMGetTarget(IntPtr module);
+
+	[DllImport(LibraryName)]
+	public static extern void LLVMDisposeMessage(IntPtr message);
+
+	[DllImport(LibraryName)]
+	public static extern IntPtr LLVMGetErrorMessage(IntPtr error);
+
+	[DllImport(LibraryName)]
+	public static extern void LLVMDisposeErrorMessage(IntPtr message);
+
+	// Per-backend registration. The C API's `LLVMInitializeAllTargets` family are header-
+	// inline, so each backend the compiler can target is bound individually.
+	[DllImport(LibraryName)]
+	public static extern void LLVMInitializeX86TargetInfo();
+
+	[DllImport(LibraryName)]
+	public static extern void LLVMInitializeX86Target();
+
+	[DllImport(LibraryName)]
+	public static extern void LLVMInitializeX86TargetMC();
+
+	[DllImport(LibraryName)]
+	public static extern void LLVMInitializeX86AsmPrinter();
+
+	[DllImport(LibraryName)]
+	public static extern void LLVMInitializeAArch64TargetInfo();
+
+	[DllImport(LibraryName)]
+	public static extern void LLVMInitializeAArch64Target();
+
+	[DllImport(LibraryName)]
+	public static extern void LLVMInitializeAArch64TargetMC();
+
+	[DllImport(LibraryName)]
+	public static extern void LLVMInitializeAArch64AsmPrinter();
+
+	[DllImport(LibraryName)]
+	public static extern int LLVMGetTargetFromTriple([MarshalAs(UnmanagedType.LPUTF8Str)] string triple, out IntPtr target, out IntPtr message);
+
+	[DllImport(LibraryName)]
+	public static extern IntPtr LLVMCreateTargetMachine(IntPtr target, [MarshalAs(UnmanagedType.LPUTF8Str)] string triple, [MarshalAs(UnmanagedType.LPUTF8Str)] string cpu, [MarshalAs(UnmanagedType.LPUTF8Str)] string features, int optLevel, int relocMode, int codeModel);
+
+	[DllImport(LibraryName)]
+	public static extern void LLVMDisposeTargetMachine(IntPtr machine);
+
+	[DllImport(LibraryName)]
+	public static extern int LLVMTargetMachineEmitToFile(IntPtr machine, IntPtr module, [MarshalAs(UnmanagedType.LPUTF8Str)] string fileName, int fileType, out IntPtr message);
+
+	[DllImport(LibraryName)]
+	public static extern IntPtr LLVMCreatePassBuilderOptions();
+
+	[DllImport(LibraryName)]
+	public static extern void LLVMDisposePassBuilderOptions(IntPtr options);
+
+	// New-pass-manager pipeline by textual name (e.g. "default<O2>"); returns an
+	// `LLVMErrorRef`, null on success.
+	[DllImport(LibraryName)]
+	public static extern IntPtr LLVMRunPasses(IntPtr module, [MarshalAs(UnmanagedType.LPUTF8Str)] string passes, IntPtr machine, IntPtr options);
+}
@@ -0,0 +1,71 @@
+// Copyright (c) 2026.The Cloth contributors.
+//
+// PgoCounters.cs is part of the Cloth Compiler.
+//
+// Use, modification, and distribution of this file are governed by the
+// license terms provided with the Cloth Compiler source distribution.
+
+using Compiler.CIR;
+using Compiler.CIR.Passes;
+
+namespace Compiler.Pgo;
+
+// Counter layout of one function for profile-guided optimization, shared by the build that
+// places the counters and the build that reads them back. Counter 0 counts entries; every
+// `if` chain and `switch` then gets one counter per arm, numbered in body order — including
+// the implicit arm of an `if` without `else` or a `switch` without `default`, so each
+// branch's weights come straight from counters instead of being derived by subtraction.
+//
+// `Hash` digests the shape (which statements, with how many arms, in which order). Both
+// builds lower the same post-pass CIR, so an unchanged function gets the same layout; a
+// changed one gets a different hash and its stale counts are dropped.
+public sealed class PgoCounters : CirRewriter {
+	private readonly Dictionary<CirStmt, int> _firstArm = new(ReferenceEqualityComparer.Instance);
+	private ulong _hash = FnvOffset;
+
+	private const ulong FnvOffset = 14695981039346656037;
+	private const ulong FnvPrime = 1099511628211;
+
+	public int Count { get; private set; } = 1;
+
+	public ulong Hash => _hash;
+
+	private PgoCounters() { }
+
+	public static PgoCounters For(CirFunction fn) {
+		var counters = new PgoCounters();
+		counters.RewriteBlock(fn.Body);
+		return counters;
+	}
+
+	// Index of the first arm counter of `stmt` (an `If` or `Switch` of the function's body),
+	// or null for a statement the layout doesn't cover.
+	public int? FirstArm(CirStmt stmt) => _firstArm.TryGetValue(stmt, out var arm) ? arm : null;
+
+	public static int ArmCount(CirStmt.If i) => i.ElseIfs.Count + 2;
+
+	public static int ArmCount(CirStmt.Switch sw) => sw.Cases.Count + (sw.Cases.Any(c => c.Pattern == null) ? 0 : 1);
+
+	public override CirStmt Rewrite(CirStmt stmt) {
+		switch (stmt) {
+			case CirStmt.If i:
+				Add(i, 'i', ArmCount(i));
+				break;
+			case CirStmt.Switch sw:
+				Add(sw, 's', ArmCount(sw));
+				break;
+		}
+
+		return RewriteChildren(stmt);
+	}
+
+	// A statement reached twice (the same node inlined into two places) shares its counters.
+	private void Add(CirStmt stmt, char kind, int arms) {
+		if (!_firstArm.TryAdd(stmt, Count)) return;
+		Count += arms;
+		Mix(kind);
+		Mix((ulong)arms);
+	}
+
+	private void Mix(ulong value) => _hash = (_hash ^ value) * FnvPrime;
+}
@@ -0,0 +1,50 @@
+// Copyright (c) 2026.The Cloth contributors.
+//
+// PgoError.cs is part of the Cloth Compiler.
+//
+// Use, modification, and distribution of this file are governed by the
+// license terms provided with the Cloth Compiler source distribution.
+
+using FrontEnd.Error;
+
+namespace Compiler.Pgo;
+
+public class PgoError : Exception, IError {
+	private readonly string _code;
+	private readonly string _label;
+	private readonly bool _willExit;
+	private readonly string? _message;
+	private readonly string? _file;
+	private readonly int _line;
+
+	private PgoError(string code, string label, bool willExit, string? message = null, string? file = null, int line = 0) : base(message ?? label) {
+		_code = code;
+		_label = label;
+		_willExit = willExit;
+		_message = message;
+		_file = file;
+		_line = line;
+	}
+
+	public static readonly PgoError MalformedProfile = new("G001", "malformed profile data", true);
+
+	public PgoError WithMessage(string message) => new(_code, _label, _willExit, message, _file, _line);
+
+	// `line` is 1-based; 0 leaves it out.
+	public PgoError WithLocation(string file, int line) => new(_code, _label, _willExit, _message, file, line);
+
+	public string ErrorCode() => _code;
+	public string GetErrorMessage() => _message ?? _label;
+	public bool WillExit() => _willExit;
+
+	public void Render() {
+		var output = FatalErrors.Output;
+		output.WriteLine($"Error[{_code}]: {_label}");
+		if (_file != null)
+			output.WriteLine(_line > 0 ? $"  --> {_file}:{_line}" : $"  --> {_file}");
+		if (_message != null)
+			output.WriteLine($"  = note: {_message}");
+		if (_willExit)
+			FatalErrors.Exit(1);
+	}
+}
@@ -0,0 +1,101 @@
+// Copyright (c) 2026.The Cloth contributors.
+//
+// PgoProfile.cs is part of the Cloth Compiler.
+//
+// Use, modification, and distribution of this file are governed by the
+// license terms provided with the Cloth Compiler source distribution.
+
+namespace Compiler.Pgo;
+
+// Counts recorded by a `--pgo=instrument` binary, keyed by CIR mangled function name. The
+// instrumented binary writes raw profiles to `build/pgo/<Name>-<pid>.profraw`; a
+// `--pgo=use` build merges them with `llvm-profdata merge -text` into
+// `build/pgo/<Name>.proftext` and reads that. Every record carries the `PgoCounters.Hash`
+// of the layout it was counted against, so counts from a function whose shape has changed
+// since are never applied to the new one.
+public sealed class PgoProfile {
+	private readonly Dictionary<string, List<(ulong Hash, long[] Counts)>> _functions;
+
+	private PgoProfile(Dictionary<string, List<(ulong Hash, long[] Counts)>> functions) {
+		_functions = functions;
+	}
+
+	// Absolute, since the instrumented binary resolves it against its own working directory.
+	public static string ProfileDirectory(string projectRoot) => Path.GetFullPath(Path.Combine(projectRoot, "build", "pgo"));
+
+	// Where a project's instrumented runs write (`-fprofile-instr-generate=` / `LLVM_PROFILE_FILE`);
+	// `%p` keeps concurrent runs apart.
+	public static string RawProfilePattern(string projectRoot, string projectName) =>
+		Path.Combine(ProfileDirectory(projectRoot), $"{projectName}-%p.profraw");
+
+	public static string TextProfilePath(string projectRoot, string projectName) =>
+		Path.Combine(ProfileDirectory(projectRoot), $"{projectName}.proftext");
+
+	// The counters of `fn` recorded against layout `hash`, or null when the profile never
+	// saw it (not run, or run before its shape changed).
+	public long[]? Counts(string fn, ulong hash) =>
+		_functions.GetValueOrDefault(fn)?.FirstOrDefault(r => r.Hash == hash).Counts;
+
+	// How often `fn` was entered. Counter 0 counts entries in every layout, so this holds
+	// across shape changes.
+	public long EntryCount(string fn) =>
+		_functions.GetValueOrDefault(fn)?.Sum(r => r.Counts.Length > 0 ? r.Counts[0] : 0) ?? 0;
+
+	// The `llvm-profdata` text format: one record per function, separated by blank lines —
+	// the name, then `# Func Hash:`, `# Num Counters:` and `# Counter Values:` headings each
+	// followed by their values. Any other heading (value profiles, bitmaps) and `:`-prefixed
+	// profile flags are skipped. A value that isn't an unsigned integer, or a record whose
+	// counter values don't match its `# Num Counters:`, is a `G001` against `path`; counts
+	// past `long.MaxValue` saturate.
+	public static PgoProfile Parse(string text, string path) {
+		var functions = new Dictionary<string, List<(ulong Hash, long[] Counts)>>(StringComparer.Ordinal);
+		var lines = text.Split('\n').Select(l => l.TrimEnd('\r')).ToArray();
+		var i = 0;
+
+		void Malformed(int line, string message) =>
+			PgoError.MalformedProfile.WithMessage($"{message}; delete the profile and record it again with --pgo=instrument").WithLocation(path, line + 1).Render();
+
+		// The unsigned value on the line after heading `heading`, at `i`.
+		ulong Value(string heading) {
+			if (i < lines.Length && ulong.TryParse(lines[i], out var value)) return value;
+			Malformed(Math.Min(i, lines.Length - 1), $"expected an unsigned integer after '{heading}'");
+			return 0;
+		}
+
+		while (i < lines.Length) {
+			var line = lines[i++];
+			if (line.Length == 0 || line.StartsWith('#') || line.StartsWith(':')) continue;
+
+			var name = line;
+			var start = i - 1;
+			ulong hash = 0;
+			ulong? declared = null;
+			var counts = new List<long>();
+			while (i < lines.Length && lines[i].Length > 0) {
+				var heading = lines[i++];
+				if (heading == "# Func Hash:") {
+					hash = Value(heading);
+					i++;
+				}
+				else if (heading == "# Num Counters:") {
+					declared = Value(heading);
+					i++;
+				}
+				else if (heading == "# Counter Values:") {
+					while (i < lines.Length && lines[i].Length > 0 && !lines[i].StartsWith('#')) {
+						counts.Add((long)Math.Min(Value(heading), long.MaxValue));
+						i++;
+					}
+				}
+			}
+
+			if (declared != null && declared != (ulong)counts.Count)
+				Malformed(start, $"'{name}' declares {declared} counters but lists {counts.Count}");
+
+			if (!functions.TryGetValue(name, out var records)) functions[name] = records = new List<(ulong, long[])>();
+			records.Add((hash, counts.ToArray()));
+		}
+
+		return new PgoProfile(functions);
+	}
+}
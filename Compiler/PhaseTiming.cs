@@ -0,0 +1,50 @@
+// Copyright (c) 2026.The Cloth contributors.
+//
+// PhaseTiming.cs is part of the Cloth Compiler.
+//
+// Use, modification, and distribution of this file are governed by the
+// license terms provided with the Cloth Compiler source distribution.
+
+using System.Diagnostics;
+
+namespace Compiler;
+
+/// <summary>
+/// One measured phase of a build (<c>cloth build --time-phases</c>): its wall-clock time, the bytes the
+/// process allocated meanwhile (on every thread, since most phases fan out), and the garbage collections
+/// of each generation it triggered. <see cref="Project"/> tells a dependency's phases from the consumer's.
+/// </summary>
+public sealed record PhaseTiming(string Project, string Phase, double ElapsedMs, long AllocatedBytes, int Gen0Collections, int Gen1Collections, int Gen2Collections);
+
+// Collects the `PhaseTiming`s of one `Compiler.Compile`. A phase is listed where it started,
+// so one that nests others (`dependencies`, around each dependency's own build) comes right
+// before them — and its numbers include theirs. `SymbolRegistry.Build` takes one to break
+// its passes out as sub-phases, and the compiler-throughput benchmarks drive both directly.
+public sealed class PhaseRecorder(string project) {
+	private readonly List<PhaseTiming> _timings = new();
+
+	public IReadOnlyList<PhaseTiming> Timings => _timings;
+
+	public T Measure<T>(string phase, Func<T> body) {
+		var index = _timings.Count;
+		var allocated = GC.GetTotalAllocatedBytes();
+		var gen0 = GC.CollectionCount(0);
+		var gen1 = GC.CollectionCount(1);
+		var gen2 = GC.CollectionCount(2);
+		var stopwatch = Stopwatch.StartNew();
+
+		var result = body();
+
+		_timings.Insert(index, new PhaseTiming(project, phase, stopwatch.Elapsed.TotalMilliseconds, GC.GetTotalAllocatedBytes() - allocated,
+			GC.CollectionCount(0) - gen0, GC.CollectionCount(1) - gen1, GC.CollectionCount(2) - gen2));
+		return result;
+	}
+
+	public void Measure(string phase, Action body) => Measure(phase, () => {
+		body();
+		return 0;
+	});
+
+	// Fold in the phases of a build this one triggered.
+	public void Include(IEnumerable<PhaseTiming> timings) => _timings.AddRange(timings);
+}
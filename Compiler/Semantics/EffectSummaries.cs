@@ -0,0 +1,658 @@
+// Copyright (c) 2026.The Cloth contributors.
+//
+// EffectSummaries.cs is part of the Cloth Compiler.
+//
+// Use, modification, and distribution of this file are governed by the
+// license terms provided with the Cloth Compiler source distribution.
+
+using FrontEnd.Parser.AST;
+using FrontEnd.Parser.AST.Declarations;
+using FrontEnd.Parser.AST.Expressions;
+using FrontEnd.Parser.AST.Statements;
+using FrontEnd.Parser.AST.Type;
+
+namespace Compiler.Semantics;
+
+// What each function may write, for the `parallel for` / `join` race check (S035), which has
+// to know what a call does to its operands without walking the callee. A summary is a
+// `WriteEffect` in the callee's own terms, kept in `SymbolRegistry.Effects` under the
+// function's mangled symbol — constructors under theirs, a class with no declared
+// constructor under `ImplicitConstructorKey`, destructors under `DestructorKey`. Libraries
+// publish theirs in their metadata.
+//
+// A body writes an object when it assigns or increments through it, deletes it, or hands it
+// to a callee whose summary writes it; each write is traced back, flow-insensitively, to the
+// body's receiver, its parameters, or the statics. Conservative throughout:
+// - a write reaches everything reachable from the written object, and once the body has
+//   stored an object into another one (or let a callee do so), any write may reach it too;
+// - a call result may reach the call's operands and the statics, unless it is bound to a
+//   local straight from an owning initializer (`new`, a call returning a class);
+// - `@Extern` code writes every reference it is passed, but no statics;
+// - a call that dispatches at run time (a `prototype` method, an interface method) or that
+//   doesn't resolve writes everything its operands reach and the statics, since an override
+//   compiled later may;
+// - a `Type&` / `Type!` parameter counts as written whatever the body does.
+//
+// Summaries are the least fixpoint over the call graph, so recursion settles.
+public static class EffectSummaries {
+	// Summarize the functions of `units` into `symbols.Effects`, next to the summaries
+	// dependencies loaded from metadata brought along.
+	public static void Compute(SymbolRegistry symbols, IReadOnlyList<CompilationUnit> units) {
+		foreach (var overloads in symbols.Overloads.Values)
+			foreach (var o in overloads)
+				if (o.IsExtern && !symbols.Effects.ContainsKey(o.MangledSymbol))
+					symbols.Effects[o.MangledSymbol] = ExternEffect(symbols, o);
+
+		// The built-in enum members (getters, `name`, `values`, `valueOf`) have no source body
+		// and only read.
+		foreach (var (methodFqn, overloads) in symbols.Overloads) {
+			var lastDot = methodFqn.LastIndexOf('.');
+			if (lastDot < 0 || !symbols.KnownEnums.Contains(methodFqn[..lastDot])) continue;
+			foreach (var o in overloads)
+				symbols.Effects.TryAdd(o.MangledSymbol, WriteEffect.None);
+		}
+
+		var perUnit = new List<FunctionSummary>[units.Count];
+		Parallel.For(0, units.Count, i => perUnit[i] = new UnitWalker(symbols, units[i]).Walk());
+		var functions = perUnit.SelectMany(list => list).ToList();
+		foreach (var fn in functions)
+			symbols.Effects[fn.Symbol] = fn.Direct;
+
+		bool changed;
+		do {
+			changed = false;
+			foreach (var fn in functions) {
+				var effect = symbols.Effects[fn.Symbol];
+				foreach (var site in fn.Sites)
+					effect = effect.Union(site.Apply(EffectOf(symbols, site.Callee)));
+				if (effect == symbols.Effects[fn.Symbol]) continue;
+				symbols.Effects[fn.Symbol] = effect;
+				changed = true;
+			}
+		} while (changed);
+	}
+
+	// What running `callee` writes, in terms of the call's operands: `Receiver` for the
+	// receiver — for `new`, the outer instance of an inner class — then the arguments.
+	public static WriteEffect EffectOf(SymbolRegistry symbols, Callee callee) {
+		var effect = callee.Symbol != null && symbols.Effects.TryGetValue(callee.Symbol, out var known) ? known : WriteEffect.All;
+		effect = effect.Union(new WriteEffect(false, callee.Declared, false));
+		if (callee.Fresh) effect = effect with { Receiver = false };
+		if (callee.Hidden) effect = new WriteEffect(effect.Receiver || effect.WritesParam(0), (effect.Params >> 1) | (effect.Params & WriteEffect.Bit(63)), effect.Statics);
+		return effect;
+	}
+
+	// The function `call` runs, resolved the way `ExpressionTyper` resolves it for codegen.
+	public static Callee ResolveCall(SymbolRegistry symbols, ExpressionTyper typer, Expression.Call call, string currentTypeFqn) {
+		var overload = typer.ResolveCallExpressionOverload(call);
+		if (overload == null) return Callee.Unknown;
+		if (!overload.IsStatic) {
+			var (receiverType, name) = call.Callee switch {
+				Expression.MemberAccess ma => (typer.InferType(ma.Target), ma.Member),
+				Expression.Identifier id => (currentTypeFqn, id.Name),
+				_ => (null, null)
+			};
+			if (name == null || IsVirtual(symbols, receiverType ?? overload.OwnerClass, name, call.Arguments.Count)) return Callee.Unknown;
+		}
+
+		return new Callee(overload.MangledSymbol, DeclaredWrites(overload.ParamOwnership));
+	}
+
+	// The constructor `new` runs, matched the way `SemanticAnalyzer.ValidateNewExpression`
+	// matches it.
+	public static Callee ResolveNew(SymbolRegistry symbols, ExpressionTyper typer, Expression.New n) {
+		if (typer.InferType(n) is not { } classFqn || !symbols.Classes.TryGetValue(classFqn, out var info)) return Callee.Unknown with { Fresh = true };
+		return ResolveConstructor(symbols, typer, classFqn, n.Arguments, info.IsInner) with { Fresh = true };
+	}
+
+	// The constructor `super(...)` (or `this(...)`) in a constructor of `classFqn` chains to.
+	public static Callee ResolveChainedConstructor(SymbolRegistry symbols, ExpressionTyper typer, string classFqn, List<Expression> args, bool super) {
+		var target = super ? symbols.ClassVtables.GetValueOrDefault(classFqn)?.ParentClassFqn : classFqn;
+		if (target == null || !symbols.Classes.TryGetValue(target, out var info)) return Callee.Unknown;
+		return ResolveConstructor(symbols, typer, target, args, info.IsInner);
+	}
+
+	// The destructor `delete target` runs, or null when none does (a value, an array of
+	// values). Deleting an array runs its elements' destructor.
+	public static Callee? ResolveDelete(SymbolRegistry symbols, ExpressionTyper typer, Expression target) {
+		if (typer.InferType(target) is not { } type) return Callee.Unknown;
+		type = TypeInference.StripNullable(type);
+		while (type.EndsWith("[]")) type = TypeInference.StripNullable(type[..^2]);
+		if (IsValueType(symbols, type)) return null;
+		return symbols.KnownClasses.Contains(type) ? new Callee(DestructorKey(type), 0) : Callee.Unknown;
+	}
+
+	public static string DestructorKey(string classFqn) => $"{classFqn}.~{SimpleName(classFqn)}";
+
+	public static string ImplicitConstructorKey(string classFqn) => $"{classFqn}.{SimpleName(classFqn)}";
+
+	// Strings, primitives and enum values can't be written through: a write to one rebinds
+	// whatever holds it.
+	public static bool IsValueType(SymbolRegistry symbols, string canonical) {
+		var type = TypeInference.StripNullable(canonical);
+		return type == "null" || (TypeInference.IsKnownPrimitive(type) && type is not ("any" or "void")) || symbols.KnownEnums.Contains(type);
+	}
+
+	// An inner class's constructors take its outer instance as parameter 0, which the
+	// caller passes as the receiver.
+	private static Callee ResolveConstructor(SymbolRegistry symbols, ExpressionTyper typer, string classFqn, List<Expression> args, bool isInner) {
+		if (!symbols.Constructors.TryGetValue(classFqn, out var ctors) || ctors.Count == 0)
+			return new Callee(ImplicitConstructorKey(classFqn), 0, Hidden: isInner);
+		var hidden = isInner ? 1 : 0;
+		var argTypes = args.Select(typer.InferType).ToList();
+		var matching = ctors.FirstOrDefault(c => c.ParamTypes.Count == args.Count + hidden && c.ParamTypes.Skip(hidden).Zip(argTypes).All(p => p.Second == null || p.Second == p.First || TypeInference.IsLosslessPromotion(p.Second!, p.First)));
+		return matching == null ? Callee.Unknown : new Callee(matching.MangledSymbol, DeclaredWrites(matching.ParamOwnership), Hidden: isInner);
+	}
+
+	// True when a call to `name` / `arity` on a receiver of static type `receiverType`
+	// dispatches through the vtable: some class up its chain declares the method `prototype`
+	// (see `CirGenerator.TryEmitVirtualPrototypeCall`).
+	private static bool IsVirtual(SymbolRegistry symbols, string receiverType, string name, int arity) {
+		var cursor = receiverType;
+		while (!string.IsNullOrEmpty(cursor) && !symbols.CycleBrokenClasses.Contains(cursor)) {
+			if (symbols.DeclaredOverloads(cursor, name) is { } overloads && overloads.Any(o => o.IsPrototype && o.ParamTypes.Count == arity)) return true;
+			cursor = symbols.ClassVtables.GetValueOrDefault(cursor)?.ParentClassFqn;
+		}
+
+		return false;
+	}
+
+	private static ulong DeclaredWrites(List<OwnershipModifier?> ownership) {
+		var bits = 0UL;
+		for (var i = 0; i < ownership.Count; i++)
+			if (ownership[i] is OwnershipModifier.MutBorrow or OwnershipModifier.Transfer)
+				bits |= WriteEffect.Bit(i);
+		return bits;
+	}
+
+	private static WriteEffect ExternEffect(SymbolRegistry symbols, MethodOverload o) {
+		var bits = 0UL;
+		for (var i = 0; i < o.ParamTypes.Count; i++)
+			if (!IsValueType(symbols, o.ParamTypes[i]))
+				bits |= WriteEffect.Bit(i);
+		return new WriteEffect(!o.IsStatic, bits, false);
+	}
+
+	private static string SimpleName(string fqn) => fqn[(fqn.LastIndexOf('.') + 1)..];
+
+	private sealed record FunctionSummary(string Symbol, WriteEffect Direct, List<CallSite> Sites);
+
+	// A call inside a summarized body: the callee, and where its receiver and arguments may
+	// come from in the caller's terms. `Stored` is what the caller stores into other objects.
+	private sealed record CallSite(Callee Callee, WriteEffect Receiver, List<WriteEffect> Args, WriteEffect Stored) {
+		public WriteEffect Apply(WriteEffect callee) {
+			var effect = callee.Statics ? WriteEffect.StaticsOnly : WriteEffect.None;
+			if (callee.Receiver) effect = effect.Union(Receiver);
+			for (var i = 0; i < Args.Count; i++)
+				if (callee.WritesParam(i))
+					effect = effect.Union(Args[i]);
+			return effect.IsNone ? effect : effect.Union(Stored);
+		}
+	}
+
+	// Walks the function bodies of one unit. Per body, passes repeat until the origins of
+	// every local (`_locals`, a `WriteEffect` read as the set of places its object may come
+	// from) and what the body stores into other objects (`_stored`) stop growing; a final
+	// pass records the body's direct writes and its call sites.
+	private sealed class UnitWalker {
+		private readonly SymbolRegistry _symbols;
+		private readonly CompilationUnit _unit;
+		private readonly Dictionary<string, string> _importMap;
+		private readonly string _moduleFqn;
+		private readonly List<FunctionSummary> _functions = new();
+
+		private string _typeFqn = "";
+		private ExpressionTyper _typer = null!;
+		private readonly Dictionary<string, WriteEffect> _locals = new();
+		private WriteEffect _stored;
+		private bool _changed;
+		private bool _recording;
+		private WriteEffect _direct;
+		private List<CallSite> _sites = new();
+
+		public UnitWalker(SymbolRegistry symbols, CompilationUnit unit) {
+			_symbols = symbols;
+			_unit = unit;
+			_importMap = SymbolRegistry.ImportMapOf(unit);
+			_moduleFqn = SymbolRegistry.ModuleFqnOf(unit);
+		}
+
+		public List<FunctionSummary> Walk() {
+			foreach (var typeDecl in _unit.Types) {
+				switch (typeDecl) {
+					case TypeDeclaration.Class { Declaration: var c }:
+						WalkClass(c, TypeFqn(_moduleFqn, c.Name));
+						break;
+					case TypeDeclaration.Enum { Declaration: var e }:
+						_typeFqn = TypeFqn(_moduleFqn, e.Name);
+						foreach (var member in e.Members)
+							if (member is MemberDeclaration.Method { Declaration: { Body: { } body } m })
+								Summarize(MethodSymbol(m), m.Parameters, 0, 0, body, [], m.Modifiers.Contains(FunctionModifiers.Static));
+						break;
+				}
+			}
+
+			return _functions;
+		}
+
+		// Constructors pair with `Constructors[typeFqn]` in declaration order, which is the
+		// order the registry added them in. Field initializers run in every constructor.
+		private void WalkClass(ClassDeclaration c, string typeFqn) {
+			_typeFqn = typeFqn;
+			var hidden = _symbols.Classes.TryGetValue(typeFqn, out var info) && info.IsInner ? 1 : 0;
+			var initializers = c.Members
+				.Select(m => m is MemberDeclaration.Field { Declaration: { IsStatic: false, Initializer: { } init } } ? init : null)
+				.OfType<Expression>()
+				.ToList();
+			var ctors = _symbols.Constructors.GetValueOrDefault(typeFqn) ?? [];
+
+			var ctorIndex = 0;
+			foreach (var member in c.Members) {
+				switch (member) {
+					case MemberDeclaration.Method { Declaration: { Body: { } body } m }:
+						Summarize(MethodSymbol(m), m.Parameters, 0, 0, body, [], m.Modifiers.Contains(FunctionModifiers.Static));
+						break;
+					case MemberDeclaration.Constructor { Declaration: var ctor }:
+						if (ctorIndex < ctors.Count)
+							Summarize(ctors[ctorIndex].MangledSymbol, c.PrimaryParameters.Concat(ctor.Parameters).ToList(), hidden, c.PrimaryParameters.Count, ctor.Body, initializers);
+						ctorIndex++;
+						break;
+					case MemberDeclaration.Destructor { Declaration: var dtor }:
+						Summarize(DestructorKey(typeFqn), [], 0, 0, dtor.Body, []);
+						break;
+					case MemberDeclaration.NestedType { Declaration: TypeDeclaration.Class { Declaration: var nested } }:
+						WalkClass(nested, $"{typeFqn}.{nested.Name}");
+						_typeFqn = typeFqn;
+						break;
+				}
+			}
+
+			var empty = new Block([], c.Span);
+			if (ctors.Count == 0)
+				Summarize(ImplicitConstructorKey(typeFqn), c.PrimaryParameters, hidden, c.PrimaryParameters.Count, empty, initializers);
+			if (!c.Members.Any(m => m is MemberDeclaration.Destructor))
+				Summarize(DestructorKey(typeFqn), [], 0, 0, empty, []);
+		}
+
+		// The mangled symbol the registry gave `m`, rebuilt the way it built it.
+		private string MethodSymbol(MethodDeclaration m) {
+			var paramTypes = m.Parameters.Select(p => Canonicalize(p.Type)).ToList();
+			return SymbolRegistry.MangleMethod(_typeFqn, m.Name, paramTypes);
+		}
+
+		// `hidden` leading parameters (an inner class's outer instance) precede `parameters`
+		// in the function's signature. A constructor stores its first `stored` parameters —
+		// the class's primary parameters — into fields of the new object before the body runs.
+		private void Summarize(string symbol, IReadOnlyList<Parameter> parameters, int hidden, int stored, Block body, List<Expression> initializers, bool isStatic = false) {
+			_locals.Clear();
+			_stored = WriteEffect.None;
+			for (var i = 0; i < stored; i++) _stored = _stored.Union(ParamOrigin(i + hidden));
+
+			_recording = false;
+			do {
+				_changed = false;
+				WalkBody(parameters, hidden, body, initializers);
+			} while (_changed);
+
+			_recording = true;
+			_direct = WriteEffect.None;
+			_sites = new List<CallSite>();
+			WalkBody(parameters, hidden, body, initializers);
+			_recording = false;
+			if (symbol == DestructorKey(_typeFqn)) AddDestructorChain();
+
+			var direct = isStatic ? _direct with { Receiver = false } : _direct;
+			// A constructor's own object is new, so its caller drops `Receiver`; whatever of the
+			// outer instance it writes must show as parameter 0 instead.
+			if (hidden > 0 && direct.Receiver) direct = direct.Union(ParamOrigin(0));
+			_functions.Add(new FunctionSummary(symbol, direct, _sites));
+		}
+
+		private void WalkBody(IReadOnlyList<Parameter> parameters, int hidden, Block body, List<Expression> initializers) {
+			_typer = new ExpressionTyper(_symbols, _importMap, _typeFqn, _moduleFqn);
+			for (var i = 0; i < parameters.Count; i++) {
+				var p = parameters[i];
+				if (p.Type.Base is BaseType.Named or BaseType.Array) _typer.DeclareLocal(p.Name, Canonicalize(p.Type));
+				Bind(p.Name, ParamOrigin(i + hidden));
+			}
+
+			foreach (var init in initializers) WalkExpr(init);
+			WalkBlock(body);
+		}
+
+		// Deleting an object runs its parent's destructor and deletes the objects its fields
+		// hold, all of which the receiver reaches.
+		private void AddDestructorChain() {
+			if (_symbols.ClassVtables.GetValueOrDefault(_typeFqn)?.ParentClassFqn is { } parent)
+				_sites.Add(new CallSite(new Callee(DestructorKey(parent), 0), WriteEffect.ReceiverOnly, [], _stored));
+			foreach (var field in _symbols.Fields.GetValueOrDefault(_typeFqn) ?? []) {
+				if (field.IsStatic || field.Name == SymbolRegistry.InnerOuterFieldName) continue;
+				var type = TypeInference.StripNullable(field.CanonicalType);
+				while (type.EndsWith("[]")) type = TypeInference.StripNullable(type[..^2]);
+				if (_symbols.KnownClasses.Contains(type))
+					_sites.Add(new CallSite(new Callee(DestructorKey(type), 0), WriteEffect.ReceiverOnly, [], _stored));
+			}
+		}
+
+		private static WriteEffect ParamOrigin(int index) => new(false, WriteEffect.Bit(index), false);
+
+		private static string TypeFqn(string moduleFqn, string name) => string.IsNullOrEmpty(moduleFqn) ? name : $"{moduleFqn}.{name}";
+
+		private void Bind(string name, WriteEffect origins) {
+			var merged = _locals.TryGetValue(name, out var existing) ? existing.Union(origins) : origins;
+			if (_locals.ContainsKey(name) && existing == merged) return;
+			_locals[name] = merged;
+			_changed = true;
+		}
+
+		private void Store(WriteEffect origins) {
+			var merged = _stored.Union(origins);
+			if (merged == _stored) return;
+			_stored = merged;
+			_changed = true;
+		}
+
+		private string Canonicalize(TypeExpression t) =>
+			TypeInference.CanonicalizeTypeExpression(t, raw => _symbols.ResolveTypeName(raw, _importMap, _moduleFqn, _typeFqn));
+
+		private void WalkBlock(Block block) {
+			foreach (var stmt in block.Statements) WalkStmt(stmt);
+		}
+
+		private void WalkStmt(Stmt stmt) {
+			switch (stmt) {
+				case Stmt.VarDecl { Declaration: var d }:
+					if (d.Init != null) WalkExpr(d.Init);
+					if (d.Type is { } declared) _typer.DeclareLocal(d.Name, Canonicalize(declared));
+					else if (d.Init != null && _typer.InferType(d.Init) is { } inferred) _typer.DeclareLocal(d.Name, inferred);
+					Bind(d.Name, d.Init == null ? WriteEffect.None : LocalOrigins(d.Init));
+					break;
+				case Stmt.TupleDestructure { Declaration: var d }:
+					WalkExpr(d.Init);
+					foreach (var b in d.Bindings) {
+						_typer.DeclareLocal(b.Name, Canonicalize(b.Type));
+						Bind(b.Name, Origins(d.Init));
+					}
+
+					break;
+				case Stmt.Assign { Assignment: var a }:
+					WalkAssign(a.Target, a.Value);
+					break;
+				case Stmt.ExprStmt { Expression: var e }: WalkExpr(e); break;
+				case Stmt.Discard { Expression: var e }: WalkExpr(e); break;
+				case Stmt.Throw { Expression: var e }: WalkExpr(e); break;
+				case Stmt.Return { Value: { } e }: WalkExpr(e); break;
+				case Stmt.Delete { Expression: var e }:
+					WalkExpr(e);
+					if (ResolveDelete(_symbols, _typer, e) is { } dtor) {
+						Write(Origins(e));
+						AddSite(dtor, Origins(e), []);
+					}
+
+					break;
+				case Stmt.If { Statement: var s }:
+					WalkExpr(s.Condition);
+					WalkBlock(s.ThenBranch);
+					foreach (var elseIf in s.ElseIfBranches) {
+						WalkExpr(elseIf.Condition);
+						WalkBlock(elseIf.Body);
+					}
+
+					if (s.ElseBranch is { } elseBranch) WalkBlock(elseBranch);
+					break;
+				case Stmt.While { Statement: var s }:
+					WalkExpr(s.Condition);
+					WalkBlock(s.Body);
+					break;
+				case Stmt.DoWhile { Statement: var s }:
+					WalkBlock(s.Body);
+					WalkExpr(s.Condition);
+					break;
+				case Stmt.For { Statement: var s }:
+					WalkStmt(s.Init);
+					WalkExpr(s.Condition);
+					WalkExpr(s.Iterator);
+					WalkBlock(s.Body);
+					break;
+				case Stmt.ForIn { Statement: var s }:
+					WalkExpr(s.Iterable);
+					_typer.DeclareLocal(s.Name, Canonicalize(s.Type));
+					Bind(s.Name, Origins(s.Iterable));
+					WalkBlock(s.Body);
+					break;
+				case Stmt.Switch { Statement: var s }:
+					WalkExpr(s.Expression);
+					foreach (var c in s.Cases)
+						foreach (var body in c.Body)
+							WalkStmt(body);
+					break;
+				case Stmt.Join { Tasks: var tasks }:
+					foreach (var task in tasks) WalkExpr(task);
+					break;
+				case Stmt.BlockStmt { Block: var b }: WalkBlock(b); break;
+				case Stmt.SuperCall { Arguments: var args }:
+					foreach (var arg in args) WalkExpr(arg);
+					AddSite(ResolveChainedConstructor(_symbols, _typer, _typeFqn, args, super: true), WriteEffect.ReceiverOnly, args);
+					break;
+				case Stmt.ThisCall { Arguments: var args }:
+					foreach (var arg in args) WalkExpr(arg);
+					AddSite(ResolveChainedConstructor(_symbols, _typer, _typeFqn, args, super: false), WriteEffect.ReceiverOnly, args);
+					break;
+			}
+		}
+
+		private void WalkExpr(Expression? expr) {
+			switch (expr) {
+				case null: return;
+				case Expression.Assign a:
+					WalkAssign(a.Target, a.Value);
+					break;
+				case Expression.Unary { Operator: UnOp.PreInc or UnOp.PreDec } u:
+					WalkExpr(u.Operand);
+					if (!IsLocal(u.Operand)) Write(WriteTarget(u.Operand));
+					break;
+				case Expression.Postfix p:
+					WalkExpr(p.Operand);
+					if (!IsLocal(p.Operand)) Write(WriteTarget(p.Operand));
+					break;
+				case Expression.Call call:
+					WalkExpr(call.Callee is Expression.MemberAccess callee ? callee.Target : null);
+					foreach (var arg in call.Arguments) WalkExpr(arg);
+					var receiver = call.Callee switch {
+						Expression.MemberAccess ma => Origins(ma.Target),
+						Expression.Identifier => WriteEffect.ReceiverOnly,
+						_ => WriteEffect.All
+					};
+					if (_typer.ResolveCallExpressionOverload(call) is { IsStatic: true }) receiver = WriteEffect.None;
+					AddSite(ResolveCall(_symbols, _typer, call, _typeFqn), receiver, call.Arguments);
+					break;
+				case Expression.New n:
+					WalkExpr(n.Receiver);
+					foreach (var arg in n.Arguments) WalkExpr(arg);
+					AddSite(ResolveNew(_symbols, _typer, n), n.Receiver != null ? Origins(n.Receiver) : WriteEffect.ReceiverOnly, n.Arguments);
+					break;
+				case Expression.Lambda l:
+					foreach (var p in l.Parameters) {
+						if (p.Type.Base is BaseType.Named or BaseType.Array) _typer.DeclareLocal(p.Name, Canonicalize(p.Type));
+						Bind(p.Name, WriteEffect.All);
+					}
+
+					if (l.Body is LambdaBody.ExpressionBody { Expression: var body }) WalkExpr(body);
+					break;
+				case Expression.Unary u: WalkExpr(u.Operand); break;
+				case Expression.Binary b:
+					WalkExpr(b.Left);
+					WalkExpr(b.Right);
+					break;
+				case Expression.MemberAccess ma: WalkExpr(ma.Target); break;
+				case Expression.MetaAccess ma: WalkExpr(ma.Target); break;
+				case Expression.Index ix:
+					WalkExpr(ix.Target);
+					WalkExpr(ix.IndexExpr);
+					break;
+				case Expression.Cast c: WalkExpr(c.Value); break;
+				case Expression.TypeCheck tc: WalkExpr(tc.Value); break;
+				case Expression.MembershipCheck mc:
+					WalkExpr(mc.Value);
+					WalkExpr(mc.Collection);
+					break;
+				case Expression.Ternary t:
+					WalkExpr(t.Condition);
+					WalkExpr(t.ThenBranch);
+					WalkExpr(t.ElseBranch);
+					break;
+				case Expression.NullCoalesce nc:
+					WalkExpr(nc.Left);
+					WalkExpr(nc.Right);
+					break;
+				case Expression.ArrayLit al:
+					foreach (var e in al.Elements) WalkExpr(e);
+					break;
+				case Expression.Tuple tu:
+					foreach (var e in tu.Elements) WalkExpr(e);
+					break;
+				case Expression.NewArray na:
+					foreach (var e in na.Sizes) WalkExpr(e);
+					break;
+				case Expression.Range r:
+					WalkExpr(r.Start);
+					WalkExpr(r.End);
+					break;
+				case Expression.Spread s: WalkExpr(s.Value); break;
+			}
+		}
+
+		// Rebinding a local only moves its origins; anything else writes the target's object
+		// and stores the value into it.
+		private void WalkAssign(Expression target, Expression value) {
+			WalkExpr(target);
+			WalkExpr(value);
+			if (IsLocal(target)) {
+				Bind(((Expression.Identifier)target).Name, LocalOrigins(value));
+				return;
+			}
+
+			Write(WriteTarget(target));
+			if (!IsValue(value)) Store(Origins(value));
+		}
+
+		private bool IsLocal(Expression expr) => expr is Expression.Identifier id && _locals.ContainsKey(id.Name);
+
+		// Whose object an assignment or increment of `target` writes: the object holding the
+		// field or element, or the receiver / statics for a bare field name.
+		private WriteEffect WriteTarget(Expression target) => target switch {
+			Expression.Identifier id => FieldOrigins(id.Name),
+			Expression.MemberAccess ma when IsStaticField(ma) => WriteEffect.StaticsOnly,
+			Expression.MemberAccess ma => Origins(ma.Target),
+			Expression.MetaAccess => WriteEffect.StaticsOnly,
+			Expression.Index ix => Origins(ix.Target),
+			_ => WriteEffect.All
+		};
+
+		private void Write(WriteEffect written) {
+			if (!_recording || written.IsNone) return;
+			_direct = _direct.Union(written).Union(_stored);
+		}
+
+		// A callee given two or more objects may store one into another.
+		private void AddSite(Callee callee, WriteEffect receiver, List<Expression> args) {
+			var argOrigins = args.Select(a => IsValue(a) ? WriteEffect.None : Origins(a)).ToList();
+			if (argOrigins.Count(o => !o.IsNone) + (receiver.IsNone ? 0 : 1) > 1)
+				Store(argOrigins.Aggregate(receiver, (acc, o) => acc.Union(o)));
+			if (_recording) _sites.Add(new CallSite(callee, receiver, argOrigins, _stored));
+		}
+
+		// A local initialized from `new` or an owning call holds an object nobody else reaches.
+		private WriteEffect LocalOrigins(Expression init) {
+			if (init is Expression.New or Expression.NewArray) return WriteEffect.None;
+			if (init is Expression.Call && _typer.InferType(init) is { } type && _symbols.KnownClasses.Contains(type)) return WriteEffect.None;
+			return Origins(init);
+		}
+
+		private bool IsValue(Expression expr) => _typer.InferType(expr) is { } type && IsValueType(_symbols, type);
+
+		// Where the object `expr` evaluates to may come from.
+		private WriteEffect Origins(Expression expr) {
+			if (IsValue(expr)) return WriteEffect.None;
+			return expr switch {
+				Expression.Identifier id => _locals.TryGetValue(id.Name, out var local) ? local : FieldOrigins(id.Name),
+				Expression.This or Expression.Super or Expression.OuterThis => WriteEffect.ReceiverOnly,
+				Expression.MemberAccess ma when IsStaticField(ma) => WriteEffect.StaticsOnly,
+				Expression.MemberAccess ma => Origins(ma.Target),
+				Expression.MetaAccess => WriteEffect.StaticsOnly,
+				Expression.Index ix => Origins(ix.Target),
+				Expression.Cast c => Origins(c.Value),
+				Expression.Ternary t => Origins(t.ThenBranch).Union(Origins(t.ElseBranch)),
+				Expression.NullCoalesce nc => Origins(nc.Left).Union(Origins(nc.Right)),
+				Expression.Assign a => Origins(a.Value),
+				Expression.Call call => call.Arguments.Aggregate(call.Callee is Expression.MemberAccess ma ? Origins(ma.Target) : WriteEffect.ReceiverOnly, (acc, a) => acc.Union(Origins(a))).Union(WriteEffect.StaticsOnly),
+				Expression.New or Expression.NewArray or Expression.Literal or Expression.Lambda => WriteEffect.None,
+				Expression.ArrayLit al => al.Elements.Aggregate(WriteEffect.None, (acc, e) => acc.Union(Origins(e))),
+				Expression.Tuple tu => tu.Elements.Aggregate(WriteEffect.None, (acc, e) => acc.Union(Origins(e))),
+				_ => WriteEffect.All
+			};
+		}
+
+		// A bare name that isn't a local: a field of this class, of an ancestor or of an
+		// enclosing instance's class, or else a type.
+		private WriteEffect FieldOrigins(string name) {
+			for (var host = _typeFqn; !string.IsNullOrEmpty(host); host = _symbols.Classes.TryGetValue(host, out var info) && info.IsInner ? info.OuterClassFqn : null) {
+				if (FindField(host, name) is { } field)
+					return field.IsStatic ? WriteEffect.StaticsOnly : WriteEffect.ReceiverOnly;
+			}
+
+			return IsTypeName(name) ? WriteEffect.None : WriteEffect.All;
+		}
+
+		// `Type.field` for a static field, or a static field reached through a value.
+		private bool IsStaticField(Expression.MemberAccess ma) {
+			var owner = ma.Target is Expression.Identifier id && !_locals.ContainsKey(id.Name) && FindField(_typeFqn, id.Name) == null
+				? _symbols.ResolveTypeName(id.Name, _importMap, _moduleFqn, _typeFqn)
+				: null;
+			owner ??= _typer.InferType(ma.Target);
+			return owner != null && FindField(owner, ma.Member) is { IsStatic: true };
+		}
+
+		private FieldInfo? FindField(string? owner, string name) {
+			while (!string.IsNullOrEmpty(owner) && !_symbols.CycleBrokenClasses.Contains(owner)) {
+				if (_symbols.Fields.TryGetValue(owner, out var fields) && fields.FirstOrDefault(f => f.Name == name) is { } field) return field;
+				owner = _symbols.ClassVtables.GetValueOrDefault(owner)?.ParentClassFqn;
+			}
+
+			return null;
+		}
+
+		private bool IsTypeName(string name) =>
+			_symbols.ResolveTypeName(name, _importMap, _moduleFqn, _typeFqn) != null
+			|| _symbols.KnownEnums.Contains(_importMap.GetValueOrDefault(name) ?? name)
+			|| _symbols.KnownEnums.Contains(TypeFqn(_moduleFqn, name));
+	}
+}
+
+// The objects a function may write, by how its caller reaches them: `Receiver` for the
+// function's `this`, bit `i` of `Params` for parameter `i` (bit 63 stands for every
+// parameter from the 64th on), `Statics` for static fields. A write to an object counts as a
+// write to every object that reaches it.
+public readonly record struct WriteEffect(bool Receiver, ulong Params, bool Statics) {
+	public static readonly WriteEffect None = default;
+	public static readonly WriteEffect All = new(true, ulong.MaxValue, true);
+	public static readonly WriteEffect ReceiverOnly = new(true, 0, false);
+	public static readonly WriteEffect StaticsOnly = new(false, 0, true);
+
+	public bool IsNone => this == None;
+
+	public bool WritesParam(int index) => (Params & Bit(index)) != 0;
+
+	public WriteEffect Union(WriteEffect other) => new(Receiver || other.Receiver, Params | other.Params, Statics || other.Statics);
+
+	public static ulong Bit(int index) => 1UL << Math.Min(index, 63);
+}
+
+// A call's target for `EffectSummaries.EffectOf`. `Symbol` is the function's `Effects` key,
+// or null when it is only known at run time; `Declared` marks the `Type&` / `Type!`
+// parameters. `Fresh` is set for `new`, whose receiver is the object being built. `Hidden`
+// is set when the callee's parameter 0 is an inner class's outer instance, which the caller
+// passes as the receiver.
+public readonly record struct Callee(string? Symbol, ulong Declared, bool Fresh = false, bool Hidden = false) {
+	public static readonly Callee Unknown = new(null, 0);
+}
@@ -5,6 +5,8 @@
 // Use, modification, and distribution of this file are governed by the
 // license terms provided with the Cloth Compiler source distribution.
 
+using System.Runtime.ExceptionServices;
+using FrontEnd.Error;
 using FrontEnd.Parser.AST;
 using FrontEnd.Parser.AST.Declarations;
 using FrontEnd.Parser.AST.Expressions;
@@ -52,6 +54,11 @@ public class SemanticAnalyzer {
 	// merged across branches/loops alongside `_deletedNames`.
 	private Dictionary<string, HashSet<string>> _aliasGroups = new();
 
+	// Local name → the name of the object it was taken from through a member or index chain
+	// (`let n = a.left;` records `n → a`), which `_aliasGroups` doesn't track. Only grows
+	// within a function; `CheckJoinTasks` reads it to see that `n` may reach into `a`.
+	private Dictionary<string, string> _localRoots = new();
+
 	// Leak detection. `_ownedKeys` records keys that own a heap allocation
 	// (added at `let x = new Foo()`, at `this.f = new Foo()`, at owning-call returns,
 	// and at `Type!` parameter entry). Both `local:<name>` and `field:<name>` are tracked
@@ -63,14 +70,34 @@ public class SemanticAnalyzer {
 	private HashSet<string> _ownedKeys = new();
 	private HashSet<string> _consumedAllPaths = new();
 
+	// `@Region` bodies. A local declared as `let x = new Foo()` there is owned by the
+	// function's arena rather than by `x`: it isn't leak-checked, and `_regionKeys` records
+	// it (plus every local that aliases it) so CheckRegionEscape can reject the moves that
+	// would outlive the arena. The set only grows within a function — a name that held a
+	// region object on any path stays region-owned.
+	private bool _regionBody;
+	private HashSet<string> _regionKeys = new();
+
 	// Canonical return type of the function currently being walked, used to validate
 	// `return value;` statements. "void" for constructors, destructors, and methods
 	// declared with `: void`. "" means we haven't entered a function yet.
 	private string _currentReturnType = "";
 
 	// Inferred types for VarDeclStmts whose source has no explicit type annotation.
-	// Keyed by the VarDeclStmt's Span (TokenSpan is a reference type, so identity is stable).
-	public Dictionary<TokenSpan, TypeExpression> InferredVarTypes { get; } = new();
+	// Keyed by the VarDeclStmt's Span, compared by position (`SpanPosition`) so types the
+	// build cache reloads for an unchanged file key the declarations of its fresh parse.
+	public Dictionary<TokenSpan, TypeExpression> InferredVarTypes { get; } = new(SpanPosition.Comparer);
+
+	// Results of an earlier build's walk, keyed by file path, that the host has shown still
+	// hold (see `AnalysisCache`). Those units aren't walked again: their diagnostics are
+	// replayed and their inferred types merged as if just produced.
+	public IReadOnlyDictionary<string, UnitAnalysis>? Reusable { get; init; }
+
+	// Each unit's result from the last `Analyze`, in unit order, for the host to keep.
+	public IReadOnlyList<UnitAnalysis> UnitResults { get; private set; } = [];
+
+	// Units the last `Analyze` walked rather than took from `Reusable`.
+	public int WalkedCount { get; private set; }
 
 	// When true, S012 LeakedOwnedValue is rendered as a warning (no exit) so the
 	// build still completes. Wired from build.toml's `[build] allowLeaks` flag.
@@ -84,6 +111,17 @@ public class SemanticAnalyzer {
 		_allowLeaks = allowLeaks;
 	}
 
+	// A worker for one unit of the parallel `InferDeclarations` pass: it shares the parent's
+	// inputs and the registry — read-only once built — and gets its own per-unit and
+	// per-function state and its own `InferredVarTypes`.
+	private SemanticAnalyzer(SemanticAnalyzer parent) {
+		_units = parent._units;
+		_externUnits = parent._externUnits;
+		_sourceRoot = parent._sourceRoot;
+		_symbols = parent._symbols;
+		_allowLeaks = parent._allowLeaks;
+	}
+
 	public void Analyze(bool requireMain = true) {
 		foreach (var (unit, filePath) in _units)
 			ValidateModulePath(unit, filePath);
@@ -105,8 +143,51 @@ public class SemanticAnalyzer {
 		foreach (var (unit, filePath) in _units)
 			ValidateEnumCasesGlobalPass(unit, filePath);
 
-		foreach (var (unit, filePath) in _units)
-			InferDeclarations(unit, filePath);
+		InferDeclarationsParallel();
+	}
+
+	// The per-unit walks read nothing but the registry and their own unit, so each unit
+	// runs on its own worker. A worker's diagnostics are captured (see `FatalErrors.Capture`)
+	// and replayed here in unit order, stopping at the first fatal one, and the inferred types
+	// are merged in the same order — the output is a serial walk's whatever the scheduling.
+	// A `Reusable` unit contributes its stored log and types in its place.
+	private void InferDeclarationsParallel() {
+		var results = new UnitAnalysis[_units.Count];
+		var outcomes = new Exception?[_units.Count];
+		var walked = 0;
+		Parallel.For(0, _units.Count, i => {
+			if (Reusable != null && Reusable.TryGetValue(_units[i].FilePath, out var reused)) {
+				results[i] = reused;
+				return;
+			}
+
+			Interlocked.Increment(ref walked);
+			var worker = new SemanticAnalyzer(this);
+			var log = new StringWriter();
+			FatalErrors.Capture = log;
+			try {
+				worker.InferDeclarations(_units[i].Unit, _units[i].FilePath);
+			}
+			catch (Exception e) {
+				outcomes[i] = e;
+			}
+			finally {
+				FatalErrors.Capture = null;
+			}
+
+			results[i] = new UnitAnalysis(log.ToString(), worker.InferredVarTypes.ToList());
+		});
+
+		for (var i = 0; i < _units.Count; i++) {
+			Console.Error.Write(results[i].Log);
+			if (outcomes[i] is CompilationAbortedException aborted) FatalErrors.Exit(aborted.ExitCode);
+			if (outcomes[i] is { } failure) ExceptionDispatchInfo.Capture(failure).Throw();
+			foreach (var (span, type) in results[i].InferredVarTypes)
+				InferredVarTypes[span] = type;
+		}
+
+		UnitResults = results;
+		WalkedCount = walked;
 	}
 
 	// File-level pre-pass that fires the structural enum diagnostics (S02C / S02D / S02E).
@@ -312,6 +393,7 @@ public class SemanticAnalyzer {
 			switch (typeDecl) {
 				case TypeDeclaration.Class { Declaration: var c }:
 					_currentTypeFqn = string.IsNullOrEmpty(moduleFqn) ? c.Name : $"{moduleFqn}.{c.Name}";
+					ValidateClassAnnotations(c.Annotations, filePath);
 					ValidateClassExtendsImplements(c, filePath);
 					foreach (var member in c.Members)
 						WalkMember(member, filePath, c.PrimaryParameters);
@@ -340,6 +422,7 @@ public class SemanticAnalyzer {
 				case MemberDeclaration.Method { Declaration: var m } when m.Body.HasValue:
 					BeginFunctionScope(m.Parameters);
 					_currentReturnType = ResolveReturnType(m.ReturnType);
+					_regionBody = HasRegionAnnotation(m.Annotations);
 					WalkBlock(m.Body.Value, filePath);
 					ValidateAllPathsReturn(m.Body.Value, m.Name, filePath);
 					CheckOwnedLocalLeaks(filePath);
@@ -375,12 +458,14 @@ public class SemanticAnalyzer {
 					if (m.Body.HasValue) {
 						BeginFunctionScope(m.Parameters);
 						_currentReturnType = ResolveReturnType(m.ReturnType);
+						_regionBody = HasRegionAnnotation(m.Annotations);
 						WalkBlock(m.Body.Value, filePath);
 						ValidateAllPathsReturn(m.Body.Value, m.Name, filePath);
 						CheckOwnedLocalLeaks(filePath);
 					}
 
 					ValidateAnnotations(m.Annotations, filePath);
+					ValidateBodyAnnotations(m.Annotations, $"method '{m.Name}' on '{_currentTypeFqn}'", m.Body.HasValue, filePath);
 					break;
 				case MemberDeclaration.Const:
 					// Const declarations on interfaces are accepted by the parser; analyzer-
@@ -460,10 +545,13 @@ public class SemanticAnalyzer {
 		_deletedNames = new HashSet<string>();
 		_paramOwnership = new Dictionary<string, OwnershipModifier?>();
 		_aliasGroups = new Dictionary<string, HashSet<string>>();
+		_localRoots = new Dictionary<string, string>();
 		_ownedKeys = new HashSet<string>();
 		_consumedAllPaths = new HashSet<string>();
+		_regionBody = false;
+		_regionKeys = new HashSet<string>();
 		foreach (var p in parameters) {
-			if (p.Type.Base is BaseType.Named)
+			if (p.Type.Base is BaseType.Named or BaseType.Array)
 				_typer.DeclareLocal(p.Name, CanonicalizeDeclaredTypeExpr(p.Type));
 			_paramOwnership[p.Name] = p.Type.Ownership;
 			// `Type!` parameters transfer ownership IN — the function body now owns the
@@ -477,8 +565,10 @@ public class SemanticAnalyzer {
 		switch (member) {
 			case MemberDeclaration.Constructor { Declaration: var ctor }:
 				ValidateAnnotations(ctor.Annotations, filePath);
+				ValidateBodyAnnotations(ctor.Annotations, $"a constructor of '{_currentTypeFqn}'", true, filePath);
 				BeginFunctionScope(primaryParams.Concat(ctor.Parameters));
 				_currentReturnType = "void";
+				_regionBody = HasRegionAnnotation(ctor.Annotations);
 				WalkBlock(ctor.Body, filePath);
 				CheckOwnedLocalLeaks(filePath);
 				break;
@@ -496,8 +586,10 @@ public class SemanticAnalyzer {
 				ValidatePrototypeFuncContext(m, filePath);
 				ValidateAnnotations(m.Annotations, filePath);
 				ValidateMethodAnnotations(m, filePath);
+				ValidateBodyAnnotations(m.Annotations, $"method '{m.Name}' on '{_currentTypeFqn}'", true, filePath, m);
 				BeginFunctionScope(m.Parameters);
 				_currentReturnType = ResolveReturnType(m.ReturnType);
+				_regionBody = HasRegionAnnotation(m.Annotations);
 				WalkBlock(m.Body.Value, filePath);
 				ValidateAllPathsReturn(m.Body.Value, m.Name, filePath);
 				CheckOwnedLocalLeaks(filePath);
@@ -508,17 +600,21 @@ public class SemanticAnalyzer {
 				ValidatePrototypeFuncContext(m, filePath);
 				ValidateAnnotations(m.Annotations, filePath);
 				ValidateMethodAnnotations(m, filePath);
+				ValidateBodyAnnotations(m.Annotations, $"method '{m.Name}' on '{_currentTypeFqn}'", false, filePath, m);
 				break;
 			case MemberDeclaration.Fragment { Declaration: var f } when f.Body.HasValue:
 				ValidateAnnotations(f.Annotations, filePath);
+				ValidateBodyAnnotations(f.Annotations, $"fragment '{f.Name}' on '{_currentTypeFqn}'", true, filePath);
 				BeginFunctionScope(f.Parameters);
 				_currentReturnType = ResolveReturnType(f.ReturnType);
+				_regionBody = HasRegionAnnotation(f.Annotations);
 				WalkBlock(f.Body.Value, filePath);
 				ValidateAllPathsReturn(f.Body.Value, f.Name, filePath);
 				CheckOwnedLocalLeaks(filePath);
 				break;
 			case MemberDeclaration.Field { Declaration: var fd }:
 				ValidateAnnotations(fd.Annotations, filePath);
+				ValidateBodyAnnotations(fd.Annotations, $"field '{fd.Name}' on '{_currentTypeFqn}'", false, filePath);
 				break;
 			case MemberDeclaration.NestedType { Declaration: TypeDeclaration.Class { Declaration: var nested } }:
 				// Recursively walk the nested class with `_currentTypeFqn` updated to the
@@ -527,6 +623,7 @@ public class SemanticAnalyzer {
 				var savedTypeFqn = _currentTypeFqn;
 				_currentTypeFqn = string.IsNullOrEmpty(savedTypeFqn) ? nested.Name : $"{savedTypeFqn}.{nested.Name}";
 				try {
+					ValidateClassAnnotations(nested.Annotations, filePath);
 					foreach (var m in nested.Members)
 						WalkMember(m, filePath, nested.PrimaryParameters);
 				}
@@ -581,7 +678,15 @@ public class SemanticAnalyzer {
 				if (d.Init != null) {
 					WalkExpr(d.Init, filePath);
 					TryRecordInitAlias(newLocalKey, d.Init);
-					ClassifyInitOwnership(newLocalKey, d.Init);
+					RecordLocalRoot(d.Name, d.Init);
+					// A region object is freed with the arena, so it has no owner to leak-check.
+					if (_regionBody && d.Init is Expression.New) {
+						_regionKeys.Add(newLocalKey);
+					}
+					else {
+						CheckRegionStore(newLocalKey, d.Init, filePath);
+						ClassifyInitOwnership(newLocalKey, d.Init);
+					}
 				}
 
 				break;
@@ -591,6 +696,7 @@ public class SemanticAnalyzer {
 			case Stmt.Return { Value: var v }:
 				if (v != null) WalkExpr(v, filePath);
 				ValidateReturn(v, filePath);
+				if (v != null) CheckRegionEscape(v, "returned", filePath);
 				// Returning a class-typed local/field transfers ownership to the caller —
 				// mark consumed via RecordDeletion so alias propagation fires too.
 				if (v != null) RecordDeletion(v);
@@ -615,11 +721,13 @@ public class SemanticAnalyzer {
 				WalkExpr(a.Target, filePath);
 				WalkExpr(a.Value, filePath);
 				ValidateAssign(a, filePath);
+				CheckRegionStore(hasLhsKey ? key : null, a.Value, filePath);
 				// Only direct assignment (`=`) creates an alias; compound forms like `+=` don't
 				// produce an aliasing relationship between target and value.
 				if (hasLhsKey && a.Operator == AssignOp.Assign) {
 					TryRecordInitAlias(key, a.Value);
 					ClassifyAssignOwnership(key, a.Value);
+					if (a.Target is Expression.Identifier target) RecordLocalRoot(target.Name, a.Value);
 				}
 
 				break;
@@ -647,7 +755,14 @@ public class SemanticAnalyzer {
 				// the body sees it. The declared type goes through canonicalization the same
 				// way `let T x = ...` does.
 				_typer.DeclareLocal(s.Name, CanonicalizeDeclaredTypeExpr(s.Type));
+				// A parallel body's `new`s don't go to the `@Region` arena (see
+				// `CirGenerator.LowerForInStmt`), so they are owned and leak-checked as usual.
+				var regionBody = _regionBody;
+				_regionBody &= !s.Parallel;
 				WalkLoopBody(s.Body, filePath);
+				_regionBody = regionBody;
+				// After the walk, so the body's locals are in the typer's scope for overload resolution.
+				if (s.Parallel) CheckParallelBody(s, filePath);
 				break;
 			case Stmt.Switch { Statement: var s }:
 				WalkExpr(s.Expression, filePath);
@@ -657,9 +772,14 @@ public class SemanticAnalyzer {
 			case Stmt.Delete { Expression: var e }:
 				WalkExpr(e, filePath);
 				ValidateDelete(e, filePath);
+				CheckRegionEscape(e, "deleted; the arena frees it when the function returns", filePath);
 				RecordDeletion(e);
 				break;
 			case Stmt.Discard { Expression: var e }: WalkExpr(e, filePath); break;
+			case Stmt.Join { Tasks: var tasks }:
+				foreach (var task in tasks) WalkExpr(task, filePath);
+				CheckJoinTasks(tasks, filePath);
+				break;
 			case Stmt.SuperCall { Arguments: var args }:
 				foreach (var a in args) WalkExpr(a, filePath);
 				break;
@@ -773,9 +893,11 @@ public class SemanticAnalyzer {
 				WalkExpr(asn.Target, filePath);
 				WalkExpr(asn.Value, filePath);
 				ValidateAssignExpr(asn, filePath);
+				CheckRegionStore(asnHasKey ? asnKey : null, asn.Value, filePath);
 				if (asnHasKey && asn.Operator == AssignOp.Assign) {
 					TryRecordInitAlias(asnKey, asn.Value);
 					ClassifyAssignOwnership(asnKey, asn.Value);
+					if (asn.Target is Expression.Identifier target) RecordLocalRoot(target.Name, asn.Value);
 				}
 
 				break;
@@ -1030,8 +1152,7 @@ public class SemanticAnalyzer {
 					// interfaces are also required of the class.
 					foreach (var sig in _symbols.TransitiveMethods(ifaceFqn)) {
 						if (sig.HasDefaultBody) continue; // default impls don't require an override yet
-						var methodFqn = $"{_currentTypeFqn}.{sig.Name}";
-						var matched = _symbols.Overloads.TryGetValue(methodFqn, out var overloads) && overloads.Any(o => o.ParamTypes.SequenceEqual(sig.ParamTypes) && o.ReturnType == sig.ReturnType);
+						var matched = _symbols.DeclaredOverloads(_currentTypeFqn, sig.Name) is { } overloads && overloads.Any(o => o.ParamTypes.SequenceEqual(sig.ParamTypes) && o.ReturnType == sig.ReturnType);
 						if (!matched)
 							SemanticError.MissingInterfaceMember.WithFile(filePath).WithMessage($"class '{_currentTypeFqn}' does not implement '{sig.Name}({string.Join(", ", sig.ParamTypes)}) : {sig.ReturnType}' required by interface '{ifaceFqn}'").Render();
 					}
@@ -1071,11 +1192,10 @@ public class SemanticAnalyzer {
 		while (!string.IsNullOrEmpty(cursor)) {
 			if (_symbols.CycleBrokenClasses.Contains(cursor)) break;
 			// Walk every overload registered as `<cursor>.<methodName>` looking for prototype
-			// declarations. The Overloads dict isn't indexed by owner, so we filter.
-			foreach (var (methodFqn, overloads) in _symbols.Overloads) {
-				if (!methodFqn.StartsWith(cursor + ".")) continue;
-				var tail = methodFqn[(cursor.Length + 1)..];
-				if (tail.Contains('.')) continue; // nested-class member; not ours
+			// declarations, through the registry's per-owner index.
+			var methods = _symbols.Names.TryGetId(cursor, out var ownerId) ? _symbols.DeclaredMethods(ownerId) : [];
+			foreach (var (name, overloads) in methods) {
+				var tail = _symbols.Names.NameOf(name);
 				foreach (var proto in overloads) {
 					if (!proto.IsPrototype || proto.OwnerClass != cursor) continue;
 					if (ChainImplementsMethod(_currentTypeFqn, tail, proto.ParamTypes, proto.ReturnType)) continue;
@@ -1093,7 +1213,7 @@ public class SemanticAnalyzer {
 		var cursor = startClass;
 		while (!string.IsNullOrEmpty(cursor)) {
 			if (_symbols.CycleBrokenClasses.Contains(cursor)) return false;
-			if (_symbols.Overloads.TryGetValue($"{cursor}.{methodName}", out var overloads)
+			if (_symbols.DeclaredOverloads(cursor, methodName) is { } overloads
 			    && overloads.Any(o => !o.IsPrototype && o.ParamTypes.SequenceEqual(paramTypes) && o.ReturnType == returnType))
 				return true;
 			cursor = _symbols.ClassVtables.TryGetValue(cursor, out var layout) ? layout.ParentClassFqn ?? "" : "";
@@ -1131,10 +1251,18 @@ public class SemanticAnalyzer {
 	}
 
 	// Built-in annotations whose semantics are wired in elsewhere. `Extern` is the FFI
-	// binding mechanism — its arg is the literal C symbol. The user-facing annotation
-	// traits (`Override`, `Implementation`, `Deprecated`) are now declared as zero-element
-	// traits in the standard library, so they go through the normal trait-arg validator.
-	private static readonly HashSet<string> BuiltinAnnotationNames = new() { "Extern" };
+	// binding mechanism — its arg is the literal C symbol. `Unchecked` turns off the
+	// runtime bounds checks on indexing and sub-slicing inside one function body (see
+	// `ValidateBodyAnnotations`); `Region` gives one function body an arena for the objects
+	// its locals allocate (see `_regionKeys`); `Compact` lets the `field-layout` pass reorder a
+	// class's own fields (see `ValidateClassAnnotations`). The user-facing annotation traits (`Override`,
+	// `Implementation`, `Deprecated`) are now declared as zero-element traits in the
+	// standard library, so they go through the normal trait-arg validator.
+	public const string UncheckedAnnotationName = "Unchecked";
+	public const string RegionAnnotationName = "Region";
+	public const string BenchAnnotationName = "Bench";
+	public const string CompactAnnotationName = "Compact";
+	private static readonly HashSet<string> BuiltinAnnotationNames = new() { "Extern", UncheckedAnnotationName, RegionAnnotationName, BenchAnnotationName, CompactAnnotationName };
 
 	// FQNs of the stdlib annotations whose presence triggers extra content validation.
 	private const string OverrideTraitFqn = "cloth.lang.Override";
@@ -1180,7 +1308,7 @@ public class SemanticAnalyzer {
 		var cursor = _symbols.ClassVtables.TryGetValue(_currentTypeFqn, out var layout) ? layout.ParentClassFqn : null;
 		while (!string.IsNullOrEmpty(cursor)) {
 			if (_symbols.CycleBrokenClasses.Contains(cursor)) break;
-			if (_symbols.Overloads.TryGetValue($"{cursor}.{m.Name}", out var overloads)
+			if (_symbols.DeclaredOverloads(cursor, m.Name) is { } overloads
 			    && overloads.Any(o => o.ParamTypes.SequenceEqual(paramTypes) && o.ReturnType == returnType))
 				return;
 			cursor = _symbols.ClassVtables.TryGetValue(cursor, out var nextLayout) ? nextLayout.ParentClassFqn : null;
@@ -1211,6 +1339,110 @@ public class SemanticAnalyzer {
 		SemanticError.ImplementationMismatch.WithFile(filePath).WithMessage($"method '{m.Name}' on class '{_currentTypeFqn}' is marked @Implementation but no interface in the implements list declares '{m.Name}({string.Join(", ", paramTypes)}) : {returnType}'").Render();
 	}
 
+	// `@Unchecked` and `@Region` take no arguments and only mean something on a declaration
+	// with a body to lower: a method, fragment, or constructor. On a field, a prototype, or
+	// an `@Extern` binding they would silently do nothing, so they're rejected instead.
+	// `method` is the declaration when `subject` is a class method, for `@Bench`.
+	private void ValidateBodyAnnotations(List<TraitAnnotation> annotations, string subject, bool hasBody, string filePath, MethodDeclaration? method = null) {
+		foreach (var a in annotations) {
+			if (a.Name == BenchAnnotationName) {
+				ValidateBenchAnnotation(a, annotations, subject, hasBody, method, filePath);
+				continue;
+			}
+
+			if (a.Name == CompactAnnotationName) {
+				SemanticError.InvalidCompact.WithFile(filePath).WithMessage($"'@Compact' on {subject} — only classes have a field layout to reorder").Render();
+				continue;
+			}
+
+			var error = a.Name switch {
+				UncheckedAnnotationName => SemanticError.InvalidUnchecked,
+				RegionAnnotationName => SemanticError.InvalidRegion,
+				_ => null
+			};
+			if (error == null) continue;
+			if (a.Args.Count > 0)
+				error.WithFile(filePath).WithMessage($"'@{a.Name}' on {subject} takes no arguments; got {a.Args.Count}").Render();
+			if (!hasBody || annotations.Any(x => x.Name == "Extern"))
+				error.WithFile(filePath).WithMessage($"'@{a.Name}' on {subject} has no body to apply to — it only affects functions and constructors with a body").Render();
+		}
+	}
+
+	// `@Bench` marks a benchmark for `cloth bench`, whose generated driver calls it in a timed
+	// loop with no instance to call it on: it must be a static class method with a body. It
+	// takes no parameters, or one integer parameter fed from `@Bench(<integer literal>)`,
+	// which the driver passes through a volatile load so the body can't be folded around a
+	// constant input.
+	private void ValidateBenchAnnotation(TraitAnnotation bench, List<TraitAnnotation> annotations, string subject, bool hasBody, MethodDeclaration? method, string filePath) {
+		var error = SemanticError.InvalidBench.WithFile(filePath);
+		if (bench.Args.Count > 1)
+			error.WithMessage($"'@Bench' on {subject} takes at most one argument; got {bench.Args.Count}").Render();
+		if (method is not { } m)
+			error.WithMessage($"'@Bench' on {subject} — only class methods can be benchmarks").Render();
+		else if (!hasBody || annotations.Any(x => x.Name == "Extern"))
+			error.WithMessage($"'@Bench' on {subject} has no body to benchmark").Render();
+		else if (!m.Modifiers.Contains(FunctionModifiers.Static))
+			error.WithMessage($"'@Bench' on {subject} needs a `static` method — the benchmark driver has no instance to call it on").Render();
+		else if (bench.Args.Count == 0 && m.Parameters.Count > 0)
+			error.WithMessage($"'@Bench' on {subject} must take no parameters, or one fed by '@Bench(<input>)'; got {m.Parameters.Count}").Render();
+		else if (bench.Args.Count == 1) {
+			var paramType = m.Parameters.Count == 1 ? CanonicalizeDeclaredTypeExpr(m.Parameters[0].Type) : null;
+			if (paramType == null || !TypeInference.IsIntegerCanonical(paramType))
+				error.WithMessage($"'@Bench(<input>)' on {subject} needs exactly one integer parameter to pass the input to").Render();
+			else if (BenchInput(bench) is not { } input || !TypeInference.LiteralFitsInteger(input, paramType))
+				error.WithMessage($"'@Bench' input on {subject} must be an integer literal that fits '{paramType}'").Render();
+		}
+	}
+
+	// The literal text of `@Bench(<input>)`, or null when there is none or it isn't a plain
+	// (optionally negated) integer literal.
+	internal static string? BenchInput(TraitAnnotation bench) => bench.Args is [{ Key: "", Value: var value }] ? value switch {
+		Expression.Literal { Value: Literal.Int i } => i.Value,
+		Expression.Unary { Operator: UnOp.Neg, Operand: Expression.Literal { Value: Literal.Int i } } => "-" + i.Value,
+		_ => null
+	} : null;
+
+	// A class takes `@Compact` (no arguments) and trait annotations. The body annotations
+	// (`@Unchecked`, `@Region`, `@Bench`) are reported as they are on a field: nothing to apply to.
+	private void ValidateClassAnnotations(List<TraitAnnotation> annotations, string filePath) {
+		ValidateAnnotations(annotations, filePath);
+		foreach (var a in annotations) {
+			if (a.Name == CompactAnnotationName && a.Args.Count > 0)
+				SemanticError.InvalidCompact.WithFile(filePath).WithMessage($"'@Compact' on class '{_currentTypeFqn}' takes no arguments; got {a.Args.Count}").Render();
+		}
+
+		ValidateBodyAnnotations(annotations.Where(a => a.Name != CompactAnnotationName).ToList(), $"class '{_currentTypeFqn}'", false, filePath);
+	}
+
+	private static bool HasRegionAnnotation(List<TraitAnnotation> annotations) =>
+		annotations.Any(a => a.Name == RegionAnnotationName);
+
+	// An arena object is destroyed when its `@Region` function returns, so it may be read,
+	// mutated and passed to borrowing callees, but no move may hand it to an owner that
+	// outlives the call: returning it, deleting it, passing it to a `Type!` parameter, or
+	// storing it anywhere but another local.
+	private void CheckRegionEscape(Expression value, string how, string filePath) {
+		if (value is not Expression.Identifier id || !_regionKeys.Contains($"local:{id.Name}")) return;
+		SemanticError.RegionEscape.WithFile(filePath).WithMessage($"'{id.Name}' is allocated in this function's @Region arena and cannot be {how}").Render();
+	}
+
+	// `target = value` where `targetKey` is the target's tombstone key, when it has one. A
+	// region object stored in another local makes that local region-owned too; any other
+	// target (a field, an element) would outlive the arena.
+	private void CheckRegionStore(string? targetKey, Expression value, string filePath) {
+		if (value is not Expression.Identifier id || !_regionKeys.Contains($"local:{id.Name}")) return;
+		if (targetKey != null && targetKey.StartsWith("local:")) _regionKeys.Add(targetKey);
+		else CheckRegionEscape(value, "stored outside a local", filePath);
+	}
+
+	private void CheckRegionTransfers(List<OwnershipModifier?> paramOwnership, List<Expression> args, string filePath) {
+		var n = Math.Min(paramOwnership.Count, args.Count);
+		for (var i = 0; i < n; i++) {
+			if (paramOwnership[i] == OwnershipModifier.Transfer)
+				CheckRegionEscape(args[i], $"passed to transfer parameter {i}", filePath);
+		}
+	}
+
 	// Validate every annotation in a list against its trait's element schema. Resolves the
 	// trait by name, checks visibility, then matches the supplied args (named or positional)
 	// against the trait's element list — types, required-vs-optional, no extras.
@@ -1428,7 +1660,7 @@ public class SemanticAnalyzer {
 		// Method-as-value access (without a call) routes here too. Use any overload's
 		// visibility — within a single method name they should agree, but when they don't
 		// we conservatively reject if any overload is reachable.
-		if (_symbols.Overloads.TryGetValue($"{targetType}.{ma.Member}", out var overloads)) {
+		if (_symbols.DeclaredOverloads(targetType, ma.Member) is { } overloads) {
 			var anyAccessible = overloads.Any(o => CanAccess(o.Visibility, o.OwnerModule, o.OwnerClass));
 			if (!anyAccessible) {
 				var first = overloads[0];
@@ -1561,6 +1793,46 @@ public class SemanticAnalyzer {
 		}
 	}
 
+	// A `Type!` argument must be the only reference the call can see: the callee owns the
+	// object outright, and the emitter marks the parameter `noalias` on that promise. So the
+	// argument has to be something the analyzer can name and tombstone (a local, a parameter,
+	// a field of `this`) or a fresh object; `obj.child`, `arr[i]` and statics stay reachable
+	// through names the call still sees. A borrowed parameter can't be transferred (the
+	// caller's caller still holds it), and no other argument or the receiver may reach the
+	// transferred object through its alias group or the roots it was taken from — which
+	// covers a field of `this` passed alongside `this`. `receiver` is the instance-method
+	// receiver, or null for constructors and static functions.
+	private void CheckExclusiveTransfers(List<OwnershipModifier?> paramOwnership, List<Expression> args, Expression? receiver, string filePath) {
+		var n = Math.Min(paramOwnership.Count, args.Count);
+		for (var i = 0; i < n; i++) {
+			if (paramOwnership[i] != OwnershipModifier.Transfer) continue;
+			if (!TryGetWriteTombstoneKey(args[i], out var key)) {
+				if (args[i] is not (Expression.Literal or Expression.NewArray) && !IsOwningInit(args[i]))
+					SemanticError.NonExclusiveTransfer.WithFile(filePath).WithMessage($"argument {i} can't be transferred: only a local, a field of 'this' or a fresh object can be given up, and this one stays reachable after the call").Render();
+				continue;
+			}
+
+			if (args[i] is Expression.Identifier id && _paramOwnership.TryGetValue(id.Name, out var ownership) && ownership != OwnershipModifier.Transfer) {
+				SemanticError.NonExclusiveTransfer.WithFile(filePath).WithMessage($"parameter '{id.Name}' is a borrow and can't be transferred to parameter {i} — mark it '!' to take ownership").Render();
+				continue;
+			}
+
+			var group = _aliasGroups.TryGetValue(key, out var aliases) ? aliases : new HashSet<string> { key };
+			var transferred = ObjectNames(key[6..]);
+			for (var j = -1; j < args.Count; j++) {
+				var other = j < 0 ? receiver : args[j];
+				if (j == i || other == null) continue;
+				var sameObject = TryGetWriteTombstoneKey(other, out var otherKey) && group.Contains(otherKey);
+				var reaches = sameObject || OperandRoots(other).Any(root => ObjectNames(root).Overlaps(transferred));
+				if (!reaches) continue;
+				var where = j < 0 ? "the receiver" : $"argument {j}";
+				SemanticError.NonExclusiveTransfer.WithFile(filePath).WithMessage(sameObject
+					? $"argument {i} is transferred, but {where} refers to the same object"
+					: $"argument {i} is transferred, but {where} still reaches it").Render();
+			}
+		}
+	}
+
 	// Temporary-expression leak. A `new Foo()` passed to a non-Transfer parameter
 	// has no caller-side name and can't be `delete`d, so it's a guaranteed runtime leak.
 	// Force the user to hoist: `let t = new Foo(); f(t); delete t;`. Only fires for direct
@@ -1656,6 +1928,13 @@ public class SemanticAnalyzer {
 			UnionAliasGroup(lhsKey, rhsKey);
 	}
 
+	// `local = a.b[i]`-style bindings: `local` may reach into `a`. Direct aliases are already
+	// in `_aliasGroups`, and fresh allocations reach nothing.
+	private void RecordLocalRoot(string local, Expression value) {
+		if (value is Expression.Identifier or Expression.This || IsOwningInit(value)) return;
+		if (WriteRoot(value) is { } root && root != local) _localRoots[local] = root;
+	}
+
 	// Merge the groups containing `a` and `b` into one shared HashSet. Callers that
 	// reassign a name (severing its old alias) must call BreakAlias first.
 	private void UnionAliasGroup(string a, string b) {
@@ -1930,6 +2209,384 @@ public class SemanticAnalyzer {
 		_aliasGroups = MergeAliasStates(new[] { preAliases, _aliasGroups });
 	}
 
+	// `parallel for`: iterations run concurrently, so everything but the objects an iteration
+	// creates itself is shared between them and may only be read. Writing it — assigning to
+	// it or through it, incrementing it, deleting it, or handing it to a call that may write
+	// it — is S035, and so is any call that may write a static field. What a call writes
+	// comes from its callee's summary (`EffectSummaries`): its `Type&` / `Type!` parameters
+	// and whatever its body writes, transitively. A write through something with no name
+	// (`f().x = 1`) is rejected unless it is a `new` object. `return` and `break` can't leave
+	// the loop early.
+	//
+	// `locals` maps each name the iteration binds to where its object came from: null when
+	// the iteration owns it (`new`, an owning call, a literal built from such values), or
+	// the name it was taken from (`let c = shared;`, `let n = a.next;`), so writing through it
+	// is checked against that name instead. The loop variable names an element of the
+	// iterable, and elements can alias each other, so it is never owned. Any local may be
+	// rebound; only writes through it are checked.
+	private void CheckParallelBody(ForInStmt loop, string filePath) {
+		var locals = new Dictionary<string, string?> { [loop.Name] = WriteRoot(loop.Iterable) ?? "" };
+		foreach (var stmt in loop.Body.Statements)
+			CheckParallelStmt(stmt, locals, 0, filePath);
+	}
+
+	// Where the object a body local initialized from `init` comes from, in `locals` terms.
+	// "" stands for an object of unknown origin, which another iteration may reach too.
+	private string? ParallelLocalSource(Expression? init) {
+		switch (init) {
+			case null or Expression.New: return null;
+			case Expression.ArrayLit al: return al.Elements.Select(ParallelLocalSource).FirstOrDefault(src => src != null);
+			case Expression.Tuple tu: return tu.Elements.Select(ParallelLocalSource).FirstOrDefault(src => src != null);
+		}
+
+		if (IsOwningInit(init)) return null;
+		if (WriteRoot(init) is { } root) return root;
+		var type = _typer.InferType(init);
+		return type != null && (type.EndsWith("[]") || _symbols.KnownClasses.Contains(type)) ? "" : null;
+	}
+
+	// After `target = value` passes the write check: a local rebound to, or an owned object
+	// made to hold, a shared value is treated as shared from here on. Never the other way —
+	// a branch that rebinds to a fresh object doesn't make the other paths' alias safe.
+	private void NoteParallelStore(Expression target, Expression value, Dictionary<string, string?> locals) {
+		if (WriteRoot(target) is not { } root || !locals.TryGetValue(root, out var current) || current != null) return;
+		if (ParallelLocalSource(value) is { } source) locals[root] = source;
+	}
+
+	// `depth` counts the loops and switches entered inside the body; a `break` at depth 0 would
+	// leave the parallel loop itself.
+	private void CheckParallelStmt(Stmt stmt, Dictionary<string, string?> locals, int depth, string filePath) {
+		switch (stmt) {
+			case Stmt.VarDecl { Declaration: var d }:
+				if (d.Init != null) CheckParallelExpr(d.Init, locals, filePath);
+				locals[d.Name] = ParallelLocalSource(d.Init);
+				break;
+			case Stmt.TupleDestructure { Declaration: var d }:
+				CheckParallelExpr(d.Init, locals, filePath);
+				var source = ParallelLocalSource(d.Init);
+				foreach (var b in d.Bindings) locals[b.Name] = source;
+				break;
+			case Stmt.Assign { Assignment: var a }:
+				CheckParallelWrite(a.Target, locals, "assigned", filePath, rebinds: true);
+				CheckParallelExpr(a.Target, locals, filePath);
+				CheckParallelExpr(a.Value, locals, filePath);
+				if (a.Operator == AssignOp.Assign) NoteParallelStore(a.Target, a.Value, locals);
+				break;
+			case Stmt.ExprStmt { Expression: var e }: CheckParallelExpr(e, locals, filePath); break;
+			case Stmt.Discard { Expression: var e }: CheckParallelExpr(e, locals, filePath); break;
+			case Stmt.Throw { Expression: var e }: CheckParallelExpr(e, locals, filePath); break;
+			case Stmt.Delete { Expression: var e }:
+				CheckParallelWrite(e, locals, "deleted", filePath);
+				if (EffectSummaries.ResolveDelete(_symbols, _typer, e) is { } dtor && EffectSummaries.EffectOf(_symbols, dtor).Statics)
+					ReportParallelStatics("deleting it runs a destructor that", filePath);
+				break;
+			case Stmt.Return:
+				SemanticError.SharedParallelMutation.WithFile(filePath).WithMessage("'return' can't leave a parallel for; every iteration runs to the end of the body").Render();
+				break;
+			case Stmt.Break when depth == 0:
+				SemanticError.SharedParallelMutation.WithFile(filePath).WithMessage("'break' can't leave a parallel for; every iteration runs to the end of the body").Render();
+				break;
+			case Stmt.If { Statement: var s }:
+				CheckParallelExpr(s.Condition, locals, filePath);
+				CheckParallelBlock(s.ThenBranch, locals, depth, filePath);
+				foreach (var elseIf in s.ElseIfBranches) {
+					CheckParallelExpr(elseIf.Condition, locals, filePath);
+					CheckParallelBlock(elseIf.Body, locals, depth, filePath);
+				}
+
+				if (s.ElseBranch is { } elseBranch) CheckParallelBlock(elseBranch, locals, depth, filePath);
+				break;
+			case Stmt.While { Statement: var s }:
+				CheckParallelExpr(s.Condition, locals, filePath);
+				CheckParallelBlock(s.Body, locals, depth + 1, filePath);
+				break;
+			case Stmt.DoWhile { Statement: var s }:
+				CheckParallelBlock(s.Body, locals, depth + 1, filePath);
+				CheckParallelExpr(s.Condition, locals, filePath);
+				break;
+			case Stmt.For { Statement: var s }:
+				CheckParallelStmt(s.Init, locals, depth, filePath);
+				CheckParallelExpr(s.Condition, locals, filePath);
+				CheckParallelExpr(s.Iterator, locals, filePath);
+				CheckParallelBlock(s.Body, locals, depth + 1, filePath);
+				break;
+			case Stmt.ForIn { Statement: var s }:
+				CheckParallelExpr(s.Iterable, locals, filePath);
+				locals[s.Name] = WriteRoot(s.Iterable) ?? "";
+				CheckParallelBlock(s.Body, locals, depth + 1, filePath);
+				break;
+			case Stmt.Switch { Statement: var s }:
+				CheckParallelExpr(s.Expression, locals, filePath);
+				foreach (var c in s.Cases)
+					foreach (var body in c.Body)
+						CheckParallelStmt(body, locals, depth + 1, filePath);
+				break;
+			case Stmt.Join { Tasks: var tasks }:
+				foreach (var task in tasks) CheckParallelExpr(task, locals, filePath);
+				break;
+			case Stmt.BlockStmt { Block: var b }: CheckParallelBlock(b, locals, depth, filePath); break;
+		}
+	}
+
+	private void CheckParallelBlock(Block block, Dictionary<string, string?> locals, int depth, string filePath) {
+		foreach (var stmt in block.Statements)
+			CheckParallelStmt(stmt, locals, depth, filePath);
+	}
+
+	private void CheckParallelExpr(Expression expr, Dictionary<string, string?> locals, string filePath) {
+		switch (expr) {
+			case Expression.Assign a:
+				CheckParallelWrite(a.Target, locals, "assigned", filePath, rebinds: true);
+				CheckParallelExpr(a.Target, locals, filePath);
+				CheckParallelExpr(a.Value, locals, filePath);
+				if (a.Operator == AssignOp.Assign) NoteParallelStore(a.Target, a.Value, locals);
+				break;
+			case Expression.Unary { Operator: UnOp.PreInc or UnOp.PreDec } u:
+				CheckParallelWrite(u.Operand, locals, "incremented", filePath, rebinds: true);
+				break;
+			case Expression.Postfix p:
+				CheckParallelWrite(p.Operand, locals, "incremented", filePath, rebinds: true);
+				break;
+			case Expression.Call call:
+			{
+				var (written, statics) = CallWrites(call);
+				foreach (var (operand, how) in written)
+					CheckParallelWrite(operand, locals, how, filePath);
+				if (statics) ReportParallelStatics(CalleeName(call), filePath);
+				if (call.Callee is Expression.MemberAccess callee) CheckParallelExpr(callee.Target, locals, filePath);
+				foreach (var arg in call.Arguments) CheckParallelExpr(arg, locals, filePath);
+				NoteParallelLinks(written, call.Callee is Expression.MemberAccess ma ? call.Arguments.Prepend(ma.Target) : call.Arguments, locals);
+				break;
+			}
+			case Expression.Unary u: CheckParallelExpr(u.Operand, locals, filePath); break;
+			case Expression.Binary b:
+				CheckParallelExpr(b.Left, locals, filePath);
+				CheckParallelExpr(b.Right, locals, filePath);
+				break;
+			case Expression.MemberAccess ma: CheckParallelExpr(ma.Target, locals, filePath); break;
+			case Expression.Index ix:
+				CheckParallelExpr(ix.Target, locals, filePath);
+				CheckParallelExpr(ix.IndexExpr, locals, filePath);
+				break;
+			case Expression.Cast c: CheckParallelExpr(c.Value, locals, filePath); break;
+			case Expression.Ternary t:
+				CheckParallelExpr(t.Condition, locals, filePath);
+				CheckParallelExpr(t.ThenBranch, locals, filePath);
+				CheckParallelExpr(t.ElseBranch, locals, filePath);
+				break;
+			case Expression.NullCoalesce nc:
+				CheckParallelExpr(nc.Left, locals, filePath);
+				CheckParallelExpr(nc.Right, locals, filePath);
+				break;
+			case Expression.New n:
+			{
+				var (written, statics) = NewWrites(n);
+				foreach (var (operand, how) in written)
+					CheckParallelWrite(operand, locals, how, filePath);
+				if (statics) ReportParallelStatics("its constructor", filePath);
+				if (n.Receiver != null) CheckParallelExpr(n.Receiver, locals, filePath);
+				foreach (var arg in n.Arguments) CheckParallelExpr(arg, locals, filePath);
+				break;
+			}
+			case Expression.ArrayLit al:
+				foreach (var e in al.Elements) CheckParallelExpr(e, locals, filePath);
+				break;
+			case Expression.Tuple tu:
+				foreach (var e in tu.Elements) CheckParallelExpr(e, locals, filePath);
+				break;
+		}
+	}
+
+	// `target` is written by an iteration; fine when it `rebinds` one of the iteration's own
+	// names (an assignment or increment of the bare name), or writes through one whose object
+	// the iteration owns. A target with no named root is fine only when it is built right
+	// there (`new Box().x = 1`); anything else (`f().x = 1`) may reach a shared object.
+	private static void CheckParallelWrite(Expression target, Dictionary<string, string?> locals, string how, string filePath, bool rebinds = false) {
+		var root = WriteRoot(target);
+		if (root == null) {
+			if (UnnamedWriteBase(target) is Expression.New or Expression.NewArray) return;
+			SemanticError.SharedParallelMutation.WithFile(filePath).WithMessage($"the object {how} here isn't reached through a name the parallel for's body binds, so it may be one another iteration reaches too; bind it to a local first").Render();
+			return;
+		}
+		if (rebinds && target is Expression.Identifier && locals.ContainsKey(root)) return;
+
+		// Follow the body's aliases back to an owned object or to the shared one.
+		var shared = root;
+		var seen = new HashSet<string>();
+		while (locals.TryGetValue(shared, out var source)) {
+			if (source == null) return;
+			if (source == "" || !seen.Add(shared)) {
+				shared = "";
+				break;
+			}
+
+			shared = source;
+		}
+
+		var error = SemanticError.SharedParallelMutation.WithFile(filePath);
+		if (shared == root) {
+			var what = root == "this" ? "'this'" : $"'{root}'";
+			error.WithMessage($"{what} is shared by every iteration of the parallel for and can't be {how} in its body; only objects the body creates itself can").Render();
+		}
+		else if (shared == "") {
+			error.WithMessage($"'{root}' may reach an object another iteration also reaches (array elements can alias each other), so it can't be {how} in the parallel for's body; only objects the body creates itself can").Render();
+		}
+		else {
+			var what = shared == "this" ? "'this'" : $"'{shared}'";
+			error.WithMessage($"'{root}' refers into {what}, which is shared by every iteration of the parallel for, so it can't be {how} in its body; only objects the body creates itself can").Render();
+		}
+	}
+
+	// The operands of `call` it may write: the receiver of an instance method, and the
+	// arguments to `Type&` / `Type!` parameters.
+	// The expression an lvalue chain with no named root starts from: `f()` for `f().a[i]`.
+	private static Expression UnnamedWriteBase(Expression target) => target switch {
+		Expression.MemberAccess ma => UnnamedWriteBase(ma.Target),
+		Expression.MetaAccess ma => UnnamedWriteBase(ma.Target),
+		Expression.Index ix => UnnamedWriteBase(ix.Target),
+		_ => target
+	};
+
+	private static void ReportParallelStatics(string what, string filePath) =>
+		SemanticError.SharedParallelMutation.WithFile(filePath).WithMessage($"{what} may write a static field, which every iteration of the parallel for shares").Render();
+
+	// After a call passes the write check: an owned object the call may write may now hold
+	// any other operand, as after `NoteParallelStore`.
+	private void NoteParallelLinks(List<(Expression Operand, string How)> written, IEnumerable<Expression> operands, Dictionary<string, string?> locals) {
+		var shared = operands.Where(o => !IsValueOperand(o)).Select(ParallelLocalSource).FirstOrDefault(source => source != null);
+		if (shared == null) return;
+		foreach (var (operand, _) in written)
+			if (WriteRoot(operand) is { } root && root != shared && locals.TryGetValue(root, out var current) && current == null)
+				locals[root] = shared;
+	}
+
+	// The operands `call` may write — its receiver, and the arguments its callee's
+	// `Type&` / `Type!` parameters or body may write — and whether it may write a static field.
+	private (List<(Expression Operand, string How)> Written, bool Statics) CallWrites(Expression.Call call) {
+		var callee = EffectSummaries.ResolveCall(_symbols, _typer, call, _currentTypeFqn);
+		var receiver = call.Callee switch {
+			Expression.MemberAccess member => member.Target,
+			Expression.Identifier => new Expression.This(call.Span),
+			_ => null
+		};
+		return OperandWrites(callee, receiver, call.Arguments, "the receiver of a call that may write it");
+	}
+
+	// The same for `new`: the outer instance an inner class's constructor is given, and the
+	// arguments. The object under construction is the iteration's own.
+	private (List<(Expression Operand, string How)> Written, bool Statics) NewWrites(Expression.New n) {
+		var callee = EffectSummaries.ResolveNew(_symbols, _typer, n);
+		return OperandWrites(callee, n.Receiver ?? new Expression.This(n.Span), n.Arguments, "the outer instance of an inner class whose constructor may write it");
+	}
+
+	private (List<(Expression Operand, string How)> Written, bool Statics) OperandWrites(Callee callee, Expression? receiver, List<Expression> args, string receiverHow) {
+		var effect = EffectSummaries.EffectOf(_symbols, callee);
+		var written = new List<(Expression Operand, string How)>();
+		if (effect.Receiver && receiver != null && !IsValueOperand(receiver)) written.Add((receiver, receiverHow));
+		for (var i = 0; i < args.Count; i++) {
+			if (!effect.WritesParam(i) || IsValueOperand(args[i])) continue;
+			var declared = (callee.Declared & WriteEffect.Bit(i)) != 0;
+			written.Add((args[i], declared ? "passed to a 'Type&' / 'Type!' parameter" : "passed to a call that may write it"));
+		}
+
+		return (written, effect.Statics);
+	}
+
+	private bool IsValueOperand(Expression e) => _typer.InferType(e) is { } type && EffectSummaries.IsValueType(_symbols, type);
+
+	private static string CalleeName(Expression.Call call) => call.Callee switch {
+		Expression.MemberAccess ma => $"'{ma.Member}'",
+		Expression.MetaAccess ma => $"'{ma.Member}'",
+		Expression.Identifier id => $"'{id.Name}'",
+		_ => "the called function"
+	};
+
+	// `join { spawn ...; }`: the tasks run concurrently, so an object one task may write — its
+	// receiver, or an argument its callee may write (`CallWrites`) — can't be reachable from
+	// any other task, under its own name or an alias (`ObjectNames`), and no task may write a
+	// static field another could read. Arguments are evaluated before the tasks start, so
+	// sharing plain values and objects nobody writes is fine. An operand with no name of its
+	// own (`a.get()`) stands for every name it is computed from.
+	private void CheckJoinTasks(List<Expression> tasks, string filePath) {
+		var written = new List<(int Task, string Root, string How)>();
+		var used = new List<(int Task, string Root)>();
+		for (var i = 0; i < tasks.Count; i++) {
+			if (tasks[i] is not Expression.Call call) continue;
+			var (writes, statics) = CallWrites(call);
+			foreach (var (operand, how) in writes)
+				foreach (var root in OperandRoots(operand))
+					written.Add((i, root, how));
+			if (statics && tasks.Count > 1)
+				SemanticError.SharedParallelMutation.WithFile(filePath).WithMessage($"spawned task {i} calls {CalleeName(call)}, which may write a static field the other tasks of the join can reach").Render();
+			var operands = call.Callee switch {
+				Expression.MemberAccess ma => call.Arguments.Prepend(ma.Target),
+				Expression.Identifier => call.Arguments.Prepend(new Expression.This(call.Span)),
+				_ => call.Arguments
+			};
+			foreach (var operand in operands)
+				foreach (var root in OperandRoots(operand))
+					used.Add((i, root));
+		}
+
+		foreach (var (task, root, how) in written) {
+			var names = ObjectNames(root);
+			var clash = used.FindIndex(u => u.Task != task && names.Overlaps(ObjectNames(u.Root)));
+			if (clash < 0) continue;
+			var (other, otherRoot) = used[clash];
+			var what = root == "this" ? "'this'" : $"'{root}'";
+			var message = otherRoot == root
+				? $"{what} is {how} in spawned task {task} and used by another task of the same join"
+				: $"{what} is {how} in spawned task {task}, and task {other} of the same join uses '{otherRoot}', which may refer to the same object";
+			SemanticError.SharedParallelMutation.WithFile(filePath).WithMessage(message).Render();
+		}
+	}
+
+	// The names `operand`'s object may be reached through: its `WriteRoot`, or for a computed
+	// value every name it is computed from. A `new` object is reachable by none.
+	private static IEnumerable<string> OperandRoots(Expression operand) {
+		if (WriteRoot(operand) is { } root) return [root];
+		return operand switch {
+			Expression.Call call => (call.Callee is Expression.MemberAccess ma ? call.Arguments.Prepend(ma.Target) : call.Arguments.Prepend(new Expression.This(call.Span))).SelectMany(OperandRoots),
+			Expression.Cast c => OperandRoots(c.Value),
+			Expression.Ternary t => OperandRoots(t.ThenBranch).Concat(OperandRoots(t.ElseBranch)),
+			Expression.NullCoalesce nc => OperandRoots(nc.Left).Concat(OperandRoots(nc.Right)),
+			Expression.MemberAccess ma => OperandRoots(ma.Target),
+			Expression.Index ix => OperandRoots(ix.Target),
+			Expression.ArrayLit al => al.Elements.SelectMany(OperandRoots),
+			Expression.Tuple tu => tu.Elements.SelectMany(OperandRoots),
+			_ => []
+		};
+	}
+
+	// `root` and every name that may refer to the same object or into it: its alias group,
+	// the objects it was taken from (`_localRoots`), transitively, and "this" for a field.
+	private HashSet<string> ObjectNames(string root) {
+		var names = new HashSet<string> { root };
+		var pending = new Stack<string>();
+		pending.Push(root);
+		while (pending.TryPop(out var name)) {
+			var isLocal = _typer.TryGetLocalType(name, out _);
+			if (!isLocal && name != "this" && !string.IsNullOrEmpty(_currentTypeFqn) && _symbols.Fields.TryGetValue(_currentTypeFqn, out var fields) && fields.Any(f => f.Name == name))
+				names.Add("this");
+			if (_aliasGroups.TryGetValue(isLocal ? $"local:{name}" : $"field:{name}", out var group))
+				foreach (var key in group)
+					if (names.Add(key[6..])) pending.Push(key[6..]);
+			if (_localRoots.TryGetValue(name, out var from) && names.Add(from)) pending.Push(from);
+		}
+
+		return names;
+	}
+
+	// Left-most name of an lvalue chain: `a` for `a.b[i].c`, "this" for `this.x`.
+	private static string? WriteRoot(Expression target) => target switch {
+		Expression.Identifier id => id.Name,
+		Expression.This => "this",
+		Expression.MemberAccess ma => WriteRoot(ma.Target),
+		Expression.MetaAccess ma => WriteRoot(ma.Target),
+		Expression.Index ix => WriteRoot(ix.Target),
+		_ => null
+	};
+
 	private static HashSet<string> UnionAll(List<HashSet<string>> states) {
 		var merged = new HashSet<string>();
 		foreach (var s in states) merged.UnionWith(s);
@@ -2028,6 +2685,8 @@ public class SemanticAnalyzer {
 		// Apply transfer-tombstoning: parameter at user-position i corresponds to
 		// matching.ParamOwnership[i + hiddenSlots]. Slice the ownership list to align.
 		var userOwnership = matching.ParamOwnership.Skip(hiddenSlots).ToList();
+		CheckExclusiveTransfers(userOwnership, n.Arguments, null, filePath);
+		CheckRegionTransfers(userOwnership, n.Arguments, filePath);
 		ApplyTransferTombstones(userOwnership, n.Arguments);
 		CheckTemporaryLeaks(userOwnership, n.Arguments, filePath);
 	}
@@ -2108,6 +2767,9 @@ public class SemanticAnalyzer {
 				SemanticError.VisibilityViolation.WithFile(filePath).WithMessage($"method '{calleeName}' is {VisibilityWord(overload.Visibility)} on '{overload.OwnerClass}' and not accessible from this scope").Render();
 			}
 
+			var receiver = overload.IsStatic ? null : call.Callee is Expression.MemberAccess member ? member.Target : new Expression.This(call.Span);
+			CheckExclusiveTransfers(overload.ParamOwnership, call.Arguments, receiver, filePath);
+			CheckRegionTransfers(overload.ParamOwnership, call.Arguments, filePath);
 			ApplyTransferTombstones(overload.ParamOwnership, call.Arguments);
 			CheckTemporaryLeaks(overload.ParamOwnership, call.Arguments, filePath);
 			return;
@@ -2193,10 +2855,18 @@ public class SemanticAnalyzer {
 		// flat `Named("i32[]")`) so the CIR lowering produces a `CirType.Array` and the
 		// LLVM emitter knows to use the slice runtime / element-aware GEPs.
 		_typer.DeclareLocal(d.Name, canonName);
-		var canonical = new TypeExpression(BuildBaseTypeFromCanonical(canonName), Nullable: false, Ownership: null, d.Span);
-		InferredVarTypes[d.Span] = canonical;
+		InferredVarTypes[d.Span] = InferredType(canonName, d.Span);
 	}
 
+	// The declared type an inferred `let` gets, and back: the canonical name it was built from.
+	internal static TypeExpression InferredType(string canonName, TokenSpan span) => new(BuildBaseTypeFromCanonical(canonName), Nullable: false, Ownership: null, span);
+
+	internal static string InferredCanonical(TypeExpression type) => type.Base switch {
+		BaseType.Array array => InferredCanonical(array.ElementType) + "[]",
+		BaseType.Named named => named.Name,
+		var other => throw new ArgumentException($"not an inferred type: {other}")
+	};
+
 	// Convert a canonical-form type string back to a `BaseType` tree. Handles the
 	// trailing-`[]` array-wrapping recursively so multi-dimensional arrays (`i32[][]`)
 	// also lower correctly. Uses a fresh `TokenSpan()` for inner nodes — we don't carry
@@ -2207,4 +2877,19 @@ public class SemanticAnalyzer {
 			return new BaseType.Array(new TypeExpression(BuildBaseTypeFromCanonical(canon[..^2]), Nullable: false, Ownership: (OwnershipModifier?) null, new TokenSpan()));
 		return new BaseType.Named(canon);
 	}
-}
\ No newline at end of file
+}
+
+// One unit's share of `InferDeclarations`: the diagnostics it logged, as rendered, and the
+// types it inferred for untyped declarations, keyed by the declarations' spans in its tree.
+public sealed record UnitAnalysis(string Log, IReadOnlyList<KeyValuePair<TokenSpan, TypeExpression>> InferredVarTypes);
+
+// Span equality by file and source offsets rather than by reference: a span rebuilt from the
+// build cache keys the same declaration as the span of a fresh parse of the same file.
+public sealed class SpanPosition : IEqualityComparer<TokenSpan> {
+	public static readonly SpanPosition Comparer = new();
+
+	public bool Equals(TokenSpan? x, TokenSpan? y) =>
+		ReferenceEquals(x, y) || x != null && y != null && x.Start == y.Start && x.End == y.End && x.File?.Path == y.File?.Path;
+
+	public int GetHashCode(TokenSpan span) => HashCode.Combine(span.Start, span.End, span.File?.Path);
+}
@@ -5,6 +5,8 @@
 // Use, modification, and distribution of this file are governed by the
 // license terms provided with the Cloth Compiler source distribution.
 
+using FrontEnd.Error;
+
 namespace Compiler.Semantics;
 
 public class SemanticError : Exception {
@@ -69,6 +71,13 @@ public class SemanticError : Exception {
 	public static readonly SemanticError EnumCaseNonConst = new("S02D", "enum case argument is not a compile-time constant", true);
 	public static readonly SemanticError DuplicateEnumCase = new("S02E", "duplicate enum case name", true);
 	public static readonly SemanticError NonExhaustiveSwitch = new("S02F", "switch over an enum-typed value is not exhaustive", true);
+	public static readonly SemanticError InvalidUnchecked = new("S030", "invalid @Unchecked annotation", true);
+	public static readonly SemanticError InvalidRegion = new("S031", "invalid @Region annotation", true);
+	public static readonly SemanticError RegionEscape = new("S032", "region-owned value escapes its @Region function", true);
+	public static readonly SemanticError NonExclusiveTransfer = new("S033", "transferred value is still reachable from the call", true);
+	public static readonly SemanticError InvalidBench = new("S034", "invalid @Bench annotation", true);
+	public static readonly SemanticError SharedParallelMutation = new("S035", "parallel code mutates state its other iterations or tasks can reach", true);
+	public static readonly SemanticError InvalidCompact = new("S036", "invalid @Compact annotation", true);
 
 	public SemanticError WithMessage(string message) => new(_code, _label, _willExit, message, _file);
 
@@ -79,14 +88,15 @@ public class SemanticError : Exception {
 	public SemanticError WithSeverity(bool willExit) => new(_code, _label, willExit, _message, _file);
 
 	public SemanticError Render() {
+		var output = FatalErrors.Output;
 		var type = _willExit ? "Error" : "Warning";
-		Console.Error.WriteLine($"{type}[{_code}]: {_label}");
+		output.WriteLine($"{type}[{_code}]: {_label}");
 		if (_file != null)
-			Console.Error.WriteLine($"  --> {_file}");
+			output.WriteLine($"  --> {_file}");
 		if (_message != null)
-			Console.Error.WriteLine($"  = note: {_message}");
+			output.WriteLine($"  = note: {_message}");
 		if (_willExit)
-			Environment.Exit(1);
+			FatalErrors.Exit(1);
 		return this;
 	}
 }
\ No newline at end of file
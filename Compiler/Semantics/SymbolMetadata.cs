@@ -0,0 +1,506 @@
+// Copyright (c) 2026.The Cloth contributors.
+//
+// SymbolMetadata.cs is part of the Cloth Compiler.
+//
+// Use, modification, and distribution of this file are governed by the
+// license terms provided with the Cloth Compiler source distribution.
+
+using System.Text;
+using FrontEnd.Parser.AST;
+using FrontEnd.Parser.AST.Expressions;
+using FrontEnd.Parser.AST.Type;
+using FrontEnd.Token;
+
+namespace Compiler.Semantics;
+
+// Precompiled interface of a library: the SymbolRegistry entries its own units declared,
+// written by `BuildLibrary` next to the installed `.lib` and loaded by dependent builds in
+// place of re-lexing and re-parsing the library's sources. Everything is stored post-
+// canonicalization, so loading is a straight copy into the registry dictionaries.
+//
+// Global numbering (interface IDs, vtable slot IDs, VtableSize) depends on the consumer's
+// own interfaces, so it is NOT stored: each class keeps only its resolved parent and
+// implements list, and `SymbolRegistry.AssignVtableLayouts` rebuilds its slots exactly as
+// it would from source. What is stored is where each slot sits in the library's compiled
+// vtable rows (`SlotPositions`, by slot key), which the consumer must reproduce.
+//
+// Entries are written in registry insertion order so a metadata-fed build registers symbols
+// in the same order a source-fed one does.
+//
+// Parse-tree payloads the registry carries — enum case arguments and trait element
+// defaults — are stored as expressions over literals, names, member access, and unary and
+// binary operators, with empty spans. Enum case arguments never leave that set (S02D). A
+// trait default that does sets `RequiresSources`, and the library then publishes no
+// metadata, so its dependents parse its sources instead.
+//
+// Each local function's write effect (`Effects`, see `EffectSummaries`) is stored too, so a
+// consumer's race check sees what calls into the library write without its bodies.
+public sealed class SymbolMetadata {
+	public const string FileName = "cloth.meta";
+
+	// Bumped whenever the layout below changes; readers reject other versions and the
+	// caller falls back to parsing the library's sources.
+	private const int FormatVersion = 4;
+	private static readonly byte[] Magic = "CLMD"u8.ToArray();
+
+	public List<(string Fqn, ClassInfo Info, string? ParentFqn, List<string> Implements)> Classes { get; } = new();
+	public List<(string Fqn, InterfaceInfo Info)> Interfaces { get; } = new();
+	public List<(string Fqn, TraitInfo Info)> Traits { get; } = new();
+	public List<(string Fqn, EnumInfo Info)> Enums { get; } = new();
+	public List<(string OwnerFqn, List<FieldInfo> Fields)> Fields { get; } = new();
+	public List<(string OwnerFqn, List<ConstructorInfo> Constructors)> Constructors { get; } = new();
+	public List<(string MethodFqn, List<MethodOverload> Overloads)> Overloads { get; } = new();
+	public List<(string SlotKey, int Position)> SlotPositions { get; } = new();
+	public List<(string Symbol, WriteEffect Effect)> Effects { get; } = new();
+
+	// Some payload can't be stored (see above), so this must not be published.
+	public bool RequiresSources { get; private set; }
+
+	// The dependency this was loaded for, named in diagnostics. Set by the loader, not stored.
+	public string? Library { get; set; }
+
+	// Snapshot every symbol the registry's local (non-extern) units declared. `slotPositions`
+	// maps each global slot ID to its position in the emitted vtable rows.
+	public static SymbolMetadata FromRegistry(SymbolRegistry symbols, Func<int, int> slotPositions) {
+		var meta = new SymbolMetadata();
+		var localTypes = new HashSet<string>();
+
+		foreach (var (fqn, info) in symbols.Classes) {
+			if (info.IsExtern) continue;
+			localTypes.Add(fqn);
+			var layout = symbols.ClassVtables.GetValueOrDefault(fqn);
+			meta.Classes.Add((fqn, info, layout?.ParentClassFqn, layout?.ImplementedInterfaceFqns ?? []));
+		}
+
+		foreach (var (fqn, info) in symbols.Interfaces)
+			if (!info.IsExtern) meta.Interfaces.Add((fqn, info));
+		foreach (var (fqn, info) in symbols.Traits) {
+			if (info.IsExtern) continue;
+			meta.Traits.Add((fqn, info));
+			meta.RequiresSources |= info.Elements.Any(e => e.Default != null && !IsStorable(e.Default));
+		}
+
+		foreach (var (fqn, info) in symbols.Enums) {
+			if (info.IsExtern) continue;
+			localTypes.Add(fqn);
+			meta.Enums.Add((fqn, info));
+		}
+
+		foreach (var (owner, fields) in symbols.Fields)
+			if (localTypes.Contains(owner)) meta.Fields.Add((owner, fields));
+		foreach (var (owner, ctors) in symbols.Constructors)
+			if (localTypes.Contains(owner)) meta.Constructors.Add((owner, ctors));
+		foreach (var (methodFqn, overloads) in symbols.Overloads) {
+			var local = overloads.Where(o => !o.IsCrossProject).ToList();
+			if (local.Count > 0) meta.Overloads.Add((methodFqn, local));
+		}
+
+		foreach (var (key, slot) in symbols.InterfaceMethodSlots)
+			if (!symbols.ExternSlotKeys.Contains(key)) meta.SlotPositions.Add((key, slotPositions(slot)));
+
+		// Write effects of the local functions: methods, constructors (declared or implicit)
+		// and destructors.
+		var effectKeys = meta.Overloads.SelectMany(entry => entry.Overloads).Select(o => o.MangledSymbol)
+			.Concat(meta.Constructors.SelectMany(entry => entry.Constructors).Select(c => c.MangledSymbol))
+			.Concat(meta.Classes.SelectMany(c => new[] { EffectSummaries.ImplicitConstructorKey(c.Fqn), EffectSummaries.DestructorKey(c.Fqn) }));
+		foreach (var key in effectKeys.Distinct())
+			if (symbols.Effects.TryGetValue(key, out var effect)) meta.Effects.Add((key, effect));
+
+		return meta;
+	}
+
+	public void Write(string path) {
+		Directory.CreateDirectory(Path.GetDirectoryName(path)!);
+		using var stream = File.Create(path);
+		Write(stream);
+	}
+
+	// Serialize to `stream`, left open. Two registries with the same local signatures write
+	// the same bytes, which `AnalysisContext` relies on to fingerprint a project's declarations.
+	public void Write(Stream stream) {
+		using var w = new BinaryWriter(stream, Encoding.UTF8, leaveOpen: true);
+		w.Write(Magic);
+		w.Write(FormatVersion);
+
+		w.Write(Classes.Count);
+		foreach (var (fqn, info, parent, implements) in Classes) {
+			w.Write(fqn);
+			w.Write((byte)info.Visibility);
+			w.Write(info.OwnerModule);
+			w.Write(info.IsInner);
+			w.Write(info.OuterClassFqn);
+			w.Write(info.IsPrototype);
+			WriteNullable(w, parent);
+			WriteStrings(w, implements);
+		}
+
+		w.Write(Interfaces.Count);
+		foreach (var (fqn, info) in Interfaces) {
+			w.Write(fqn);
+			w.Write((byte)info.Visibility);
+			w.Write(info.OwnerModule);
+			WriteStrings(w, info.Extends);
+			w.Write(info.Methods.Count);
+			foreach (var sig in info.Methods) {
+				w.Write(sig.Name);
+				WriteStrings(w, sig.ParamTypes);
+				WriteOwnership(w, sig.ParamOwnership);
+				w.Write(sig.ReturnType);
+				w.Write(sig.HasDefaultBody);
+				w.Write((byte)sig.Visibility);
+			}
+		}
+
+		w.Write(Traits.Count);
+		foreach (var (fqn, info) in Traits) {
+			w.Write(fqn);
+			w.Write((byte)info.Visibility);
+			w.Write(info.OwnerModule);
+			w.Write(info.Elements.Count);
+			foreach (var elem in info.Elements) {
+				w.Write(elem.Name);
+				w.Write(elem.CanonicalType);
+				WriteExpression(w, elem.Default);
+			}
+		}
+
+		w.Write(Enums.Count);
+		foreach (var (fqn, info) in Enums) {
+			w.Write(fqn);
+			w.Write((byte)info.Visibility);
+			w.Write(info.OwnerModule);
+			w.Write(info.Parameters.Count);
+			foreach (var p in info.Parameters) {
+				w.Write(p.Name);
+				w.Write(p.CanonicalType);
+				w.Write((byte)p.Visibility);
+			}
+
+			w.Write(info.Cases.Count);
+			foreach (var c in info.Cases) {
+				w.Write(c.Name);
+				w.Write(c.Ordinal);
+				w.Write(c.ArgExprs.Count);
+				foreach (var arg in c.ArgExprs) WriteExpression(w, arg);
+			}
+		}
+
+		w.Write(Fields.Count);
+		foreach (var (owner, fields) in Fields) {
+			w.Write(owner);
+			w.Write(fields.Count);
+			foreach (var f in fields) {
+				w.Write(f.Name);
+				w.Write(f.CanonicalType);
+				w.Write((byte)f.Visibility);
+				w.Write(f.IsStatic);
+				w.Write(f.IsConst);
+				w.Write(f.OwnerClass);
+			}
+		}
+
+		w.Write(Constructors.Count);
+		foreach (var (owner, ctors) in Constructors) {
+			w.Write(owner);
+			w.Write(ctors.Count);
+			foreach (var c in ctors) {
+				WriteStrings(w, c.ParamTypes);
+				WriteOwnership(w, c.ParamOwnership);
+				w.Write((byte)c.Visibility);
+				w.Write(c.OwnerClass);
+				w.Write(c.OwnerModule);
+				w.Write(c.MangledSymbol);
+			}
+		}
+
+		w.Write(Overloads.Count);
+		foreach (var (methodFqn, overloads) in Overloads) {
+			w.Write(methodFqn);
+			w.Write(overloads.Count);
+			foreach (var o in overloads) {
+				w.Write(o.MangledSymbol);
+				WriteStrings(w, o.ParamTypes);
+				WriteOwnership(w, o.ParamOwnership);
+				w.Write(o.ReturnType);
+				w.Write(o.IsExtern);
+				w.Write((byte)o.Visibility);
+				w.Write(o.OwnerClass);
+				w.Write(o.OwnerModule);
+				w.Write(o.IsStatic);
+				w.Write(o.IsPrototype);
+			}
+		}
+
+		w.Write(SlotPositions.Count);
+		foreach (var (key, position) in SlotPositions) {
+			w.Write(key);
+			w.Write(position);
+		}
+
+		w.Write(Effects.Count);
+		foreach (var (symbol, effect) in Effects) {
+			w.Write(symbol);
+			w.Write(effect.Receiver);
+			w.Write(effect.Params);
+			w.Write(effect.Statics);
+		}
+	}
+
+	// Load a metadata file as seen from a consumer: every type is marked extern and every
+	// overload cross-project, matching what `SymbolRegistry.Build` records for extern units.
+	// Returns null when the file is missing, unreadable, corrupt, or from another format
+	// version, and the caller falls back to the library's sources.
+	public static SymbolMetadata? TryRead(string path) {
+		if (!File.Exists(path)) return null;
+		try {
+			using var stream = File.OpenRead(path);
+			using var r = new BinaryReader(stream, Encoding.UTF8);
+			if (!r.ReadBytes(Magic.Length).AsSpan().SequenceEqual(Magic) || r.ReadInt32() != FormatVersion) return null;
+			var meta = Read(r);
+			return stream.Position == stream.Length ? meta : null;
+		}
+		catch (Exception e) when (e is IOException or InvalidDataException or FormatException or UnauthorizedAccessException) {
+			return null;
+		}
+	}
+
+	private static SymbolMetadata Read(BinaryReader r) {
+		var meta = new SymbolMetadata();
+		var emptySpan = new TokenSpan();
+
+		for (int i = 0, n = r.ReadInt32(); i < n; i++) {
+			var fqn = r.ReadString();
+			var visibility = (Visibility)r.ReadByte();
+			var ownerModule = r.ReadString();
+			var isInner = r.ReadBoolean();
+			var outerFqn = r.ReadString();
+			var isPrototype = r.ReadBoolean();
+			var parent = ReadNullable(r);
+			var implements = ReadStrings(r);
+			meta.Classes.Add((fqn, new ClassInfo(visibility, ownerModule, IsExtern: true, isInner, outerFqn, isPrototype), parent, implements));
+		}
+
+		for (int i = 0, n = r.ReadInt32(); i < n; i++) {
+			var fqn = r.ReadString();
+			var visibility = (Visibility)r.ReadByte();
+			var ownerModule = r.ReadString();
+			var extends = ReadStrings(r);
+			var methods = new List<InterfaceMethodSig>();
+			for (int j = 0, m = r.ReadInt32(); j < m; j++) {
+				var name = r.ReadString();
+				var paramTypes = ReadStrings(r);
+				var ownership = ReadOwnership(r);
+				var returnType = r.ReadString();
+				var hasDefault = r.ReadBoolean();
+				methods.Add(new InterfaceMethodSig(name, paramTypes, ownership, returnType, hasDefault, (Visibility)r.ReadByte(), emptySpan));
+			}
+
+			meta.Interfaces.Add((fqn, new InterfaceInfo(visibility, ownerModule, IsExtern: true, methods, extends)));
+		}
+
+		for (int i = 0, n = r.ReadInt32(); i < n; i++) {
+			var fqn = r.ReadString();
+			var visibility = (Visibility)r.ReadByte();
+			var ownerModule = r.ReadString();
+			var elements = new List<TraitElementInfo>();
+			for (int j = 0, m = r.ReadInt32(); j < m; j++) {
+				var name = r.ReadString();
+				var canonical = r.ReadString();
+				elements.Add(new TraitElementInfo(name, canonical, ReadExpression(r, emptySpan), emptySpan));
+			}
+
+			meta.Traits.Add((fqn, new TraitInfo(visibility, ownerModule, IsExtern: true, elements)));
+		}
+
+		for (int i = 0, n = r.ReadInt32(); i < n; i++) {
+			var fqn = r.ReadString();
+			var visibility = (Visibility)r.ReadByte();
+			var ownerModule = r.ReadString();
+			var parameters = new List<EnumParameter>();
+			for (int j = 0, m = r.ReadInt32(); j < m; j++)
+				parameters.Add(new EnumParameter(r.ReadString(), r.ReadString(), (Visibility)r.ReadByte()));
+			var cases = new List<EnumCaseInfo>();
+			for (int j = 0, m = r.ReadInt32(); j < m; j++) {
+				var name = r.ReadString();
+				var ordinal = r.ReadInt32();
+				var args = new List<Expression>();
+				for (int k = 0, a = r.ReadInt32(); k < a; k++) args.Add(ReadExpression(r, emptySpan) ?? throw new InvalidDataException("missing enum case argument"));
+				cases.Add(new EnumCaseInfo(name, ordinal, args));
+			}
+
+			meta.Enums.Add((fqn, new EnumInfo(visibility, ownerModule, IsExtern: true, parameters, cases)));
+		}
+
+		for (int i = 0, n = r.ReadInt32(); i < n; i++) {
+			var owner = r.ReadString();
+			var fields = new List<FieldInfo>();
+			for (int j = 0, m = r.ReadInt32(); j < m; j++)
+				fields.Add(new FieldInfo(r.ReadString(), r.ReadString(), (Visibility)r.ReadByte(), r.ReadBoolean(), r.ReadBoolean(), r.ReadString()));
+			meta.Fields.Add((owner, fields));
+		}
+
+		for (int i = 0, n = r.ReadInt32(); i < n; i++) {
+			var owner = r.ReadString();
+			var ctors = new List<ConstructorInfo>();
+			for (int j = 0, m = r.ReadInt32(); j < m; j++)
+				ctors.Add(new ConstructorInfo(ReadStrings(r), ReadOwnership(r), (Visibility)r.ReadByte(), r.ReadString(), r.ReadString(), r.ReadString()));
+			meta.Constructors.Add((owner, ctors));
+		}
+
+		for (int i = 0, n = r.ReadInt32(); i < n; i++) {
+			var methodFqn = r.ReadString();
+			var overloads = new List<MethodOverload>();
+			for (int j = 0, m = r.ReadInt32(); j < m; j++) {
+				var symbol = r.ReadString();
+				var paramTypes = ReadStrings(r);
+				var ownership = ReadOwnership(r);
+				var returnType = r.ReadString();
+				var isExtern = r.ReadBoolean();
+				var visibility = (Visibility)r.ReadByte();
+				var ownerClass = r.ReadString();
+				var ownerModule = r.ReadString();
+				var isStatic = r.ReadBoolean();
+				var isPrototype = r.ReadBoolean();
+				overloads.Add(new MethodOverload(symbol, paramTypes, ownership, returnType, isExtern, IsCrossProject: true, visibility, ownerClass, ownerModule, isStatic, isPrototype));
+			}
+
+			meta.Overloads.Add((methodFqn, overloads));
+		}
+
+		for (int i = 0, n = r.ReadInt32(); i < n; i++)
+			meta.SlotPositions.Add((r.ReadString(), r.ReadInt32()));
+		for (int i = 0, n = r.ReadInt32(); i < n; i++)
+			meta.Effects.Add((r.ReadString(), new WriteEffect(r.ReadBoolean(), r.ReadUInt64(), r.ReadBoolean())));
+
+		return meta;
+	}
+
+	private static void WriteStrings(BinaryWriter w, List<string> values) {
+		w.Write(values.Count);
+		foreach (var v in values) w.Write(v);
+	}
+
+	private static List<string> ReadStrings(BinaryReader r) {
+		var count = ReadCount(r);
+		var values = new List<string>(count);
+		for (var i = 0; i < count; i++) values.Add(r.ReadString());
+		return values;
+	}
+
+	private static void WriteNullable(BinaryWriter w, string? value) {
+		w.Write(value != null);
+		if (value != null) w.Write(value);
+	}
+
+	private static string? ReadNullable(BinaryReader r) => r.ReadBoolean() ? r.ReadString() : null;
+
+	// A list length that presizes a list: every entry takes at least a byte, so one larger
+	// than what's left of the file is corruption, not a reason to allocate.
+	private static int ReadCount(BinaryReader r) {
+		var count = r.ReadInt32();
+		if (count < 0 || count > r.BaseStream.Length - r.BaseStream.Position) throw new InvalidDataException($"bad list length {count}");
+		return count;
+	}
+
+	// Ownership per parameter: 0 = borrow (null), otherwise `OwnershipModifier + 1`.
+	private static void WriteOwnership(BinaryWriter w, List<OwnershipModifier?> values) {
+		w.Write(values.Count);
+		foreach (var v in values) w.Write((byte)(v is { } o ? (int)o + 1 : 0));
+	}
+
+	private static List<OwnershipModifier?> ReadOwnership(BinaryReader r) {
+		var count = ReadCount(r);
+		var values = new List<OwnershipModifier?>(count);
+		for (var i = 0; i < count; i++) {
+			var b = r.ReadByte();
+			values.Add(b == 0 ? null : (OwnershipModifier)(b - 1));
+		}
+
+		return values;
+	}
+
+	// Whether `WriteExpression` can store `expr` whole.
+	private static bool IsStorable(Expression expr) => expr switch {
+		Expression.Literal or Expression.Identifier => true,
+		Expression.Unary u => IsStorable(u.Operand),
+		Expression.Binary b => IsStorable(b.Left) && IsStorable(b.Right),
+		Expression.MemberAccess ma => IsStorable(ma.Target),
+		Expression.MetaAccess ma => IsStorable(ma.Target),
+		_ => false
+	};
+
+	// Tag byte: 0 = none, 1..8 = literal kind, 9 = unary, 10 = binary, 11 = identifier,
+	// 12 = member access, 13 = meta access, 14 = anything else. A file holding 14 comes from
+	// a `RequiresSources` library and fails to load, so the consumer reads the sources.
+	private static void WriteExpression(BinaryWriter w, Expression? value) {
+		switch (value) {
+			case null: w.Write((byte)0); break;
+			case Expression.Literal { Value: Literal.Int i }: w.Write((byte)1); w.Write(i.Value); break;
+			case Expression.Literal { Value: Literal.Float f }: w.Write((byte)2); w.Write(f.Value); break;
+			case Expression.Literal { Value: Literal.Bool b }: w.Write((byte)3); w.Write(b.Value); break;
+			case Expression.Literal { Value: Literal.Char c }: w.Write((byte)4); w.Write(c.Value); break;
+			case Expression.Literal { Value: Literal.Str s }: w.Write((byte)5); w.Write(s.Value); break;
+			case Expression.Literal { Value: Literal.Bit bit }: w.Write((byte)6); w.Write(bit.Value); break;
+			case Expression.Literal { Value: Literal.Null }: w.Write((byte)7); break;
+			case Expression.Literal { Value: Literal.Nan }: w.Write((byte)8); break;
+			case Expression.Unary u:
+				w.Write((byte)9);
+				w.Write((byte)u.Operator);
+				WriteExpression(w, u.Operand);
+				break;
+			case Expression.Binary b:
+				w.Write((byte)10);
+				WriteExpression(w, b.Left);
+				w.Write((byte)b.Operator);
+				WriteExpression(w, b.Right);
+				break;
+			case Expression.Identifier id: w.Write((byte)11); w.Write(id.Name); break;
+			case Expression.MemberAccess ma:
+				w.Write((byte)12);
+				WriteExpression(w, ma.Target);
+				w.Write(ma.Member);
+				break;
+			case Expression.MetaAccess ma:
+				w.Write((byte)13);
+				WriteExpression(w, ma.Target);
+				w.Write(ma.Member);
+				break;
+			default: w.Write((byte)14); break;
+		}
+	}
+
+	private static Expression? ReadExpression(BinaryReader r, TokenSpan span) {
+		switch (r.ReadByte()) {
+			case 0: return null;
+			case 1: return new Expression.Literal(new Literal.Int(r.ReadString()), span);
+			case 2: return new Expression.Literal(new Literal.Float(r.ReadString()), span);
+			case 3: return new Expression.Literal(new Literal.Bool(r.ReadBoolean()), span);
+			case 4: return new Expression.Literal(new Literal.Char(r.ReadChar()), span);
+			case 5: return new Expression.Literal(new Literal.Str(r.ReadString()), span);
+			case 6: return new Expression.Literal(new Literal.Bit(r.ReadByte()), span);
+			case 7: return new Expression.Literal(new Literal.Null(), span);
+			case 8: return new Expression.Literal(new Literal.Nan(), span);
+			case 9: {
+				var op = (UnOp)r.ReadByte();
+				return new Expression.Unary(op, Operand(r, span), span);
+			}
+			case 10: {
+				var left = Operand(r, span);
+				var op = (BinOp)r.ReadByte();
+				return new Expression.Binary(left, op, Operand(r, span), span);
+			}
+			case 11: return new Expression.Identifier(r.ReadString(), span);
+			case 12: {
+				var target = Operand(r, span);
+				return new Expression.MemberAccess(target, r.ReadString(), span);
+			}
+			case 13: {
+				var target = Operand(r, span);
+				return new Expression.MetaAccess(target, r.ReadString(), span);
+			}
+			case var tag: throw new InvalidDataException($"bad expression tag {tag}");
+		}
+	}
+
+	private static Expression Operand(BinaryReader r, TokenSpan span) => ReadExpression(r, span) ?? throw new InvalidDataException("missing operand");
+}
@@ -5,6 +5,7 @@
 // Use, modification, and distribution of this file are governed by the
 // license terms provided with the Cloth Compiler source distribution.
 
+using System.Collections.Concurrent;
 using FrontEnd.Parser.AST;
 using FrontEnd.Parser.AST.Declarations;
 using FrontEnd.Parser.AST.Expressions;
@@ -87,6 +88,15 @@ public sealed class SymbolRegistry {
 	// order across all interfaces, so they're stable per compilation.
 	public Dictionary<string, int> InterfaceMethodSlots { get; } = new();
 
+	// Slot keys of `InterfaceMethodSlots` declared by a dependency (an extern interface or
+	// prototype class). Their vtable row positions are the dependency's, not this build's.
+	public HashSet<string> ExternSlotKeys { get; } = new();
+
+	// Slot key → row position and the library that published it, from the precompiled
+	// dependencies that declare it. Keys of a source-fed dependency are absent;
+	// `CirDispatchLayout` re-derives those.
+	public Dictionary<string, (int Position, string? Library)> PublishedSlotPositions { get; } = new();
+
 	// Per-interface integer IDs (0-based) used to index the per-class implements bitmap
 	// embedded in each vtable global. Populated by `AssignVtableLayouts` in a stable
 	// (sorted-FQN) order. Cycle-broken interfaces still get an ID — only the bitmap-write
@@ -120,34 +130,158 @@ public sealed class SymbolRegistry {
 	// and every parent-chain walker short-circuits on these to avoid infinite loops.
 	public HashSet<string> CycleBrokenClasses { get; } = new();
 
+	// What each function may write, by mangled symbol; see `EffectSummaries`. Filled by the
+	// last pass of `Build`, after the entries a precompiled dependency published.
+	public Dictionary<string, WriteEffect> Effects { get; } = new();
+
+	// Every type FQN and method-member name, interned by `Build`; see `SymbolTable`.
+	public SymbolTable Names { get; } = new();
+
+	// The methods each type declares itself, indexed by the type's `Names` ID: member-name ID
+	// → its overload list (the same list object as in `Overloads`). Null for types without
+	// methods. Built by `IndexMembers` once every member is registered.
+	private Dictionary<SymbolId, List<MethodOverload>>?[] _methodsByOwner = [];
+
 	// Memoization caches for the transitive walks. Keyed by interface FQN. Populated
-	// lazily on first access.
-	private readonly Dictionary<string, List<InterfaceMethodSig>> _transitiveMethodsCache = new();
-	private readonly Dictionary<string, HashSet<string>> _transitiveAncestorsCache = new();
+	// lazily on first access — the only state that changes after `Build`, so they're
+	// concurrent for the parallel analysis workers. Racing fills compute equal values.
+	private readonly ConcurrentDictionary<string, List<InterfaceMethodSig>> _transitiveMethodsCache = new();
+	private readonly ConcurrentDictionary<string, HashSet<string>> _transitiveAncestorsCache = new();
 
-	public static SymbolRegistry Build(IEnumerable<(CompilationUnit Unit, string FilePath)> units, IEnumerable<(CompilationUnit Unit, string FilePath)>? externUnits = null) {
-		var registry = new SymbolRegistry();
+	// Set only while `Build` runs; see `Phase`.
+	private PhaseRecorder? _phases;
+
+	private void Phase(string name, Action body) {
+		if (_phases != null) _phases.Measure(name, body);
+		else body();
+	}
+
+	// `externMetadata` carries dependencies loaded from precompiled `SymbolMetadata` instead of
+	// source. Each phase registers them right after the source units of the same phase, which
+	// is where an extern unit's entries would have landed, so dictionary order (and with it
+	// slot numbering and emission order) matches a source-fed build.
+	//
+	// `phases`, when given, records each pass as a `symbols.*` sub-phase of the caller's timings.
+	public static SymbolRegistry Build(IEnumerable<(CompilationUnit Unit, string FilePath)> units, IEnumerable<(CompilationUnit Unit, string FilePath)>? externUnits = null, IEnumerable<SymbolMetadata>? externMetadata = null, PhaseRecorder? phases = null) {
+		var registry = new SymbolRegistry { _phases = phases };
 		var allUnits = new List<(CompilationUnit Unit, bool IsExtern)>();
 		foreach (var (unit, _) in units) allUnits.Add((unit, false));
 		if (externUnits != null)
 			foreach (var (unit, _) in externUnits)
 				allUnits.Add((unit, true));
+		var metadata = externMetadata?.ToList() ?? new List<SymbolMetadata>();
 
 		// Two-pass registration so cross-class type references in member signatures resolve
 		// regardless of declaration order: pass 1 collects every class/interface/trait FQN;
 		// pass 2 walks members with the full set of known names available.
-		foreach (var (unit, isExtern) in allUnits)
-			registry.RegisterTypeNames(unit, isExtern);
-		foreach (var (unit, isExtern) in allUnits)
-			registry.RegisterTypeMembers(unit, isExtern);
+		registry.Phase("symbols.names", () => {
+			foreach (var (unit, isExtern) in allUnits)
+				registry.RegisterTypeNames(unit, isExtern);
+			foreach (var meta in metadata)
+				registry.RegisterMetadataNames(meta);
+		});
+		registry.Phase("symbols.members", () => {
+			foreach (var (unit, isExtern) in allUnits)
+				registry.RegisterTypeMembers(unit, isExtern);
+			foreach (var meta in metadata)
+				registry.RegisterMetadataMembers(meta);
+		});
+		registry.Phase("symbols.index", registry.IndexMembers);
 		// Pass 3: assign global slot IDs and build per-class vtable layouts. Runs after
 		// pass 2 so all interface method signatures are visible regardless of declaration
 		// order across units.
-		registry.AssignVtableLayouts(allUnits);
+		registry.Phase("symbols.vtables", () => registry.AssignVtableLayouts(allUnits, metadata));
+		// Pass 4: per-function write effects. Needs the vtables to tell virtual calls apart.
+		registry.Phase("symbols.effects", () => EffectSummaries.Compute(registry, allUnits.Select(u => u.Unit).ToList()));
+
+		registry._phases = null;
 
 		return registry;
 	}
 
+	// Pass-1 equivalent for a precompiled dependency: type FQNs and their per-kind info.
+	// Interface / trait / enum entries arrive complete, so pass 2 has nothing to fill in.
+	private void RegisterMetadataNames(SymbolMetadata meta) {
+		foreach (var (fqn, info, _, _) in meta.Classes) {
+			KnownClasses.Add(fqn);
+			Classes[fqn] = info;
+		}
+
+		foreach (var (fqn, info) in meta.Interfaces) {
+			KnownInterfaces.Add(fqn);
+			Interfaces[fqn] = info;
+		}
+
+		foreach (var (fqn, info) in meta.Traits) {
+			KnownTraits.Add(fqn);
+			Traits[fqn] = info;
+		}
+
+		foreach (var (fqn, info) in meta.Enums) {
+			KnownEnums.Add(fqn);
+			Enums[fqn] = info;
+		}
+	}
+
+	// Pass-2 equivalent for a precompiled dependency: fields, constructors, and overloads.
+	private void RegisterMetadataMembers(SymbolMetadata meta) {
+		foreach (var (owner, fields) in meta.Fields) {
+			if (!Fields.TryGetValue(owner, out var list))
+				Fields[owner] = list = new();
+			list.AddRange(fields);
+		}
+
+		foreach (var (owner, ctors) in meta.Constructors) {
+			if (!Constructors.TryGetValue(owner, out var list))
+				Constructors[owner] = list = new();
+			list.AddRange(ctors);
+		}
+
+		foreach (var (methodFqn, overloads) in meta.Overloads) {
+			if (!Overloads.TryGetValue(methodFqn, out var list))
+				Overloads[methodFqn] = list = new();
+			list.AddRange(overloads);
+			foreach (var o in overloads) ExternMethodSymbols.Add(o.MangledSymbol);
+		}
+
+		foreach (var (symbol, effect) in meta.Effects)
+			Effects[symbol] = effect;
+	}
+
+	// Intern every type FQN (first, so types get the low IDs) and split each `Overloads` key
+	// into owner and member name for `DeclaredOverloads`.
+	private void IndexMembers() {
+		foreach (var fqn in KnownClasses.Concat(KnownInterfaces).Concat(KnownTraits).Concat(KnownEnums))
+			Names.Intern(fqn);
+
+		var members = new List<(SymbolId Owner, SymbolId Name, List<MethodOverload> Overloads)>(Overloads.Count);
+		foreach (var (methodFqn, overloads) in Overloads) {
+			var lastDot = methodFqn.LastIndexOf('.');
+			if (lastDot < 0) continue;
+			members.Add((Names.Intern(methodFqn[..lastDot]), Names.Intern(methodFqn[(lastDot + 1)..]), overloads));
+		}
+
+		_methodsByOwner = new Dictionary<SymbolId, List<MethodOverload>>?[Names.Count];
+		foreach (var (owner, name, overloads) in members)
+			(_methodsByOwner[owner.Value] ??= new())[name] = overloads;
+	}
+
+	// The overloads `owner` itself declares under `name` — `Overloads["{owner}.{name}"]` —
+	// or null.
+	public List<MethodOverload>? DeclaredOverloads(SymbolId owner, SymbolId name) =>
+		owner.Value < _methodsByOwner.Length && _methodsByOwner[owner.Value] is { } methods && methods.TryGetValue(name, out var overloads) ? overloads : null;
+
+	// The same by name, for callers walking string FQNs: two lookups in `Names`, and no
+	// method-FQN string is built.
+	public List<MethodOverload>? DeclaredOverloads(string owner, string name) =>
+		Names.TryGetId(owner, out var ownerId) && Names.TryGetId(name, out var nameId) ? DeclaredOverloads(ownerId, nameId) : null;
+
+	// Every member name `owner` declares methods under, with its overloads, in registration order.
+	public IEnumerable<(SymbolId Name, List<MethodOverload> Overloads)> DeclaredMethods(SymbolId owner) =>
+		owner.Value < _methodsByOwner.Length && _methodsByOwner[owner.Value] is { } methods
+			? methods.Select(kv => (kv.Key, kv.Value))
+			: [];
+
 	// Canonical mangled symbol for an interface method's default-impl function. Mirrors the
 	// shape used by class-method mangling so the LLVM emitter can consume both uniformly.
 	public static string DefaultImplSymbol(string ifaceFqn, string methodName, List<string> paramTypes) =>
@@ -518,17 +652,14 @@ public sealed class SymbolRegistry {
 	// interfaces (the cycle is reported separately as S022).
 	public IReadOnlyList<InterfaceMethodSig> TransitiveMethods(string ifaceFqn) {
 		if (_transitiveMethodsCache.TryGetValue(ifaceFqn, out var cached)) return cached;
-		if (CycleBrokenInterfaces.Contains(ifaceFqn)) {
-			_transitiveMethodsCache[ifaceFqn] = new();
-			return _transitiveMethodsCache[ifaceFqn];
-		}
+		if (CycleBrokenInterfaces.Contains(ifaceFqn))
+			return _transitiveMethodsCache.GetOrAdd(ifaceFqn, new List<InterfaceMethodSig>());
 
 		var seen = new HashSet<(string, string, string)>(); // (name, paramKey, returnType)
 		var collected = new List<InterfaceMethodSig>();
 		var visited = new HashSet<string>();
 		Walk(ifaceFqn);
-		_transitiveMethodsCache[ifaceFqn] = collected;
-		return collected;
+		return _transitiveMethodsCache.GetOrAdd(ifaceFqn, collected);
 
 		void Walk(string fqn) {
 			if (!visited.Add(fqn)) return;
@@ -547,14 +678,11 @@ public sealed class SymbolRegistry {
 	public HashSet<string> TransitiveAncestors(string ifaceFqn) {
 		if (_transitiveAncestorsCache.TryGetValue(ifaceFqn, out var cached)) return cached;
 		var result = new HashSet<string>();
-		if (CycleBrokenInterfaces.Contains(ifaceFqn)) {
-			_transitiveAncestorsCache[ifaceFqn] = result;
-			return result;
-		}
+		if (CycleBrokenInterfaces.Contains(ifaceFqn))
+			return _transitiveAncestorsCache.GetOrAdd(ifaceFqn, result);
 
 		Walk(ifaceFqn);
-		_transitiveAncestorsCache[ifaceFqn] = result;
-		return result;
+		return _transitiveAncestorsCache.GetOrAdd(ifaceFqn, result);
 
 		void Walk(string fqn) {
 			if (!result.Add(fqn)) return;
@@ -603,7 +731,7 @@ public sealed class SymbolRegistry {
 	// Pass 3 — assign global slot IDs to every interface method and build per-class vtable
 	// layouts. Slot order is deterministic: interfaces in dictionary-insertion order, and
 	// methods within each interface in their declaration order.
-	private void AssignVtableLayouts(List<(CompilationUnit Unit, bool IsExtern)> allUnits) {
+	private void AssignVtableLayouts(List<(CompilationUnit Unit, bool IsExtern)> allUnits, List<SymbolMetadata> metadata) {
 		// Detect interface inheritance cycles first so transitive walks don't infinite-loop.
 		DetectInterfaceCycles();
 
@@ -621,6 +749,7 @@ public sealed class SymbolRegistry {
 				var key = SlotKey(ifaceFqn, sig.Name, sig.ParamTypes);
 				if (InterfaceMethodSlots.ContainsKey(key)) continue;
 				InterfaceMethodSlots[key] = nextSlot++;
+				if (info.IsExtern) ExternSlotKeys.Add(key);
 			}
 		}
 
@@ -637,9 +766,14 @@ public sealed class SymbolRegistry {
 				var key = SlotKey(o.OwnerClass, methodName, o.ParamTypes);
 				if (InterfaceMethodSlots.ContainsKey(key)) continue;
 				InterfaceMethodSlots[key] = nextSlot++;
+				if (o.IsCrossProject) ExternSlotKeys.Add(key);
 			}
 		}
 
+		foreach (var meta in metadata)
+			foreach (var (key, position) in meta.SlotPositions)
+				PublishedSlotPositions.TryAdd(key, (position, meta.Library));
+
 		VtableSize = nextSlot;
 
 		// Walk every class declaration and produce a vtable layout for those with IsList
@@ -653,6 +787,12 @@ public sealed class SymbolRegistry {
 			}
 		}
 
+		// Precompiled dependencies carry their classes' already-resolved parent and
+		// implements list; slots are filled against this build's global numbering.
+		foreach (var meta in metadata)
+			foreach (var (fqn, _, parentFqn, implements) in meta.Classes)
+				BuildClassVtable(fqn, parentFqn, implements);
+
 		// Detect class inheritance cycles before any chain walker runs. Mirrors the
 		// interface-cycle pass; uses already-resolved `ParentClassFqn`s. Walkers
 		// downstream short-circuit on members of `CycleBrokenClasses`.
@@ -667,7 +807,7 @@ public sealed class SymbolRegistry {
 		// Once every class has its layout (including ParentClassFqn), fill prototype-method
 		// slots. Walks each class's parent chain looking for prototype methods declared on
 		// any ancestor, then picks the most-derived implementation reachable from the class.
-		FillPrototypeMethodSlots();
+		Phase("symbols.prototype-slots", FillPrototypeMethodSlots);
 	}
 
 	// For each class, scan its ancestor chain (parents, grandparents, …) for interfaces
@@ -700,7 +840,7 @@ public sealed class SymbolRegistry {
 
 							// Most-derived impl wins: walk from leaf upward.
 							foreach (var derived in chain) {
-								if (!Overloads.TryGetValue($"{derived}.{sig.Name}", out var overloads)) continue;
+								if (DeclaredOverloads(derived, sig.Name) is not { } overloads) continue;
 								var match = overloads.FirstOrDefault(o => o.ParamTypes.SequenceEqual(sig.ParamTypes) && o.ReturnType == sig.ReturnType);
 								if (match != null) {
 									layout.Slots[slot] = match.MangledSymbol;
@@ -745,11 +885,11 @@ public sealed class SymbolRegistry {
 			// Build the parent chain from this class up to a null root. Skip cycle-broken
 			// classes — their `chain` is meaningless and would loop without the guard.
 			if (CycleBrokenClasses.Contains(classFqn)) continue;
-			var chain = new List<string>();
+			var chain = new List<(string Fqn, SymbolId Id)>();
 			var cursor = classFqn;
 			while (!string.IsNullOrEmpty(cursor)) {
 				if (CycleBrokenClasses.Contains(cursor)) break;
-				chain.Add(cursor);
+				chain.Add((cursor, Names.Intern(cursor)));
 				cursor = ClassVtables.TryGetValue(cursor, out var l) ? l.ParentClassFqn ?? "" : "";
 			}
 
@@ -757,18 +897,15 @@ public sealed class SymbolRegistry {
 			// prototype method declared on it. Match each to the most-derived implementation
 			// in the chain — closest-to-`classFqn` wins, since slots reflect virtual dispatch.
 			foreach (var ancestor in chain) {
-				foreach (var (methodFqn, overloads) in Overloads) {
-					if (!methodFqn.StartsWith(ancestor + ".")) continue;
-					var tail = methodFqn[(ancestor.Length + 1)..];
-					if (tail.Contains('.')) continue;
+				foreach (var (name, overloads) in DeclaredMethods(ancestor.Id)) {
 					foreach (var proto in overloads) {
-						if (!proto.IsPrototype || proto.OwnerClass != ancestor) continue;
-						var slotKey = SlotKey(ancestor, tail, proto.ParamTypes);
+						if (!proto.IsPrototype || proto.OwnerClass != ancestor.Fqn) continue;
+						var slotKey = SlotKey(ancestor.Fqn, Names.NameOf(name), proto.ParamTypes);
 						if (!InterfaceMethodSlots.TryGetValue(slotKey, out var slot)) continue;
 						// Walk the chain from classFqn upward looking for the first non-prototype
 						// overload matching the signature.
 						foreach (var derived in chain) {
-							if (!Overloads.TryGetValue($"{derived}.{tail}", out var dOverloads)) continue;
+							if (DeclaredOverloads(derived.Id, name) is not { } dOverloads) continue;
 							var match = dOverloads.FirstOrDefault(o => !o.IsPrototype && o.ParamTypes.SequenceEqual(proto.ParamTypes) && o.ReturnType == proto.ReturnType);
 							if (match != null) {
 								layout.Slots[slot] = match.MangledSymbol;
@@ -795,9 +932,6 @@ public sealed class SymbolRegistry {
 			if (ifaceFqn != null) implementedFqns.Add(ifaceFqn);
 		}
 
-		if (implementedFqns.Count > 0)
-			ImplementedInterfaces[typeFqn] = implementedFqns;
-
 		// Resolve the parent class FQN (`: BaseClass`) so the runtime cast machinery can
 		// walk the chain. Unresolved names are dropped silently — the analyzer's S019 fires
 		// the user-facing diagnostic.
@@ -805,6 +939,20 @@ public sealed class SymbolRegistry {
 		if (!string.IsNullOrEmpty(c.Extends))
 			parentFqn = ResolveClassName(c.Extends!, importMap, moduleFqn, typeFqn);
 
+		BuildClassVtable(typeFqn, parentFqn, implementedFqns);
+
+		foreach (var member in c.Members) {
+			if (member is MemberDeclaration.NestedType { Declaration: TypeDeclaration.Class { Declaration: var nested } })
+				BuildClassVtableRecursive(nested, typeFqn, importMap);
+		}
+	}
+
+	// Record one class's vtable layout from its resolved parent and implements list. Shared
+	// by source-declared classes and classes loaded from precompiled metadata.
+	private void BuildClassVtable(string typeFqn, string? parentFqn, List<string> implementedFqns) {
+		if (implementedFqns.Count > 0)
+			ImplementedInterfaces[typeFqn] = implementedFqns;
+
 		// Every class gets a vtable layout. Classes with no `IsList` still need an identity
 		// tag for class→class downcasts; their slots array is the standard size with all
 		// nulls (no interface methods to fill). The parent pointer drives chain walks.
@@ -822,8 +970,7 @@ public sealed class SymbolRegistry {
 
 					// Look for a class-side override matching the signature exactly.
 					string? implementer = null;
-					var methodFqn = $"{typeFqn}.{sig.Name}";
-					if (Overloads.TryGetValue(methodFqn, out var overloads)) {
+					if (DeclaredOverloads(typeFqn, sig.Name) is { } overloads) {
 						var matching = overloads.FirstOrDefault(o => o.ParamTypes.SequenceEqual(sig.ParamTypes) && o.ReturnType == sig.ReturnType);
 						if (matching != null) implementer = matching.MangledSymbol;
 					}
@@ -839,11 +986,6 @@ public sealed class SymbolRegistry {
 		}
 
 		ClassVtables[typeFqn] = new ClassVtableLayout(typeFqn, parentFqn, implementedFqns, slots.ToList());
-
-		foreach (var member in c.Members) {
-			if (member is MemberDeclaration.NestedType { Declaration: TypeDeclaration.Class { Declaration: var nested } })
-				BuildClassVtableRecursive(nested, typeFqn, importMap);
-		}
 	}
 
 	// True when `descendant` is `ancestor` itself or extends through to `ancestor` along its
@@ -902,6 +1044,15 @@ public sealed class SymbolRegistry {
 		return outerFqn;
 	}
 
+	// The resolver pass 2 canonicalizes member signatures with: a class FQN, else an
+	// interface FQN. For walkers outside the registry that rebuild a member's mangled symbol.
+	public string? ResolveTypeName(string rawName, Dictionary<string, string> importMap, string moduleFqn, string enclosingClassFqn = "") =>
+		ResolveClassName(rawName, importMap, moduleFqn, enclosingClassFqn) ?? ResolveInterfaceName(rawName, importMap, moduleFqn, enclosingClassFqn);
+
+	public static Dictionary<string, string> ImportMapOf(CompilationUnit unit) => BuildImportMap(unit.Imports);
+
+	public static string ModuleFqnOf(CompilationUnit unit) => ModuleFqn(unit.Module);
+
 	// Resolve a raw class name (as written in source) to a registry FQN. Lookup order:
 	// importMap → already-FQN → enclosing class's nested scope (`<enclosingClassFqn>.<rawName>`)
 	// → same-module sibling → dotted-name fallback (`Outer.Inner` shorthand). Returns null
@@ -972,7 +1123,7 @@ public sealed class SymbolRegistry {
 	private static string TypeFqn(string moduleFqn, string className) =>
 		string.IsNullOrEmpty(moduleFqn) ? className : $"{moduleFqn}.{className}";
 
-	private static string MangleMethod(string typeFqn, string name, List<string> paramTypes) =>
+	public static string MangleMethod(string typeFqn, string name, List<string> paramTypes) =>
 		paramTypes.Count == 0 ? $"{typeFqn}.{name}" : $"{typeFqn}.{name}__{string.Join("__", paramTypes)}";
 }
 
@@ -0,0 +1,34 @@
+// Copyright (c) 2026.The Cloth contributors.
+//
+// SymbolTable.cs is part of the Cloth Compiler.
+//
+// Use, modification, and distribution of this file are governed by the
+// license terms provided with the Cloth Compiler source distribution.
+
+namespace Compiler.Semantics;
+
+// Dense integer IDs for the type FQNs and member names the registry is keyed on. Every name
+// is interned once, in registration order, while `SymbolRegistry.Build` runs; after that the
+// table is only read, so the parallel analysis workers can share it. An ID indexes straight
+// into the registry's per-symbol arrays: a walk that holds IDs (a parent chain, a member
+// name) resolves each hop without assembling and hashing an `"{owner}.{name}"` string.
+public sealed class SymbolTable {
+	private readonly Dictionary<string, SymbolId> _ids = new(StringComparer.Ordinal);
+	private readonly List<string> _names = new();
+
+	public int Count => _names.Count;
+
+	public SymbolId Intern(string name) {
+		if (_ids.TryGetValue(name, out var id)) return id;
+		id = new SymbolId(_names.Count);
+		_ids[name] = id;
+		_names.Add(name);
+		return id;
+	}
+
+	public bool TryGetId(string name, out SymbolId id) => _ids.TryGetValue(name, out id);
+
+	public string NameOf(SymbolId id) => _names[id.Value];
+}
+
+public readonly record struct SymbolId(int Value);
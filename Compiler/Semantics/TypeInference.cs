@@ -166,7 +166,7 @@ public static class TypeInference {
 		};
 	}
 
-	private static bool TryParseSignedInt(string text, out long result) {
+	internal static bool TryParseSignedInt(string text, out long result) {
 		result = 0;
 		var clean = text.Replace("_", "");
 		var negative = false;
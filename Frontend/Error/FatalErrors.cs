@@ -0,0 +1,50 @@
+// Copyright (c) 2026.The Cloth contributors.
+//
+// FatalErrors.cs is part of the Cloth Frontend.
+//
+// Use, modification, and distribution of this file are governed by the
+// license terms provided with the Cloth Compiler source distribution.
+
+using System.Diagnostics.CodeAnalysis;
+
+namespace FrontEnd.Error;
+
+// How a fatal diagnostic ends the build. A one-shot `cloth build` exits the process right
+// after rendering it; a host that outlives one build (`cloth build --watch`, `cloth serve`)
+// sets `Throw`, and the diagnostic surfaces as a `CompilationAbortedException` it catches.
+public static class FatalErrors {
+	public static bool Throw { get; set; }
+
+	// Set on a thread while it lexes and parses one file for the parallel parse: frontend
+	// diagnostics are written there instead of stderr, and a fatal one ends that file by
+	// throwing rather than exiting. The compiler replays the logs in path order.
+	[ThreadStatic]
+	private static TextWriter? _capture;
+
+	public static TextWriter? Capture {
+		get => _capture;
+		set => _capture = value;
+	}
+
+	// Where a frontend diagnostic is rendered on this thread.
+	public static TextWriter Output => _capture ?? Console.Error;
+
+	[DoesNotReturn]
+	public static void Exit(int exitCode) {
+		if (Throw || _capture != null) throw new CompilationAbortedException(exitCode);
+		Environment.Exit(exitCode);
+	}
+
+	// The abort behind `e`, which a `Parallel.For` worker wraps in an AggregateException.
+	public static CompilationAbortedException? AbortOf(Exception e) => e switch {
+		CompilationAbortedException aborted => aborted,
+		AggregateException aggregate => aggregate.Flatten().InnerExceptions.Select(AbortOf).FirstOrDefault(a => a != null),
+		_ => null
+	};
+}
+
+// A fatal diagnostic under `FatalErrors.Throw`. The diagnostic itself has already been
+// written to stderr.
+public sealed class CompilationAbortedException(int exitCode) : Exception($"compilation aborted with exit code {exitCode}") {
+	public int ExitCode { get; } = exitCode;
+}
@@ -19,9 +19,9 @@ public interface IError {
 	}
 
 	public void Render() {
-		Console.Error.WriteLine($"error[{ErrorCode()}]: {GetErrorMessage()}");
+		FatalErrors.Output.WriteLine($"error[{ErrorCode()}]: {GetErrorMessage()}");
 		if (WillExit()) {
-			Environment.Exit(ExitCode());
+			FatalErrors.Exit(ExitCode());
 		}
 	}
 }
\ No newline at end of file
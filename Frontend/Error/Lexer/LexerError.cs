@@ -46,15 +46,16 @@ public class LexerError : Exception, IError {
 	public bool WillExit() => _willExit;
 
 	public void Render() {
-		Console.Error.WriteLine($"Error[{_code}]: {_label}");
+		var output = FatalErrors.Output;
+		output.WriteLine($"Error[{_code}]: {_label}");
 		if (_span != null) {
 			var filePath = _span.File?.Path ?? "<unknown>";
-			Console.Error.WriteLine($"  --> {filePath}:{_span.StartLine}:{_span.StartColumn}");
+			output.WriteLine($"  --> {filePath}:{_span.StartLine}:{_span.StartColumn}");
 		}
 
 		if (_message != null)
-			Console.Error.WriteLine($"  = note: {_message}");
+			output.WriteLine($"  = note: {_message}");
 		if (_willExit)
-			Environment.Exit(1);
+			FatalErrors.Exit(1);
 	}
 }
\ No newline at end of file
@@ -37,6 +37,8 @@ public class ParserError : Exception, IError {
 	public static readonly ParserError InvalidTopLevelDecl = new("P00B", "invalid top-level declaration", true);
 	public static readonly ParserError InvalidDestructorName = new("P00C", "destructor name must be the same as the stating class", true);
 	public static readonly ParserError ClassNameMismatch = new("P00D", "top-level class identifier must match the source file name", true);
+	public static readonly ParserError InvalidSpawn = new("P00E", "'spawn' takes a call", true);
+	public static readonly ParserError AnnotatedNonClass = new("P00F", "only class declarations take annotations", true);
 
 	public ParserError WithMessage(string message) => new(_code, _label, _willExit, message, _span);
 	public ParserError WithSpan(TokenSpan span) => new(_code, _label, _willExit, _message, span);
@@ -46,18 +48,19 @@ public class ParserError : Exception, IError {
 	public bool WillExit() => _willExit;
 
 	public ParserError Render() {
+		var output = FatalErrors.Output;
 		var type = _willExit ? "Error" : "Warning";
 
-		Console.Error.WriteLine($"{type}[{_code}]: {_label}");
+		output.WriteLine($"{type}[{_code}]: {_label}");
 		if (_span != null) {
 			var filePath = _span.File?.Path ?? "<unknown>";
-			Console.Error.WriteLine($"  --> {filePath}:{_span.StartLine}:{_span.StartColumn}");
+			output.WriteLine($"  --> {filePath}:{_span.StartLine}:{_span.StartColumn}");
 		}
 
 		if (_message != null)
-			Console.Error.WriteLine($"  = note: {_message}");
+			output.WriteLine($"  = note: {_message}");
 		if (_willExit)
-			Environment.Exit(1);
+			FatalErrors.Exit(1);
 
 		return this;
 	}
@@ -0,0 +1,43 @@
+// Copyright (c) 2026.The Cloth contributors.
+// 
+// LexemeTable.cs is part of the Cloth Frontend.
+// 
+// Use, modification, and distribution of this file are governed by the
+// license terms provided with the Cloth Compiler source distribution.
+
+using System.Collections.Concurrent;
+
+namespace FrontEnd.Lexer;
+
+// Process-wide intern table for identifier, keyword, and operator lexemes. The same few
+// hundred names recur across every file of a project, so each distinct spelling is
+// allocated once and every later token shares that string. Lookups go through a
+// span-keyed alternate view, so a repeat costs a hash probe and no allocation. Concurrent
+// because `Compiler.ParseUnits` lexes files in parallel.
+//
+// A long-lived host (`cloth serve`, `--watch`) lexes every project and every edit for as
+// long as it runs, so the table is emptied once it holds `Capacity` spellings rather than
+// growing with each identifier ever typed. Interning only shares storage — tokens compare
+// by value — so strings handed out before a reset stay valid.
+internal static class LexemeTable {
+	private const int Capacity = 1 << 16;
+
+	private static readonly ConcurrentDictionary<string, string> Table = new(StringComparer.Ordinal);
+	private static readonly ConcurrentDictionary<string, string>.AlternateLookup<ReadOnlySpan<char>> Lookup = Table.GetAlternateLookup<ReadOnlySpan<char>>();
+
+	// Entries added since the last reset; `Table.Count` would take every bucket lock.
+	private static int _count;
+
+	public static string Intern(ReadOnlySpan<char> text) {
+		if (Lookup.TryGetValue(text, out var existing)) return existing;
+		var str = text.ToString();
+		if (!Table.TryAdd(str, str)) return Table.TryGetValue(str, out existing) ? existing : str;
+
+		if (Interlocked.Increment(ref _count) > Capacity) {
+			Table.Clear();
+			Interlocked.Exchange(ref _count, 0);
+		}
+
+		return str;
+	}
+}
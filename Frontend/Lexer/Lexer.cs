@@ -5,7 +5,6 @@
 // Use, modification, and distribution of this file are governed by the
 // license terms provided with the Cloth Compiler source distribution.
 
-using System.Text;
 using FrontEnd.Error.Lexer;
 using FrontEnd.File;
 using FrontEnd.Token;
@@ -13,6 +12,13 @@ using FrontEnd.Token;
 namespace FrontEnd.Lexer;
 
 public class Lexer {
+	// Multi-character operators, longest first, so `...` wins over `..`. Sorted once rather
+	// than on every operator token.
+	private static readonly string[] MultiCharOperatorsByLength = Operators.MultiCharOperators.OrderByDescending(o => o.Length).ToArray();
+
+	// The source text exactly as read. CRLF and lone CR line endings are not rewritten up
+	// front; `BumpOne` / `BumpN` treat `\r\n` as one line break as they walk, so span offsets
+	// index the file's real characters and no normalized copy is made.
 	private readonly string _input;
 
 	private readonly ClothFile _sourceFile;
@@ -20,31 +26,22 @@ public class Lexer {
 	private int _column;
 	private int _index;
 	private int _line;
+	private bool _started;
 
 	public Lexer(ClothFile sourceFile) {
 		if (!sourceFile.Validate()) {
 			LexerError.InvalidFile.WithMessage($"Invalid source file: {sourceFile.Path}").Render();
 		}
 
-		sourceFile.Read();
-		var normalized = new StringBuilder(sourceFile.Content.Length);
-		for (var i = 0; i < sourceFile.Content.Length; i++) {
-			var ch = sourceFile.Content[i];
-			if (ch == '\r') {
-				if (i + 1 < sourceFile.Content.Length && sourceFile.Content[i + 1] == '\n') i++;
-				normalized.Append('\n');
-			}
-			else {
-				normalized.Append(ch);
-			}
-		}
+		if (sourceFile.Content.Length == 0) sourceFile.Read();
 
 		_sourceFile = sourceFile;
-		_input = normalized.ToString();
+		_input = sourceFile.Content;
 		_index = 0;
 		_line = 1;
 		_column = 1;
 		_afterColonColon = false;
+		_started = false;
 	}
 
 	public ClothFile GetSourceFile() {
@@ -52,24 +49,34 @@ public class Lexer {
 	}
 
 	public List<Token.Token> LexAll() {
-		if (!ClothFile.Exists(_sourceFile)) {
-			LexerError.FileNotFound.WithMessage($"File not found: {_sourceFile}").Render();
+		List<Token.Token> tokens = new();
+
+		while (true) {
+			var token = NextToken();
+			tokens.Add(token);
+			if (token.Type == TokenType.Eof) break;
 		}
 
-		List<Token.Token> tokens = new();
+		return tokens;
+	}
+
+	// Pull-based entry point: lex and return the next token. Once the end of input has been
+	// reached every further call returns a fresh Eof token. Lexer errors are rendered (and
+	// exit) here, exactly as `LexAll` did for the whole file.
+	public Token.Token NextToken() {
+		if (!_started) {
+			_started = true;
+			if (!ClothFile.Exists(_sourceFile))
+				LexerError.FileNotFound.WithMessage($"File not found: {_sourceFile}").Render();
+		}
 
 		while (true)
 			try {
-				var token = NextTokenInternal();
-				var isEof = token.Type == TokenType.Eof;
-				tokens.Add(token);
-				if (isEof) break;
+				return NextTokenInternal();
 			}
 			catch (LexerError err) {
 				err.Render();
 			}
-
-		return tokens;
 	}
 
 	private Token.Token NextTokenInternal() {
@@ -120,7 +127,7 @@ public class Lexer {
 			var ch = PeekChar();
 			if (!ch.HasValue) return;
 
-			if (IsWhitespace(ch.Value)) {
+			if (IsWhitespace(ch.Value) || ch.Value == '\r') {
 				BumpOne();
 				continue;
 			}
@@ -135,7 +142,7 @@ public class Lexer {
 				BumpN(2);
 				while (true) {
 					var c = PeekChar();
-					if (!c.HasValue || c.Value == '\n') break;
+					if (!c.HasValue || c.Value is '\n' or '\r') break;
 					BumpOne();
 				}
 
@@ -191,7 +198,7 @@ public class Lexer {
 				break;
 		}
 
-		return Slice(start, _index);
+		return LexemeTable.Intern(_input.AsSpan(start, _index - start));
 	}
 
 	private Token.Token LexNumberOrDotPrefixedLiteral() {
@@ -307,7 +314,7 @@ public class Lexer {
 		var startCol = _column;
 		BumpOne();
 
-		if (IsEof() || PeekChar() == '\n') throw ErrorAtSpanStart(LexerError.UnterminatedCharLiteral, startIndex, startLine, startCol);
+		if (IsEof() || PeekChar() is '\n' or '\r') throw ErrorAtSpanStart(LexerError.UnterminatedCharLiteral, startIndex, startLine, startCol);
 
 		if (PeekChar() == '\\') {
 			BumpOne();
@@ -337,7 +344,7 @@ public class Lexer {
 		while (true) {
 			if (IsEof()) throw ErrorAtSpanStart(LexerError.UnterminatedString, startIndex, startLine, startCol);
 			var ch = PeekChar() ?? throw ErrorAtSpanStart(LexerError.UnterminatedString, startIndex, startLine, startCol);
-			if (ch == '\n') throw ErrorAtSpanStart(LexerError.UnterminatedString, startIndex, startLine, startCol);
+			if (ch is '\n' or '\r') throw ErrorAtSpanStart(LexerError.UnterminatedString, startIndex, startLine, startCol);
 			if (ch == '"') {
 				BumpOne();
 				break;
@@ -365,7 +372,7 @@ public class Lexer {
 		var startLine = _line;
 		var startCol = _column;
 
-		foreach (var op in Operators.MultiCharOperators.OrderByDescending(o => o.Length))
+		foreach (var op in MultiCharOperatorsByLength)
 			if (StartsWith(op)) {
 				BumpN(op.Length);
 				var endIndex = _index;
@@ -383,7 +390,7 @@ public class Lexer {
 			var endIndex = _index;
 			var endLine = _line;
 			var endCol = _column;
-			var lexeme = Slice(startIndex, endIndex);
+			var lexeme = LexemeTable.Intern(_input.AsSpan(startIndex, endIndex - startIndex));
 			_afterColonColon = false;
 			var opKind = Operators.GetOperatorFromString(lexeme);
 			return MakeToken(TokenType.Operator, lexeme, lexeme, startIndex, endIndex, startLine, startCol, endLine, endCol, op: opKind);
@@ -421,8 +428,7 @@ public class Lexer {
 	}
 
 	private bool StartsWith(string s) {
-		if (_index + s.Length > _input.Length) return false;
-		return _input.Substring(_index, s.Length) == s;
+		return _input.AsSpan(_index).StartsWith(s, StringComparison.Ordinal);
 	}
 
 	private char? PeekChar() {
@@ -446,34 +452,29 @@ public class Lexer {
 	}
 
 	private void BumpOne() {
-		var ch = PeekChar();
-		if (!ch.HasValue) return;
+		if (IsEof()) return;
+		Bump(_input[_index]);
+	}
+
+	private void BumpN(int nBytes) {
+		var target = Math.Min(_index + nBytes, _input.Length);
+		while (_index < target) Bump(_input[_index]);
+	}
 
+	// Advance past one character, tracking line/column. `\r\n` counts as a single line
+	// break (the `\r` is consumed without moving the column; the `\n` ends the line) and a
+	// lone `\r` is a line break on its own, matching the old normalize-then-lex behaviour.
+	private void Bump(char ch) {
 		_index++;
-		if (ch.Value == '\n') {
+		if (ch == '\n' || (ch == '\r' && (_index >= _input.Length || _input[_index] != '\n'))) {
 			_line++;
 			_column = 1;
 		}
-		else {
+		else if (ch != '\r') {
 			_column++;
 		}
 	}
 
-	private void BumpN(int nBytes) {
-		var target = Math.Min(_index + nBytes, _input.Length);
-		while (_index < target) {
-			var ch = _input[_index];
-			_index++;
-			if (ch == '\n') {
-				_line++;
-				_column = 1;
-			}
-			else {
-				_column++;
-			}
-		}
-	}
-
 	private static bool IsWhitespace(char ch) {
 		return ch is ' ' or '\t' or '\n';
 	}
@@ -0,0 +1,45 @@
+// Copyright (c) 2026.The Cloth contributors.
+// 
+// TokenStream.cs is part of the Cloth Frontend.
+// 
+// Use, modification, and distribution of this file are governed by the
+// license terms provided with the Cloth Compiler source distribution.
+
+using FrontEnd.File;
+using FrontEnd.Token;
+
+namespace FrontEnd.Lexer;
+
+// Lazily-filled token buffer between the Lexer and the Parser. Tokens are pulled from the
+// lexer only as the parser's cursor (or lookahead) reaches them, so lexing is interleaved
+// with parsing instead of materializing the whole file up front. Already-lexed tokens are
+// kept because the parser backtracks via `SaveCursor` / `RestoreTo`.
+public sealed class TokenStream(Lexer lexer) {
+	private readonly List<Token.Token> _buffer = new();
+	private bool _complete;
+
+	public ClothFile SourceFile => lexer.GetSourceFile();
+
+	// Token at `index`, lexing forward as needed. Indexes past the end yield the Eof token,
+	// mirroring the parser's old "clamp to last token" behaviour over a full list.
+	public Token.Token this[int index] {
+		get {
+			Fill(index);
+			return index < _buffer.Count ? _buffer[index] : _buffer[^1];
+		}
+	}
+
+	// True when `index` is the final (Eof) token of the stream.
+	public bool IsLast(int index) {
+		Fill(index + 1);
+		return index >= _buffer.Count - 1;
+	}
+
+	private void Fill(int index) {
+		while (!_complete && _buffer.Count <= index) {
+			var token = lexer.NextToken();
+			_buffer.Add(token);
+			if (token.Type == TokenType.Eof) _complete = true;
+		}
+	}
+}
@@ -11,4 +11,4 @@ using FrontEnd.Token;
 
 namespace FrontEnd.Parser.AST.Declarations;
 
-public readonly record struct ClassDeclaration(Visibility? Visibility, List<ClassModifiers> Modifiers, string Name, List<Parameter> PrimaryParameters, string? Extends, List<string> IsList, List<MemberDeclaration> Members, TokenSpan Span);
\ No newline at end of file
+public readonly record struct ClassDeclaration(List<TraitAnnotation> Annotations, Visibility? Visibility, List<ClassModifiers> Modifiers, string Name, List<Parameter> PrimaryParameters, string? Extends, List<string> IsList, List<MemberDeclaration> Members, TokenSpan Span);
\ No newline at end of file
@@ -11,4 +11,5 @@ using FrontEnd.Token;
 
 namespace FrontEnd.Parser.AST.Statements;
 
-public readonly record struct ForInStmt(TypeExpression Type, string Name, Expression Iterable, Block Body, TokenSpan Span);
\ No newline at end of file
+// `Parallel` marks a `parallel for`: iterations may run concurrently, in any order.
+public readonly record struct ForInStmt(TypeExpression Type, string Name, Expression Iterable, Block Body, TokenSpan Span, bool Parallel = false);
\ No newline at end of file
@@ -43,6 +43,10 @@ public abstract record Stmt(TokenSpan Span) {
 
 	public sealed record Delete(Expression Expression, TokenSpan Span) : Stmt(Span);
 
+	// `join { spawn f(a); spawn g(b); }` — runs every spawned call concurrently and waits
+	// for all of them. Each task is a call expression.
+	public sealed record Join(List<Expression> Tasks, TokenSpan Span) : Stmt(Span);
+
 	public sealed record BlockStmt(Block Block) : Stmt(Block.Span);
 
 	public sealed record SuperCall(List<Expression> Arguments, TokenSpan Span) : Stmt(Span);
@@ -19,7 +19,7 @@ using Lexer;
 using Token;
 
 public class Parser {
-	private readonly List<Token> _tokens;
+	private readonly TokenStream _tokens;
 	private Token _current;
 	private bool _moduleDeclared;
 	private int _cursor;
@@ -35,8 +35,8 @@ public class Parser {
 	internal ExpressionParser ExpressionParser;
 
 	public Parser(Lexer lexer) {
-		_tokens = lexer.LexAll();
-		_current = _tokens.First();
+		_tokens = new TokenStream(lexer);
+		_current = _tokens[0];
 		_moduleDeclared = false;
 		_cursor = 0;
 		_currentFileName = lexer.GetSourceFile().NameWithoutExtension;
@@ -47,7 +47,7 @@ public class Parser {
 	public CompilationUnit Parse() {
 		var start = _current.Span;
 
-		_current = _tokens.First();
+		_current = _tokens[0];
 		var module = ParseModuleDeclaration();
 		var imports = ParseImports();
 		var types = new List<TypeDeclaration>();
@@ -198,10 +198,12 @@ public class Parser {
 	}
 
 	private TypeDeclaration ParseTypeDeclaration() {
+		var annotations = ParseAnnotations();
 		var visibility = ParseVisibility();
 		var modifiers = ParseTopModifiers();
+		ExpectClassIfAnnotated(annotations);
 		return _current.Keyword switch {
-			Keyword.Class => new TypeDeclaration.Class(ParseClassDeclaration(visibility, modifiers)),
+			Keyword.Class => new TypeDeclaration.Class(ParseClassDeclaration(annotations, visibility, modifiers)),
 			Keyword.Struct => new TypeDeclaration.Struct(ParseStructDeclaration(visibility)),
 			Keyword.Enum => new TypeDeclaration.Enum(ParseEnumDeclaration(visibility)),
 			Keyword.Interface => new TypeDeclaration.Interface(ParseInterfaceDeclaration(visibility)),
@@ -210,7 +212,7 @@ public class Parser {
 		};
 	}
 
-	private ClassDeclaration ParseClassDeclaration(Visibility visibility, List<ClassModifiers> modifiers, bool nested = false) {
+	private ClassDeclaration ParseClassDeclaration(List<TraitAnnotation> annotations, Visibility visibility, List<ClassModifiers> modifiers, bool nested = false) {
 		var start = _current.Span;
 		ExpectKeyword(Keyword.Class); // consume 'class'
 
@@ -257,7 +259,7 @@ public class Parser {
 			var members = ParseMembers();
 			ExpectOperator(Operator.RBrace);
 
-			return new ClassDeclaration(visibility, modifiers, name, parameters, extends, implementors, members, TokenSpan.Merge(start, Previous().Span));
+			return new ClassDeclaration(annotations, visibility, modifiers, name, parameters, extends, implementors, members, TokenSpan.Merge(start, Previous().Span));
 		}
 		finally {
 			_currentClassName = previousClassName;
@@ -511,7 +513,7 @@ public class Parser {
 				// NESTED TYPE: class modifiers (`inner`, `prototype`, `const`) may appear
 				// before the kind keyword. ParseNestedTypeDeclaration reads any modifiers,
 				// then dispatches on the kind.
-				members.Add(new MemberDeclaration.NestedType(ParseNestedTypeDeclaration(visibility, modifiers)));
+				members.Add(new MemberDeclaration.NestedType(ParseNestedTypeDeclaration(annotations, visibility, modifiers)));
 			}
 			else if (_current.Type == TokenType.Identifier && _current.Literal == _currentClassName) {
 				// CONSTRUCTOR — name matches the class currently being parsed (filename for
@@ -536,11 +538,12 @@ public class Parser {
 	// `const`), then dispatches on the kind keyword. Each kind's parser consumes its own
 	// keyword and the required identifier; the `nested: true` flag forces identifier-mandatory
 	// mode and (for class/struct) makes the primary-ctor parens mandatory too.
-	private TypeDeclaration ParseNestedTypeDeclaration(Visibility visibility, List<FunctionModifiers> _) {
+	private TypeDeclaration ParseNestedTypeDeclaration(List<TraitAnnotation> annotations, Visibility visibility, List<FunctionModifiers> _) {
 		var modifiers = ParseTopModifiers(); // may consume `inner` / `prototype` / `const`
+		ExpectClassIfAnnotated(annotations);
 		var kind = _current.Keyword;
 		return kind switch {
-			Keyword.Class => new TypeDeclaration.Class(ParseClassDeclaration(visibility, modifiers, nested: true)),
+			Keyword.Class => new TypeDeclaration.Class(ParseClassDeclaration(annotations, visibility, modifiers, nested: true)),
 			Keyword.Struct => new TypeDeclaration.Struct(ParseStructDeclaration(visibility, nested: true)),
 			Keyword.Enum => new TypeDeclaration.Enum(ParseEnumDeclaration(visibility, nested: true)),
 			Keyword.Interface => new TypeDeclaration.Interface(ParseInterfaceDeclaration(visibility, nested: true)),
@@ -549,6 +552,13 @@ public class Parser {
 		};
 	}
 
+	// Annotations ahead of a type declaration (`@Compact class`) are kept on classes only; the
+	// other kinds have no layout or code for one to act on.
+	private void ExpectClassIfAnnotated(List<TraitAnnotation> annotations) {
+		if (annotations.Count > 0 && !CheckKeyword(Keyword.Class))
+			throw ParserError.AnnotatedNonClass.WithMessage($"'@{annotations[0].Name}' is not allowed on '{_current.Lexeme}' declarations").WithSpan(annotations[0].Span).Render();
+	}
+
 	/// <summary>
 	/// Parses a list of annotations from the current token stream.
 	/// An annotation is identified by the '@' operator, followed by an identifier or meta token.
@@ -1271,7 +1281,7 @@ public class Parser {
 	/// </summary>
 	/// <returns>The token at the new cursor position after advancing.</returns>
 	internal Token Advance() {
-		if (_cursor < _tokens.Count - 1) _cursor++;
+		if (!_tokens.IsLast(_cursor)) _cursor++;
 		return _current = _tokens[_cursor];
 	}
 
@@ -1282,7 +1292,7 @@ public class Parser {
 	/// <returns>The previous token in the token stream, or the first token if at the beginning of the stream.</returns>
 	internal Token Previous() {
 		if (_cursor - 1 > 0) return _tokens[_cursor - 1];
-		return _tokens.First();
+		return _tokens[0];
 	}
 
 	/// <summary>
@@ -1301,9 +1311,7 @@ public class Parser {
 	/// <param name="offset">The number of positions to move forward from the current cursor to peek at a token.</param>
 	/// <returns>The token located at the specified offset, or the last token if the offset exceeds the bounds of the token list.</returns>
 	internal Token PeekAt(int offset) {
-		var target = _cursor + offset;
-		if (target < _tokens.Count) return _tokens[target];
-		return _tokens.Last();
+		return _tokens[_cursor + offset];
 	}
 
 	/// <summary>
@@ -39,6 +39,8 @@ internal sealed class StatementParser(Parser parser) {
 		if (parser.CheckKeyword(Keyword.While)) return ParseWhileStmt();
 		if (parser.CheckKeyword(Keyword.Do)) return ParseDoWhileStmt();
 		if (parser.CheckKeyword(Keyword.For)) return ParseForStmt();
+		if (IsContextual("parallel") && parser.PeekAt(1).Keyword == Keyword.For) return ParseParallelForStmt();
+		if (IsContextual("join") && parser.PeekAt(1).Operator == Operator.LBrace) return ParseJoinStmt();
 		if (parser.CheckKeyword(Keyword.Return)) return ParseReturnStmt();
 		if (parser.CheckKeyword(Keyword.Throw)) return ParseThrowStmt();
 		if (parser.CheckKeyword(Keyword.Delete)) return ParseDeleteStmt();
@@ -439,6 +441,52 @@ internal sealed class StatementParser(Parser parser) {
 		}
 	}
 
+	/// <summary>
+	/// Parses a 'parallel for' statement: a 'for-in' loop whose iterations may run
+	/// concurrently. 'parallel' is contextual, so it stays usable as an identifier.
+	/// </summary>
+	/// <returns>
+	/// A parsed <see cref="Stmt.ForIn"/> with <see cref="ForInStmt.Parallel"/> set.
+	/// </returns>
+	private Stmt ParseParallelForStmt() {
+		var start = parser.Current.Span;
+		parser.Advance();
+		var loop = ParseForStmt();
+		if (loop is not Stmt.ForIn { Statement: var s })
+			throw ParserError.ExpectedKeyword.WithMessage("'parallel' applies to a 'for (T x in xs)' loop").WithSpan(start).Render();
+		return new Stmt.ForIn(s with { Span = TokenSpan.Merge(start, s.Span), Parallel = true });
+	}
+
+	/// <summary>
+	/// Parses a 'join' block, whose body is a list of 'spawn call(...);' statements. Both
+	/// words are contextual.
+	/// </summary>
+	/// <returns>
+	/// A parsed <see cref="Stmt.Join"/> holding the spawned calls in source order.
+	/// </returns>
+	private Stmt ParseJoinStmt() {
+		var start = parser.Current.Span;
+		parser.Advance();
+		parser.ExpectOperator(Operator.LBrace);
+		var tasks = new List<Expression>();
+		while (!parser.CheckOperator(Operator.RBrace) && !parser.AtEof()) {
+			if (!IsContextual("spawn"))
+				throw ParserError.ExpectedKeyword.WithMessage($"expected 'spawn' in a join block, got '{parser.Current.Lexeme}'").WithSpan(parser.Current.Span).Render();
+			var spawnSpan = parser.Current.Span;
+			parser.Advance();
+			var task = ParseExpression();
+			if (task is not Expression.Call)
+				throw ParserError.InvalidSpawn.WithSpan(spawnSpan).Render();
+			parser.ExpectSemiColon();
+			tasks.Add(task);
+		}
+
+		parser.ExpectOperator(Operator.RBrace);
+		return new Stmt.Join(tasks, TokenSpan.Merge(start, parser.Previous().Span));
+	}
+
+	private bool IsContextual(string word) => parser.Current.Type == TokenType.Identifier && parser.Current.Lexeme == word;
+
 	/// <summary>
 	/// Parses the initializer section of a 'for' loop statement. This method determines
 	/// whether the initialization is a variable declaration, a type-annotated variable